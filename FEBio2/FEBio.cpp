@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include "FECore/log.h"
 #include "FEBioStdSolver.h"
 #include "FECore/FECoreKernel.h"
+#include "FECore/FEProfiler.h"
 #include "FECore/FEAnalysis.h"
 #include "Interrupt.h"
 #include "FEBioXML/XMLReader.h"
@@ -75,6 +76,7 @@ struct CMDOPTIONS
 	char	sztask[MAXFILE];	//!< task name
 	char	szctrl[MAXFILE];	//!< control file for tasks
 	char	szimp[MAXFILE];		//!< import file
+	char	sztim[MAXFILE];		//!< timings file
 };
 
 //-----------------------------------------------------------------------------
@@ -260,6 +262,7 @@ bool ParseCmdLine(int nargs, char* argv[], CMDOPTIONS& ops)
 	ops.sztask[0] = 0;
 	ops.szctrl[0] = 0;
 	ops.szimp[0] = 0;
+	ops.sztim[0] = 0;
 
 	// set the location of the configuration file
 	char szpath[1024] = {0};
@@ -380,7 +383,19 @@ bool ParseCmdLine(int nargs, char* argv[], CMDOPTIONS& ops)
 		{
 			brun = false;
 		}
+		else if (strcmp(sz, "-profile") == 0)
+		{
+			// turn on profiling and see if a trace file is requested
+			FEProfiler& prf = FEProfiler::GetInstance();
+			prf.Enable(true);
+			if ((i<nargs-1) && (argv[i+1][0] != '-')) prf.SetTraceFile(argv[++i]);
+		}
 
+		else if (strcmp(sz, "-timings") == 0)
+		{
+			// write the timing info to a (JSON) file
+			strcpy(ops.sztim, argv[++i]);
+		}
 		else if (strcmp(sz, "-import") == 0)
 		{
 			strcpy(ops.szimp, argv[++i]);
@@ -490,6 +505,7 @@ int Run(CMDOPTIONS& ops)
 	fem.SetLogFilename (ops.szlog);
 	fem.SetPlotFilename(ops.szplt);  
 	fem.SetDumpFilename(ops.szdmp);
+	if (ops.sztim[0]) fem.SetTimingsFilename(ops.sztim);
 		
 	// read the input file if specified
 	if (ops.szfile[0])
@@ -30,12 +30,14 @@ SOFTWARE.*/
 #include "FEBioLib/FEBioModel.h"
 #include "FECore/log.h"
 #include "FEBioXML/FERestartImport.h"
+#include "FEBioXML/FEBioMeshFile.h"
 #include "FECore/DumpFile.h"
 #include <FECore/FEAnalysis.h>
 
 //-----------------------------------------------------------------------------
 REGISTER_FECORE_CLASS(FEBioStdSolver    , FETASK_ID, "solve"  );
 REGISTER_FECORE_CLASS(FEBioRestart		, FETASK_ID, "restart");
+REGISTER_FECORE_CLASS(FEBioMeshConverter, FETASK_ID, "convert_mesh");
 
 //-----------------------------------------------------------------------------
 FEBioStdSolver::FEBioStdSolver(FEModel* pfem) : FECoreTask(pfem) {}
@@ -69,6 +71,9 @@ bool FEBioRestart::Init(const char *szfile)
 	{
 		// the file is binary so just read the dump file and return
 
+		// make sure the archive is not corrupted
+		if (DumpFile::CheckIntegrity(szfile) == false) { fprintf(stderr, "FATAL ERROR: restart archive %s is corrupted\n", szfile); return false; }
+
 		// open the archive
 		DumpFile ar(fem);
 		if (ar.Open(szfile) == false) { fprintf(stderr, "FATAL ERROR: failed opening restart archive\n"); return false; }
@@ -127,3 +132,42 @@ bool FEBioRestart::Run()
 	// continue the analysis
 	return (m_pfem ? m_pfem->Solve() : false);
 }
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshConverter::Init(const char* szfile)
+{
+	FEBioModel& fem = static_cast<FEBioModel&>(*GetFEModel());
+
+	// if no file name is given, we use the input file name with the .febm extension
+	if ((szfile == 0) || (szfile[0] == 0))
+	{
+		const char* szin = fem.GetInputFileName();
+		if ((szin == 0) || (szin[0] == 0)) { fprintf(stderr, "FATAL ERROR: No input file specified\n"); return false; }
+		strcpy(m_szfile, szin);
+		char* ch = strrchr(m_szfile, '.');
+		if (ch) *ch = 0;
+		strcat(m_szfile, ".febm");
+	}
+	else strcpy(m_szfile, szfile);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshConverter::Run()
+{
+	FEModel& fem = *GetFEModel();
+
+	FEBioMeshFile meshFile;
+	if ((meshFile.Create(m_szfile) == false) || (meshFile.WriteMesh(fem) == false))
+	{
+		fprintf(stderr, "FATAL ERROR: %s (%s)\n", meshFile.GetErrorString(), m_szfile);
+		return false;
+	}
+	meshFile.Close();
+
+	FEMesh& mesh = fem.GetMesh();
+	printf("Mesh written to %s (%d nodes, %d elements)\n", m_szfile, mesh.Nodes(), mesh.Elements());
+
+	return true;
+}
@@ -56,3 +56,21 @@ public:
 	//! Run the FE model
 	virtual bool Run();
 };
+
+//-----------------------------------------------------------------------------
+// This task writes the mesh of the input file to a binary mesh file (.febm)
+// that can then be referenced from the Geometry or Include section.
+class FEBioMeshConverter : public FECoreTask
+{
+public:
+	FEBioMeshConverter(FEModel* pfem) : FECoreTask(pfem){}
+
+	//! initialization (szfile is the name of the mesh file)
+	bool Init(const char* szfile);
+
+	//! write the mesh file
+	bool Run();
+
+private:
+	char	m_szfile[512];
+};
@@ -627,6 +627,8 @@ void FEFluidDomain3D::Update(const FETimeInfo& tp)
     
     bool berr = false;
     int NE = (int) m_Elem.size();
+    // the worker threads use the model (and log file) of this thread
+    FEModel* pfem = FECoreKernel::GetThreadModel();
 #pragma omp parallel for shared(NE, berr)
     for (int i=0; i<NE; ++i)
     {
@@ -638,6 +640,7 @@ void FEFluidDomain3D::Update(const FETimeInfo& tp)
         {
 #pragma omp critical
             {
+                FEModelScope scope(pfem);
                 // reset the logfile mode
                 felog.SetMode(nmode);
                 berr = true;
@@ -390,6 +390,32 @@ bool FEFluidFSISolver::InitEquations()
         if (n.m_ID[m_dofWZ] != -1) m_nveq++;
         if (n.m_ID[m_dofEF] != -1) m_nfeq++;
     }
+
+	// In the block scheme, the dilatation equations form one contiguous block
+	// (followed by the rigid body equations), which can be used by block solvers.
+	if ((m_eq_scheme == EQUATION_SCHEME::BLOCK) && (m_nfeq > 0))
+	{
+		int nmin = m_neq, nmax = -1;
+		for (int i=0; i<mesh.Nodes(); ++i)
+		{
+			int nid = mesh.Node(i).m_ID[m_dofEF];
+			if (nid != -1)
+			{
+				nid = (nid < -1 ? -nid-2 : nid);
+				if (nid < nmin) nmin = nid;
+				if (nid > nmax) nmax = nid;
+			}
+		}
+
+		if (nmax - nmin + 1 == m_nfeq)
+		{
+			vector<int> part;
+			part.push_back(nmin);
+			part.push_back(m_nfeq);
+			if (m_neq - nmax - 1 > 0) part.push_back(m_neq - nmax - 1);
+			SetPartitions(part);
+		}
+	}
     
     // All initialization is done
     return true;
@@ -1557,6 +1583,8 @@ bool FEFluidFSISolver::Residual(vector<double>& R)
     }
     
     // calculate the internal (stress) forces
+    // (collected in per-thread buffers)
+    RHS.BeginParallelAssembly(m_asmbuf);
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEDomain& dom = mesh.Domain(i);
@@ -1569,6 +1597,7 @@ bool FEFluidFSISolver::Residual(vector<double>& R)
             else if (edom) edom->InternalForces(RHS);
         }
     }
+    RHS.EndParallelAssembly();
     
     // calculate the body forces
 	for (int j = 0; j<m_fem.BodyLoads(); ++j)
@@ -28,6 +28,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEFluidNormalTraction.h"
 #include "FECore/FEModel.h"
+#include "FECore/FEBlockAssembler.h"
 
 //=============================================================================
 BEGIN_PARAMETER_LIST(FEFluidNormalTraction, FESurfaceLoad)
@@ -76,78 +77,90 @@ void FEFluidNormalTraction::UnpackLM(FEElement& el, vector<int>& lm)
 //! Calculate the residual for the traction load
 void FEFluidNormalTraction::Residual(const FETimeInfo& tp, FEGlobalVector& R)
 {
-    vector<double> fe;
-    vector<int> elm;
-    
-    vec3d rt[FEElement::MAX_NODES];
-	double tn[FEElement::MAX_NODES];
-    
-    int i, n;
     int N = m_psurf->Elements();
-    for (int iel=0; iel<N; ++iel)
+
+    // the element vectors are evaluated in parallel and assembled in element order
+    FEBlockAssembler A(R, N);
+    while (A.NextBlock())
     {
-        FESurfaceElement& el = m_psurf->Element(iel);
+        int n0 = A.BlockStart();
+        int n1 = A.BlockEnd();
+        #pragma omp parallel
+        {
+            vector<double> fe;
+            vector<int> elm;
+
+            vec3d rt[FEElement::MAX_NODES];
+            double tn[FEElement::MAX_NODES];
+
+            int i, n;
+            #pragma omp for
+            for (int iel=n0; iel<n1; ++iel)
+            {
+                FESurfaceElement& el = m_psurf->Element(iel);
         
-        int ndof = 3*el.Nodes();
-        fe.resize(ndof);
+                int ndof = 3*el.Nodes();
+                fe.resize(ndof);
         
-        // nr integration points
-        int nint = el.GaussPoints();
+                // nr integration points
+                int nint = el.GaussPoints();
         
-        // nr of element nodes
-        int neln = el.Nodes();
+                // nr of element nodes
+                int neln = el.Nodes();
         
-        // nodal coordinates
-        for (i=0; i<neln; ++i) {
-            FENode& node = m_psurf->GetMesh()->Node(el.m_node[i]);
-            rt[i] = node.m_rt*tp.alphaf + node.m_rp*(1-tp.alphaf);
+                // nodal coordinates
+                for (i=0; i<neln; ++i) {
+                    FENode& node = m_psurf->GetMesh()->Node(el.m_node[i]);
+                    rt[i] = node.m_rt*tp.alphaf + node.m_rp*(1-tp.alphaf);
 
-			tn[i] = m_TC.value<double>(iel, i)*m_scale;
-        }
+                    tn[i] = m_TC.value<double>(iel, i)*m_scale;
+                }
         
-        double* Gr, *Gs;
-        double* N;
-        double* w  = el.GaussWeights();
+                double* Gr, *Gs;
+                double* N;
+                double* w  = el.GaussWeights();
         
-        vec3d dxr, dxs;
+                vec3d dxr, dxs;
         
-        // repeat over integration points
-        zero(fe);
-        for (n=0; n<nint; ++n)
-        {
-            N  = el.H(n);
-            Gr = el.Gr(n);
-            Gs = el.Gs(n);
+                // repeat over integration points
+                zero(fe);
+                for (n=0; n<nint; ++n)
+                {
+                    N  = el.H(n);
+                    Gr = el.Gr(n);
+                    Gs = el.Gs(n);
             
-            // calculate the tangent vectors
-            dxr = dxs = vec3d(0,0,0);
-            for (i=0; i<neln; ++i)
-            {
-                dxr.x += Gr[i]*rt[i].x;
-                dxr.y += Gr[i]*rt[i].y;
-                dxr.z += Gr[i]*rt[i].z;
+                    // calculate the tangent vectors
+                    dxr = dxs = vec3d(0,0,0);
+                    for (i=0; i<neln; ++i)
+                    {
+                        dxr.x += Gr[i]*rt[i].x;
+                        dxr.y += Gr[i]*rt[i].y;
+                        dxr.z += Gr[i]*rt[i].z;
                 
-                dxs.x += Gs[i]*rt[i].x;
-                dxs.y += Gs[i]*rt[i].y;
-                dxs.z += Gs[i]*rt[i].z;
-            }
+                        dxs.x += Gs[i]*rt[i].x;
+                        dxs.y += Gs[i]*rt[i].y;
+                        dxs.z += Gs[i]*rt[i].z;
+                    }
             
-            vec3d normal = dxr ^ dxs;
+                    vec3d normal = dxr ^ dxs;
             
-            for (i=0; i<neln; ++i)
-            {
-				vec3d f = normal*(tn[i]*w[n]);
+                    for (i=0; i<neln; ++i)
+                    {
+                        vec3d f = normal*(tn[i]*w[n]);
 
-                fe[3*i  ] += N[i]*f.x;
-                fe[3*i+1] += N[i]*f.y;
-                fe[3*i+2] += N[i]*f.z;
-            }
-        }
+                        fe[3*i  ] += N[i]*f.x;
+                        fe[3*i+1] += N[i]*f.y;
+                        fe[3*i+2] += N[i]*f.z;
+                    }
+                }
         
-        // get the element's LM vector and adjust it
-        UnpackLM(el, elm);
+                // get the element's LM vector and adjust it
+                UnpackLM(el, elm);
         
-        // add element force vector to global force vector
-        R.Assemble(el.m_node, elm, fe);
+                // add element force vector to global force vector
+                A.Add(iel, el.m_node, elm, fe);
+            }
+        }
     }
 }
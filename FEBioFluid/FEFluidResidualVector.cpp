@@ -48,30 +48,13 @@ void FEFluidResidualVector::Assemble(vector<int>& en, vector<int>& elm, vector<d
     
     vector<double>& R = m_R;
     
-    int i, I;
-    
     vec3d a, d;
     
     //#pragma omp critical
     {
         // assemble the element residual into the global residual
         int ndof = fe.size();
-        for (i=0; i<ndof; ++i)
-        {
-            
-            I = elm[i];
-            
-            if ( I >= 0){
-#pragma omp atomic
-                R[I] += fe[i];
-            }
-            // TODO: Find another way to store reaction forces
-            
-            else if (-I-2 >= 0){
-#pragma omp atomic
-                m_Fr[-I-2] -= fe[i];
-            }
-        }
+        AssembleVector(elm, fe);
         
         
         int ndn = ndof / en.size();
@@ -85,6 +85,7 @@ FEFluidSolver::FEFluidSolver(FEModel* pfem) : FENewtonSolver(pfem)
 
     m_rhoi = 0;
     m_pred = 0;
+    m_err = -1;
     
 	// Preferred strategy is Broyden's method
 	SetDefaultStrategy(QN_BROYDEN);
@@ -302,6 +303,7 @@ void FEFluidSolver::Serialize(DumpStream& ar)
         ar << m_naug;
 		ar << m_alphaf << m_alpham << m_gammaf;
 		ar << m_nveq << m_ndeq;
+		ar << m_err;
     }
     else
     {
@@ -312,6 +314,7 @@ void FEFluidSolver::Serialize(DumpStream& ar)
         ar >> m_naug;
 		ar >> m_alphaf >> m_alpham >> m_gammaf;
 		ar >> m_nveq >> m_ndeq;
+		ar >> m_err;
 	}
 
 	if (ar.IsShallow() == false)
@@ -416,6 +419,50 @@ void FEFluidSolver::UpdateKinematics(vector<double>& ui)
     }
 }
 
+//-----------------------------------------------------------------------------
+//! Estimates the local time integration error of the converged time step from
+//! the difference between the corrected solution and the explicit predictor
+//! y_p + dt*ydot_p (i.e. the "same Ydot" predictor). This difference is of
+//! order dt^2 and is measured relative to the norm of the solution. Since the
+//! velocity and dilatation have different units, the relative error is calculated
+//! for each field separately and the largest one is returned.
+//! This is only available for dynamic analyses, since the time derivatives are
+//! not updated otherwise.
+double FEFluidSolver::EstimateTimeStepError()
+{
+    FEAnalysis* pstep = m_fem.GetCurrentStep();
+    if (pstep->m_nanalysis != FE_DYNAMIC) return -1.0;
+
+    double dt = m_fem.GetTime().timeIncrement;
+
+    FEMesh& mesh = m_fem.GetMesh();
+    const int N = mesh.Nodes();
+    double ev = 0, nv = 0, ee = 0, ne = 0;
+#pragma omp parallel for reduction(+:ev,nv,ee,ne)
+    for (int i=0; i<N; ++i)
+    {
+        FENode& node = mesh.Node(i);
+
+        vec3d vft = node.get_vec3d(m_dofWX, m_dofWY, m_dofWZ);
+        vec3d vfp = node.get_vec3d(m_dofWXP, m_dofWYP, m_dofWZP);
+        vec3d afp = node.get_vec3d(m_dofAWXP, m_dofAWYP, m_dofAWZP);
+        vec3d dv = vft - (vfp + afp*dt);
+        ev += dv*dv;
+        nv += vft*vft;
+
+        double eft = node.get(m_dofEF);
+        double efp = node.get(m_dofEFP);
+        double aefp = node.get(m_dofAEFP);
+        double de = eft - (efp + aefp*dt);
+        ee += de*de;
+        ne += eft*eft;
+    }
+
+    double rv = (nv > 0 ? sqrt(ev/nv) : 0.0);
+    double re = (ne > 0 ? sqrt(ee/ne) : 0.0);
+    return (rv > re ? rv : re);
+}
+
 //-----------------------------------------------------------------------------
 //! Updates the current state of the model
 void FEFluidSolver::Update(vector<double>& ui)
@@ -525,6 +572,7 @@ void FEFluidSolver::PrepStep()
     zero(m_Ui);
     zero(m_Vi);
     zero(m_Di);
+    m_err = -1;
     
     // store previous mesh state
     // we need them for strain and acceleration calculations
@@ -807,6 +855,9 @@ bool FEFluidSolver::Quasin()
     if (bconv)
     {
         m_Ut += m_Ui;
+
+        // estimate the time integration error for the time step controller
+        m_err = EstimateTimeStepError();
     }
     
     return bconv;
@@ -1032,11 +1083,14 @@ bool FEFluidSolver::Residual(vector<double>& R)
     }
     
     // calculate the internal (stress) forces
+    // (collected in per-thread buffers)
+    RHS.BeginParallelAssembly(m_asmbuf);
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
         dom.InternalForces(RHS, tp);
     }
+    RHS.EndParallelAssembly();
     
     // calculate the body forces
 	for (int j = 0; j<m_fem.BodyLoads(); ++j)
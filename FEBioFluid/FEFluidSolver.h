@@ -90,6 +90,9 @@ public:
     
     //! Performs a Newton-Raphson iteration
     bool Quasin() override;
+
+    //! local time integration error of the last converged time step
+    double TimeStepError() override { return m_err; }
     
     //! Lagrangian augmentation
     bool Augment() override;
@@ -122,6 +125,9 @@ public:
 protected:
     void GetVelocityData(vector<double>& vi, vector<double>& ui);
     void GetDilatationData(vector<double>& ei, vector<double>& ui);
+
+    //! estimate the local time integration error of the converged time step
+    double EstimateTimeStepError();
     
 public:
     // convergence tolerances
@@ -154,6 +160,7 @@ public:
     double  m_alpham;       //!< alpha step for Ydot={∂v/∂t,∂e/∂t}
     double  m_gammaf;       //!< gamma
     int     m_pred;         //!< predictor method
+    double  m_err;          //!< local error estimate of last converged time step (-1 if not available)
 
 protected:
     int     m_dofX;
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/FEAnalysis.h"
 #include "FECore/FENormalProjection.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -265,7 +266,7 @@ void FETiedFluidSurface::GetNormalVelocity(int nface, double& vn)
 
 FETiedFluidInterface::FETiedFluidInterface(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-    static int count = 1;
+    static std::atomic<int> count(1);
     SetID(count++);
     
     // initial values
@@ -845,6 +845,8 @@ void FEThermoElasticSolidDomain::Update(const FETimeInfo& tp)
 {
 	bool berr = false;
 	int NE = (int) m_Elem.size();
+	// the worker threads use the model (and log file) of this thread
+	FEModel* pfem = FECoreKernel::GetThreadModel();
 	#pragma omp parallel for shared(NE, berr)
 	for (int i=0; i<NE; ++i)
 	{
@@ -856,6 +858,7 @@ void FEThermoElasticSolidDomain::Update(const FETimeInfo& tp)
 		{
 			#pragma omp critical
 			{
+				FEModelScope scope(pfem);
 				berr = true;
 				if (NegativeJacobian::m_boutput) e.print();
 			}
@@ -0,0 +1,105 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEBioCheckpoint.h"
+#include <FECore/DumpFile.h>
+#include <FECore/FEModel.h>
+#include <FECore/log.h>
+#include <stdio.h>
+
+#ifdef WIN32
+	#include <windows.h>
+#endif
+
+//-----------------------------------------------------------------------------
+FEBioCheckpointWriter::FEBioCheckpointWriter(FEModel& fem) : m_fem(fem), m_ar(fem)
+{
+	m_bok = true;
+	m_bwait = false;
+}
+
+//-----------------------------------------------------------------------------
+FEBioCheckpointWriter::~FEBioCheckpointWriter()
+{
+	if (m_thread.joinable()) m_thread.join();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioCheckpointWriter::Write(const char* szfile, bool basync)
+{
+	// we only keep one copy of the model, so the last checkpoint must be written first
+	Wait();
+
+	// serialize the model (the stream keeps its buffer between checkpoints)
+	m_ar.clear();
+	m_ar.Open(true, false);
+	m_fem.Serialize(m_ar);
+
+	m_file = szfile;
+	m_bwait = true;
+	if (basync)
+	{
+		m_thread = std::thread(&FEBioCheckpointWriter::WriteFile, this);
+		return true;
+	}
+
+	WriteFile();
+	return Wait();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioCheckpointWriter::Wait()
+{
+	if (m_thread.joinable()) m_thread.join();
+	if (m_bwait == false) return true;
+	m_bwait = false;
+
+	// The log is not thread safe, so the result is reported here
+	if (m_bok) felog.printf("\nRestart point created. Archive name is %s\n", m_file.c_str());
+	else felog.printf("WARNING: Failed creating restart file (%s).\n", m_file.c_str());
+
+	return m_bok;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioCheckpointWriter::WriteFile()
+{
+	// write to a temporary file first, so that an existing checkpoint
+	// is only replaced by a complete one
+	std::string tmp = m_file + ".tmp";
+	m_bok = DumpFile::WriteBuffer(tmp.c_str(), m_ar.data(), m_ar.size());
+	if (m_bok)
+	{
+		// replace the old checkpoint (rename does not replace existing files on Windows)
+#ifdef WIN32
+		m_bok = (MoveFileExA(tmp.c_str(), m_file.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+#else
+		m_bok = (rename(tmp.c_str(), m_file.c_str()) == 0);
+#endif
+	}
+}
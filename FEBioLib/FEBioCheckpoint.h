@@ -0,0 +1,69 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/DumpMemStream.h>
+#include <thread>
+#include <string>
+
+class FEModel;
+
+//-----------------------------------------------------------------------------
+//! This class writes restart files (checkpoints) from an in-memory copy of the
+//! model state. The model is serialized into a memory stream, which is then
+//! written to file, optionally by a background thread so that the solver can
+//! continue. The file is first written under a temporary name and renamed once
+//! it is complete, and it ends with a trailer that contains a checksum of the data
+//! (see DumpFile::CheckIntegrity).
+class FEBioCheckpointWriter
+{
+public:
+	FEBioCheckpointWriter(FEModel& fem);
+
+	//! destructor (waits for the background thread)
+	~FEBioCheckpointWriter();
+
+	//! Serialize the model and write it to szfile. If basync is true, the file is
+	//! written in the background and the function returns as soon as the model is
+	//! serialized. Returns false if the model could not be written.
+	bool Write(const char* szfile, bool basync);
+
+	//! Wait until the last checkpoint is written. Returns false if writing it failed.
+	bool Wait();
+
+private:
+	// write the stream to file (runs on the background thread)
+	void WriteFile();
+
+private:
+	FEModel&		m_fem;
+	DumpMemStream	m_ar;		//!< the serialized model
+	std::thread		m_thread;	//!< thread that writes the file
+	std::string		m_file;		//!< file name of the checkpoint being written
+	bool			m_bok;		//!< result of the last write
+	bool			m_bwait;	//!< a write result still needs to be reported
+};
@@ -37,10 +37,15 @@ SOFTWARE.*/
 #include "FECore/NLConstraintDataRecord.h"
 #include "FECore/log.h"
 #include "FECore/FECoreKernel.h"
+#include "FECore/FEProfiler.h"
 #include "FECore/DumpFile.h"
+#include "FEBioCheckpoint.h"
 #include "FECore/DOFS.h"
 #include "febio.h"
 #include "version.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 //-----------------------------------------------------------------------------
 BEGIN_PARAMETER_LIST(FEBioModel, FEModel)
@@ -81,7 +86,13 @@ FEBioModel::FEBioModel()
 	m_szplot[0] = 0;
 	m_szlog[0] = 0;
 	m_szdump[0] = 0;
+	m_sztimings[0] = 0;
 	m_debug = false;
+
+	m_ndumpFiles = 1;
+	m_bdumpAsync = false;
+	m_ndumps = 0;
+	m_ckp = 0;
 	m_becho = true;
 	m_plot = 0;
 
@@ -94,6 +105,9 @@ FEBioModel::~FEBioModel()
 {
 	// close the plot file
 	if (m_plot) { delete m_plot; m_plot = 0; }
+
+	// finish writing the last checkpoint
+	if (m_ckp) { m_ckp->Wait(); delete m_ckp; m_ckp = 0; }
 }
 
 //-----------------------------------------------------------------------------
@@ -106,8 +120,79 @@ Timer& FEBioModel::GetSolveTimer()
 //! return number of seconds of time spent in linear solver
 int FEBioModel::GetLinearSolverTime() const
 {
-	Timer* t = FECoreKernel::GetInstance().FindTimer("solve");
-	return t->peek();
+	// the timers of this model are used, since this can be called outside of Solve
+	const vector<Timer*>& timers = GetTimers();
+	for (size_t i = 0; i<timers.size(); ++i)
+	{
+		if (timers[i]->name() == "solve") return timers[i]->peek();
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+//! Write the timing info to the timings file. This is a JSON file that contains
+//! the model size, the iteration counts, the times of the main phases and the
+//! times of all the named timers (see TRACK_TIME). It is used by the benchmark
+//! scripts to track performance between versions.
+bool FEBioModel::WriteTimings(bool bconv)
+{
+	if (m_sztimings[0] == 0) return true;
+
+	FILE* fp = fopen(m_sztimings, "wt");
+	if (fp == 0) return false;
+
+#ifdef _OPENMP
+	int nthreads = omp_get_max_threads();
+#else
+	int nthreads = 1;
+#endif
+
+	FEMesh& mesh = GetMesh();
+	int ntimesteps = 0, ntotiter = 0, ntotref = 0, ntotrhs = 0;
+	for (int i=0; i<Steps(); ++i)
+	{
+		FEAnalysis* pstep = GetStep(i);
+		ntimesteps += pstep->m_ntimesteps;
+		ntotiter   += pstep->m_ntotiter;
+		ntotref    += pstep->m_ntotref;
+		ntotrhs    += pstep->m_ntotrhs;
+	}
+
+	fprintf(fp, "{\n");
+	const char* sztitle = GetFileTitle();
+	fprintf(fp, "\t\"file\": \"%s\",\n", (sztitle ? sztitle : ""));
+	fprintf(fp, "\t\"version\": \"%d.%d.%d\",\n", VERSION, SUBVERSION, SUBSUBVERSION);
+	fprintf(fp, "\t\"converged\": %s,\n", (bconv ? "true" : "false"));
+	fprintf(fp, "\t\"threads\": %d,\n", nthreads);
+	fprintf(fp, "\t\"nodes\": %d,\n", mesh.Nodes());
+	fprintf(fp, "\t\"elements\": %d,\n", mesh.Elements());
+	fprintf(fp, "\t\"time_steps\": %d,\n", ntimesteps);
+	fprintf(fp, "\t\"iterations\": %d,\n", ntotiter);
+	fprintf(fp, "\t\"reformations\": %d,\n", ntotref);
+	fprintf(fp, "\t\"rhs_evaluations\": %d,\n", ntotrhs);
+
+	// the main phases
+	fprintf(fp, "\t\"phases\": {\n");
+	fprintf(fp, "\t\t\"input\": %lg,\n", m_InputTime.GetTime());
+	fprintf(fp, "\t\t\"init\": %lg,\n" , m_InitTime.GetTime());
+	fprintf(fp, "\t\t\"solve\": %lg,\n", m_SolveTime.GetTime());
+	fprintf(fp, "\t\t\"io\": %lg\n"    , m_IOTimer.GetTime());
+	fprintf(fp, "\t},\n");
+
+	// the named timers
+	FECoreKernel& fecore = FECoreKernel::GetInstance();
+	int ntimers = fecore.Timers();
+	fprintf(fp, "\t\"timers\": {");
+	for (int i=0; i<ntimers; ++i)
+	{
+		Timer* ti = fecore.GetTimer(i);
+		fprintf(fp, "%s\n\t\t\"%s\": %lg", (i == 0 ? "" : ","), ti->name().c_str(), ti->GetTime());
+	}
+	fprintf(fp, "\n\t}\n");
+	fprintf(fp, "}\n");
+
+	fclose(fp);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -186,6 +271,12 @@ void FEBioModel::SetDumpFilename (const char* szfile)
 	strcpy(m_szdump, szfile); 
 }
 
+//-----------------------------------------------------------------------------
+void FEBioModel::SetTimingsFilename(const char* szfile)
+{
+	strcpy(m_sztimings, szfile);
+}
+
 //-----------------------------------------------------------------------------
 //! Return the name of the input file
 const char* FEBioModel::GetInputFileName()
@@ -235,6 +326,9 @@ bool FEBioModel::Input(const char* szfile)
 	// start the timer
 	TimerTracker t(m_InputTime);
 
+	// work on this model (log file, timers and profiler)
+	FEModelScope scope(this);
+
 	// create file reader
 	FEBioImport fim;
 
@@ -257,6 +351,7 @@ bool FEBioModel::Input(const char* szfile)
 
 	// see if user redefined output filenames
 	if (fim.m_szdmp[0]) SetDumpFilename(fim.m_szdmp);
+	SetDumpOptions(fim.m_ndmpFiles, fim.m_bdmpAsync);
 	if (fim.m_szlog[0]) SetLogFilename (fim.m_szlog);
 	if (fim.m_szplt[0]) SetPlotFilename(fim.m_szplt);
 
@@ -553,10 +648,43 @@ void FEBioModel::WriteData()
 	m_Data.Write();
 }
 
+//-----------------------------------------------------------------------------
+void FEBioModel::SetDumpOptions(int nfiles, bool basync)
+{
+	m_ndumpFiles = (nfiles < 1 ? 1 : nfiles);
+	m_bdumpAsync = basync;
+}
+
 //-----------------------------------------------------------------------------
 //! Dump state to archive for restarts
 void FEBioModel::DumpData()
 {
+	// When more than one restart file is requested or when they are written in the background,
+	// the restart files are written from a copy of the model state by the checkpoint writer.
+	if ((m_ndumpFiles > 1) || m_bdumpAsync)
+	{
+		char szfile[MAX_STRING + 16];
+		if (m_ndumpFiles > 1)
+		{
+			// rotate over the files by inserting the file index before the extension
+			strcpy(szfile, m_szdump);
+			char* ch = strrchr(szfile, '.');
+			char* sl = strrchr(szfile, '/');
+			char* bs = strrchr(szfile, '\\');
+			if (bs > sl) sl = bs;
+			if ((ch == 0) || (sl && (sl > ch))) ch = szfile + strlen(szfile);
+			char szext[MAX_STRING];
+			strcpy(szext, ch);
+			sprintf(ch, ".%d%s", m_ndumps % m_ndumpFiles, szext);
+		}
+		else strcpy(szfile, m_szdump);
+		m_ndumps++;
+
+		if (m_ckp == 0) m_ckp = new FEBioCheckpointWriter(*this);
+		m_ckp->Write(szfile, m_bdumpAsync);
+		return;
+	}
+
 	DumpFile ar(*this);
 	if (ar.Create(m_szdump) == false)
 	{
@@ -717,6 +845,9 @@ bool FEBioModel::Init()
 {
 	TimerTracker t(m_InitTime);
 
+	// work on this model (log file, timers and profiler)
+	FEModelScope scope(this);
+
 	// Open the logfile
 	if (m_logLevel != 0)
 	{
@@ -895,6 +1026,9 @@ bool FEBioModel::Reset()
 
 bool FEBioModel::Solve()
 {
+	// work on this model (log file, timers and profiler)
+	FEModelScope scope(this);
+
 	// start the total time tracker
 	m_SolveTime.start();
 
@@ -909,6 +1043,9 @@ bool FEBioModel::Solve()
 	m_SolveTime.time_str(sztime);
 	felog.printf("\n Elapsed time : %s\n\n", sztime);
 
+	// write the timings file
+	if (WriteTimings(bconv) == false) felog.printf("WARNING: Failed writing timings file %s.\n\n", m_sztimings);
+
 	// print additional stats to the log file only
 	if (felog.GetMode() & Logfile::LOG_FILE)
 	{
@@ -957,6 +1094,13 @@ bool FEBioModel::Solve()
 		Timer::time_str(total_linsol, sztime); felog.printf("\t   time in linear solver ........ : %s (%lg sec)\n\n", sztime, total_linsol);
 		Timer::time_str(total_time  , sztime); felog.printf("\tTotal elapsed time .............. : %s (%lg sec)\n\n", sztime, total_time  );
 
+		// print the profiler report
+		FEProfiler& prf = FEProfiler::GetInstance();
+		if (prf.IsEnabled())
+		{
+			prf.PrintReport();
+			if (prf.WriteTrace() == false) felog.printf("WARNING: Failed writing profiler trace file.\n\n");
+		}
 
 		felog.SetMode(old_mode);
 
@@ -33,6 +33,8 @@ SOFTWARE.*/
 #include <FECore/FECoreKernel.h>
 #include "febiolib_api.h"
 
+class FEBioCheckpointWriter;
+
 //-----------------------------------------------------------------------------
 //! The FEBio model specializes the FEModel class to implement FEBio specific
 //! functionality.
@@ -74,6 +76,9 @@ public: // --- I/O functions ---
 	//! dump data to archive for restart
 	void DumpData();
 
+	//! set the nr of rotating restart files and whether they are written in the background
+	void SetDumpOptions(int nfiles, bool basync);
+
 public:
 	//! set the problem title
 	void SetTitle(const char* sz);
@@ -106,6 +111,7 @@ public: // --- I/O functions ---
 	void SetLogFilename  (const char* szfile);
 	void SetPlotFilename (const char* szfile);
 	void SetDumpFilename (const char* szfile);
+	void SetTimingsFilename(const char* szfile);
 
 	//! Get the I/O file names
 	const char* GetInputFileName();
@@ -127,6 +133,9 @@ public: // Timers
 	//! return number of seconds of time spent in linear solver
 	int GetLinearSolverTime() const;
 
+	//! write the timing info of the last run to the timings file (JSON)
+	bool WriteTimings(bool bconv);
+
 public:
 	//! set the debug level
 	void SetDebugFlag(bool b) { m_debug = b; }
@@ -153,6 +162,12 @@ protected: // file names
 	char	m_szplot[MAX_STRING];	//!< plot output file name
 	char	m_szlog [MAX_STRING];	//!< log output file name
 	char	m_szdump[MAX_STRING];	//!< dump file name
+	char	m_sztimings[MAX_STRING];	//!< timings output file name (optional)
+
+	int		m_ndumpFiles;			//!< nr of rotating restart files
+	bool	m_bdumpAsync;			//!< write restart files in the background
+	int		m_ndumps;				//!< nr of restart files written so far
+	FEBioCheckpointWriter*	m_ckp;	//!< writer for rotating and background restart files
 
 	char	m_sztitle[MAX_STRING];	//!< model title
 
@@ -125,6 +125,8 @@ bool Configure(const char* szfile)
 						else if (strcmp(szt, "stokes"            ) == 0) FECoreKernel::SetDefaultSolver(nsolver = STOKES_SOLVER    );
 						else if (strcmp(szt, "cg_stokes"         ) == 0) FECoreKernel::SetDefaultSolver(nsolver = CG_STOKES_SOLVER );
 						else if (strcmp(szt, "schur"             ) == 0) FECoreKernel::SetDefaultSolver(nsolver = SCHUR_SOLVER     );
+						else if (strcmp(szt, "block_gmres"       ) == 0) FECoreKernel::SetDefaultSolver(nsolver = BLOCK_GMRES_SOLVER);
+						else if (strcmp(szt, "mixed_precision"   ) == 0) FECoreKernel::SetDefaultSolver(nsolver = MIXED_PRECISION_SOLVER);
 						else { fprintf(stderr, "Invalid linear solver\n"); return false; }
 
 						if (tag.isleaf() == false)
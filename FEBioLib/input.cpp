@@ -455,6 +455,8 @@ void echo_input(FEBioModel& fem)
 	case STOKES_SOLVER      : felog.printf("Stokes\n"            ); break;
 	case CG_STOKES_SOLVER   : felog.printf("CG_Stokes\n"         ); break;
 	case SCHUR_SOLVER       : felog.printf("Schur\n"             ); break;
+	case BLOCK_GMRES_SOLVER : felog.printf("Block GMRES\n"       ); break;
+	case MIXED_PRECISION_SOLVER: felog.printf("Mixed precision\n"); break;
 	default:
 		assert(false);
 		felog.printf("Unknown solver\n");
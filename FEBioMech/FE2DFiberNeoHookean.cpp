@@ -36,29 +36,19 @@ BEGIN_PARAMETER_LIST(FE2DFiberNeoHookean, FEElasticMaterial)
 	ADD_PARAMETER(m_ac, FE_PARAM_DOUBLE, "active_contraction");
 END_PARAMETER_LIST();
 
-double FE2DFiberNeoHookean::m_cth[FE2DFiberNeoHookean::NSTEPS];
-double FE2DFiberNeoHookean::m_sth[FE2DFiberNeoHookean::NSTEPS];
-
-
 //////////////////////////////////////////////////////////////////////
 // FE2DFiberNeoHookean
 //////////////////////////////////////////////////////////////////////
 
 FE2DFiberNeoHookean::FE2DFiberNeoHookean(FEModel* pfem) : FEElasticMaterial(pfem)
 {
-	static bool bfirst = true;
-
-	if (bfirst)
+	double ph;
+	const double PI = 4.0*atan(1.0);
+	for (int n=0; n<NSTEPS; ++n)
 	{
-		double ph;
-		const double PI = 4.0*atan(1.0);
-		for (int n=0; n<NSTEPS; ++n)
-		{
-			ph = 2.0*PI*n / (double) NSTEPS;
-			m_cth[n] = cos(ph);
-			m_sth[n] = sin(ph);
-		}
-		bfirst = false;
+		ph = 2.0*PI*n / (double) NSTEPS;
+		m_cth[n] = cos(ph);
+		m_sth[n] = sin(ph);
 	}
 
 	m_ac = 0;
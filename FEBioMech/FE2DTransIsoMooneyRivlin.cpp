@@ -41,9 +41,6 @@ BEGIN_PARAMETER_LIST(FE2DTransIsoMooneyRivlin, FEUncoupledMaterial)
 	ADD_PARAMETER(m_ac, FE_PARAM_DOUBLE, "active_contraction");
 END_PARAMETER_LIST();
 
-double FE2DTransIsoMooneyRivlin::m_cth[FE2DTransIsoMooneyRivlin::NSTEPS];
-double FE2DTransIsoMooneyRivlin::m_sth[FE2DTransIsoMooneyRivlin::NSTEPS];
-
 #ifndef SQR
 #define SQR(x) ((x)*(x))
 #endif
@@ -54,19 +51,13 @@ double FE2DTransIsoMooneyRivlin::m_sth[FE2DTransIsoMooneyRivlin::NSTEPS];
 
 FE2DTransIsoMooneyRivlin::FE2DTransIsoMooneyRivlin(FEModel* pfem) : FEUncoupledMaterial(pfem)
 {
-	static bool bfirst = true;
-
-	if (bfirst)
+	double ph;
+	const double PI = 4.0*atan(1.0);
+	for (int n=0; n<NSTEPS; ++n)
 	{
-		double ph;
-		const double PI = 4.0*atan(1.0);
-		for (int n=0; n<NSTEPS; ++n)
-		{
-			ph = 2.0*PI*n / (double) NSTEPS;
-			m_cth[n] = cos(ph);
-			m_sth[n] = sin(ph);
-		}
-		bfirst = false;
+		ph = 2.0*PI*n / (double) NSTEPS;
+		m_cth[n] = cos(ph);
+		m_sth[n] = sin(ph);
 	}
 
 	m_c1 = 0;
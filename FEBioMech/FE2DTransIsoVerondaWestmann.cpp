@@ -39,28 +39,19 @@ BEGIN_PARAMETER_LIST(FE2DTransIsoVerondaWestmann, FEUncoupledMaterial)
 	ADD_PARAMETER(m_lam1, FE_PARAM_DOUBLE, "lam_max");
 END_PARAMETER_LIST();
 
-double FE2DTransIsoVerondaWestmann::m_cth[FE2DTransIsoVerondaWestmann::NSTEPS];
-double FE2DTransIsoVerondaWestmann::m_sth[FE2DTransIsoVerondaWestmann::NSTEPS];
-
 //////////////////////////////////////////////////////////////////////
 // FE2DTransIsoVerondaWestmann
 //////////////////////////////////////////////////////////////////////
 
 FE2DTransIsoVerondaWestmann::FE2DTransIsoVerondaWestmann(FEModel* pfem) : FEUncoupledMaterial(pfem)
 {
-	static bool bfirst = true;
-
-	if (bfirst)
+	double ph;
+	const double PI = 4.0*atan(1.0);
+	for (int n=0; n<NSTEPS; ++n)
 	{
-		double ph;
-		const double PI = 4.0*atan(1.0);
-		for (int n=0; n<NSTEPS; ++n)
-		{
-			ph = 2.0*PI*n / (double) NSTEPS;
-			m_cth[n] = cos(ph);
-			m_sth[n] = sin(ph);
-		}
-		bfirst = false;
+		ph = 2.0*PI*n / (double) NSTEPS;
+		m_cth[n] = cos(ph);
+		m_sth[n] = sin(ph);
 	}
 
 	m_w[0] = m_w[1] = 1;
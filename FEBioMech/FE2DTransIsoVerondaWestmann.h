@@ -65,8 +65,8 @@ public:
 	DECLARE_PARAMETER_LIST();
 
 protected:
-	static double	m_cth[NSTEPS];
-	static double	m_sth[NSTEPS];
+	double	m_cth[NSTEPS];
+	double	m_sth[NSTEPS];
 
 	double	m_w[2];
 };
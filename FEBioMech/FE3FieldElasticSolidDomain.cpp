@@ -407,6 +407,8 @@ void FE3FieldElasticSolidDomain::Update(const FETimeInfo& tp)
 {
 	bool berr = false;
 	int NE = (int) m_Elem.size();
+	// the worker threads use the model (and log file) of this thread
+	FEModel* pfem = FECoreKernel::GetThreadModel();
 	#pragma omp parallel for shared(NE, berr)
 	for (int i=0; i<NE; ++i)
 	{
@@ -418,6 +420,7 @@ void FE3FieldElasticSolidDomain::Update(const FETimeInfo& tp)
 		{
 			#pragma omp critical
 			{
+				FEModelScope scope(pfem);
 				berr = true;
 				if (NegativeJacobian::m_boutput) e.print();
 			}
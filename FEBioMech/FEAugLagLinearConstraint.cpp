@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "FEAugLagLinearConstraint.h"
 #include "FECore/FEModel.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 void FEAugLagLinearConstraint::Serialize(DumpStream& ar)
@@ -70,7 +71,7 @@ END_PARAMETER_LIST();
 //-----------------------------------------------------------------------------
 FELinearConstraintSet::FELinearConstraintSet(FEModel* pfem) : FESurfaceConstraint(pfem)
 {
-	static int nc = 1;
+	static std::atomic<int> nc(1);
 	m_nID = nc++;
 
 	m_laugon = true;
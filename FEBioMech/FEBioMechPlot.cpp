@@ -2919,39 +2919,33 @@ bool FEPlotSPRStresses::Save(FEDomain& dom, FEDataStream& a)
 	int NE = sd.Elements();
 
 	// build the element data array
+	const int NC = 6;
 	vector< vector<double> > ED;
 	ED.resize(NE);
 	for (int i=0; i<NE; ++i)
 	{
-		FESolidElement& e = sd.Element(i);
-		int nint = e.GaussPoints();
-		ED[i].assign(nint, 0.0);
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		ED[i].assign(nint*NC, 0.0);
 	}
 
-	// this array will store the results
-	FESPRProjection map;
-	vector<double> val[6];
-
-	// loop over stress components
-	for (int n=0; n<6; ++n)
+	// fill the ED array
+	for (int i=0; i<NE; ++i)
 	{
-		// fill the ED array
-		for (int i=0; i<NE; ++i)
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		for (int j=0; j<nint; ++j)
 		{
-			FESolidElement& el = sd.Element(i);
-			int nint = el.GaussPoints();
-			for (int j=0; j<nint; ++j)
-			{
-				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
-				mat3ds& s = ep.m_s;
-				ED[i][j] = s(LUT[n][0], LUT[n][1]);
-			}
+			FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
+			mat3ds& s = ep.m_s;
+			for (int n=0; n<NC; ++n) ED[i][j*NC + n] = s(LUT[n][0], LUT[n][1]);
 		}
-
-		// project to nodes
-		map.Project(sd, ED, val[n]);
 	}
 
+	// project all stress components to the nodes
+	vector< vector<double> > val;
+	m_map.Project(sd, ED, NC, val);
+
 	// copy results to archive
 	for (int i=0; i<NN; ++i)
 	{
@@ -2980,40 +2974,34 @@ bool FEPlotSPRLinearStresses::Save(FEDomain& dom, FEDataStream& a)
 	int NE = sd.Elements();
 
 	// build the element data array
+	const int NC = 6;
 	vector< vector<double> > ED;
 	ED.resize(NE);
 	for (int i=0; i<NE; ++i)
 	{
-		FESolidElement& e = sd.Element(i);
-		int nint = e.GaussPoints();
-		ED[i].assign(nint, 0.0);
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		ED[i].assign(nint*NC, 0.0);
 	}
 
-	// this array will store the results
-	FESPRProjection map;
-	map.SetInterpolationOrder(1);
-	vector<double> val[6];
-
-	// loop over stress components
-	for (int n=0; n<6; ++n)
+	// fill the ED array
+	for (int i=0; i<NE; ++i)
 	{
-		// fill the ED array
-		for (int i=0; i<NE; ++i)
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		for (int j=0; j<nint; ++j)
 		{
-			FESolidElement& el = sd.Element(i);
-			int nint = el.GaussPoints();
-			for (int j=0; j<nint; ++j)
-			{
-				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
-				mat3ds& s = ep.m_s;
-				ED[i][j] = s(LUT[n][0], LUT[n][1]);
-			}
+			FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
+			mat3ds& s = ep.m_s;
+			for (int n=0; n<NC; ++n) ED[i][j*NC + n] = s(LUT[n][0], LUT[n][1]);
 		}
-
-		// project to nodes
-		map.Project(sd, ED, val[n]);
 	}
 
+	// project all stress components to the nodes
+	m_map.SetInterpolationOrder(1);
+	vector< vector<double> > val;
+	m_map.Project(sd, ED, NC, val);
+
 	// copy results to archive
 	for (int i=0; i<NN; ++i)
 	{
@@ -3040,41 +3028,35 @@ bool FEPlotSPRPrincStresses::Save(FEDomain& dom, FEDataStream& a)
 	int NE = sd.Elements();
 
 	// build the element data array
+	const int NC = 3;
 	vector< vector<double> > ED;
 	ED.resize(NE);
 	for (int i=0; i<NE; ++i)
 	{
-		FESolidElement& e = sd.Element(i);
-		int nint = e.GaussPoints();
-		ED[i].assign(nint, 0.0);
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		ED[i].assign(nint*NC, 0.0);
 	}
 
-	// this array will store the results
-	FESPRProjection map;
-	vector<double> val[3];
-
-	// loop over stress components
-	for (int n=0; n<3; ++n)
+	// fill the ED array
+	for (int i=0; i<NE; ++i)
 	{
-		// fill the ED array
-		for (int i=0; i<NE; ++i)
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		for (int j=0; j<nint; ++j)
 		{
-			FESolidElement& el = sd.Element(i);
-			int nint = el.GaussPoints();
-			for (int j=0; j<nint; ++j)
-			{
-				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
-				mat3ds& s = ep.m_s;
-				double l[3];
-				s.exact_eigen(l);
-				ED[i][j] = l[n];
-			}
+			FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
+			mat3ds& s = ep.m_s;
+			double l[3];
+			s.exact_eigen(l);
+			for (int n=0; n<NC; ++n) ED[i][j*NC + n] = l[n];
 		}
-
-		// project to nodes
-		map.Project(sd, ED, val[n]);
 	}
 
+	// project all stress components to the nodes
+	vector< vector<double> > val;
+	m_map.Project(sd, ED, NC, val);
+
 	// copy results to archive
 	for (int i=0; i<NN; ++i)
 	{
@@ -3098,40 +3080,34 @@ bool FEPlotSPRTestLinear::Save(FEDomain& dom, FEDataStream& a)
 	int NE = sd.Elements();
 
 	// build the element data array
+	const int NC = 3;
 	vector< vector<double> > ED;
 	ED.resize(NE);
 	for (int i=0; i<NE; ++i)
 	{
-		FESolidElement& e = sd.Element(i);
-		int nint = e.GaussPoints();
-		ED[i].assign(nint, 0.0);
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		ED[i].assign(nint*NC, 0.0);
 	}
 
-	// this array will store the results
-	FESPRProjection map;
-	vector<double> val[3];
-
-	// loop over stress components
-	for (int n=0; n<3; ++n)
+	// fill the ED array
+	for (int i=0; i<NE; ++i)
 	{
-		// fill the ED array
-		for (int i=0; i<NE; ++i)
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		for (int j=0; j<nint; ++j)
 		{
-			FESolidElement& el = sd.Element(i);
-			int nint = el.GaussPoints();
-			for (int j=0; j<nint; ++j)
-			{
-				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
-				vec3d r = ep.m_rt;
-				double l[3] = {r.x, r.y, r.z};
-				ED[i][j] = l[n];
-			}
+			FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
+			vec3d r = ep.m_rt;
+			double l[3] = {r.x, r.y, r.z};
+			for (int n=0; n<NC; ++n) ED[i][j*NC + n] = l[n];
 		}
-
-		// project to nodes
-		map.Project(sd, ED, val[n]);
 	}
 
+	// project all stress components to the nodes
+	vector< vector<double> > val;
+	m_map.Project(sd, ED, NC, val);
+
 	// copy results to archive
 	for (int i=0; i<NN; ++i)
 	{
@@ -3155,40 +3131,34 @@ bool FEPlotSPRTestQuadratic::Save(FEDomain& dom, FEDataStream& a)
 	int NE = sd.Elements();
 
 	// build the element data array
+	const int NC = 6;
 	vector< vector<double> > ED;
 	ED.resize(NE);
 	for (int i=0; i<NE; ++i)
 	{
-		FESolidElement& e = sd.Element(i);
-		int nint = e.GaussPoints();
-		ED[i].assign(nint, 0.0);
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		ED[i].assign(nint*NC, 0.0);
 	}
 
-	// this array will store the results
-	FESPRProjection map;
-	vector<double> val[6];
-
-	// loop over stress components
-	for (int n=0; n<6; ++n)
+	// fill the ED array
+	for (int i=0; i<NE; ++i)
 	{
-		// fill the ED array
-		for (int i=0; i<NE; ++i)
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		for (int j=0; j<nint; ++j)
 		{
-			FESolidElement& el = sd.Element(i);
-			int nint = el.GaussPoints();
-			for (int j=0; j<nint; ++j)
-			{
-				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
-				vec3d r = ep.m_rt;
-				double l[6] = {r.x*r.x, r.y*r.y, r.z*r.z, r.x*r.y, r.y*r.z, r.x*r.z};
-				ED[i][j] = l[n];
-			}
+			FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
+			vec3d r = ep.m_rt;
+			double l[6] = {r.x*r.x, r.y*r.y, r.z*r.z, r.x*r.y, r.y*r.z, r.x*r.z};
+			for (int n=0; n<NC; ++n) ED[i][j*NC + n] = l[n];
 		}
-
-		// project to nodes
-		map.Project(sd, ED, val[n]);
 	}
 
+	// project all stress components to the nodes
+	vector< vector<double> > val;
+	m_map.Project(sd, ED, NC, val);
+
 	// copy results to archive
 	for (int i=0; i<NN; ++i)
 	{
@@ -3559,44 +3529,38 @@ bool FEPlotSPRLagrangeStrain::Save(FEDomain& dom, FEDataStream& a)
 	int NE = sd.Elements();
 
 	// build the element data array
+	const int NC = 6;
 	vector< vector<double> > ED;
 	ED.resize(NE);
 	for (int i=0; i<NE; ++i)
 	{
-		FESolidElement& e = sd.Element(i);
-		int nint = e.GaussPoints();
-		ED[i].assign(nint, 0.0);
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		ED[i].assign(nint*NC, 0.0);
 	}
 
-	// this array will store the results
-	FESPRProjection map;
-	vector<double> val[6];
-
 	mat3dd I(1.0);
 
-	// loop over strain components
-	for (int n=0; n<6; ++n)
+	// fill the ED array
+	for (int i=0; i<NE; ++i)
 	{
-		// fill the ED array
-		for (int i=0; i<NE; ++i)
+		FESolidElement& el = sd.Element(i);
+		int nint = el.GaussPoints();
+		for (int j=0; j<nint; ++j)
 		{
-			FESolidElement& el = sd.Element(i);
-			int nint = el.GaussPoints();
-			for (int j=0; j<nint; ++j)
-			{
-				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
+			FEElasticMaterialPoint& ep = *el.GetMaterialPoint(j)->ExtractData<FEElasticMaterialPoint>();
 
-				mat3d C = ep.RightCauchyGreen();
-				mat3ds E = ((C - I)*0.5).sym();
+			mat3d C = ep.RightCauchyGreen();
+			mat3ds E = ((C - I)*0.5).sym();
 
-				ED[i][j] = E(LUT[n][0], LUT[n][1]);
-			}
+			for (int n=0; n<NC; ++n) ED[i][j*NC + n] = E(LUT[n][0], LUT[n][1]);
 		}
-
-		// project to nodes
-		map.Project(sd, ED, val[n]);
 	}
 
+	// project all strain components to the nodes
+	vector< vector<double> > val;
+	m_map.Project(sd, ED, NC, val);
+
 	// copy results to archive
 	for (int i=0; i<NN; ++i)
 	{
@@ -27,6 +27,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <FECore/FEPlotData.h>
+#include "FESPRProjection.h"
 
 //=============================================================================
 //                            N O D E   D A T A
@@ -695,6 +696,9 @@ class FEPlotSPRStresses : public FEDomainData
 public:
 	FEPlotSPRStresses(FEModel* pfem) : FEDomainData(PLT_MAT3FS, FMT_NODE){}
 	bool Save(FEDomain& dom, FEDataStream& a);
+
+private:
+	FESPRProjection	m_map;
 };
 
 //-----------------------------------------------------------------------------
@@ -705,6 +709,9 @@ class FEPlotSPRLinearStresses : public FEDomainData
 public:
 	FEPlotSPRLinearStresses(FEModel* pfem) : FEDomainData(PLT_MAT3FS, FMT_NODE){}
 	bool Save(FEDomain& dom, FEDataStream& a);
+
+private:
+	FESPRProjection	m_map;
 };
 
 //-----------------------------------------------------------------------------
@@ -715,6 +722,9 @@ class FEPlotSPRPrincStresses : public FEDomainData
 public:
 	FEPlotSPRPrincStresses(FEModel* pfem) : FEDomainData(PLT_MAT3FD, FMT_NODE){}
 	bool Save(FEDomain& dom, FEDataStream& a);
+
+private:
+	FESPRProjection	m_map;
 };
 
 //-----------------------------------------------------------------------------
@@ -725,6 +735,9 @@ class FEPlotSPRTestLinear: public FEDomainData
 public:
 	FEPlotSPRTestLinear(FEModel* pfem) : FEDomainData(PLT_MAT3FD, FMT_NODE){}
 	bool Save(FEDomain& dom, FEDataStream& a);
+
+private:
+	FESPRProjection	m_map;
 };
 
 //-----------------------------------------------------------------------------
@@ -735,6 +748,9 @@ class FEPlotSPRTestQuadratic: public FEDomainData
 public:
 	FEPlotSPRTestQuadratic(FEModel* pfem) : FEDomainData(PLT_MAT3FS, FMT_NODE){}
 	bool Save(FEDomain& dom, FEDataStream& a);
+
+private:
+	FESPRProjection	m_map;
 };
 
 //-----------------------------------------------------------------------------
@@ -884,6 +900,9 @@ class FEPlotSPRLagrangeStrain : public FEDomainData
 public:
 	FEPlotSPRLagrangeStrain(FEModel* pfem) : FEDomainData(PLT_MAT3FS, FMT_NODE){}
 	bool Save(FEDomain& dom, FEDataStream& a);
+
+private:
+	FESPRProjection	m_map;
 };
 
 
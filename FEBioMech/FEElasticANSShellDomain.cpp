@@ -108,7 +108,6 @@ void FEElasticANSShellDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
     for (size_t i=0; i<m_Elem.size(); ++i)
     {
         FEShellElementNew& el = m_Elem[i];
-        el.m_alphai.zero();
         
         int n = el.GaussPoints();
         for (int j=0; j<n; ++j)
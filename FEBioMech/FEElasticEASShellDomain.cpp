@@ -35,10 +35,162 @@ SOFTWARE.*/
 #include <math.h>
 #include <FECore/FESolidDomain.h>
 
+//-----------------------------------------------------------------------------
+// Kernels for the EAS condensation. These are templated on the number of element
+// nodes, so that the loops have fixed sizes for the common shell elements. The
+// value 0 is used when the number of nodes is only known at run time.
+namespace EASKernel {
+
+const int NEAS = FEElasticEASShellDomain::NEAS;
+
+// fe += Kua*Kaai*fa (and Kwa for the shell dofs)
+template <int NELN> void Force(int neln, const double* Kaai, const double* fa, const double* Kua, const double* Kwa, vector<double>& fe)
+{
+    const int N = (NELN > 0 ? NELN : neln);
+    
+    double Kif[NEAS];
+    for (int a=0; a<NEAS; ++a)
+    {
+        double s = 0.0;
+        for (int b=0; b<NEAS; ++b) s += Kaai[a*NEAS + b]*fa[b];
+        Kif[a] = s;
+    }
+    
+    for (int i=0; i<N; ++i)
+    {
+        const double* Ku = Kua + 3*NEAS*i;
+        const double* Kw = Kwa + 3*NEAS*i;
+        for (int k=0; k<3; ++k)
+        {
+            double fu = 0.0, fw = 0.0;
+            for (int a=0; a<NEAS; ++a)
+            {
+                fu += Ku[k*NEAS + a]*Kif[a];
+                fw += Kw[k*NEAS + a]*Kif[a];
+            }
+            fe[6*i + k    ] += fu;
+            fe[6*i + k + 3] += fw;
+        }
+    }
+}
+
+// ke -= B*Kaai*B^T, where B stacks the Kua and Kwa of all nodes (6 rows per node)
+template <int NELN> void Stiffness(int neln, const double* Kaai, const double* Kua, const double* Kwa, matrix& ke)
+{
+    const int N = (NELN > 0 ? NELN : neln);
+    
+    // row r of B
+    const double* B[6*FEElement::MAX_NODES];
+    for (int i=0; i<N; ++i)
+        for (int k=0; k<3; ++k)
+        {
+            B[6*i + k    ] = Kua + (3*i + k)*NEAS;
+            B[6*i + k + 3] = Kwa + (3*i + k)*NEAS;
+        }
+    
+    // BK = B*Kaai
+    double BK[6*FEElement::MAX_NODES][NEAS];
+    for (int r=0; r<6*N; ++r)
+        for (int a=0; a<NEAS; ++a)
+        {
+            double s = 0.0;
+            for (int b=0; b<NEAS; ++b) s += B[r][b]*Kaai[b*NEAS + a];
+            BK[r][a] = s;
+        }
+    
+    for (int r=0; r<6*N; ++r)
+    {
+        double* ker = ke[r];
+        for (int c=0; c<6*N; ++c)
+        {
+            const double* Bc = B[c];
+            double s = 0.0;
+            for (int a=0; a<NEAS; ++a) s += BK[r][a]*Bc[a];
+            ker[c] -= s;
+        }
+    }
+}
+
+// da = Kaai*(fa + sum(Kua^T*Du + Kwa^T*Dw)), where D stores the 6 dof increments of each node
+template <int NELN> void Alpha(int neln, const double* Kaai, const double* fa, const double* Kua, const double* Kwa, const double* D, double* da)
+{
+    const int N = (NELN > 0 ? NELN : neln);
+    
+    double v[NEAS];
+    for (int a=0; a<NEAS; ++a) v[a] = fa[a];
+    for (int j=0; j<N; ++j)
+    {
+        const double* Du = D + 6*j;
+        const double* Dw = Du + 3;
+        const double* Ku = Kua + 3*NEAS*j;
+        const double* Kw = Kwa + 3*NEAS*j;
+        for (int a=0; a<NEAS; ++a)
+            v[a] += Ku[a]*Du[0] + Ku[NEAS + a]*Du[1] + Ku[2*NEAS + a]*Du[2]
+                  + Kw[a]*Dw[0] + Kw[NEAS + a]*Dw[1] + Kw[2*NEAS + a]*Dw[2];
+    }
+    
+    for (int a=0; a<NEAS; ++a)
+    {
+        double s = 0.0;
+        for (int b=0; b<NEAS; ++b) s += Kaai[a*NEAS + b]*v[b];
+        da[a] = s;
+    }
+}
+
+// invert the NEAS x NEAS matrix A in place (Gauss-Jordan with partial pivoting)
+bool Invert(double* A)
+{
+    int ipiv[NEAS];
+    for (int k=0; k<NEAS; ++k)
+    {
+        // find the pivot
+        int p = k;
+        for (int i=k+1; i<NEAS; ++i) if (fabs(A[i*NEAS + k]) > fabs(A[p*NEAS + k])) p = i;
+        ipiv[k] = p;
+        if (A[p*NEAS + k] == 0.0) return false;
+        if (p != k) for (int j=0; j<NEAS; ++j) { double t = A[k*NEAS + j]; A[k*NEAS + j] = A[p*NEAS + j]; A[p*NEAS + j] = t; }
+        
+        double d = 1.0 / A[k*NEAS + k];
+        A[k*NEAS + k] = 1.0;
+        for (int j=0; j<NEAS; ++j) A[k*NEAS + j] *= d;
+        
+        for (int i=0; i<NEAS; ++i)
+        {
+            if (i == k) continue;
+            double f = A[i*NEAS + k];
+            A[i*NEAS + k] = 0.0;
+            for (int j=0; j<NEAS; ++j) A[i*NEAS + j] -= f*A[k*NEAS + j];
+        }
+    }
+    
+    // undo the row swaps by swapping columns in reverse order
+    for (int k=NEAS-1; k>=0; --k)
+    {
+        int p = ipiv[k];
+        if (p != k) for (int i=0; i<NEAS; ++i) { double t = A[i*NEAS + k]; A[i*NEAS + k] = A[i*NEAS + p]; A[i*NEAS + p] = t; }
+    }
+    return true;
+}
+
+} // namespace EASKernel
+
+// call an EAS kernel with the number of nodes as a template argument for the common shell elements
+#define EAS_KERNEL(f, neln, ...) \
+    switch (neln) { \
+    case 3: EASKernel::f<3>(3, __VA_ARGS__); break; \
+    case 4: EASKernel::f<4>(4, __VA_ARGS__); break; \
+    case 6: EASKernel::f<6>(6, __VA_ARGS__); break; \
+    case 8: EASKernel::f<8>(8, __VA_ARGS__); break; \
+    default: EASKernel::f<0>(neln, __VA_ARGS__); \
+    }
+
 //-----------------------------------------------------------------------------
 FEElasticEASShellDomain::FEElasticEASShellDomain(FEModel* pfem) : FESSIShellDomain(pfem), FEElasticDomain(pfem)
 {
     m_pMat = 0;
+    m_nEAS = NEAS;
+    m_neln = 0;
+    m_nstride = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -62,25 +214,77 @@ bool FEElasticEASShellDomain::Init()
 	if (FESSIShellDomain::Init() == false) return false;
     
     // set up EAS arrays
-    m_nEAS = 7;
+    // The EAS data of all elements is stored in one array, using the same
+    // amount of storage for each element.
+    m_nEAS = NEAS;
+    m_neln = 0;
     for (int i=0; i<Elements(); ++i)
     {
         FEShellElementNew& el = ShellElement(i);
         int neln = el.Nodes();
         int nint = el.GaussPoints();
-        el.m_Kaai.resize(m_nEAS, m_nEAS);
-        el.m_fa.resize(m_nEAS, 1);
-        el.m_alpha.resize(m_nEAS, 1); el.m_alpha.zero();
-        el.m_alphat.resize(m_nEAS, 1); el.m_alphat.zero();
-        el.m_alphai.resize(m_nEAS, 1); el.m_alphai.zero();
-        el.m_Kua.resize(neln,matrix(3, m_nEAS));
-        el.m_Kwa.resize(neln,matrix(3, m_nEAS));
+        if (neln > m_neln) m_neln = neln;
         el.m_E.resize(nint, mat3ds(0, 0, 0, 0, 0, 0));
     }
+    m_nstride = NEAS*NEAS + 4*NEAS + 2*3*NEAS*m_neln;
+    m_EAS.assign(Elements()*m_nstride, 0.0);
     
     return true;
 }
 
+//-----------------------------------------------------------------------------
+FEElasticEASShellDomain::EAS_DATA FEElasticEASShellDomain::EASData(int iel)
+{
+    assert((iel >= 0) && (iel < Elements()));
+    double* p = &m_EAS[0] + iel*m_nstride;
+    EAS_DATA d;
+    d.Kaai   = p; p += NEAS*NEAS;
+    d.fa     = p; p += NEAS;
+    d.alpha  = p; p += NEAS;
+    d.alphat = p; p += NEAS;
+    d.alphai = p; p += NEAS;
+    d.Kua    = p; p += 3*NEAS*m_neln;
+    d.Kwa    = p;
+    return d;
+}
+
+//-----------------------------------------------------------------------------
+FEElasticEASShellDomain::EAS_DATA FEElasticEASShellDomain::EASData(FEShellElementNew& el)
+{
+    return EASData((int)(&el - &m_Elem[0]));
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticEASShellDomain::Serialize(DumpStream& ar)
+{
+    FESSIShellDomain::Serialize(ar);
+    
+    if (ar.IsShallow())
+    {
+        if (ar.IsSaving())
+        {
+            for (size_t i=0; i<m_EAS.size(); ++i) ar << m_EAS[i];
+        }
+        else
+        {
+            for (size_t i=0; i<m_EAS.size(); ++i) ar >> m_EAS[i];
+        }
+    }
+    else
+    {
+        if (ar.IsSaving())
+        {
+            ar << m_neln << m_nstride;
+            ar << m_EAS;
+        }
+        else
+        {
+            ar >> m_neln >> m_nstride;
+            ar >> m_EAS;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void FEElasticEASShellDomain::Activate()
 {
@@ -116,7 +320,8 @@ void FEElasticEASShellDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
     for (size_t i=0; i<m_Elem.size(); ++i)
     {
         FEShellElementNew& el = m_Elem[i];
-        el.m_alphai.zero();
+        EAS_DATA ed = EASData((int)i);
+        for (int k=0; k<NEAS; ++k) ed.alphai[k] = 0.0;
         
         int n = el.GaussPoints();
         for (int j=0; j<n; ++j)
@@ -132,7 +337,8 @@ void FEElasticEASShellDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 void FEElasticEASShellDomain::InternalForces(FEGlobalVector& R)
 {
     int NS = (int)m_Elem.size();
-#pragma omp parallel for shared (NS)
+    int nerr = -1;
+#pragma omp parallel for shared (NS, nerr)
     for (int i=0; i<NS; ++i)
     {
         // element force vector
@@ -147,7 +353,14 @@ void FEElasticEASShellDomain::InternalForces(FEGlobalVector& R)
         fe.assign(ndof, 0);
         
         // calculate element's internal force
-        ElementInternalForce(el, fe);
+        // (exceptions cannot leave the parallel loop, so they are thrown again below)
+        try { ElementInternalForce(el, fe); }
+        catch (SingularMatrix e)
+        {
+#pragma omp critical
+            if ((nerr < 0) || (e.m_iel < nerr)) nerr = e.m_iel;
+            continue;
+        }
         
         // get the element's LM vector
         UnpackLM(el, lm);
@@ -155,6 +368,7 @@ void FEElasticEASShellDomain::InternalForces(FEGlobalVector& R)
         // assemble the residual
         R.Assemble(el.m_node, lm, fe, true);
     }
+    if (nerr >= 0) throw SingularMatrix(nerr);
 }
 
 //-----------------------------------------------------------------------------
@@ -191,8 +405,6 @@ void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, vector
     // EAS method: Evaluate Kua, Kwa, and Kaa
     // Also evaluate PK2 stress and material tangent using enhanced strain
     EvaluateEAS(el, EE, HU, HW, S, C);
-    matrix Kif(7,1);
-    Kif = el.m_Kaai*el.m_fa;
     
     vector<matrix> hu(neln, matrix(3,6));
     vector<matrix> hw(neln, matrix(3,6));
@@ -200,23 +412,8 @@ void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, vector
     vector<vec3d> Nw(neln);
     
     // EAS contribution
-    matrix Fu(3,1), Fw(3,1);
-    for (i=0; i<neln; ++i)
-    {
-        Fu = el.m_Kua[i]*Kif;
-        Fw = el.m_Kwa[i]*Kif;
-        
-        // calculate internal force
-        // the '-' sign is so that the internal forces get subtracted
-        // from the global residual vector
-        fe[6*i  ] += Fu(0,0);
-        fe[6*i+1] += Fu(1,0);
-        fe[6*i+2] += Fu(2,0);
-        
-        fe[6*i+3] += Fw(0,0);
-        fe[6*i+4] += Fw(1,0);
-        fe[6*i+5] += Fw(2,0);
-    }
+    EAS_DATA ed = EASData(el);
+    EAS_KERNEL(Force, neln, ed.Kaai, ed.fa, ed.Kua, ed.Kwa, fe);
     
     // repeat for all integration points
     for (n=0; n<nint; ++n)
@@ -238,19 +435,24 @@ void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, vector
         
         for (i=0; i<neln; ++i)
         {
-            Fu = hu[i]*SC;
-            Fw = hw[i]*SC;
-            
-            // calculate internal force
-            // the '-' sign is so that the internal forces get subtracted
-            // from the global residual vector
-            fe[6*i  ] -= Fu(0,0)*detJt;
-            fe[6*i+1] -= Fu(1,0)*detJt;
-            fe[6*i+2] -= Fu(2,0)*detJt;
-            
-            fe[6*i+3] -= Fw(0,0)*detJt;
-            fe[6*i+4] -= Fw(1,0)*detJt;
-            fe[6*i+5] -= Fw(2,0)*detJt;
+            matrix& hui = hu[i];
+            matrix& hwi = hw[i];
+            for (int k=0; k<3; ++k)
+            {
+                // Fu = hu*SC, Fw = hw*SC
+                double Fu = 0.0, Fw = 0.0;
+                for (int l=0; l<6; ++l)
+                {
+                    Fu += hui(k,l)*SC(l,0);
+                    Fw += hwi(k,l)*SC(l,0);
+                }
+                
+                // calculate internal force
+                // the '-' sign is so that the internal forces get subtracted
+                // from the global residual vector
+                fe[6*i+k  ] -= Fu*detJt;
+                fe[6*i+k+3] -= Fw*detJt;
+            }
         }
     }
 }
@@ -471,7 +673,8 @@ void FEElasticEASShellDomain::StiffnessMatrix(FESolver* psolver)
 {
     // repeat over all shell elements
     int NS = (int)m_Elem.size();
-#pragma omp parallel for shared (NS)
+    int nerr = -1;
+#pragma omp parallel for shared (NS, nerr)
     for (int iel=0; iel<NS; ++iel)
     {
         matrix ke;
@@ -484,7 +687,13 @@ void FEElasticEASShellDomain::StiffnessMatrix(FESolver* psolver)
         ke.resize(ndof, ndof);
         
         // calculate the element stiffness matrix
-        ElementStiffness(iel, ke);
+        try { ElementStiffness(iel, ke); }
+        catch (SingularMatrix e)
+        {
+#pragma omp critical
+            if ((nerr < 0) || (e.m_iel < nerr)) nerr = e.m_iel;
+            continue;
+        }
         
         // get the element's LM vector
         UnpackLM(el, lm);
@@ -494,6 +703,7 @@ void FEElasticEASShellDomain::StiffnessMatrix(FESolver* psolver)
         psolver->AssembleStiffness(el.m_node, lm, ke);
         
     }
+    if (nerr >= 0) throw SingularMatrix(nerr);
 }
 
 //-----------------------------------------------------------------------------
@@ -605,33 +815,9 @@ void FEElasticEASShellDomain::ElementStiffness(int iel, matrix& ke)
     
     ke.zero();
     
-    matrix KUU(3,3), KUW(3,3), KWU(3,3), KWW(3,3);
-    for (i=0, i6=0; i<neln; ++i, i6 += 6)
-    {
-        for (j=0, j6 = 0; j<neln; ++j, j6 += 6)
-        {
-            KUU = (el.m_Kua[i]*el.m_Kaai*el.m_Kua[j].transpose());
-            KUW = (el.m_Kua[i]*el.m_Kaai*el.m_Kwa[j].transpose());
-            KWU = (el.m_Kwa[i]*el.m_Kaai*el.m_Kua[j].transpose());
-            KWW = (el.m_Kwa[i]*el.m_Kaai*el.m_Kwa[j].transpose());
-            
-            ke[i6  ][j6  ] -= KUU(0,0); ke[i6  ][j6+1] -= KUU(0,1); ke[i6  ][j6+2] -= KUU(0,2);
-            ke[i6+1][j6  ] -= KUU(1,0); ke[i6+1][j6+1] -= KUU(1,1); ke[i6+1][j6+2] -= KUU(1,2);
-            ke[i6+2][j6  ] -= KUU(2,0); ke[i6+2][j6+1] -= KUU(2,1); ke[i6+2][j6+2] -= KUU(2,2);
-            
-            ke[i6  ][j6+3] -= KUW(0,0); ke[i6  ][j6+4] -= KUW(0,1); ke[i6  ][j6+5] -= KUW(0,2);
-            ke[i6+1][j6+3] -= KUW(1,0); ke[i6+1][j6+4] -= KUW(1,1); ke[i6+1][j6+5] -= KUW(1,2);
-            ke[i6+2][j6+3] -= KUW(2,0); ke[i6+2][j6+4] -= KUW(2,1); ke[i6+2][j6+5] -= KUW(2,2);
-            
-            ke[i6+3][j6  ] -= KWU(0,0); ke[i6+3][j6+1] -= KWU(0,1); ke[i6+3][j6+2] -= KWU(0,2);
-            ke[i6+4][j6  ] -= KWU(1,0); ke[i6+4][j6+1] -= KWU(1,1); ke[i6+4][j6+2] -= KWU(1,2);
-            ke[i6+5][j6  ] -= KWU(2,0); ke[i6+5][j6+1] -= KWU(2,1); ke[i6+5][j6+2] -= KWU(2,2);
-            
-            ke[i6+3][j6+3] -= KWW(0,0); ke[i6+3][j6+4] -= KWW(0,1); ke[i6+3][j6+5] -= KWW(0,2);
-            ke[i6+4][j6+3] -= KWW(1,0); ke[i6+4][j6+4] -= KWW(1,1); ke[i6+4][j6+5] -= KWW(1,2);
-            ke[i6+5][j6+3] -= KWW(2,0); ke[i6+5][j6+4] -= KWW(2,1); ke[i6+5][j6+5] -= KWW(2,2);
-        }
-    }
+    // EAS contribution
+    EAS_DATA ed = EASData(iel);
+    EAS_KERNEL(Stiffness, neln, ed.Kaai, ed.Kua, ed.Kwa, ke);
     
     for (n=0; n<nint; ++n)
     {
@@ -935,25 +1121,24 @@ void FEElasticEASShellDomain::UpdateEAS(vector<double>& ui)
         // number of nodes
         int neln = el.Nodes();
         
-        // allocate arrays
-        matrix dalpha(m_nEAS,1);
-        matrix Du(3,1), Dw(3,1);
-        
-        // nodal coordinates and EAS vector alpha update
-        dalpha = el.m_fa;
+        // nodal displacement increments
+        double D[6*FEElement::MAX_NODES];
         for (int j=0; j<neln; ++j)
         {
             FENode& nj = mesh.Node(el.m_node[j]);
-            Du(0,0) = (nj.m_ID[m_dofX] >=0) ? ui[nj.m_ID[m_dofX]] : 0;
-            Du(1,0) = (nj.m_ID[m_dofY] >=0) ? ui[nj.m_ID[m_dofY]] : 0;
-            Du(2,0) = (nj.m_ID[m_dofZ] >=0) ? ui[nj.m_ID[m_dofZ]] : 0;
-            Dw(0,0) = (nj.m_ID[m_dofSX] >=0) ? ui[nj.m_ID[m_dofSX]] : 0;
-            Dw(1,0) = (nj.m_ID[m_dofSY] >=0) ? ui[nj.m_ID[m_dofSY]] : 0;
-            Dw(2,0) = (nj.m_ID[m_dofSZ] >=0) ? ui[nj.m_ID[m_dofSZ]] : 0;
-            dalpha += el.m_Kua[j].transpose()*Du + el.m_Kwa[j].transpose()*Dw;
+            D[6*j  ] = (nj.m_ID[m_dofX] >=0) ? ui[nj.m_ID[m_dofX]] : 0;
+            D[6*j+1] = (nj.m_ID[m_dofY] >=0) ? ui[nj.m_ID[m_dofY]] : 0;
+            D[6*j+2] = (nj.m_ID[m_dofZ] >=0) ? ui[nj.m_ID[m_dofZ]] : 0;
+            D[6*j+3] = (nj.m_ID[m_dofSX] >=0) ? ui[nj.m_ID[m_dofSX]] : 0;
+            D[6*j+4] = (nj.m_ID[m_dofSY] >=0) ? ui[nj.m_ID[m_dofSY]] : 0;
+            D[6*j+5] = (nj.m_ID[m_dofSZ] >=0) ? ui[nj.m_ID[m_dofSZ]] : 0;
         }
-        dalpha = el.m_Kaai*dalpha;
-        el.m_alpha = el.m_alphat + el.m_alphai - dalpha;
+        
+        // EAS vector alpha update
+        EAS_DATA ed = EASData(i);
+        double dalpha[NEAS];
+        EAS_KERNEL(Alpha, neln, ed.Kaai, ed.fa, ed.Kua, ed.Kwa, D, dalpha);
+        for (int k=0; k<NEAS; ++k) ed.alpha[k] = ed.alphat[k] + ed.alphai[k] - dalpha[k];
     }
 }
 
@@ -967,32 +1152,31 @@ void FEElasticEASShellDomain::UpdateIncrementsEAS(vector<double>& ui, const bool
     {
         // get the solid element
 		FEShellElementNew& el = m_Elem[i];
+        EAS_DATA ed = EASData(i);
         
         if (binc) {
             // number of nodes
             int neln = el.Nodes();
             
-            // allocate arrays
-            matrix dalpha(m_nEAS,1);
-            matrix Du(3,1), Dw(3,1);
-            
-            // nodal coordinates and EAS vector alpha update
-            dalpha = el.m_fa;
+            // nodal displacement increments
+            double D[6*FEElement::MAX_NODES];
             for (int j=0; j<neln; ++j)
             {
                 FENode& nj = mesh.Node(el.m_node[j]);
-                Du(0,0) = (nj.m_ID[m_dofX] >=0) ? ui[nj.m_ID[m_dofX]] : 0;
-                Du(1,0) = (nj.m_ID[m_dofY] >=0) ? ui[nj.m_ID[m_dofY]] : 0;
-                Du(2,0) = (nj.m_ID[m_dofZ] >=0) ? ui[nj.m_ID[m_dofZ]] : 0;
-                Dw(0,0) = (nj.m_ID[m_dofSX] >=0) ? ui[nj.m_ID[m_dofSX]] : 0;
-                Dw(1,0) = (nj.m_ID[m_dofSY] >=0) ? ui[nj.m_ID[m_dofSY]] : 0;
-                Dw(2,0) = (nj.m_ID[m_dofSZ] >=0) ? ui[nj.m_ID[m_dofSZ]] : 0;
-                dalpha += el.m_Kua[j].transpose()*Du + el.m_Kwa[j].transpose()*Dw;
+                D[6*j  ] = (nj.m_ID[m_dofX] >=0) ? ui[nj.m_ID[m_dofX]] : 0;
+                D[6*j+1] = (nj.m_ID[m_dofY] >=0) ? ui[nj.m_ID[m_dofY]] : 0;
+                D[6*j+2] = (nj.m_ID[m_dofZ] >=0) ? ui[nj.m_ID[m_dofZ]] : 0;
+                D[6*j+3] = (nj.m_ID[m_dofSX] >=0) ? ui[nj.m_ID[m_dofSX]] : 0;
+                D[6*j+4] = (nj.m_ID[m_dofSY] >=0) ? ui[nj.m_ID[m_dofSY]] : 0;
+                D[6*j+5] = (nj.m_ID[m_dofSZ] >=0) ? ui[nj.m_ID[m_dofSZ]] : 0;
             }
-            dalpha = el.m_Kaai*dalpha;
-            el.m_alphai -= dalpha;
+            
+            // EAS vector alpha update
+            double dalpha[NEAS];
+            EAS_KERNEL(Alpha, neln, ed.Kaai, ed.fa, ed.Kua, ed.Kwa, D, dalpha);
+            for (int k=0; k<NEAS; ++k) ed.alphai[k] -= dalpha[k];
         }
-        else el.m_alphat += el.m_alphai;
+        else for (int k=0; k<NEAS; ++k) ed.alphat[k] += ed.alphai[k];
     }
 }
 
@@ -1279,12 +1463,11 @@ void FEElasticEASShellDomain::EvaluateEAS(FEShellElementNew& el, vector<double>&
     vec3d Gcnt[3];
     
     // Evaluate fa, Kua, Kwa, and Kaa by integrating over the element
-    el.m_fa.zero();
-    el.m_Kaai.zero();
-    for (i=0; i< neln; ++i) {
-        el.m_Kua[i].zero();
-        el.m_Kwa[i].zero();
-    }
+    EAS_DATA ed = EASData(el);
+    double* Kaa = ed.Kaai;
+    for (i=0; i<NEAS*NEAS; ++i) Kaa[i] = 0.0;
+    for (i=0; i<NEAS; ++i) ed.fa[i] = 0.0;
+    for (i=0; i<3*NEAS*neln; ++i) { ed.Kua[i] = 0.0; ed.Kwa[i] = 0.0; }
     
     // repeat for all integration points
     for (n=0; n<nint; ++n)
@@ -1308,13 +1491,17 @@ void FEElasticEASShellDomain::EvaluateEAS(FEShellElementNew& el, vector<double>&
         detJt *= gw[n];
         
         // Evaluate enhancing strain ES (covariant components)
-        matrix ES(6,1);
-        ES = G*el.m_alpha;
+        double ES[6];
+        for (int k=0; k<6; ++k)
+        {
+            ES[k] = 0.0;
+            for (int a=0; a<NEAS; ++a) ES[k] += G(k,a)*ed.alpha[a];
+        }
         // Evaluate the tensor form of ES
-        mat3ds Es = ((Gcnt[0] & Gcnt[0])*ES(0,0) + (Gcnt[1] & Gcnt[1])*ES(1,0) + (Gcnt[2] & Gcnt[2])*ES(2,0) +
-                     ((Gcnt[0] & Gcnt[1]) + (Gcnt[1] & Gcnt[0]))*(ES(3,0)/2) +
-                     ((Gcnt[1] & Gcnt[2]) + (Gcnt[2] & Gcnt[1]))*(ES(4,0)/2) +
-                     ((Gcnt[2] & Gcnt[0]) + (Gcnt[0] & Gcnt[2]))*(ES(5,0)/2)).sym();
+        mat3ds Es = ((Gcnt[0] & Gcnt[0])*ES[0] + (Gcnt[1] & Gcnt[1])*ES[1] + (Gcnt[2] & Gcnt[2])*ES[2] +
+                     ((Gcnt[0] & Gcnt[1]) + (Gcnt[1] & Gcnt[0]))*(ES[3]/2) +
+                     ((Gcnt[1] & Gcnt[2]) + (Gcnt[2] & Gcnt[1]))*(ES[4]/2) +
+                     ((Gcnt[2] & Gcnt[0]) + (Gcnt[0] & Gcnt[2]))*(ES[5]/2)).sym();
         // Evaluate enhanced strain
         el.m_E[n] = Ec + Es;
         
@@ -1329,37 +1516,54 @@ void FEElasticEASShellDomain::EvaluateEAS(FEShellElementNew& el, vector<double>&
         matrix CC;
         tens4dsCntMat66(c[n], Gcnt, CC);
         
-        // Evaluate fa
-        matrix tmp(m_nEAS,1);
-        tmp = G.transpose()*SM;
-        tmp *= detJt;
-        el.m_fa += tmp;
-        
-        // Evaluate Kaa
-        matrix Tmpa(m_nEAS,m_nEAS);
-        Tmpa = G.transpose()*CC*G;
-        Tmpa *= detJt;
-        el.m_Kaai += Tmpa;
+        // CG = CC*G*detJt
+        double CG[6][NEAS];
+        for (int k=0; k<6; ++k)
+            for (int a=0; a<NEAS; ++a)
+            {
+                double s = 0.0;
+                for (int l=0; l<6; ++l) s += CC(k,l)*G(l,a);
+                CG[k][a] = s*detJt;
+            }
         
-        eta = el.gt(n);
-        Mr = el.Hr(n);
-        Ms = el.Hs(n);
-        M  = el.H(n);
+        // Evaluate fa and Kaa
+        for (int a=0; a<NEAS; ++a)
+        {
+            double s = 0.0;
+            for (int k=0; k<6; ++k) s += G(k,a)*SM(k,0);
+            ed.fa[a] += s*detJt;
+            
+            for (int b=0; b<NEAS; ++b)
+            {
+                double t = 0.0;
+                for (int k=0; k<6; ++k) t += G(k,a)*CG[k][b];
+                Kaa[a*NEAS + b] += t;
+            }
+        }
         
         // Evaluate Kua and Kwa
-        matrix Tmp(3,m_nEAS);
         for (i=0; i<neln; ++i)
         {
-            Tmp = hu[i]*CC*G;
-            Tmp *= detJt;
-            el.m_Kua[i] += Tmp;
-            Tmp = hw[i]*CC*G;
-            Tmp *= detJt;
-            el.m_Kwa[i] += Tmp;
+            matrix& hui = hu[i];
+            matrix& hwi = hw[i];
+            double* Kua = ed.Kua + 3*NEAS*i;
+            double* Kwa = ed.Kwa + 3*NEAS*i;
+            for (int k=0; k<3; ++k)
+                for (int a=0; a<NEAS; ++a)
+                {
+                    double su = 0.0, sw = 0.0;
+                    for (int l=0; l<6; ++l)
+                    {
+                        su += hui(k,l)*CG[l][a];
+                        sw += hwi(k,l)*CG[l][a];
+                    }
+                    Kua[k*NEAS + a] += su;
+                    Kwa[k*NEAS + a] += sw;
+                }
         }
     }
     // invert Kaa
-    el.m_Kaai = el.m_Kaai.inverse();
+    if (EASKernel::Invert(Kaa) == false) throw SingularMatrix(el.GetID());
 }
 
 //-----------------------------------------------------------------------------
@@ -46,6 +46,9 @@ public:
     //! Activate the domain
     void Activate() override;
     
+    //! serialize domain data
+    void Serialize(DumpStream& ar) override;
+    
     //! Unpack shell element data
     void UnpackLM(FEElement& el, vector<int>& lm) override;
     
@@ -136,7 +139,34 @@ public:
     void UpdateEAS(vector<double>& ui) override;
     void UpdateIncrementsEAS(vector<double>& ui, const bool binc) override;
     
+public:
+    //! number of enhanced strain parameters
+    enum { NEAS = 7 };
+    
+protected:
+    // The EAS data of an element. This points into the domain's EAS array.
+    struct EAS_DATA
+    {
+        double* Kaai;       //!< inverse of Kaa (NEAS x NEAS)
+        double* fa;         //!< EAS residual (NEAS)
+        double* alpha;      //!< EAS parameters (NEAS)
+        double* alphat;     //!< EAS parameters at end of last time step (NEAS)
+        double* alphai;     //!< EAS parameter increment of this time step (NEAS)
+        double* Kua;        //!< Kua for each node (3 x NEAS per node)
+        double* Kwa;        //!< Kwa for each node (3 x NEAS per node)
+    };
+    
+    //! get the EAS data of an element
+    EAS_DATA EASData(int iel);
+    
+    //! get the EAS data of an element
+    EAS_DATA EASData(FEShellElementNew& el);
+    
 protected:
     FESolidMaterial*    m_pMat;
     int                 m_nEAS;
+    
+    vector<double>      m_EAS;      //!< EAS data of all elements
+    int                 m_neln;     //!< max nr of element nodes (sets the size of Kua, Kwa)
+    int                 m_nstride;  //!< size of EAS data of one element
 };
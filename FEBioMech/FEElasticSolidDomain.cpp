@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include <FECore/FEModel.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/sys.h>
+#include <FECore/FEProfiler.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -43,6 +44,8 @@ FEElasticSolidDomain::FEElasticSolidDomain(FEModel* pfem) : FESolidDomain(pfem),
 	m_pMat = 0;
     m_alphaf = m_beta = 1;
     m_alpham = 2;
+	m_bcacheGrad = false;
+	m_bgradValid = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -66,6 +69,36 @@ void FEElasticSolidDomain::SetMaterial(FEMaterial* pmat)
 	else m_pMat = 0;
 }
 
+//-----------------------------------------------------------------------------
+void FEElasticSolidDomain::CacheShapeGradients(bool b)
+{
+	m_bcacheGrad = b;
+	m_bgradValid = false;
+	if (b == false)
+	{
+		m_Gc.clear(); m_Jc.clear();
+		m_Goff.clear(); m_Joff.clear();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticSolidDomain::GetShapeGradients(FESolidElement& el, const vec3d*& G, const double*& J, vec3d* Gbuf, double* Jbuf)
+{
+	if (m_bgradValid)
+	{
+		int iel = (int)(&el - &m_Elem[0]);
+		assert((iel >= 0) && (iel < (int)m_Elem.size()));
+		G = &m_Gc[m_Goff[iel]];
+		J = &m_Jc[m_Joff[iel]];
+	}
+	else
+	{
+		ShapeGradients(el, Gbuf, Jbuf, m_alphaf);
+		G = Gbuf;
+		J = Jbuf;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::Activate()
 {
@@ -91,6 +124,7 @@ void FEElasticSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
     m_alphaf = timeInfo.alphaf;
     m_alpham = timeInfo.alpham;
     m_beta = timeInfo.beta;
+	m_bgradValid = false;
 
 	vec3d r0, rt;
 	for (size_t i=0; i<m_Elem.size(); ++i)
@@ -112,29 +146,42 @@ void FEElasticSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 {
 	int NE = m_Elem.size();
-	#pragma omp parallel for shared (NE)
-	for (int i=0; i<NE; ++i)
+
+	// the worker threads use the model (and profiler) of this thread
+	FEModel* pfem = FECoreKernel::GetThreadModel();
+
+	#pragma omp parallel shared (NE)
 	{
-		// element force vector
-		vector<double> fe;
-		vector<int> lm;
+		FEModelScope model(pfem);
+
+		// the scope is closed when this thread finishes its elements so
+		// that the profiler can report the load imbalance between threads
+		PROFILE_SCOPE("element loop");
+
+		#pragma omp for nowait
+		for (int i=0; i<NE; ++i)
+		{
+			// element force vector
+			vector<double> fe;
+			vector<int> lm;
 		
-		// get the element
-		FESolidElement& el = m_Elem[i];
+			// get the element
+			FESolidElement& el = m_Elem[i];
 
-		// get the element force vector and initialize it to zero
-		int ndof = 3*el.Nodes();
-		fe.assign(ndof, 0);
+			// get the element force vector and initialize it to zero
+			int ndof = 3*el.Nodes();
+			fe.assign(ndof, 0);
 
-		// calculate internal force vector
-        ElementInternalForce(el, fe);
+			// calculate internal force vector
+			ElementInternalForce(el, fe);
         
-		// get the element's LM vector
-		UnpackLM(el, lm);
+			// get the element's LM vector
+			UnpackLM(el, lm);
 
-		// assemble element 'fe'-vector into global R vector
-		//#pragma omp critical
-		R.Assemble(el.m_node, lm, fe);
+			// assemble element 'fe'-vector into global R vector
+			//#pragma omp critical
+			R.Assemble(el.m_node, lm, fe);
+		}
 	}
 }
 
@@ -143,39 +190,34 @@ void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 
 void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<double>& fe)
 {
-	// jacobian matrix, inverse jacobian matrix and determinants
-	double Ji[3][3];
-
 	int nint = el.GaussPoints();
 	int neln = el.Nodes();
 
 	double*	gw = el.GaussWeights();
 
+	// spatial shape function gradients and jacobians at all integration points
+	vec3d Gbuf[FEElement::MAX_NODES*FEElement::MAX_INTPOINTS];
+	double Jbuf[FEElement::MAX_INTPOINTS];
+	const vec3d* G;
+	const double* J;
+	GetShapeGradients(el, G, J, Gbuf, Jbuf);
+
 	// repeat for all integration points
-	for (int n=0; n<nint; ++n)
+	for (int n=0; n<nint; ++n, G += neln)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
 
-		// calculate the jacobian
-		double detJt = invjact(el, Ji, n, m_alphaf);
-
-		detJt *= gw[n];
+		double detJt = J[n]*gw[n];
 
 		// get the stress vector for this integration point
         mat3ds& s = pt.m_s;
 
-		const double* Gr = el.Gr(n);
-		const double* Gs = el.Gs(n);
-		const double* Gt = el.Gt(n);
-
 		for (int i=0; i<neln; ++i)
 		{
-			// calculate global gradient of shape functions
-			// note that we need the transposed of Ji, not Ji itself !
-			double Gx = Ji[0][0]*Gr[i]+Ji[1][0]*Gs[i]+Ji[2][0]*Gt[i];
-			double Gy = Ji[0][1]*Gr[i]+Ji[1][1]*Gs[i]+Ji[2][1]*Gt[i];
-			double Gz = Ji[0][2]*Gr[i]+Ji[1][2]*Gs[i]+Ji[2][2]*Gt[i];
+			double Gx = G[i].x;
+			double Gy = G[i].y;
+			double Gz = G[i].z;
 
 			// calculate internal force
 			// the '-' sign is so that the internal forces get subtracted
@@ -237,7 +279,6 @@ void FEElasticSolidDomain::ElementBodyForce(FEBodyForce& BF, FESolidElement& el,
 	// jacobian
 	double detJ;
 	double *H;
-	double* gw = el.GaussWeights();
 	vec3d f;
 
 	// number of nodes
@@ -249,7 +290,7 @@ void FEElasticSolidDomain::ElementBodyForce(FEBodyForce& BF, FESolidElement& el,
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 
-		detJ = detJ0(el, n)*gw[n];
+		detJ = detJ0w(el, n);
 
 		// get the force
 		f = BF.force(mp);
@@ -278,7 +319,6 @@ void FEElasticSolidDomain::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEle
 	// jacobian
 	double detJ;
 	double *H;
-	double* gw = el.GaussWeights();
 	mat3ds K;
 
 	// loop over integration points
@@ -286,7 +326,7 @@ void FEElasticSolidDomain::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEle
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		detJ = detJ0(el, n)*gw[n]*m_alphaf;
+		detJ = detJ0w(el, n)*m_alphaf;
 
 		// get the stiffness
 		K = BF.stiffness(mp);
@@ -315,19 +355,22 @@ void FEElasticSolidDomain::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEle
 //! calculates element's geometrical stiffness component for integration point n
 void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matrix &ke)
 {
-	// spatial derivatives of shape functions
-	vec3d G[FEElement::MAX_NODES];
-
 	// weights at gauss points
 	const double *gw = el.GaussWeights();
 
+	// spatial derivatives of shape functions and jacobians
+	vec3d Gbuf[FEElement::MAX_NODES*FEElement::MAX_INTPOINTS];
+	double Jbuf[FEElement::MAX_INTPOINTS];
+	const vec3d* G;
+	const double* J;
+	GetShapeGradients(el, G, J, Gbuf, Jbuf);
+
 	// calculate geometrical element stiffness matrix
 	int neln = el.Nodes();
 	int nint = el.GaussPoints();
-	for (int n = 0; n<nint; ++n)
+	for (int n = 0; n<nint; ++n, G += neln)
 	{
-		// calculate shape function gradients and jacobian
-		double w = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
+		double w = J[n]*gw[n]*m_alphaf;
 
 		// get the material point data
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
@@ -357,8 +400,12 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	const int nint = el.GaussPoints();
 	const int neln = el.Nodes();
 
-	// global derivatives of shape functions
-	vec3d G[FEElement::MAX_NODES];
+	// global derivatives of shape functions and jacobians
+	vec3d Gbuf[FEElement::MAX_NODES*FEElement::MAX_INTPOINTS];
+	double Jbuf[FEElement::MAX_INTPOINTS];
+	const vec3d* G;
+	const double* J;
+	GetShapeGradients(el, G, J, Gbuf, Jbuf);
 
 	double Gxi, Gyi, Gzi;
 	double Gxj, Gyj, Gzj;
@@ -376,10 +423,9 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	const double *gw = el.GaussWeights();
 
 	// calculate element stiffness matrix
-	for (int n=0; n<nint; ++n)
+	for (int n=0; n<nint; ++n, G += neln)
 	{
-		// calculate jacobian and shape function gradients
-		detJt = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
+		detJt = J[n]*gw[n]*m_alphaf;
 
 		// setup the material point
 		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
@@ -445,45 +491,162 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Same as ElementGeometricalStiffness + ElementMaterialStiffness, but the number
+//! of nodes is a compile-time constant so that the loops over the nodes can be
+//! unrolled. The full (symmetric) matrix is returned.
+template <int NELN>
+void FEElasticSolidDomain::ElementStiffness(FESolidElement& el, fixed_matrix<3*NELN, 3*NELN>& ke)
+{
+	assert(el.Nodes() == NELN);
+	ke.zero();
+
+	// global derivatives of shape functions and jacobians
+	vec3d Gbuf[NELN*FEElement::MAX_INTPOINTS];
+	double Jbuf[FEElement::MAX_INTPOINTS];
+	const vec3d* G;
+	const double* J;
+	GetShapeGradients(el, G, J, Gbuf, Jbuf);
+
+	// The 'D' matrix
+	double D[6][6];
+
+	// The 'BL^T*D' matrix of node i
+	double BD[3][6];
+
+	// weights at gauss points
+	const double *gw = el.GaussWeights();
+
+	int nint = el.GaussPoints();
+	for (int n=0; n<nint; ++n, G += NELN)
+	{
+		double detJt = J[n]*gw[n]*m_alphaf;
+
+		// get the material point data
+		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+
+		// element's Cauchy-stress tensor at gauss point n
+		const mat3ds& s = pt.m_s;
+
+		// get the 'D' matrix
+		tens4ds C = m_pMat->Tangent(mp);
+		C.extract(D);
+
+		// we only calculate the upper triangular part
+		for (int i=0; i<NELN; ++i)
+		{
+			const double Gxi = G[i].x*detJt;
+			const double Gyi = G[i].y*detJt;
+			const double Gzi = G[i].z*detJt;
+
+			for (int k=0; k<6; ++k)
+			{
+				BD[0][k] = Gxi*D[0][k] + Gyi*D[3][k] + Gzi*D[5][k];
+				BD[1][k] = Gyi*D[1][k] + Gxi*D[3][k] + Gzi*D[4][k];
+				BD[2][k] = Gzi*D[2][k] + Gyi*D[4][k] + Gxi*D[5][k];
+			}
+
+			// initial stress
+			const vec3d sGi = s*vec3d(Gxi, Gyi, Gzi);
+
+			double* ke0 = ke[3*i  ];
+			double* ke1 = ke[3*i+1];
+			double* ke2 = ke[3*i+2];
+			for (int j=i; j<NELN; ++j)
+			{
+				const double Gxj = G[j].x;
+				const double Gyj = G[j].y;
+				const double Gzj = G[j].z;
+				const double kab = sGi.x*Gxj + sGi.y*Gyj + sGi.z*Gzj;
+				const int j3 = 3*j;
+
+				ke0[j3  ] += BD[0][0]*Gxj + BD[0][3]*Gyj + BD[0][5]*Gzj + kab;
+				ke0[j3+1] += BD[0][1]*Gyj + BD[0][3]*Gxj + BD[0][4]*Gzj;
+				ke0[j3+2] += BD[0][2]*Gzj + BD[0][4]*Gyj + BD[0][5]*Gxj;
+
+				ke1[j3  ] += BD[1][0]*Gxj + BD[1][3]*Gyj + BD[1][5]*Gzj;
+				ke1[j3+1] += BD[1][1]*Gyj + BD[1][3]*Gxj + BD[1][4]*Gzj + kab;
+				ke1[j3+2] += BD[1][2]*Gzj + BD[1][4]*Gyj + BD[1][5]*Gxj;
+
+				ke2[j3  ] += BD[2][0]*Gxj + BD[2][3]*Gyj + BD[2][5]*Gzj;
+				ke2[j3+1] += BD[2][1]*Gyj + BD[2][3]*Gxj + BD[2][4]*Gzj;
+				ke2[j3+2] += BD[2][2]*Gzj + BD[2][4]*Gyj + BD[2][5]*Gxj + kab;
+			}
+		}
+	}
+
+	// assign symmetic parts
+	ke.copy_ut();
+}
+
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::StiffnessMatrix(FESolver* psolver)
 {
 	// repeat over all solid elements
 	int NE = m_Elem.size();
+
+	// see InternalForces
+	FEModel* pfem = FECoreKernel::GetThreadModel();
 	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
+	#pragma omp parallel shared (NE)
 	{
-		// element stiffness matrix
-		matrix ke;
+		// see InternalForces
+		FEModelScope model(pfem);
+		PROFILE_SCOPE("element loop");
+
+		// element stiffness matrices (one set per thread)
+		fixed_matrix<12, 12> ke4;	// TET4
+		fixed_matrix<24, 24> ke8;	// HEX8
+		fixed_matrix<30, 30> ke10;	// TET10
+		matrix ke;					// all other elements
 		vector<int> lm;
-		
-		FESolidElement& el = m_Elem[iel];
-
-		// create the element's stiffness matrix
-		int ndof = 3*el.Nodes();
-		ke.resize(ndof, ndof);
-		ke.zero();
-
-		// calculate geometrical stiffness
-		ElementGeometricalStiffness(el, ke);
 
-		// calculate material stiffness
-		ElementMaterialStiffness(el, ke);
+		#pragma omp for nowait
+		for (int iel=0; iel<NE; ++iel)
+		{
+			FESolidElement& el = m_Elem[iel];
 
-		// assign symmetic parts
-		// TODO: Can this be omitted by changing the Assemble routine so that it only
-		// grabs elements from the upper diagonal matrix?
-		for (int i=0; i<ndof; ++i)
-			for (int j=i+1; j<ndof; ++j)
-				ke[j][i] = ke[i][j];
+			matrix* pke = 0;
+			switch (el.Nodes())
+			{
+			case  4: ElementStiffness< 4>(el, ke4 ); pke = &ke4 ; break;
+			case  8: ElementStiffness< 8>(el, ke8 ); pke = &ke8 ; break;
+			case 10: ElementStiffness<10>(el, ke10); pke = &ke10; break;
+			default:
+				{
+					// create the element's stiffness matrix
+					int ndof = 3*el.Nodes();
+					ke.resize(ndof, ndof);
+					ke.zero();
+
+					// calculate geometrical stiffness
+					ElementGeometricalStiffness(el, ke);
+
+					// calculate material stiffness
+					ElementMaterialStiffness(el, ke);
+
+					// assign symmetic parts
+					// TODO: Can this be omitted by changing the Assemble routine so that it only
+					// grabs elements from the upper diagonal matrix?
+					for (int i=0; i<ndof; ++i)
+						for (int j=i+1; j<ndof; ++j)
+							ke[j][i] = ke[i][j];
+
+					pke = &ke;
+				}
+			}
 
-		// get the element's LM vector
-		UnpackLM(el, lm);
+			// get the element's LM vector
+			UnpackLM(el, lm);
 
-		// assemble element matrix in global stiffness matrix
-		#pragma omp critical
-		psolver->AssembleStiffness(el.m_node, lm, ke);
+			// assemble element matrix in global stiffness matrix
+			#pragma omp critical
+			{
+				PROFILE_SCOPE("assembly");
+				psolver->AssembleStiffness(el.m_node, lm, *pke);
+			}
+		}
 	}
 }
 
@@ -583,9 +746,6 @@ void FEElasticSolidDomain::ElementMassMatrix(FESolidElement& el, matrix& ke, dou
 	const int neln = el.Nodes();
 	const int ndof = 3*neln;
 
-	// weights at gauss points
-	const double *gw = el.GaussWeights();
-
 	// density
 	double D = m_pMat->Density();
     
@@ -596,7 +756,7 @@ void FEElasticSolidDomain::ElementMassMatrix(FESolidElement& el, matrix& ke, dou
 		double* H = el.H(n);
 
 		// Jacobian
-		double J0 = detJ0(el, n)*gw[n];
+		double J0 = detJ0w(el, n);
 
 		for (int i=0; i<neln; ++i)
 			for (int j=i; j<neln; ++j)
@@ -632,17 +792,41 @@ void FEElasticSolidDomain::Update(const FETimeInfo& tp)
 
 	bool berr = false;
 	int NE = (int) m_Elem.size();
+
+	// allocate the shape function gradient cache
+	m_bgradValid = false;
+	if (m_bcacheGrad && ((int)m_Goff.size() != NE))
+	{
+		m_Goff.resize(NE);
+		m_Joff.resize(NE);
+		int ng = 0, nj = 0;
+		for (int i=0; i<NE; ++i)
+		{
+			FESolidElement& el = m_Elem[i];
+			m_Goff[i] = ng; ng += el.GaussPoints()*el.Nodes();
+			m_Joff[i] = nj; nj += el.GaussPoints();
+		}
+		m_Gc.resize(ng);
+		m_Jc.resize(nj);
+	}
+
+	// the worker threads use the model (and log file) of this thread
+	FEModel* pfem = FECoreKernel::GetThreadModel();
 	#pragma omp parallel for shared(NE, berr)
 	for (int i=0; i<NE; ++i)
 	{
 		try
 		{
 			UpdateElementStress(i, tp);
+
+			// evaluate the gradients for the residual and stiffness
+			if (m_bcacheGrad) ShapeGradients(m_Elem[i], &m_Gc[m_Goff[i]], &m_Jc[m_Joff[i]], m_alphaf);
 		}
 		catch (NegativeJacobian e)
 		{
 			#pragma omp critical
 			{
+				FEModelScope scope(pfem);
 				// reset the logfile mode
 				felog.SetMode(nmode);
 				berr = true;
@@ -660,6 +844,8 @@ void FEElasticSolidDomain::Update(const FETimeInfo& tp)
 		if (NegativeJacobian::m_boutput == false) felog.printbox("ERROR", "Negative jacobian was detected.");
 		throw DoRunningRestart();
 	}
+
+	m_bgradValid = m_bcacheGrad;
 }
 
 //-----------------------------------------------------------------------------
@@ -690,6 +876,11 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
         a[j] = node.m_at*m_alpham + node.m_ap*(1-m_alpham);
 	}
 
+	// deformation gradients at all integration points
+	mat3d Fn[FEElement::MAX_INTPOINTS];
+	double Jn[FEElement::MAX_INTPOINTS];
+	defgrads(el, Fn, Jn);
+
 	// loop over the integration points and calculate
 	// the stress at the integration point
 	for (int n=0; n<nint; ++n)
@@ -704,9 +895,8 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 		pt.m_rt = el.Evaluate(r, n);
 
 		// get the deformation gradient and determinant at intermediate time
-        double Jt;
-        mat3d Ft, Fp;
-        Jt = defgrad(el, Ft, n);
+        double Jt = Jn[n];
+        mat3d Ft = Fn[n], Fp;
 
 		if (m_alphaf == 1.0)
 		{
@@ -822,15 +1012,13 @@ void FEElasticSolidDomain::ElementInertialForce(FESolidElement& el, vector<doubl
     int nint = el.GaussPoints();
     int neln = el.Nodes();
     
-    double*    gw = el.GaussWeights();
-    
     // repeat for all integration points
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
         FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
         double dens = m_pMat->Density();
-        double J0 = detJ0(el, n)*gw[n];
+        double J0 = detJ0w(el, n);
         
         double* H = el.H(n);
         for (int i=0; i<neln; ++i)
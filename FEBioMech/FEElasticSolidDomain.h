@@ -51,6 +51,11 @@ public:
 	//! Unpack solid element data
 	void UnpackLM(FEElement& el, vector<int>& lm) override;
 
+	//! Turn on or off the caching of the spatial shape function gradients.
+	//! When on, the gradients are evaluated when the stresses are updated and reused
+	//! by the residual and stiffness evaluations of the same iteration.
+	void CacheShapeGradients(bool b);
+
 public: // overrides from FEDomain
 
 	//! get the material
@@ -97,6 +102,10 @@ public:
 	//! material stiffness component
 	virtual void ElementMaterialStiffness(FESolidElement& el, matrix& ke);
 
+	//! material and geometrical stiffness for elements with NELN nodes
+	//! (specialized kernel for the common element types)
+	template <int NELN> void ElementStiffness(FESolidElement& el, fixed_matrix<3*NELN, 3*NELN>& ke);
+
 	//! calculates the solid element mass matrix
 	void ElementMassMatrix(FESolidElement& el, matrix& ke, double a);
 
@@ -113,10 +122,24 @@ public:
 
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
-    
+
+protected:
+	//! Get the spatial shape function gradients and Jacobians at all integration points
+	//! of an element at the intermediate configuration. These are taken from the cache
+	//! if it is valid, otherwise they are evaluated and stored in Gbuf and Jbuf.
+	void GetShapeGradients(FESolidElement& el, const vec3d*& G, const double*& J, vec3d* Gbuf, double* Jbuf);
+
 protected:
 	FESolidMaterial*	m_pMat;
     double              m_alphaf;
     double              m_alpham;
     double              m_beta;
+
+	// shape function gradient cache
+	bool			m_bcacheGrad;	//!< cache the spatial shape function gradients
+	bool			m_bgradValid;	//!< the cache is up to date
+	vector<vec3d>	m_Gc;			//!< cached gradients
+	vector<double>	m_Jc;			//!< cached Jacobians
+	vector<int>		m_Goff;			//!< offset of each element in m_Gc
+	vector<int>		m_Joff;			//!< offset of each element in m_Jc
 };
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/log.h"
 #include "FECore/FEGlobalMatrix.h"
 #include "FECore/FEDataExport.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -364,7 +365,7 @@ void FEFacetSlidingSurface::GetNodalContactTraction(int nface, vec3d* tn)
 
 FEFacet2FacetSliding::FEFacet2FacetSliding(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int ncount = 1;
+	static std::atomic<int> ncount(1);
 	SetID(ncount++);
 
 	// default parameters
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/FEClosestPointProjection.h"
 #include "FECore/FEGlobalMatrix.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define tied interface parameters
@@ -153,7 +154,7 @@ void FEFacetTiedSurface::Serialize(DumpStream &ar)
 FEFacet2FacetTied::FEFacet2FacetTied(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
 	// give this interface an ID
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	// define sibling relationships
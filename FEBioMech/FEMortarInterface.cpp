@@ -30,12 +30,15 @@ SOFTWARE.*/
 #include "FECore/mortar.h"
 #include "FECore/log.h"
 #include <FECore/FEMesh.h>
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 FEMortarInterface::FEMortarInterface(FEModel* pfem) : FEContactInterface(pfem)
 {
 	// set the integration rule
 	m_pT = dynamic_cast<FESurfaceElementTraits*>(FEElementLibrary::GetElementTraits(FE_TRI3G7));
+
+	m_srad = 0.0;	// no search radius limitation
 }
 
 //-----------------------------------------------------------------------------
@@ -60,7 +63,33 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 
 	// calculate the mortar surface
 	MortarSurface mortar;
-	CalculateMortarSurface(ss, ms, mortar);
+	CalculateMortarSurface(ss, ms, mortar, m_tree, m_srad);
+
+	// only nodes that share a patch will get nonzero weights
+	m_n1c.assign(NS, vector<int>());
+	m_n2c.assign(NS, vector<int>());
+	for (int i=0; i<mortar.Patches(); ++i)
+	{
+		Patch& pi = mortar.GetPatch(i);
+		FESurfaceElement& se = ss.Element(pi.GetSlaveFacetID());
+		FESurfaceElement& me = ms.Element(pi.GetMasterFacetID());
+		for (int A=0; A<se.Nodes(); ++A)
+		{
+			int a = se.m_lnode[A];
+			for (int B=0; B<se.Nodes(); ++B) m_n1c[a].push_back(se.m_lnode[B]);
+			for (int C=0; C<me.Nodes(); ++C) m_n2c[a].push_back(me.m_lnode[C]);
+		}
+	}
+	for (int A=0; A<NS; ++A)
+	{
+		vector<int>& n1c = m_n1c[A];
+		sort(n1c.begin(), n1c.end());
+		n1c.erase(unique(n1c.begin(), n1c.end()), n1c.end());
+
+		vector<int>& n2c = m_n2c[A];
+		sort(n2c.begin(), n2c.end());
+		n2c.erase(unique(n2c.begin(), n2c.end()), n2c.end());
+	}
 
 	// These arrays will store the shape function values of the projection points 
 	// on the slave and master side when evaluating the integral over a pallet
@@ -185,8 +214,9 @@ void FEMortarInterface::UpdateNodalGaps(FEMortarContactSurface& ss, FEMortarCont
 	for (int A=0; A<NS; ++A)
 	{
 		// loop over all slave nodes
-		for (int B=0; B<NS; ++B)
+		for (int iB=0; iB<(int)m_n1c[A].size(); ++iB)
 		{
+			int B = m_n1c[A][iB];
 			FENode& nodeB = ss.Node(B);
 			vec3d& xB = nodeB.m_rt;
 			double nAB = m_n1[A][B];
@@ -194,8 +224,9 @@ void FEMortarInterface::UpdateNodalGaps(FEMortarContactSurface& ss, FEMortarCont
 		}
 
 		// loop over master side
-		for (int C=0; C<NM; ++C)
+		for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 		{
+			int C = m_n2c[A][iC];
 			FENode& nodeC = ms.Node(C);
 			vec3d& xC = nodeC.m_rt;
 			double nAC = m_n2[A][C];
@@ -28,6 +28,7 @@ SOFTWARE.*/
 #pragma once
 #include "FEContactInterface.h"
 #include "FEMortarContactSurface.h"
+#include "FECore/mortar.h"
 
 //-----------------------------------------------------------------------------
 // Base class for mortar-type contact formulations
@@ -47,7 +48,15 @@ protected:
 	matrix	m_n1;	//!< integration weights n1_AB
 	matrix	m_n2;	//!< integration weights n2_AB
 
+	vector< vector<int> >	m_n1c;	//!< columns of m_n1 that can be nonzero (for each row)
+	vector< vector<int> >	m_n2c;	//!< columns of m_n2 that can be nonzero (for each row)
+
+	double	m_srad;	//!< search radius (relative to facet size, 0 = no limit)
+
 private:
 	// integration rule
 	FESurfaceElementTraits*	m_pT;
+
+	// bounding-box tree of master facets
+	FacetBoxTree	m_tree;
 };
@@ -115,6 +115,7 @@ BEGIN_PARAMETER_LIST(FEMortarSlidingContact, FEMortarInterface)
 	ADD_PARAMETER(m_eps          , FE_PARAM_DOUBLE, "penalty"      );
 	ADD_PARAMETER(m_naugmin      , FE_PARAM_INT   , "minaug"       );
 	ADD_PARAMETER(m_naugmax      , FE_PARAM_INT   , "maxaug"       );
+	ADD_PARAMETER(m_srad         , FE_PARAM_DOUBLE, "search_radius");
 END_PARAMETER_LIST();
 
 //-----------------------------------------------------------------------------
@@ -209,8 +210,9 @@ void FEMortarSlidingContact::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 		vector<int> en(1);
 		vector<int> lm(3);
 		vector<double> fe(3);
-		for (int B=0; B<NS; ++B)
+		for (int iB=0; iB<(int)m_n1c[A].size(); ++iB)
 		{
+			int B = m_n1c[A][iB];
 			FENode& nodeB = m_ss.Node(B);
 			en[0] = m_ss.NodeIndex(B);
 			lm[0] = nodeB.m_ID[m_dofX];
@@ -229,8 +231,9 @@ void FEMortarSlidingContact::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 		}
 
 		// loop over master side
-		for (int C=0; C<NM; ++C)
+		for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 		{
+			int C = m_n2c[A][iC];
 			FENode& nodeC = m_ms.Node(C);
 			en[0] = m_ms.NodeIndex(C);
 			lm[0] = nodeC.m_ID[m_dofX];
@@ -274,8 +277,9 @@ void FEMortarSlidingContact::ContactGapStiffness(FESolver* psolver)
 		double eps = m_eps*m_ss.m_A[A];
 
 		// loop over all slave nodes
-		for (int B=0; B<NS; ++B)
+		for (int iB=0; iB<(int)m_n1c[A].size(); ++iB)
 		{
+			int B = m_n1c[A][iB];
 			FENode& nodeB = m_ss.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
@@ -289,8 +293,9 @@ void FEMortarSlidingContact::ContactGapStiffness(FESolver* psolver)
 				kA[2][0] = eps*nAB*(nuA.z*nuA.x); kA[2][1] = eps*nAB*(nuA.z*nuA.y); kA[2][2] = eps*nAB*(nuA.z*nuA.z);
 
 				// loop over slave nodes
-				for (int C=0; C<NS; ++C)
+				for (int iC=0; iC<(int)m_n1c[A].size(); ++iC)
 				{
+					int C = m_n1c[A][iC];
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -310,8 +315,9 @@ void FEMortarSlidingContact::ContactGapStiffness(FESolver* psolver)
 				}
 
 				// loop over master nodes
-				for (int C=0; C<NM; ++C)
+				for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 				{
+					int C = m_n2c[A][iC];
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -333,8 +339,9 @@ void FEMortarSlidingContact::ContactGapStiffness(FESolver* psolver)
 		}
 
 		// loop over all master nodes
-		for (int B=0; B<NM; ++B)
+		for (int iB=0; iB<(int)m_n2c[A].size(); ++iB)
 		{
+			int B = m_n2c[A][iB];
 			FENode& nodeB = m_ms.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
@@ -348,8 +355,9 @@ void FEMortarSlidingContact::ContactGapStiffness(FESolver* psolver)
 				kA[2][0] = eps*nAB*(nuA.z*nuA.x); kA[2][1] = eps*nAB*(nuA.z*nuA.y); kA[2][2] = eps*nAB*(nuA.z*nuA.z);
 
 				// loop over slave nodes
-				for (int C=0; C<NS; ++C)
+				for (int iC=0; iC<(int)m_n1c[A].size(); ++iC)
 				{
+					int C = m_n1c[A][iC];
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -369,8 +377,9 @@ void FEMortarSlidingContact::ContactGapStiffness(FESolver* psolver)
 				}
 
 				// loop over master nodes
-				for (int C=0; C<NM; ++C)
+				for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 				{
+					int C = m_n2c[A][iC];
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -437,8 +446,9 @@ void FEMortarSlidingContact::ContactNormalStiffness(FESolver* psolver)
 			lm2[2] = nodej2.m_ID[2];
 
 			// loop over slave nodes
-			for (int B=0; B<NS; ++B)
+			for (int iB=0; iB<(int)m_n1c[A].size(); ++iB)
 			{
+				int B = m_n1c[A][iB];
 				FENode& nodeB = m_ss.Node(B);
 				
 				double nAB = m_n1[A][B];
@@ -466,8 +476,9 @@ void FEMortarSlidingContact::ContactNormalStiffness(FESolver* psolver)
 			}
 
 			// loop over master nodes
-			for (int B=0; B<NM; ++B)
+			for (int iB=0; iB<(int)m_n2c[A].size(); ++iB)
 			{
+				int B = m_n2c[A][iB];
 				FENode& nodeB = m_ms.Node(B);
 				
 				double nAB = m_n2[A][B];
@@ -66,6 +66,7 @@ BEGIN_PARAMETER_LIST(FEMortarTiedContact, FEMortarInterface)
 	ADD_PARAMETER(m_eps          , FE_PARAM_DOUBLE, "penalty"      );
 	ADD_PARAMETER(m_naugmin      , FE_PARAM_INT   , "minaug"       );
 	ADD_PARAMETER(m_naugmax      , FE_PARAM_INT   , "maxaug"       );
+	ADD_PARAMETER(m_srad         , FE_PARAM_DOUBLE, "search_radius");
 END_PARAMETER_LIST();
 
 //-----------------------------------------------------------------------------
@@ -147,8 +148,9 @@ void FEMortarTiedContact::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 		vector<int> en(1);
 		vector<int> lm(3);
 		vector<double> fe(3);
-		for (int B=0; B<NS; ++B)
+		for (int iB=0; iB<(int)m_n1c[A].size(); ++iB)
 		{
+			int B = m_n1c[A][iB];
 			FENode& nodeB = m_ss.Node(B);
 			en[0] = m_ss.NodeIndex(B);
 			lm[0] = nodeB.m_ID[m_dofX];
@@ -167,8 +169,9 @@ void FEMortarTiedContact::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 		}
 
 		// loop over master side
-		for (int C=0; C<NM; ++C)
+		for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 		{
+			int C = m_n2c[A][iC];
 			FENode& nodeC = m_ms.Node(C);
 			en[0] = m_ms.NodeIndex(C);
 			lm[0] = nodeC.m_ID[m_dofX];
@@ -203,8 +206,9 @@ void FEMortarTiedContact::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 		double eps = m_eps*m_ss.m_A[A];
 
 		// loop over all slave nodes
-		for (int B=0; B<NS; ++B)
+		for (int iB=0; iB<(int)m_n1c[A].size(); ++iB)
 		{
+			int B = m_n1c[A][iB];
 			FENode& nodeB = m_ss.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
@@ -214,8 +218,9 @@ void FEMortarTiedContact::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 			if (nAB != 0.0)
 			{
 				// loop over slave nodes
-				for (int C=0; C<NS; ++C)
+				for (int iC=0; iC<(int)m_n1c[A].size(); ++iC)
 				{
+					int C = m_n1c[A][iC];
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -233,8 +238,9 @@ void FEMortarTiedContact::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 				}
 
 				// loop over master nodes
-				for (int C=0; C<NM; ++C)
+				for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 				{
+					int C = m_n2c[A][iC];
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -254,8 +260,9 @@ void FEMortarTiedContact::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 		}
 
 		// loop over all master nodes
-		for (int B=0; B<NM; ++B)
+		for (int iB=0; iB<(int)m_n2c[A].size(); ++iB)
 		{
+			int B = m_n2c[A][iB];
 			FENode& nodeB = m_ms.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
@@ -265,8 +272,9 @@ void FEMortarTiedContact::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 			if (nAB != 0.0)
 			{
 				// loop over slave nodes
-				for (int C=0; C<NS; ++C)
+				for (int iC=0; iC<(int)m_n1c[A].size(); ++iC)
 				{
+					int C = m_n1c[A][iC];
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -284,8 +292,9 @@ void FEMortarTiedContact::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 				}
 
 				// loop over master nodes
-				for (int C=0; C<NM; ++C)
+				for (int iC=0; iC<(int)m_n2c[A].size(); ++iC)
 				{
+					int C = m_n2c[A][iC];
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/FENormalProjection.h"
 #include "FECore/FEGlobalMatrix.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -197,7 +198,7 @@ void FEPeriodicSurface::GetNodalContactTraction(int nface, vec3d* tn)
 
 FEPeriodicBoundary::FEPeriodicBoundary(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	m_stol = 0.01;
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/FENormalProjection.h"
 #include "FECore/FEGlobalMatrix.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -49,7 +50,7 @@ END_PARAMETER_LIST();
 
 FEPeriodicBoundary1O::FEPeriodicBoundary1O(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	m_stol = 0.01;
@@ -28,6 +28,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEPressureLoad.h"
 #include "FECore/FEModel.h"
+#include "FECore/FEBlockAssembler.h"
 
 //-----------------------------------------------------------------------------
 // Parameter block for pressure loads
@@ -344,70 +345,96 @@ void FEPressureLoad::StiffnessMatrix(const FETimeInfo& tp, FESolver* psolver)
 	// unless of course we don't want it at all
 	if (m_bstiff == false) return;
 
-	matrix ke;
-	vector<int> lm;
-
 	FESurface& surf = GetSurface();
 	int npr = surf.Elements();
-	for (int m=0; m<npr; ++m)
+
+	// the element matrices are evaluated in parallel and assembled in element order
+	FEBlockAssembler A(psolver, npr);
+	while (A.NextBlock())
 	{
-		// get the surface element
-		FESurfaceElement& el = m_psurf->Element(m);
+		int n0 = A.BlockStart();
+		int n1 = A.BlockEnd();
+		#pragma omp parallel
+		{
+			matrix ke;
+			vector<int> lm;
+			vector<double> tn;
 
-		// calculate nodal normal tractions
-		int neln = el.Nodes();
-		vector<double> tn(neln);
+			#pragma omp for
+			for (int m=n0; m<n1; ++m)
+			{
+				// get the surface element
+				FESurfaceElement& el = m_psurf->Element(m);
 
-		// evaluate the prescribed traction.
-		// note the negative sign. This is because this boundary condition uses the 
-		// convention that a positive pressure is compressive
-		for (int j=0; j<neln; ++j) tn[j] = -m_pressure*m_PC.value<double>(m, j);
+				// calculate nodal normal tractions
+				int neln = el.Nodes();
+				tn.resize(neln);
 
-		// get the element stiffness matrix
-		int ndof = 3*neln;
-		ke.resize(ndof, ndof);
+				// evaluate the prescribed traction.
+				// note the negative sign. This is because this boundary condition uses the 
+				// convention that a positive pressure is compressive
+				for (int j=0; j<neln; ++j) tn[j] = -m_pressure*m_PC.value<double>(m, j);
 
-		// calculate pressure stiffness
-		PressureStiffness(el, ke, tn);
+				// get the element stiffness matrix
+				int ndof = 3*neln;
+				ke.resize(ndof, ndof);
 
-		// get the element's LM vector
-		UnpackLM(el, lm);
+				// calculate pressure stiffness
+				PressureStiffness(el, ke, tn);
 
-		// assemble element matrix in global stiffness matrix
-		psolver->AssembleStiffness(el.m_node, lm, ke);
+				// get the element's LM vector
+				UnpackLM(el, lm);
+
+				// assemble element matrix in global stiffness matrix
+				A.Add(m, el.m_node, lm, ke);
+			}
+		}
 	}
 }
 
 //-----------------------------------------------------------------------------
 void FEPressureLoad::Residual(const FETimeInfo& tp, FEGlobalVector& R)
 {
-	vector<double> fe;
-	vector<int> lm;
-
 	FESurface& surf = GetSurface();
 	int npr = surf.Elements();
-	for (int i=0; i<npr; ++i)
+
+	// the element vectors are evaluated in parallel and assembled in element order
+	FEBlockAssembler A(R, npr);
+	while (A.NextBlock())
 	{
-		FESurfaceElement& el = m_psurf->Element(i);
+		int n0 = A.BlockStart();
+		int n1 = A.BlockEnd();
+		#pragma omp parallel
+		{
+			vector<double> fe;
+			vector<int> lm;
+			vector<double> tn;
 
-		// calculate nodal normal tractions
-		int neln = el.Nodes();
-		vector<double> tn(neln);
+			#pragma omp for
+			for (int i=n0; i<n1; ++i)
+			{
+				FESurfaceElement& el = m_psurf->Element(i);
 
-		// evaluate the prescribed traction.
-		// note the negative sign. This is because this boundary condition uses the 
-		// convention that a positive pressure is compressive
-		for (int j=0; j<el.Nodes(); ++j) tn[j] = -m_pressure*m_PC.value<double>(i, j);
+				// calculate nodal normal tractions
+				int neln = el.Nodes();
+				tn.resize(neln);
+
+				// evaluate the prescribed traction.
+				// note the negative sign. This is because this boundary condition uses the 
+				// convention that a positive pressure is compressive
+				for (int j=0; j<el.Nodes(); ++j) tn[j] = -m_pressure*m_PC.value<double>(i, j);
 		
-		int ndof = 3*neln;
-		fe.resize(ndof);
+				int ndof = 3*neln;
+				fe.resize(ndof);
 
-		if (m_blinear) LinearPressureForce(el, fe, tn); else PressureForce(el, fe, tn);
+				if (m_blinear) LinearPressureForce(el, fe, tn); else PressureForce(el, fe, tn);
 
-		// get the element's LM vector
-		UnpackLM(el, lm);
+				// get the element's LM vector
+				UnpackLM(el, lm);
 
-		// add element force vector to global force vector
-		R.Assemble(el.m_node, lm, fe);
+				// add element force vector to global force vector
+				A.Add(i, el.m_node, lm, fe);
+			}
+		}
 	}
 }
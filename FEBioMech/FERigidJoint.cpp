@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/log.h"
 #include "FECore/FEModel.h"
 #include "FECore/FEMaterial.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 BEGIN_PARAMETER_LIST(FERigidJoint, FERigidConnector);
@@ -45,7 +46,7 @@ END_PARAMETER_LIST();
 //-----------------------------------------------------------------------------
 FERigidJoint::FERigidJoint(FEModel* pfem) : FERigidConnector(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	m_nID = count++;
 	m_blaugon = true; // on by default for backward compatibility
 
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include <FECore/FEGlobalMatrix.h>
 #include <FECore/log.h>
 #include <FECore/FERigidSystem.h>
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -166,7 +167,7 @@ void FERigidSlidingSurface::UnpackLM(FEElement& el, vector<int>& lm)
 //! constructor
 FERigidSlidingContact::FERigidSlidingContact(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	m_rigid = 0;
@@ -44,6 +44,9 @@ FERigidSolver::FERigidSolver(FEModel* fem) : m_fem(fem)
 	m_dofX = m_dofY = m_dofZ = -1;
 
 	m_bAllowMixedBCs = false;
+
+	m_mapAlpha = 1.0;
+	m_bmapsValid = false;
 }
 
 int FERigidSolver::InitEquations(int neq)
@@ -118,6 +121,7 @@ int FERigidSolver::InitEquations(int neq)
 //! Serialization
 void FERigidSolver::Serialize(DumpStream& ar)
 {
+	InvalidateRigidNodeMaps();
 	if (ar.IsShallow()) return;
 
 	if (ar.IsSaving())
@@ -144,6 +148,8 @@ void FERigidSolver::Serialize(DumpStream& ar)
 // \todo: eliminate need for ui parameter
 void FERigidSolver::PrepStep(const FETimeInfo& timeInfo, vector<double>& ui)
 {
+	InvalidateRigidNodeMaps();
+
 	FERigidSystem& rigid = *m_fem->GetRigidSystem();
 	int NO = rigid.Objects();
 	for (int i = 0; i<NO; ++i) rigid.Object(i)->Init();
@@ -299,543 +305,282 @@ void FERigidSolver::PrepStep(const FETimeInfo& timeInfo, vector<double>& ui)
 }
 
 //-----------------------------------------------------------------------------
-//! This function calculates the rigid stiffness matrices
-void FERigidSolver::RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha)
+//! Calculate the kinematic maps of all rigid interface nodes. These map the
+//! nodal displacement (and shell director) dofs onto the rigid body dofs.
+//! They only depend on the current configuration, so they are evaluated once
+//! per iteration instead of for each element that is assembled.
+void FERigidSolver::UpdateRigidNodeMaps(double alpha)
 {
-    int n = (int)en.size();
-    FEMesh& mesh = m_fem->GetMesh();
-    
-    bool bclamped_shell = false;
-    for (int j = 0; j<n; ++j) {
-        if (mesh.Node(en[j]).HasFlags(FENode::SHELL) && mesh.Node(en[j]).HasFlags(FENode::RIGID_CLAMP)) {
-            bclamped_shell = true;
-            break;
-        }
-    }
-    if (bclamped_shell)
-        RigidStiffnessShell(K, ui, F, en, elm, ke, alpha);
-    else
-        RigidStiffnessSolid(K, ui, F, en, elm, ke, alpha);
-    return;
+	FEMesh& mesh = m_fem->GetMesh();
+	FERigidSystem& rigid = *m_fem->GetRigidSystem();
+
+	int NN = mesh.Nodes();
+	m_rnode.assign(NN, -1);
+	m_rmap.clear();
+	for (int i=0; i<NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		if (node.m_rid >= 0)
+		{
+			FERigidBody& RB = *rigid.Object(node.m_rid);
+
+			RIGID_NODE rn;
+			rn.nrb = node.m_rid;
+
+			// relative distance to the center of mass
+			vec3d a = node.m_rt - RB.m_rt;
+
+			// same, but using the alpha rule
+			vec3d aa = (node.m_rt - RB.m_rt)*alpha + (node.m_rp - RB.m_rp)*(1 - alpha);
+
+			rn.Z[0].skew(a);
+			rn.Za[0].skew(aa);
+
+			// the shell director
+			if (node.HasFlags(FENode::SHELL))
+			{
+				vec3d d = node.m_d0 + node.get_vec3d(m_dofX, m_dofY, m_dofZ) - node.get_vec3d(m_dofSX, m_dofSY, m_dofSZ);
+				rn.Z[1].skew(a - d);
+				rn.Za[1].skew(aa - d);
+			}
+			else
+			{
+				rn.Z[1] = rn.Z[0];
+				rn.Za[1] = rn.Za[0];
+			}
+
+			m_rnode[i] = (int) m_rmap.size();
+			m_rmap.push_back(rn);
+		}
+	}
+
+	m_mapAlpha = alpha;
+	m_bmapsValid = true;
 }
 
 //-----------------------------------------------------------------------------
-//! This function calculates the rigid stiffness matrices
-//! correct stiffness matrix for rigid-solid interfaces
-void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha)
+//! This function condenses the element stiffness matrix onto the rigid body dofs
+//! of the rigid interface nodes of the element.
+//! For each rigid interface node, the translational dofs (and for clamped shells 
+//! also the shell displacement dofs) are coupled to the rigid body via u = r - Z*q,
+//! where Z is the skew matrix of the node's offset to the center of mass.
+//! The contributions of all nodes that are attached to the same rigid body are
+//! first summed up and then added to the global matrix in one pass.
+void FERigidSolver::RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha)
 {
-    FERigidSystem& rigid = *m_fem->GetRigidSystem();
-    if (rigid.Objects() == 0) return;
-    
-    int i, j, k, l, n = (int)en.size();
-    
-    // get nodal DOFS
-    DOFS& fedofs = m_fem->GetDOFS();
-    int MAX_NDOFS = fedofs.GetTotalDOFS();
+	FERigidSystem& rigid = *m_fem->GetRigidSystem();
+	if (rigid.Objects() == 0) return;
+
+	if ((m_bmapsValid == false) || (m_mapAlpha != alpha)) UpdateRigidNodeMaps(alpha);
+
+	FEMesh& mesh = m_fem->GetMesh();
+	int n = (int)en.size();
+
+	// find the rigid bodies this element is attached to
+	m_slot.resize(n);
+	m_rb.clear();
+	bool bclamped_shell = false;
+	for (int i=0; i<n; ++i)
+	{
+		m_slot[i] = -1;
+		int m = m_rnode[en[i]];
+		if (m >= 0)
+		{
+			int nrb = m_rmap[m].nrb;
+			int a = 0;
+			for (; a<(int)m_rb.size(); ++a) if (m_rb[a] == nrb) break;
+			if (a == (int)m_rb.size()) m_rb.push_back(nrb);
+			m_slot[i] = a;
+		}
 
+		FENode& node = mesh.Node(en[i]);
+		if (node.HasFlags(FENode::SHELL) && node.HasFlags(FENode::RIGID_CLAMP)) bclamped_shell = true;
+	}
+	int nb = (int)m_rb.size();
+	if (nb == 0) return;
+
+	// nr of dofs per node
 	int ndof = ke.columns() / n;
-    
-    matrix kij(ndof, ndof);
-    matrix KF(ndof, 6);
+	int N = ndof*n;
+
+	// nr of nodal dofs coupled to the rigid body (in groups of three)
+	int ntr = (bclamped_shell ? 2 : 1);
+	int nc = 3*ntr;
+
+	// condensed matrices for each (pair of) rigid bodie(s)
+	// Krr: rigid - rigid, Kfr: element dof - rigid, Krf: rigid - element dof
+	m_Krr.assign(nb*nb*36, 0.0);
+	m_Kfr.assign(nb*N*6, 0.0);
+	m_Krf.assign(nb*N*6, 0.0);
+	m_bfr.assign(nb*N, 0);
+	m_brf.assign(nb*N, 0);
+
+	double X[6][6];
+	for (int j=0; j<n; ++j)
+	{
+		int b = m_slot[j];
+		if (b >= 0)
+		{
+			const RIGID_NODE& rj = m_rmap[m_rnode[en[j]]];
 
-    double KR[6][6];
-    
-    int *lmi, *lmj;
-    int I, J;
-    
-    vec3d zi, zj;
-    mat3d Zi, Zj;
-    
-   
-    FEMesh& mesh = m_fem->GetMesh();
-    
-    // loop over columns
-    for (j = 0; j<n; ++j)
-    {
-        FENode& nodej = mesh.Node(en[j]);
-        if (nodej.m_rid >= 0)
-        {
-            // this is a rigid interface node
-            // get the rigid body this node is attached to
-            FERigidBody& RBj = *rigid.Object(nodej.m_rid);
-            
-            // get the rigid body equation nrs.
-            lmj = RBj.m_LM;
-            
-            // get the relative distance to the center of mass
-            zj = nodej.m_rt - RBj.m_rt;
-            Zj.skew(zj);
-            
-            // loop over rows
-            for (i = 0; i<n; ++i)
-            {
-                // get the element sub-matrix
-                for (k = 0; k<ndof; ++k)
-                    for (l = 0; l<ndof; ++l)
-                        kij[k][l] = ke[ndof*i + k][ndof*j + l];
-                
-                mat3d Kuu(kij[0][0], kij[0][1], kij[0][2],
-                          kij[1][0], kij[1][1], kij[1][2],
-                          kij[2][0], kij[2][1], kij[2][2]);
-                
-                FENode& nodei = mesh.Node(en[i]);
-                
-                if (nodei.m_rid >= 0)
-                {
-                    // node i is also a rigid body node
-                    // get the rigid body this node is attached to
-                    FERigidBody& RBi = *rigid.Object(nodei.m_rid);
-                    
-                    lmi = RBi.m_LM;
-                    
-                    // get the relative distance (use alpha rule)
-                    zi = (nodei.m_rt - RBi.m_rt)*alpha + (nodei.m_rp - RBi.m_rp)*(1 - alpha);
-                    Zi.skew(zi);
-                    
-                    mat3d M;
-                    
-                    // Kuu transformation to Krr
-                    M = Kuu*alpha;
-                    KR[0][0] = M[0][0]; KR[0][1] = M[0][1]; KR[0][2] = M[0][2];
-                    KR[1][0] = M[1][0]; KR[1][1] = M[1][1]; KR[1][2] = M[1][2];
-                    KR[2][0] = M[2][0]; KR[2][1] = M[2][1]; KR[2][2] = M[2][2];
-                    
-                    
-                    // Kuu transformation to Krq
-                    M = Kuu*Zj*(-alpha);
-                    KR[0][3] = M[0][0]; KR[0][4] = M[0][1]; KR[0][5] = M[0][2];
-                    KR[1][3] = M[1][0]; KR[1][4] = M[1][1]; KR[1][5] = M[1][2];
-                    KR[2][3] = M[2][0]; KR[2][4] = M[2][1]; KR[2][5] = M[2][2];
-
-                    
-                    // Kuu transformation to Kqr
-                    M = Zi*Kuu*alpha;
-                    KR[3][0] = M[0][0]; KR[3][1] = M[0][1]; KR[3][2] = M[0][2];
-                    KR[4][0] = M[1][0]; KR[4][1] = M[1][1]; KR[4][2] = M[1][2];
-                    KR[5][0] = M[2][0]; KR[5][1] = M[2][1]; KR[5][2] = M[2][2];
-
-                    
-                    // Kuu transformation to Kqq
-                    M = Zi*Kuu*Zj*(-alpha);
-                    KR[3][3] = M[0][0]; KR[3][4] = M[0][1]; KR[3][5] = M[0][2];
-                    KR[4][3] = M[1][0]; KR[4][4] = M[1][1]; KR[4][5] = M[1][2];
-                    KR[5][3] = M[2][0]; KR[5][4] = M[2][1]; KR[5][5] = M[2][2];
-                    
-                    // add the stiffness components to the Krr matrix
-                    for (k = 0; k<6; ++k)
-                        for (l = 0; l<6; ++l)
-                        {
-                            J = lmj[k];
-                            I = lmi[l];
-                            
-                            if (I >= 0)
-                            {
-                                // multiply KR by alpha for alpha rule
-                                if (J < -1) F[I] -= KR[l][k]*ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KR[l][k]);
-                            }
-                        }
-                    
-                    // we still need to couple the non-rigid degrees of node i to the
-                    // rigid dofs of node j
-                    for (k = 3; k<ndof; ++k) {
-                        vec3d kpu(kij[k][0], kij[k][1], kij[k][2]);
-                        vec3d m = kpu*alpha;
-                        KF[k][0] = m.x; KF[k][1] = m.y; KF[k][2] = m.z;
-                        m = Zj*kpu*alpha;
-                        KF[k][3] = m.x; KF[k][4] = m.y; KF[k][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 3; l<ndof; ++l)
-                        {
-                            J = lmj[k];
-                            I = elm[ndof*i + l];
-                            
-                            if (I >= 0)
-                            {
-                                // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                    
-                    // now the transpose location
-                    for (l = 3; l<ndof; ++l) {
-                        vec3d kup(kij[0][l], kij[1][l], kij[2][l]);
-                        vec3d m = Zi*kup;
-                        KF[l][0] = kup.x; KF[l][1] = kup.y; KF[l][2] = kup.z;
-                        KF[l][3] = m.x; KF[l][4] = m.y; KF[l][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 3; l<ndof; ++l)
-                        {
-                            J = elm[ndof*j + l];
-                            I = lmi[k];
-                            
-                            if (I >= 0)
-                            {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                    
-                }
-                else
-                {
-                    // node i is not a rigid body node
-                    // add the stiffness components to the Kfr matrix
-                    
-                    // Kij
-                    for (k = 0; k<ndof; ++k) {
-                        vec3d kpu(kij[k][0], kij[k][1], kij[k][2]);
-                        vec3d m = kpu*alpha;
-                        KF[k][0] = m.x; KF[k][1] = m.y; KF[k][2] = m.z;
-                        m = Zj*kpu*alpha;
-                        KF[k][3] = m.x; KF[k][4] = m.y; KF[k][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 0; l<ndof; ++l)
-                        {
-                            J = lmj[k];
-                            I = elm[ndof*i + l];
-                            
-                            if (I >= 0)
-                            {
-                                // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                }
-            }
-        }
-        else
-        {
-            // loop over rows
-            for (i = 0; i<n; ++i)
-            {
-                FENode& nodei = mesh.Node(en[i]);
-                if (nodei.m_rid >= 0)
-                {
-                    // node i is a rigid body
-                    // get the rigid body this node is attached to
-                    FERigidBody& RBi = *rigid.Object(nodei.m_rid);
-                    
-                    // get the rigid body equation nrs.
-                    lmi = RBi.m_LM;
-                    
-                    // get the relative distance (use alpha rule)
-                    zi = (nodei.m_rt - RBi.m_rt)*alpha + (nodei.m_rp - RBi.m_rp)*(1 - alpha);
-                    Zi.skew(zi);
-                    
-                    // get the element sub-matrix
-                    for (k = 0; k<ndof; ++k)
-                        for (l = 0; l<ndof; ++l)
-                            kij[k][l] = ke[ndof*i + k][ndof*j + l];
-                    
-                    // add the stiffness components to the Krf matrix
-                    
-                    // Kij
-                    for (k = 0; k<ndof; ++k) {
-                        vec3d kup(kij[0][k], kij[1][k], kij[2][k]);
-                        vec3d m = Zi*kup;
-                        KF[k][0] = kup.x; KF[k][1] = kup.y; KF[k][2] = kup.z;
-                        KF[k][3] = m.x; KF[k][4] = m.y; KF[k][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 0; l<ndof; ++l)
-                        {
-                            I = lmi[k];
-                            J = elm[ndof*j + l];
-                            
-                            if (I >= 0)
-                            {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                }
-            }
-        }
-    }
+			for (int i=0; i<n; ++i)
+			{
+				int a = m_slot[i];
+
+				// element rows of node i that are mapped onto the rigid dofs of node j
+				int k0 = (a >= 0 ? nc : 0);
+				for (int k=k0; k<ndof; ++k)
+				{
+					int r = ndof*i + k;
+					double* kf = &m_Kfr[(b*N + r)*6];
+					CondenseRow(ke[r] + ndof*j, ntr, rj.Z, alpha, kf);
+					m_bfr[b*N + r] = 1;
+				}
+
+				if (a >= 0)
+				{
+					const RIGID_NODE& ri = m_rmap[m_rnode[en[i]]];
+
+					// rigid-rigid coupling: Za^T*Kij*Z
+					for (int k=0; k<nc; ++k)
+					{
+						for (int l=0; l<6; ++l) X[k][l] = 0.0;
+						CondenseRow(ke[ndof*i + k] + ndof*j, ntr, rj.Z, alpha, X[k]);
+					}
+
+					double* kr = &m_Krr[(a*nb + b)*36];
+					for (int l=0; l<6; ++l)
+					{
+						for (int t=0; t<ntr; ++t)
+						{
+							vec3d x(X[3*t][l], X[3*t+1][l], X[3*t+2][l]);
+							vec3d m = ri.Za[t]*x;
+							kr[     l] += x.x; kr[ 6 + l] += x.y; kr[12 + l] += x.z;
+							kr[18 + l] += m.x; kr[24 + l] += m.y; kr[30 + l] += m.z;
+						}
+					}
+
+					// the rigid dofs of node i to the non-rigid dofs of node j
+					for (int l=nc; l<ndof; ++l)
+					{
+						int c = ndof*j + l;
+						CondenseColumn(ke, ndof*i, c, ntr, ri.Za, &m_Krf[(a*N + c)*6]);
+						m_brf[a*N + c] = 1;
+					}
+				}
+			}
+		}
+		else
+		{
+			for (int i=0; i<n; ++i)
+			{
+				int a = m_slot[i];
+				if (a >= 0)
+				{
+					const RIGID_NODE& ri = m_rmap[m_rnode[en[i]]];
+					for (int l=0; l<ndof; ++l)
+					{
+						int c = ndof*j + l;
+						CondenseColumn(ke, ndof*i, c, ntr, ri.Za, &m_Krf[(a*N + c)*6]);
+						m_brf[a*N + c] = 1;
+					}
+				}
+			}
+		}
+	}
+
+	// assemble the condensed matrices
+	for (int a=0; a<nb; ++a)
+	{
+		int* lmi = rigid.Object(m_rb[a])->m_LM;
+		for (int b=0; b<nb; ++b)
+		{
+			int* lmj = rigid.Object(m_rb[b])->m_LM;
+			const double* kr = &m_Krr[(a*nb + b)*36];
+			for (int l=0; l<6; ++l)
+			{
+				int I = lmi[l];
+				if (I >= 0)
+				{
+					for (int k=0; k<6; ++k)
+					{
+						int J = lmj[k];
+						if (J < -1) F[I] -= kr[l*6 + k]*ui[-J - 2];
+						else if (J >= 0) K.add(I, J, kr[l*6 + k]);
+					}
+				}
+			}
+		}
+	}
+
+	for (int b=0; b<nb; ++b)
+	{
+		int* lmj = rigid.Object(m_rb[b])->m_LM;
+		for (int r=0; r<N; ++r)
+		{
+			int I = elm[r];
+			if ((I >= 0) && m_bfr[b*N + r])
+			{
+				const double* kf = &m_Kfr[(b*N + r)*6];
+				for (int k=0; k<6; ++k)
+				{
+					int J = lmj[k];
+					if (J < -1) F[I] -= kf[k]*ui[-J - 2];
+					else if (J >= 0) K.add(I, J, kf[k]);
+				}
+			}
+		}
+	}
+
+	for (int a=0; a<nb; ++a)
+	{
+		int* lmi = rigid.Object(m_rb[a])->m_LM;
+		for (int c=0; c<N; ++c)
+		{
+			int J = elm[c];
+			if (m_brf[a*N + c] && (J != -1))
+			{
+				const double* kf = &m_Krf[(a*N + c)*6];
+				for (int k=0; k<6; ++k)
+				{
+					int I = lmi[k];
+					if (I >= 0)
+					{
+						if (J < -1) F[I] -= kf[k]*ui[-J - 2];
+						else if (J >= 0) K.add(I, J, kf[k]);
+					}
+				}
+			}
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
-//! This function calculates the rigid stiffness matrices
-//! correct stiffness matrix for rigid bodies accounting for rigid-body-deformable-shell interfaces
-void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha)
+//! Multiply the row segment k of the element matrix (i.e. the columns of a rigid
+//! interface node) with the node's kinematic map and add it to kr (scaled by s).
+void FERigidSolver::CondenseRow(const double* k, int ntr, const mat3d* Z, double s, double* kr)
 {
-    FERigidSystem& rigid = *m_fem->GetRigidSystem();
-    if (rigid.Objects() == 0) return;
-    
-    int i, j, k, l, n = (int)en.size();
-    
-    // get nodal DOFS
-    DOFS& fedofs = m_fem->GetDOFS();
-    int MAX_NDOFS = fedofs.GetTotalDOFS();
-    
-    vector< vector<double> > kij; kij.assign(MAX_NDOFS, vector<double>(MAX_NDOFS));
-    
-    vector< vector<double> > KF; KF.assign(MAX_NDOFS, vector<double>(6));
-    double KR[6][6];
-    
-    int *lmi, *lmj;
-    int I, J;
-    
-    vec3d ai, aj, bi, bj;
-    mat3d Ai, Aj, Bi, Bj;
-    
-    int ndof = ke.columns() / n;
-    
-    FEMesh& mesh = m_fem->GetMesh();
-    
-    // loop over columns
-    for (j = 0; j<n; ++j)
-    {
-        FENode& nodej = mesh.Node(en[j]);
-        if (nodej.m_rid >= 0)
-        {
-            // this is a rigid interface node
-            // get the rigid body this node is attached to
-            FERigidBody& RBj = *rigid.Object(nodej.m_rid);
-            
-            // get the rigid body equation nrs.
-            lmj = RBj.m_LM;
-            
-            // get the relative distance to the center of mass
-            aj = nodej.m_rt - RBj.m_rt;
-            Aj.skew(aj);
-            
-            // get the shell director
-            bj = aj - (nodej.m_d0 + nodej.get_vec3d(m_dofX, m_dofY, m_dofZ) - nodej.get_vec3d(m_dofSX, m_dofSY, m_dofSZ));
-            Bj.skew(bj);
-            
-            // loop over rows
-            for (i = 0; i<n; ++i)
-            {
-                // get the element sub-matrix
-                for (k = 0; k<ndof; ++k)
-                    for (l = 0; l<ndof; ++l)
-                        kij[k][l] = ke[ndof*i + k][ndof*j + l];
-                
-                mat3d Kuu(kij[0][0], kij[0][1], kij[0][2],
-                          kij[1][0], kij[1][1], kij[1][2],
-                          kij[2][0], kij[2][1], kij[2][2]);
-                
-                mat3d Kuw(kij[0][3], kij[0][4], kij[0][5],
-                          kij[1][3], kij[1][4], kij[1][5],
-                          kij[2][3], kij[2][4], kij[2][5]);
-                
-                mat3d Kwu(kij[3][0], kij[3][1], kij[3][2],
-                          kij[4][0], kij[4][1], kij[4][2],
-                          kij[5][0], kij[5][1], kij[5][2]);
-                
-                mat3d Kww(kij[3][3], kij[3][4], kij[3][5],
-                          kij[4][3], kij[4][4], kij[4][5],
-                          kij[5][3], kij[5][4], kij[5][5]);
-                
-                FENode& nodei = mesh.Node(en[i]);
-                
-                if (nodei.m_rid >= 0)
-                {
-                    // node i is also a rigid body node
-                    // get the rigid body this node is attached to
-                    FERigidBody& RBi = *rigid.Object(nodei.m_rid);
-                    
-                    lmi = RBi.m_LM;
-                    
-                    // get the relative distance (use alpha rule)
-                    ai = (nodei.m_rt - RBi.m_rt)*alpha + (nodei.m_rp - RBi.m_rp)*(1 - alpha);
-                    Ai.skew(ai);
-                    
-                    // get the shell director
-                    bi = ai - (nodei.m_d0 + nodei.get_vec3d(m_dofX, m_dofY, m_dofZ) - nodei.get_vec3d(m_dofSX, m_dofSY, m_dofSZ));
-                    Bi.skew(bi);
-                    
-                    mat3d M;
-                    
-                    // Kuu transformation
-                    M = (Kuu + Kwu + Kuw + Kww)*alpha;
-                    KR[0][0] = M[0][0]; KR[0][1] = M[0][1]; KR[0][2] = M[0][2];
-                    KR[1][0] = M[1][0]; KR[1][1] = M[1][1]; KR[1][2] = M[1][2];
-                    KR[2][0] = M[2][0]; KR[2][1] = M[2][1]; KR[2][2] = M[2][2];
-                    
-                    
-                    // Kuw transformation
-                    M = ((Kuu + Kwu)*Aj + (Kuw + Kww)*Bj)*(-alpha);
-                    KR[0][3] = M[0][0]; KR[0][4] = M[0][1]; KR[0][5] = M[0][2];
-                    KR[1][3] = M[1][0]; KR[1][4] = M[1][1]; KR[1][5] = M[1][2];
-                    KR[2][3] = M[2][0]; KR[2][4] = M[2][1]; KR[2][5] = M[2][2];
-                    
-                    
-                    // Kwu transformation
-                    M = (Ai*(Kuu + Kuw) + Bi*(Kwu + Kww))*alpha;
-                    KR[3][0] = M[0][0]; KR[3][1] = M[0][1]; KR[3][2] = M[0][2];
-                    KR[4][0] = M[1][0]; KR[4][1] = M[1][1]; KR[4][2] = M[1][2];
-                    KR[5][0] = M[2][0]; KR[5][1] = M[2][1]; KR[5][2] = M[2][2];
-                    
-                    
-                    // Kww transformation
-                    M = ((Ai*Kuu + Bi*Kwu)*Aj + (Ai*Kuw + Bi*Kww)*Bj)*(-alpha);
-                    KR[3][3] = M[0][0]; KR[3][4] = M[0][1]; KR[3][5] = M[0][2];
-                    KR[4][3] = M[1][0]; KR[4][4] = M[1][1]; KR[4][5] = M[1][2];
-                    KR[5][3] = M[2][0]; KR[5][4] = M[2][1]; KR[5][5] = M[2][2];
-                    
-                    // add the stiffness components to the Krr matrix
-                    for (k = 0; k<6; ++k)
-                        for (l = 0; l<6; ++l)
-                        {
-                            J = lmj[k];
-                            I = lmi[l];
-                            
-                            if (I >= 0)
-                            {
-                                // multiply KR by alpha for alpha rule
-                                if (J < -1) F[I] -= KR[l][k]*ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KR[l][k]);
-                            }
-                        }
-                    
-                    // we still need to couple the non-rigid degrees of node i to the
-                    // rigid dofs of node j
-                    for (k = 6; k<ndof; ++k) {
-                        vec3d kpu(kij[k][0], kij[k][1], kij[k][2]);
-                        vec3d kpw(kij[k][3], kij[k][4], kij[k][5]);
-                        vec3d m = (kpu + kpw)*alpha;
-                        KF[k][0] = m.x; KF[k][1] = m.y; KF[k][2] = m.z;
-                        m = (Aj*kpu + Bj*kpw)*alpha;
-                        KF[k][3] = m.x; KF[k][4] = m.y; KF[k][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 6; l<ndof; ++l)
-                        {
-                            J = lmj[k];
-                            I = elm[ndof*i + l];
-                            
-                            if (I >= 0)
-                            {
-                                // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                    
-                    // now the transpose location
-                    for (l = 6; l<ndof; ++l) {
-                        vec3d kup(kij[0][l], kij[1][l], kij[2][l]);
-                        vec3d kwp(kij[3][l], kij[4][l], kij[5][l]);
-                        vec3d m = kup + kwp;
-                        KF[l][0] = m.x; KF[l][1] = m.y; KF[l][2] = m.z;
-                        m = Ai*kup + Bi*kwp;
-                        KF[l][3] = m.x; KF[l][4] = m.y; KF[l][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 6; l<ndof; ++l)
-                        {
-                            J = elm[ndof*j + l];
-                            I = lmi[k];
-                            
-                            if (I >= 0)
-                            {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                    
-                }
-                else
-                {
-                    // node i is not a rigid body node
-                    // add the stiffness components to the Kfr matrix
-                    
-                    // Kij
-                    for (k = 0; k<ndof; ++k) {
-                        vec3d kpu(kij[k][0], kij[k][1], kij[k][2]);
-                        vec3d kpw(kij[k][3], kij[k][4], kij[k][5]);
-                        vec3d m = (kpu + kpw)*alpha;
-                        KF[k][0] = m.x; KF[k][1] = m.y; KF[k][2] = m.z;
-                        m = (Aj*kpu + Bj*kpw)*alpha;
-                        KF[k][3] = m.x; KF[k][4] = m.y; KF[k][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 0; l<ndof; ++l)
-                        {
-                            J = lmj[k];
-                            I = elm[ndof*i + l];
-                            
-                            if (I >= 0)
-                            {
-                                // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                }
-            }
-        }
-        else
-        {
-            // loop over rows
-            for (i = 0; i<n; ++i)
-            {
-                FENode& nodei = mesh.Node(en[i]);
-                if (nodei.m_rid >= 0)
-                {
-                    // node i is a rigid body
-                    // get the rigid body this node is attached to
-                    FERigidBody& RBi = *rigid.Object(nodei.m_rid);
-                    
-                    // get the rigid body equation nrs.
-                    lmi = RBi.m_LM;
-                    
-                    // get the relative distance (use alpha rule)
-                    ai = (nodei.m_rt - RBi.m_rt)*alpha + (nodei.m_rp - RBi.m_rp)*(1 - alpha);
-                    Ai.skew(ai);
-                    
-                    // get the shell director
-                    bi = ai - (nodei.m_d0 + nodei.get_vec3d(m_dofX, m_dofY, m_dofZ) - nodei.get_vec3d(m_dofSX, m_dofSY, m_dofSZ));
-                    Bi.skew(bi);
-                    
-                    // get the element sub-matrix
-                    for (k = 0; k<ndof; ++k)
-                        for (l = 0; l<ndof; ++l)
-                            kij[k][l] = ke[ndof*i + k][ndof*j + l];
-                    
-                    // add the stiffness components to the Krf matrix
-                    
-                    // Kij
-                    for (k = 0; k<ndof; ++k) {
-                        vec3d kup(kij[0][k], kij[1][k], kij[2][k]);
-                        vec3d kwp(kij[3][k], kij[4][k], kij[5][k]);
-                        vec3d m = kup + kwp;
-                        KF[k][0] = m.x; KF[k][1] = m.y; KF[k][2] = m.z;
-                        m = Ai*kup + Bi*kwp;
-                        KF[k][3] = m.x; KF[k][4] = m.y; KF[k][5] = m.z;
-                    }
-                    
-                    for (k = 0; k<6; ++k)
-                        for (l = 0; l<ndof; ++l)
-                        {
-                            I = lmi[k];
-                            J = elm[ndof*j + l];
-                            
-                            if (I >= 0)
-                            {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
-                            }
-                        }
-                }
-            }
-        }
-    }
+	for (int t=0; t<ntr; ++t)
+	{
+		vec3d kt(k[3*t], k[3*t+1], k[3*t+2]);
+		vec3d m = Z[t]*kt;
+		kr[0] += kt.x*s; kr[1] += kt.y*s; kr[2] += kt.z*s;
+		kr[3] += m.x*s; kr[4] += m.y*s; kr[5] += m.z*s;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Multiply column c of the element matrix, starting at row r0 (i.e. the rows of a rigid
+//! interface node) with the transpose of the node's kinematic map and add it to kr.
+void FERigidSolver::CondenseColumn(matrix& ke, int r0, int c, int ntr, const mat3d* Z, double* kr)
+{
+	for (int t=0; t<ntr; ++t)
+	{
+		vec3d kt(ke[r0 + 3*t][c], ke[r0 + 3*t + 1][c], ke[r0 + 3*t + 2][c]);
+		vec3d m = Z[t]*kt;
+		kr[0] += kt.x; kr[1] += kt.y; kr[2] += kt.z;
+		kr[3] += m.x; kr[4] += m.y; kr[5] += m.z;
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -906,6 +651,9 @@ void FERigidSolver::AssembleResidual(int node_id, int dof, double f, vector<doub
 //-----------------------------------------------------------------------------
 void FERigidSolver::Residual()
 {
+	// the nodes have moved
+	InvalidateRigidNodeMaps();
+
 	FERigidSystem& rigid = *m_fem->GetRigidSystem();
 	int NRB = rigid.Objects();
 	for (int i = 0; i<NRB; ++i)
@@ -1089,6 +837,8 @@ void FERigidSolverOld::UpdateRigidKinematics()
 //! Updates the rigid body data
 void FERigidSolverOld::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui, bool bnewUpdate)
 {
+	InvalidateRigidNodeMaps();
+
 	// get the number of rigid bodies
 	FERigidSystem& rigid = *m_fem->GetRigidSystem();
 	const int NRB = rigid.Objects();
@@ -1244,6 +994,8 @@ void FERigidSolverNew::UpdateIncrements(vector<double>& Ui, vector<double>& ui,
 //! Updates the rigid body data
 void FERigidSolverNew::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui)
 {
+	InvalidateRigidNodeMaps();
+
 	// update rigid bodies
 	FERigidSystem& rigid = *m_fem->GetRigidSystem();
 	int nrb = rigid.Objects();
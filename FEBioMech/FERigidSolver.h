@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "FEBodyForce.h"
 #include <FECore/FETimeInfo.h>
 #include <FECore/FESolver.h>
+#include <FECore/mat3d.h>
 #include <vector>
 using namespace std;
 
@@ -60,15 +61,9 @@ public:
 	// This is called at the start of each time step
 	void PrepStep(const FETimeInfo& timeInfo, vector<double>& ui);
 
-	// correct stiffness matrix for rigid bodies
+	// correct stiffness matrix for rigid bodies (including rigid-body-deformable-shell interfaces)
 	void RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha);
 
-    // correct stiffness matrix for rigid bodies accounting for rigid-body-deformable-shell interfaces
-    void RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha);
-    
-    // correct stiffness matrix for rigid bodies accounting for rigid-body-deformable-shell interfaces
-    void RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vector<double>& F, vector<int>& en, vector<int>& elm, matrix& ke, double alpha);
-    
 	// adjust residual for rigid-deformable interface nodes
 	void AssembleResidual(int node_id, int dof, double f, vector<double>& R);
     
@@ -88,6 +83,35 @@ public:
 public:
 	void AllowMixedBCs(bool b) { m_bAllowMixedBCs = b; }
 
+protected:
+	// evaluate the kinematic maps of the rigid interface nodes
+	void UpdateRigidNodeMaps(double alpha);
+
+	// the maps need to be reevaluated when the configuration changes
+	void InvalidateRigidNodeMaps() { m_bmapsValid = false; }
+
+	static void CondenseRow(const double* k, int ntr, const mat3d* Z, double s, double* kr);
+	static void CondenseColumn(matrix& ke, int r0, int c, int ntr, const mat3d* Z, double* kr);
+
+protected:
+	// kinematic map of a rigid interface node
+	struct RIGID_NODE
+	{
+		int		nrb;	// rigid body the node is attached to
+		mat3d	Z[2];	// skew matrices of offset to center of mass (nodal and shell displacement)
+		mat3d	Za[2];	// same, but evaluated with the alpha rule
+	};
+
+	vector<int>			m_rnode;		// index into m_rmap for each mesh node (or -1)
+	vector<RIGID_NODE>	m_rmap;			// kinematic maps of the rigid interface nodes
+	double				m_mapAlpha;		// alpha used for evaluating the maps
+	bool				m_bmapsValid;	// maps are up to date
+
+	// scratch data for RigidStiffness
+	vector<int>		m_slot, m_rb;
+	vector<double>	m_Krr, m_Kfr, m_Krf;
+	vector<char>	m_bfr, m_brf;
+
 protected:
 	FEModel*	m_fem;
 	int			m_dofX, m_dofY, m_dofZ;
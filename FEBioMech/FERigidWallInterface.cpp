@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/FEGlobalMatrix.h"
 #include "FECore/log.h"
 #include <FEBioMech/FEElasticShellDomainOld.h>
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -223,7 +224,7 @@ void FERigidWallSurface::UnpackLM(FEElement& el, vector<int>& lm)
 //! constructor
 FERigidWallInterface::FERigidWallInterface(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_plane(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	m_eps = 0;
@@ -30,6 +30,9 @@ SOFTWARE.*/
 #include "FECore/FESolidDomain.h"
 #include "FECore/FEMesh.h"
 #include "FEElasticMaterial.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 using namespace std;
 
 //-------------------------------------------------------------------------------------------------
@@ -41,20 +44,26 @@ FESPRProjection::FESPRProjection()
 //-------------------------------------------------------------------------------------------------
 void FESPRProjection::SetInterpolationOrder(int p)
 {
+	if (p != m_p) m_patches.clear();
 	m_p = p;
 }
 
 //-------------------------------------------------------------------------------------------------
-//! Projects the integration point data, stored in d, onto the nodes of the domain.
-//! The result is stored in o.
-void FESPRProjection::Project(FESolidDomain& dom, const vector< vector<double> >& d, vector<double>& o)
+// evaluate the polynomial basis at r
+static void spr_basis(const vec3d& r, int ndof, double* pk)
+{
+	pk[0] = 1.0; pk[1] = r.x; pk[2] = r.y; pk[3] = r.z;
+	if (ndof >=  7) { pk[4] = r.x*r.y; pk[5] = r.y*r.z; pk[6] = r.x*r.z; }
+	if (ndof >= 10) { pk[7] = r.x*r.x; pk[8] = r.y*r.y; pk[9] = r.z*r.z; }
+}
+
+//-------------------------------------------------------------------------------------------------
+FESPRProjection::PATCHES* FESPRProjection::GetPatches(FESolidDomain& dom)
 {
 	// get the mesh
 	FEMesh& mesh = *dom.GetMesh();
 	int NN = dom.Nodes();
-
-	// allocate output array
-	o.assign(NN, 0.0);
+	int NE = dom.Elements();
 
 	// check element type
 	int NDOF = -1;	// number of degrees of freedom of polynomial
@@ -75,158 +84,260 @@ void FESPRProjection::Project(FESolidDomain& dom, const vector< vector<double> >
 	case ET_HEX20 : { NDOF = (m_p == 1 ? 7 : 10); NCN = 8; } break;
 	case ET_HEX27 : { NDOF = (m_p == 1 ? 7 : 10); NCN = 8; } break;
 	default:
-		return;
+		return 0;
 	}
 
-	// we keep a tag array to keep track of which nodes we processed
-	int NM = mesh.Nodes();
-	vector<int> tag; tag.assign(NM, 0);
+	PATCHES& P = m_patches[&dom];
 
-	// for higher order elements
-	// we need to make sure that we don't process the edge nodes
-	// we assume here that the first NCN nodes of the element
-	// are the corner nodes and that all other nodes are edge or interior nodes
-	int NE = dom.Elements();
-	for (int i=0; i<NE; ++i)
+	// (re)build the patches if the mesh changed
+	if ((P.nelems != NE) || (P.ndof != NDOF) || ((int)P.rt.size() != NN))
 	{
-		FESolidElement& el = dom.Element(i);
-		int ne = el.Nodes();
-		for (int j=NCN; j<ne; ++j) tag[el.m_node[j]] = 2;
+		P.nelems = NE;
+		P.ndof = NDOF;
+
+		// we keep a tag array to keep track of which nodes we processed
+		int NM = mesh.Nodes();
+		P.tag.assign(NM, 0);
+
+		// for higher order elements
+		// we need to make sure that we don't process the edge nodes
+		// we assume here that the first NCN nodes of the element
+		// are the corner nodes and that all other nodes are edge or interior nodes
+		for (int i=0; i<NE; ++i)
+		{
+			FESolidElement& el = dom.Element(i);
+			int ne = el.Nodes();
+			for (int j=NCN; j<ne; ++j) P.tag[el.m_node[j]] = 2;
+		}
+
+		// build the node-element-list. This will define our patches
+		P.NEL.Create(dom);
+
+		P.Ai.assign(NN, matrix());
+		P.ok.assign(NN, 0);
+
+		// this forces the matrices to be calculated
+		P.rt.clear();
 	}
 
-	// this array will store the results
-	vector<double> val;
-	val.assign(NM, 0.0);
+	// see if the nodes moved since the matrices were calculated
+	bool bupdate = ((int)P.rt.size() != NN);
+	for (int i=0; (bupdate == false) && (i<NN); ++i)
+	{
+		const vec3d& r = dom.Node(i).m_rt;
+		if ((r.x != P.rt[i].x) || (r.y != P.rt[i].y) || (r.z != P.rt[i].z)) bupdate = true;
+	}
+	if (bupdate == false) return &P;
 
-	// build the node-element-list. This will define our patches
-	FENodeElemList NEL;
-	NEL.Create(dom);
+	P.rt.resize(NN);
+	for (int i=0; i<NN; ++i) P.rt[i] = dom.Node(i).m_rt;
 
-	// loop over all nodes
+	// calculate the inverse patch matrices
+#pragma omp parallel for schedule(dynamic, 64)
 	for (int i=0; i<NN; ++i)
 	{
-		// get the node
-		FENode& node = dom.Node(i);
+		P.ok[i] = 0;
 		int in = dom.NodeIndex(i);
 
 		// don't loop over edge nodes (edge or interior nodes have a tag > 1)
-		if (tag[in] <= 1)
+		if (P.tag[in] > 1) continue;
+
+		// get the nodal position
+		vec3d rc = P.rt[i];
+
+		// get the element patch
+		int ne = P.NEL.Valence(in);
+		FEElement** ppe = P.NEL.ElementList(in);
+
+		// setup the A-matrix
+		double pk[10];
+		matrix A(NDOF,NDOF); A.zero();
+		int m = 0;
+		for (int j=0; j<ne; ++j)
+		{
+			FEElement& el = *(ppe[j]);
+
+			int nint = el.GaussPoints();
+			for (int n=0; n<nint; ++n, ++m)
+			{
+				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(n)->ExtractData<FEElasticMaterialPoint>();
+				spr_basis(ep.m_rt - rc, NDOF, pk);
+				for (int k=0; k<NDOF; ++k)
+					for (int l=0; l<NDOF; ++l) A[k][l] += pk[k]*pk[l];
+			}
+		}
+
+		// make sure we have enough sampling points
+		if (m > NDOF + 1)
+		{
+			// invert matrix
+			P.Ai[i] = A.inverse();
+			P.ok[i] = 1;
+		}
+	}
+
+	return &P;
+}
+
+//-------------------------------------------------------------------------------------------------
+//! Projects the integration point data, stored in d, onto the nodes of the domain.
+//! The result is stored in o.
+void FESPRProjection::Project(FESolidDomain& dom, const vector< vector<double> >& d, vector<double>& o)
+{
+	vector< vector<double> > v;
+	Project(dom, d, 1, v);
+	o = v[0];
+}
+
+//-------------------------------------------------------------------------------------------------
+//! Projects ncomp components of the integration point data at once.
+void FESPRProjection::Project(FESolidDomain& dom, const vector< vector<double> >& d, int ncomp, vector< vector<double> >& o)
+{
+	// get the mesh
+	FEMesh& mesh = *dom.GetMesh();
+	int NN = dom.Nodes();
+
+	// allocate output array
+	o.resize(ncomp);
+	for (int k=0; k<ncomp; ++k) o[k].assign(NN, 0.0);
+
+	// get the patches
+	PATCHES* pp = GetPatches(dom);
+	if (pp == 0) return;
+	PATCHES& P = *pp;
+	const int NDOF = P.ndof;
+
+	// Calculate the polynomial coefficients for all patches. 
+	// The coefficients of component k of patch i are stored at c[(i*ncomp + k)*NDOF]
+	vector<double> c(NN*ncomp*NDOF, 0.0);
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int i=0; i<NN; ++i)
+	{
+		if (P.ok[i] == 0) continue;
+
+		int in = dom.NodeIndex(i);
+		vec3d rc = P.rt[i];
+
+		// get the element patch
+		int ne = P.NEL.Valence(in);
+		FEElement** ppe = P.NEL.ElementList(in);
+		int* pei = P.NEL.ElementIndexList(in);
+
+		// setup the right-hand sides
+		double pk[10];
+		vector<double> b(ncomp*NDOF, 0.0);
+		for (int j=0; j<ne; ++j)
 		{
-			// get the nodal position
-			vec3d rc = node.m_rt;
-
-			// get the element patch
-			int ne = NEL.Valence(in);
-			FEElement** ppe = NEL.ElementList(in);
-			int* pei = NEL.ElementIndexList(in);
-
-			// setup the A-matrix
-			vector<double> pk(NDOF);
-			matrix A(NDOF,NDOF); A.zero();
-			int m = 0;
-			for (int j=0; j<ne; ++j)
+			FEElement& el = *(ppe[j]);
+			const vector<double>& ed = d[pei[j]];
+
+			assert(ppe[j] == &dom.Element(pei[j]));
+
+			int nint = el.GaussPoints();
+			for (int n=0; n<nint; ++n)
 			{
-				FEElement& el = *(ppe[j]);
+				FEElasticMaterialPoint& ep = *el.GetMaterialPoint(n)->ExtractData<FEElasticMaterialPoint>();
+				spr_basis(ep.m_rt - rc, NDOF, pk);
 
-				int nint = el.GaussPoints();
-				for (int n=0; n<nint; ++n, ++m)
+				for (int k=0; k<ncomp; ++k)
 				{
-					FEElasticMaterialPoint& ep = *el.GetMaterialPoint(n)->ExtractData<FEElasticMaterialPoint>();
-					vec3d r = ep.m_rt - rc;
-					pk[0] = 1.0; pk[1] = r.x; pk[2] = r.y; pk[3] = r.z;
-					if (NDOF >=  7) { pk[4] = r.x*r.y; pk[5] = r.y*r.z; pk[6] = r.x*r.z; }
-					if (NDOF >= 10) { pk[7] = r.x*r.x; pk[8] = r.y*r.y; pk[9] = r.z*r.z; }
-					A += outer_product(pk);
+					double s = ed[n*ncomp + k];
+					double* bk = &b[k*NDOF];
+					for (int l=0; l<NDOF; l++) bk[l] += s*pk[l];
 				}
 			}
+		}
 
-			// invert matrix and make sure condition number is good enough
-			matrix Ai = A.inverse();
-
-			// make sure we have enough sampling points
-			if (m > NDOF + 1)
+		// solve the linear systems
+		matrix& Ai = P.Ai[i];
+		for (int k=0; k<ncomp; ++k)
+		{
+			double* bk = &b[k*NDOF];
+			double* ck = &c[(i*ncomp + k)*NDOF];
+			for (int l=0; l<NDOF; ++l)
 			{
-				vector<double> b; b.assign(NDOF,0.0);
-				for (int j=0; j<ne; ++j)
-				{
-					FEElement& el = *(ppe[j]);
-					const vector<double>& ed = d[pei[j]];
+				double cl = 0.0;
+				for (int m=0; m<NDOF; ++m) cl += Ai[l][m]*bk[m];
+				ck[l] = cl;
+			}
+		}
+	}
 
-					assert(ppe[j] == &dom.Element(pei[j]));
+	// Now, evaluate the patch polynomials at the nodes. This is done in the same order 
+	// as the patches are processed, since patches can overwrite each other's values.
 
-					int nint = el.GaussPoints();
-					for (int n=0; n<nint; ++n)
-					{
-						FEElasticMaterialPoint& ep = *el.GetMaterialPoint(n)->ExtractData<FEElasticMaterialPoint>();
-						vec3d r = ep.m_rt - rc;
-						pk[0] = 1.0; pk[1] = r.x; pk[2] = r.y; pk[3] = r.z;
-						if (NDOF >=  7) { pk[4] = r.x*r.y; pk[5] = r.y*r.z; pk[6] = r.x*r.z; }
-						if (NDOF >= 10) { pk[7] = r.x*r.x; pk[8] = r.y*r.y; pk[9] = r.z*r.z; }
-
-						double s = ed[n];
-						for (int k=0; k<NDOF; k++) b[k] += s*pk[k];
-					}
-				}
+	// this array will store the results
+	int NM = mesh.Nodes();
+	vector<int> tag = P.tag;
+	vector<double> val(NM*ncomp, 0.0);
+	double pk[10];
+	for (int i=0; i<NN; ++i)
+	{
+		if (P.ok[i] == 0) continue;
 
-				// solve the linear system
-				vector<double> c = Ai*b;
+		int in = dom.NodeIndex(i);
+		vec3d rc = P.rt[i];
+		const double* ci = &c[i*ncomp*NDOF];
 
-				// tag this node as processed
-				tag[in] = 1;
+		// tag this node as processed
+		tag[in] = 1;
 
-				// store result
-				val[in] = c[0];
+		// store result
+		for (int k=0; k<ncomp; ++k) val[in*ncomp + k] = ci[k*NDOF];
 
-				// loop over all unprocessed nodes of this patch
-				for (int j=0; j<ne; ++j)
+		// loop over all unprocessed nodes of this patch
+		int ne = P.NEL.Valence(in);
+		FEElement** ppe = P.NEL.ElementList(in);
+		for (int j=0; j<ne; ++j)
+		{
+			FEElement& el = *(ppe[j]);
+			int en = el.Nodes();
+			for (int k=0; k<en; ++k)
+			{
+				int em = el.m_node[k];
+				if (tag[em] != 1)
 				{
-					FEElement& el = *(ppe[j]);
-					int en = el.Nodes();
-					for (int k=0; k<en; ++k)
+					spr_basis(mesh.Node(em).m_rt - rc, NDOF, pk);
+
+					// for edge nodes, we need to keep track of how often we visit this node
+					// Therefore we increment the tag.
+					// (remember that the tag started at 2 for edge/interior nodes)
+					if (tag[em] >= 2) tag[em]++;
+
+					for (int l=0; l<ncomp; ++l)
 					{
-						int em = el.m_node[k];
-						if (tag[em] != 1)
-						{
-							vec3d r = mesh.Node(em).m_rt - rc;
-							pk[0] = 1.0; pk[1] = r.x; pk[2] = r.y; pk[3] = r.z;
-							if (NDOF >=  7) { pk[4] = r.x*r.y; pk[5] = r.y*r.z; pk[6] = r.x*r.z; }
-							if (NDOF >= 10) { pk[7] = r.x*r.x; pk[8] = r.y*r.y; pk[9] = r.z*r.z; }
-
-							// calculate the value for this node
-							double v = 0;
-							for (int l=0; l<NDOF; ++l) v += pk[l]*c[l];
-
-							// for edge nodes, we need to keep track of how often we visit this node
-							// Therefore we increment the tag.
-							// (remember that the tag started at 2 for edge/interior nodes)
-							if (tag[em] >= 2)
-							{
-								tag[em]++;
-								val[em] += v;
-							}
-							else val[em] = v;
-						}
+						// calculate the value for this node
+						const double* cl = ci + l*NDOF;
+						double v = 0;
+						for (int m=0; m<NDOF; ++m) v += pk[m]*cl[m];
+
+						if (tag[em] >= 2) val[em*ncomp + l] += v;
+						else val[em*ncomp + l] = v;
 					}
 				}
 			}
 		}
 	}
 
-	// copy results to archive
+	// copy results
 	for (int i=0; i<NN; ++i)
 	{
 		int in = dom.NodeIndex(i);
-		double s = val[in];
 
 		// for edge nodes we need to average
 		// (remember that the tag started at 2 for edge/interior nodes)
+		int l = 0;
 		if (tag[in] >= 2)
 		{
 //			assert(tag[in] > 2);	// all edges nodes must be visited at least once!
-			int l = tag[in]-2;
+			l = tag[in]-2;
+		}
+
+		for (int k=0; k<ncomp; ++k)
+		{
+			double s = val[in*ncomp + k];
 			if (l > 0) s /= (double) (l);
+			o[k][i] = s;
 		}
-		
-		o[i] = s;
 	}
 }
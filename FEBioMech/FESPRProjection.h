@@ -26,22 +26,55 @@ SOFTWARE.*/
 
 
 #pragma once
+#include "FECore/matrix.h"
+#include "FECore/vec3d.h"
+#include "FECore/FENodeElemList.h"
 #include <vector>
+#include <map>
 
 class FESolidDomain;
 
 //-------------------------------------------------------------------------------------------------
 //! This class implements the super-convergent-patch recovery method which projects integration point
 //! data to the finite element nodes.
+//! The patches and the inverted patch matrices are stored for each domain, so that they can be
+//! reused for all the components that are projected and for later calls, as long as the
+//! mesh did not move.
 class FESPRProjection
 {
+	// patch data for a domain
+	struct PATCHES
+	{
+		PATCHES() : nelems(-1), ndof(-1) {}
+
+		int					nelems;	//!< number of elements of domain when data was created
+		int					ndof;	//!< number of degrees of freedom of polynomial
+		FENodeElemList		NEL;	//!< node-element list (defines the patches)
+		std::vector<int>	tag;	//!< initial node tags (2 for edge and interior nodes, 0 otherwise)
+		std::vector<vec3d>	rt;		//!< nodal positions when the matrices were calculated
+		std::vector<matrix>	Ai;		//!< inverse of patch matrix (for each domain node)
+		std::vector<int>	ok;		//!< does the patch have enough sampling points?
+	};
+
 public:
 	FESPRProjection();
 
+	//! project one component
 	void Project(FESolidDomain& dom, const std::vector< std::vector<double> >& d, std::vector<double>& o);
 
+	//! project ncomp components at once. The values of component k at integration point n 
+	//! of element i are stored in d[i][n*ncomp + k]. The nodal values of component k are
+	//! returned in o[k].
+	void Project(FESolidDomain& dom, const std::vector< std::vector<double> >& d, int ncomp, std::vector< std::vector<double> >& o);
+
 	void SetInterpolationOrder(int p);
 
+private:
+	//! get the patch data for a domain (returns 0 if the element type is not supported)
+	PATCHES* GetPatches(FESolidDomain& dom);
+
 protected:
 	int		m_p;	//!< interpolation order (set to -1 for default rules)
+
+	std::map<FESolidDomain*, PATCHES>	m_patches;	//!< patch data for each domain
 };
@@ -31,7 +31,9 @@ SOFTWARE.*/
 #include "FECore/FEClosestPointProjection.h"
 #include "FECore/FEModel.h"
 #include "FECore/FEGlobalMatrix.h"
+#include "FECore/FEBlockAssembler.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -446,7 +448,7 @@ void FESlidingSurface::GetNodalContactTraction(int nface, vec3d* tn)
 //! constructor
 FESlidingInterface::FESlidingInterface(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	m_mu = 0;
@@ -724,130 +726,142 @@ void FESlidingInterface::Update(int niter, const FETimeInfo& tp)
 
 void FESlidingInterface::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 {
-	int j, k, l, m, n, np;
-	int nseln, nmeln, ndof;
-
-	// element contact force vector
-	vector<double> fe;
-
-	// the lm array for this force vector
-	vector<int> lm;
-
-	// the en array
-	vector<int> en;
-
-	// the elements LM vectors
-	vector<int> sLM;
-	vector<int> mLM;
-
 	const int MN = FEElement::MAX_NODES;
-	vec3d r0[MN];
-	double w[MN];
-	double* Gr, *Gs;
-	double detJ[MN];
-	vec3d dxr, dxs;
 
 	// do two-pass
 	int npass = (m_btwo_pass?2:1);
 	if (m_bself_contact) npass = 1;
-	for (np=0; np<npass; ++np)
+	for (int np=0; np<npass; ++np)
 	{
 		// pick the slave and master surfaces
 		FESlidingSurface& ss = (np==0? m_ss : m_ms);
 		FESlidingSurface& ms = (np==0? m_ms : m_ss);
 
 		// loop over all slave facets
+		// (the element vectors are evaluated in parallel and assembled in element order)
 		int ne = ss.Elements();
-		for (j=0; j<ne; ++j)
+		FEBlockAssembler A(R, ne);
+		while (A.NextBlock())
 		{
-			// get the slave element
-			FESurfaceElement& sel = ss.Element(j);
-			nseln = sel.Nodes();
+			int n0 = A.BlockStart();
+			int n1 = A.BlockEnd();
+			#pragma omp parallel
+			{
+				int k, l, m, n;
+				int nseln, nmeln, ndof;
 
-			// get the element's LM array
-			ss.UnpackLM(sel, sLM);
+				// element contact force vector
+				vector<double> fe;
 
-			// nodal coordinates
-			for (int i=0; i<nseln; ++i) r0[i] = ss.GetMesh()->Node(sel.m_node[i]).m_r0;
+				// the lm array for this force vector
+				vector<int> lm;
 
-			// we calculate all the metrics we need before we
-			// calculate the nodal forces
-			for (n=0; n<nseln; ++n)
-			{
-				Gr = sel.Gr(n);
-				Gs = sel.Gs(n);
+				// the en array
+				vector<int> en;
 
-				// calculate jacobian
-				// note that we are integrating over the reference surface
-				dxr = dxs = vec3d(0,0,0);
-				for (k=0; k<nseln; ++k)
-				{
-					dxr.x += Gr[k]*r0[k].x;
-					dxr.y += Gr[k]*r0[k].y;
-					dxr.z += Gr[k]*r0[k].z;
+				// the elements LM vectors
+				vector<int> sLM;
+				vector<int> mLM;
 
-					dxs.x += Gs[k]*r0[k].x;
-					dxs.y += Gs[k]*r0[k].y;
-					dxs.z += Gs[k]*r0[k].z;
-				}
+				vec3d r0[MN];
+				double w[MN];
+				double* Gr, *Gs;
+				double detJ[MN];
+				vec3d dxr, dxs;
 
-				// jacobians
-				detJ[n] = (dxr ^ dxs).norm();
+				#pragma omp for schedule(dynamic)
+				for (int j=n0; j<n1; ++j)
+				{
+					// get the slave element
+					FESurfaceElement& sel = ss.Element(j);
+					nseln = sel.Nodes();
 
-				// integration weights
-				w[n] = sel.GaussWeights()[n];
-			}
+					// get the element's LM array
+					ss.UnpackLM(sel, sLM);
 
-			// loop over slave element nodes (which are the integration points as well)
-			// and calculate the contact nodal force
-			for (n=0; n<nseln; ++n)
-			{
-				// get the local node number
-				m = sel.m_lnode[n];
-
-				// see if this node's constraint is active
-				// that is, if it has a master element associated with it
-				// TODO: is this a good way to test for an active constraint
-				// The rigid wall criteria seems to work much better.
-				if (ss.m_pme[m] != 0)
-				{
-					// This node is active and could lead to a non-zero
-					// contact force.
-					// get the master element
-					FESurfaceElement& mel = *ss.m_pme[m];
-					ms.UnpackLM(mel, mLM);
-
-					// calculate the degrees of freedom
-					nmeln = mel.Nodes();
-					ndof = 3*(nmeln+1);
-					fe.resize(ndof);
-
-					// calculate the nodal force
-					ContactNodalForce(m, ss, mel, fe);
-
-					// multiply force with weights
-					for (l=0; l<ndof; ++l) fe[l] *= detJ[n]*w[n];
-					
-					// fill the lm array
-					lm.resize(3*(nmeln+1));
-					lm[0] = sLM[n*3  ];
-					lm[1] = sLM[n*3+1];
-					lm[2] = sLM[n*3+2];
+					// nodal coordinates
+					for (int i=0; i<nseln; ++i) r0[i] = ss.GetMesh()->Node(sel.m_node[i]).m_r0;
 
-					for (l=0; l<nmeln; ++l)
+					// we calculate all the metrics we need before we
+					// calculate the nodal forces
+					for (n=0; n<nseln; ++n)
 					{
-						lm[3*(l+1)  ] = mLM[l*3  ];
-						lm[3*(l+1)+1] = mLM[l*3+1];
-						lm[3*(l+1)+2] = mLM[l*3+2];
+						Gr = sel.Gr(n);
+						Gs = sel.Gs(n);
+
+						// calculate jacobian
+						// note that we are integrating over the reference surface
+						dxr = dxs = vec3d(0,0,0);
+						for (k=0; k<nseln; ++k)
+						{
+							dxr.x += Gr[k]*r0[k].x;
+							dxr.y += Gr[k]*r0[k].y;
+							dxr.z += Gr[k]*r0[k].z;
+
+							dxs.x += Gs[k]*r0[k].x;
+							dxs.y += Gs[k]*r0[k].y;
+							dxs.z += Gs[k]*r0[k].z;
+						}
+
+						// jacobians
+						detJ[n] = (dxr ^ dxs).norm();
+
+						// integration weights
+						w[n] = sel.GaussWeights()[n];
 					}
 
-					// fill the en array
-					en.resize(nmeln+1);
-					en[0] = sel.m_node[n];
-					for (l=0; l<nmeln; ++l) en[l+1] = mel.m_node[l];
-
-					// assemble into global force vector
-					R.Assemble(en, lm, fe);
+					// loop over slave element nodes (which are the integration points as well)
+					// and calculate the contact nodal force
+					for (n=0; n<nseln; ++n)
+					{
+						// get the local node number
+						m = sel.m_lnode[n];
+
+						// see if this node's constraint is active
+						// that is, if it has a master element associated with it
+						// TODO: is this a good way to test for an active constraint
+						// The rigid wall criteria seems to work much better.
+						if (ss.m_pme[m] != 0)
+						{
+							// This node is active and could lead to a non-zero
+							// contact force.
+							// get the master element
+							FESurfaceElement& mel = *ss.m_pme[m];
+							ms.UnpackLM(mel, mLM);
+
+							// calculate the degrees of freedom
+							nmeln = mel.Nodes();
+							ndof = 3*(nmeln+1);
+							fe.resize(ndof);
+
+							// calculate the nodal force
+							ContactNodalForce(m, ss, mel, fe);
+
+							// multiply force with weights
+							for (l=0; l<ndof; ++l) fe[l] *= detJ[n]*w[n];
+					
+							// fill the lm array
+							lm.resize(3*(nmeln+1));
+							lm[0] = sLM[n*3  ];
+							lm[1] = sLM[n*3+1];
+							lm[2] = sLM[n*3+2];
+
+							for (l=0; l<nmeln; ++l)
+							{
+								lm[3*(l+1)  ] = mLM[l*3  ];
+								lm[3*(l+1)+1] = mLM[l*3+1];
+								lm[3*(l+1)+2] = mLM[l*3+2];
+							}
+
+							// fill the en array
+							en.resize(nmeln+1);
+							en[0] = sel.m_node[n];
+							for (l=0; l<nmeln; ++l) en[l+1] = mel.m_node[l];
+
+							// assemble into global force vector
+							A.Add(j, en, lm, fe);
+						}
+					}
 				}
 			}
 		}
@@ -1073,115 +1087,127 @@ void FESlidingInterface::ContactNodalForce(int m, FESlidingSurface& ss, FESurfac
 
 void FESlidingInterface::StiffnessMatrix(FESolver* psolver, const FETimeInfo& tp)
 {
-	int j, k, l, n, m, np;
-	int nseln, nmeln, ndof;
-
-	matrix ke;
-
 	const int MAXMN = FEElement::MAX_NODES;
-	vector<int> lm(3*(MAXMN + 1));
-	vector<int> en(MAXMN+1);
-
-	double *Gr, *Gs, w[6];
-	vec3d r0[6];
-
-	double detJ[6];
-	vec3d dxr, dxs;
-
-	vector<int> sLM;
-	vector<int> mLM;
 
 	// do two-pass
 	int npass = (m_btwo_pass?2:1);
 	if (m_bself_contact) npass = 1;
-	for (np=0; np<npass; ++np)
+	for (int np=0; np<npass; ++np)
 	{
 		// get the master and slave surface
 		FESlidingSurface& ss = (np==0?m_ss:m_ms);	
 		FESlidingSurface& ms = (np==0?m_ms:m_ss);	
 
 		// loop over all slave elements
+		// (the element matrices are evaluated in parallel and assembled in element order)
 		int ne = ss.Elements();
-		for (j=0; j<ne; ++j)
+		FEBlockAssembler A(psolver, ne);
+		while (A.NextBlock())
 		{
-			// unpack the slave element
-			FESurfaceElement& se = ss.Element(j);
-			nseln = se.Nodes();
-
-			// get the element's LM array
-			ss.UnpackLM(se, sLM);
-
-			// get the nodal coordinates
-			for (int i=0; i<nseln; ++i) r0[i] = ss.GetMesh()->Node(se.m_node[i]).m_r0;
-
-			// get all the metrics we need 
-			for (n=0; n<nseln; ++n)
+			int n0 = A.BlockStart();
+			int n1 = A.BlockEnd();
+			#pragma omp parallel
 			{
-				Gr = se.Gr(n);
-				Gs = se.Gs(n);
+				int k, l, n, m;
+				int nseln, nmeln, ndof;
 
-				// calculate jacobian
-				dxr = dxs = vec3d(0,0,0);
-				for (k=0; k<nseln; ++k)
-				{
-					dxr.x += Gr[k]*r0[k].x;
-					dxr.y += Gr[k]*r0[k].y;
-					dxr.z += Gr[k]*r0[k].z;
-
-					dxs.x += Gs[k]*r0[k].x;
-					dxs.y += Gs[k]*r0[k].y;
-					dxs.z += Gs[k]*r0[k].z;
-				}
-
-				detJ[n] = (dxr ^ dxs).norm();
-				w[n] = se.GaussWeights()[n];
-			}
+				matrix ke;
 
-			// loop over all integration points (that is nodes)
-			for (n=0; n<nseln; ++n)
-			{
-				m = se.m_lnode[n];
+				vector<int> lm(3*(MAXMN + 1));
+				vector<int> en(MAXMN+1);
 
-				// see if this node's constraint is active
-				// that is, if it has a master element associated with it
-				if (ss.m_pme[m] != 0)
-				{
-					// get the master element
-					FESurfaceElement& me = *ss.m_pme[m];
+				double *Gr, *Gs, w[6];
+				vec3d r0[6];
 
-					// get the masters element's LM array
-					ms.UnpackLM(me, mLM);
+				double detJ[6];
+				vec3d dxr, dxs;
 
-					nmeln = me.Nodes();
-					ndof = 3*(nmeln+1);
+				vector<int> sLM;
+				vector<int> mLM;
 
-					// calculate the stiffness matrix
-					ke.resize(ndof, ndof);
-					ContactNodalStiffness(m, ss, me, ke);
+				#pragma omp for schedule(dynamic)
+				for (int j=n0; j<n1; ++j)
+				{
+					// unpack the slave element
+					FESurfaceElement& se = ss.Element(j);
+					nseln = se.Nodes();
 
-					// muliply with weights
-					for (k=0; k<ndof; ++k)
-						for (l=0; l<ndof; ++l) ke[k][l] *= detJ[n]*w[n];
+					// get the element's LM array
+					ss.UnpackLM(se, sLM);
 
-					// fill the lm array
-					lm[0] = sLM[n*3  ];
-					lm[1] = sLM[n*3+1];
-					lm[2] = sLM[n*3+2];
+					// get the nodal coordinates
+					for (int i=0; i<nseln; ++i) r0[i] = ss.GetMesh()->Node(se.m_node[i]).m_r0;
 
-					for (k=0; k<nmeln; ++k)
+					// get all the metrics we need 
+					for (n=0; n<nseln; ++n)
 					{
-						lm[3*(k+1)  ] = mLM[k*3  ];
-						lm[3*(k+1)+1] = mLM[k*3+1];
-						lm[3*(k+1)+2] = mLM[k*3+2];
+						Gr = se.Gr(n);
+						Gs = se.Gs(n);
+
+						// calculate jacobian
+						dxr = dxs = vec3d(0,0,0);
+						for (k=0; k<nseln; ++k)
+						{
+							dxr.x += Gr[k]*r0[k].x;
+							dxr.y += Gr[k]*r0[k].y;
+							dxr.z += Gr[k]*r0[k].z;
+
+							dxs.x += Gs[k]*r0[k].x;
+							dxs.y += Gs[k]*r0[k].y;
+							dxs.z += Gs[k]*r0[k].z;
+						}
+
+						detJ[n] = (dxr ^ dxs).norm();
+						w[n] = se.GaussWeights()[n];
 					}
 
-					// create the en array
-					en.resize(nmeln+1);
-					en[0] = se.m_node[n];
-					for (k=0; k<nmeln; ++k) en[k+1] = me.m_node[k];
+					// loop over all integration points (that is nodes)
+					for (n=0; n<nseln; ++n)
+					{
+						m = se.m_lnode[n];
+
+						// see if this node's constraint is active
+						// that is, if it has a master element associated with it
+						if (ss.m_pme[m] != 0)
+						{
+							// get the master element
+							FESurfaceElement& me = *ss.m_pme[m];
+
+							// get the masters element's LM array
+							ms.UnpackLM(me, mLM);
+
+							nmeln = me.Nodes();
+							ndof = 3*(nmeln+1);
+
+							// calculate the stiffness matrix
+							ke.resize(ndof, ndof);
+							ContactNodalStiffness(m, ss, me, ke);
+
+							// muliply with weights
+							for (k=0; k<ndof; ++k)
+								for (l=0; l<ndof; ++l) ke[k][l] *= detJ[n]*w[n];
+
+							// fill the lm array
+							lm[0] = sLM[n*3  ];
+							lm[1] = sLM[n*3+1];
+							lm[2] = sLM[n*3+2];
+
+							for (k=0; k<nmeln; ++k)
+							{
+								lm[3*(k+1)  ] = mLM[k*3  ];
+								lm[3*(k+1)+1] = mLM[k*3+1];
+								lm[3*(k+1)+2] = mLM[k*3+2];
+							}
+
+							// create the en array
+							en.resize(nmeln+1);
+							en[0] = se.m_node[n];
+							for (k=0; k<nmeln; ++k) en[k+1] = me.m_node[k];
 						
-					// assemble stiffness matrix
-					psolver->AssembleStiffness(en, lm, ke);
+							// assemble stiffness matrix
+							A.Add(j, en, lm, ke);
+						}
+					}
 				}
 			}
 		}
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/FEModel.h"
 #include "FECore/FEAnalysis.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -367,7 +368,7 @@ void FESlidingSurfaceBW::GetStickStatus(int nface, double& pg)
 
 FESlidingInterfaceBW::FESlidingInterfaceBW(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-    static int count = 1;
+    static std::atomic<int> count(1);
     SetID(count++);
     
     // initial values
@@ -384,6 +385,9 @@ FESlidingInterfaceBW::FESlidingInterfaceBW(FEModel* pfem) : FEContactInterface(p
     m_btension = false;
     m_breloc = false;
     m_bsmaug = false;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
     m_mu = 0.0;
     
     m_naugmin = 0;
@@ -688,9 +692,6 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
 
 void FESlidingInterfaceBW::Update(int nsolve_iter, const FETimeInfo& tp)
 {
-    static int naug = 0;
-    static int biter = 0;
-    
     FEModel& fem = *GetFEModel();
     
     // get the iteration number
@@ -699,13 +700,13 @@ void FESlidingInterfaceBW::Update(int nsolve_iter, const FETimeInfo& tp)
     FEAnalysis* pstep = fem.GetCurrentStep();
     FESolver* psolver = pstep->GetFESolver();
     if (psolver->m_niter == 0) {
-        biter = 0;
-        naug = psolver->m_naug;
-    } else if (psolver->m_naug > naug) {
-        biter = psolver->m_niter;
-        naug = psolver->m_naug;
+        m_biter = 0;
+        m_naug = psolver->m_naug;
+    } else if (psolver->m_naug > m_naug) {
+        m_biter = psolver->m_niter;
+        m_naug = psolver->m_naug;
     }
-    int niter = psolver->m_niter - biter;
+    int niter = psolver->m_niter - m_biter;
     bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
     // get the logfile
     //	Logfile& log = GetLogfile();
@@ -713,9 +714,8 @@ void FESlidingInterfaceBW::Update(int nsolve_iter, const FETimeInfo& tp)
     
     // project the surfaces onto each other
     // this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
-    bfirst = false;
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
+    m_bfirst = false;
     if (m_btwo_pass) ProjectSurface(m_ms, m_ss, bupseg);
     
     if (nsolve_iter == 0)
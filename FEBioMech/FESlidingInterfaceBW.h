@@ -182,5 +182,10 @@ public:
     bool            m_bflipm;       //!< flip master normal
     bool            m_bflips;       //!< flip slave normal
 
+protected:
+    int             m_naug;         //!< augmentation nr at the last call to Update
+    int             m_biter;        //!< iteration nr at the start of the last augmentation
+    bool            m_bfirst;       //!< first call to Update
+
     DECLARE_PARAMETER_LIST();
 };
@@ -49,6 +49,7 @@ SOFTWARE.*/
 #include <FECore/RigidBC.h>
 #include <FECore/FEModelLoad.h>
 #include <FECore/FELinearConstraintManager.h>
+#include <FECore/FEProfiler.h>
 #include "FESSIShellDomain.h"
 
 //-----------------------------------------------------------------------------
@@ -64,6 +65,8 @@ BEGIN_PARAMETER_LIST(FESolidSolver2, FENewtonSolver)
 	ADD_PARAMETER(m_beta         , FE_PARAM_DOUBLE, "beta"        );
 	ADD_PARAMETER(m_gamma        , FE_PARAM_DOUBLE, "gamma"       );
 	ADD_PARAMETER(m_logSolve     , FE_PARAM_BOOL  ,"logSolve");
+	ADD_PARAMETER(m_bcacheGrad   , FE_PARAM_BOOL  , "cache_gradients");
+	ADD_PARAMETER(m_bcacheRefGrad, FE_PARAM_BOOL  , "cache_ref_gradients");
 END_PARAMETER_LIST();
 
 //-----------------------------------------------------------------------------
@@ -82,6 +85,8 @@ FESolidSolver2::FESolidSolver2(FEModel* pfem) : FENewtonSolver(pfem), m_rigidSol
 	m_nreq = 0;
 
 	m_logSolve = false;
+	m_bcacheGrad = false;
+	m_bcacheRefGrad = false;
 
 	// default Newmark parameters (trapezoidal rule)
     m_rhoi = -2;
@@ -258,6 +263,22 @@ bool FESolidSolver2::Init()
     gather(m_Ut, mesh, m_dofSZ);
 
     SolverWarnings();
+
+	// the elastic solid domains can keep the shape function gradients between
+	// the stress update and the residual and stiffness evaluations
+	for (int i=0; i<mesh.Domains(); ++i)
+	{
+		FEElasticSolidDomain* pd = dynamic_cast<FEElasticSolidDomain*>(&mesh.Domain(i));
+		if (pd) pd->CacheShapeGradients(m_bcacheGrad);
+	}
+
+	// the solid domains (including the biphasic and multiphasic ones) can keep
+	// the reference gradients for the whole analysis
+	for (int i=0; i<mesh.Domains(); ++i)
+	{
+		FESolidDomain* pd = dynamic_cast<FESolidDomain*>(&mesh.Domain(i));
+		if (pd) pd->CacheReferenceGradients(m_bcacheRefGrad);
+	}
     
 	return true;
 }
@@ -622,7 +643,11 @@ void FESolidSolver2::UpdateContact()
 	for (int i = 0; i<m_fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(m_fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->Update(m_niter, tp);
+		if (pci->IsActive())
+		{
+			FEProfileScope scope("contact projection", pci->GetTypeStr());
+			pci->Update(m_niter, tp);
+		}
 	}
 }
 
@@ -956,6 +981,7 @@ bool FESolidSolver2::StiffnessMatrix()
 	{
 		if (mesh.Domain(i).IsActive()) 
 		{
+			FEProfileScope scope(mesh.Domain(i).GetName().c_str(), mesh.Domain(i).GetMaterial()->GetTypeStr());
 			FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
 			dom.StiffnessMatrix(this);
 		}
@@ -1048,11 +1074,17 @@ void FESolidSolver2::NonLinearConstraintStiffness(const FETimeInfo& tp)
 
 void FESolidSolver2::ContactStiffness()
 {
+	TRACK_TIME("contact");
+
 	const FETimeInfo& tp = m_fem.GetTime();
 	for (int i = 0; i<m_fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(m_fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->StiffnessMatrix(this, tp);
+		if (pci->IsActive())
+		{
+			FEProfileScope scope("contact", pci->GetTypeStr());
+			pci->StiffnessMatrix(this, tp);
+		}
 	}
 }
 
@@ -1226,11 +1258,17 @@ void FESolidSolver2::AssembleStiffness(vector<int>& en, vector<int>& elm, matrix
 //! Calculates the contact forces
 void FESolidSolver2::ContactForces(FEGlobalVector& R)
 {
+	TRACK_TIME("contact");
+
 	const FETimeInfo& tp = m_fem.GetTime();
 	for (int i = 0; i<m_fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(m_fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->Residual(R, tp);
+		if (pci->IsActive())
+		{
+			FEProfileScope scope("contact", pci->GetTypeStr());
+			pci->Residual(R, tp);
+		}
 	}
 }
 
@@ -1263,15 +1301,19 @@ bool FESolidSolver2::Residual(vector<double>& R)
 	FEMesh& mesh = m_fem.GetMesh();
 
 	// calculate the internal (stress) forces
+	// (collected in per-thread buffers)
+	RHS.BeginParallelAssembly(m_asmbuf);
 	for (int i=0; i<mesh.Domains(); ++i)
 	{
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive() && dom.GetMaterial()->IsRigid() == false)
         {
+			FEProfileScope scope(dom.GetName().c_str(), dom.GetMaterial()->GetTypeStr());
             FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
             edom.InternalForces(RHS);
         }
 	}
+	RHS.EndParallelAssembly();
 
 	// extract the internal forces
 	// (only when we really need it, below)
@@ -155,6 +155,8 @@ public:
 	double	m_Rmax;			//!< max residual value
 
 	bool	m_logSolve;		//!< flag to use Aggarwal's log method
+	bool	m_bcacheGrad;	//!< cache the spatial shape function gradients of the solid domains
+	bool	m_bcacheRefGrad;	//!< cache the reference shape function gradients of the solid domains
 
 	// equation numbers
 	int		m_nreq;			//!< start of rigid body equations
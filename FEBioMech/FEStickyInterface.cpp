@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/FEClosestPointProjection.h"
 #include "FECore/FEGlobalMatrix.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -173,7 +174,7 @@ void FEStickySurface::GetNodalContactTraction(int nface, vec3d* tn)
 //! Constructor. Initialize default values.
 FEStickyInterface::FEStickyInterface(FEModel* pfem) : FEContactInterface(pfem), ss(pfem), ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 
 	// define sibling relationships
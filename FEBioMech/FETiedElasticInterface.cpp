@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FECore/FEAnalysis.h"
 #include "FECore/FENormalProjection.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -243,7 +244,7 @@ void FETiedElasticSurface::GetContactTraction(int nface, vec3d& pt)
 
 FETiedElasticInterface::FETiedElasticInterface(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-    static int count = 1;
+    static std::atomic<int> count(1);
     SetID(count++);
     
     // initial values
@@ -28,6 +28,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FETractionLoad.h"
 #include "FECore/FEModel.h"
+#include "FECore/FEBlockAssembler.h"
 
 //=============================================================================
 BEGIN_PARAMETER_LIST(FETractionLoad, FESurfaceLoad)
@@ -59,75 +60,87 @@ void FETractionLoad::SetSurface(FESurface* ps)
 //! Calculate the residual for the traction load
 void FETractionLoad::Residual(const FETimeInfo& tp, FEGlobalVector& R)
 {
-	vector<double> fe;
-	vector<int> lm;
-
-	vec3d r0[FEElement::MAX_NODES];
-	vec3d tn[FEElement::MAX_NODES];
-
 	FESurface& surf = *m_psurf;
 	FEMesh& mesh = *surf.GetMesh();
 	int NF = surf.Elements();
-	for (int iel=0; iel<NF; ++iel)
-	{
-		FESurfaceElement& el = surf.Element(iel);
-
-		int ndof = 3*el.Nodes();
-		fe.resize(ndof);
-
-		// nr integration points
-		int nint = el.GaussPoints();
-
-		// nr of element nodes
-		int neln = el.Nodes();
-
-		// nodal coordinates
-		for (int i=0; i<neln; ++i)
-		{
-			r0[i] = mesh.Node(el.m_node[i]).m_r0;
-			tn[i] = m_TC.value<vec3d>(iel, i)*m_scale;
-		}
 
-		double* Gr, *Gs;
-		double* N;
-		double* w  = el.GaussWeights();
-
-		// repeat over integration points
-		zero(fe);
-		for (int n=0; n<nint; ++n)
+	// the element vectors are evaluated in parallel and assembled in element order
+	FEBlockAssembler A(R, NF);
+	while (A.NextBlock())
+	{
+		int n0 = A.BlockStart();
+		int n1 = A.BlockEnd();
+		#pragma omp parallel
 		{
-			N  = el.H(n);
-			Gr = el.Gr(n);
-			Gs = el.Gs(n);
-
-
-			// calculate the tangent vectors
-			vec3d dxr(0,0,0), dxs(0,0,0);
-			for (int i=0; i<neln; ++i) 
-			{
-				dxr.x += Gr[i]*r0[i].x;
-				dxr.y += Gr[i]*r0[i].y;
-				dxr.z += Gr[i]*r0[i].z;
+			vector<double> fe;
+			vector<int> lm;
 
-				dxs.x += Gs[i]*r0[i].x;
-				dxs.y += Gs[i]*r0[i].y;
-				dxs.z += Gs[i]*r0[i].z;
-			}
-			double dv = ((dxr ^ dxs).norm()*w[n]);
+			vec3d r0[FEElement::MAX_NODES];
+			vec3d tn[FEElement::MAX_NODES];
 
-			for (int i=0; i<neln; ++i)
+			#pragma omp for
+			for (int iel=n0; iel<n1; ++iel)
 			{
-				fe[3*i  ] += N[i]*tn[i].x*dv;
-				fe[3*i+1] += N[i]*tn[i].y*dv;
-				fe[3*i+2] += N[i]*tn[i].z*dv;
+				FESurfaceElement& el = surf.Element(iel);
+
+				int ndof = 3*el.Nodes();
+				fe.resize(ndof);
+
+				// nr integration points
+				int nint = el.GaussPoints();
+
+				// nr of element nodes
+				int neln = el.Nodes();
+
+				// nodal coordinates
+				for (int i=0; i<neln; ++i)
+				{
+					r0[i] = mesh.Node(el.m_node[i]).m_r0;
+					tn[i] = m_TC.value<vec3d>(iel, i)*m_scale;
+				}
+
+				double* Gr, *Gs;
+				double* N;
+				double* w  = el.GaussWeights();
+
+				// repeat over integration points
+				zero(fe);
+				for (int n=0; n<nint; ++n)
+				{
+					N  = el.H(n);
+					Gr = el.Gr(n);
+					Gs = el.Gs(n);
+
+
+					// calculate the tangent vectors
+					vec3d dxr(0,0,0), dxs(0,0,0);
+					for (int i=0; i<neln; ++i) 
+					{
+						dxr.x += Gr[i]*r0[i].x;
+						dxr.y += Gr[i]*r0[i].y;
+						dxr.z += Gr[i]*r0[i].z;
+
+						dxs.x += Gs[i]*r0[i].x;
+						dxs.y += Gs[i]*r0[i].y;
+						dxs.z += Gs[i]*r0[i].z;
+					}
+					double dv = ((dxr ^ dxs).norm()*w[n]);
+
+					for (int i=0; i<neln; ++i)
+					{
+						fe[3*i  ] += N[i]*tn[i].x*dv;
+						fe[3*i+1] += N[i]*tn[i].y*dv;
+						fe[3*i+2] += N[i]*tn[i].z*dv;
+					}
+				}
+
+				// get the element's LM vector
+				UnpackLM(el, lm);
+
+				// add element force vector to global force vector
+				A.Add(iel, el.m_node, lm, fe);
 			}
 		}
-
-		// get the element's LM vector
-		UnpackLM(el, lm);
-
-		// add element force vector to global force vector
-		R.Assemble(el.m_node, lm, fe);
 	}
 }
 
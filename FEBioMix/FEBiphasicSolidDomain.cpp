@@ -814,6 +814,8 @@ void FEBiphasicSolidDomain::Update(const FETimeInfo& tp)
 {
 	bool berr = false;
 	int NE = (int) m_Elem.size();
+	// the worker threads use the model (and log file) of this thread
+	FEModel* pfem = FECoreKernel::GetThreadModel();
 	#pragma omp parallel for shared(NE, berr)
 	for (int i=0; i<NE; ++i)
 	{
@@ -825,6 +827,7 @@ void FEBiphasicSolidDomain::Update(const FETimeInfo& tp)
 		{
 			#pragma omp critical
 			{
+				FEModelScope scope(pfem);
 				berr = true;
 				if (NegativeJacobian::m_boutput) e.print();
 			}
@@ -872,6 +875,11 @@ void FEBiphasicSolidDomain::UpdateElementStress(int iel)
             pn[j] = node.get(m_dofP);
 	}
 
+	// get the deformation gradients and determinants at all integration points
+	mat3d Fn[FEElement::MAX_INTPOINTS];
+	double Jn[FEElement::MAX_INTPOINTS];
+	defgrads(el, Fn, Jn);
+
 	// loop over the integration points and calculate
 	// the stress at the integration point
 	for (int n=0; n<nint; ++n)
@@ -886,7 +894,8 @@ void FEBiphasicSolidDomain::UpdateElementStress(int iel)
 		pt.m_rt = el.Evaluate(rt, n);
 			
 		// get the deformation gradient and determinant
-		pt.m_J = defgrad(el, pt.m_F, n);
+		pt.m_F = Fn[n];
+		pt.m_J = Jn[n];
 			
 		// poroelasticity data
 		FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
@@ -628,8 +628,8 @@ bool FEBiphasicSoluteShellDomain::ElementBiphasicSoluteStiffness(FEShellElement&
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradMu(neln), gradMw(neln);
-    vector<double> Mu(neln), Mw(neln);
+    vec3d gradMu[FEElement::MAX_NODES], gradMw[FEElement::MAX_NODES];
+    double Mu[FEElement::MAX_NODES], Mw[FEElement::MAX_NODES];
     vec3d gradM;
     double tmp;
     
@@ -924,8 +924,8 @@ bool FEBiphasicSoluteShellDomain::ElementBiphasicSoluteStiffnessSS(FEShellElemen
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradMu(neln), gradMw(neln);
-    vector<double> Mu(neln), Mw(neln);
+    vec3d gradMu[FEElement::MAX_NODES], gradMw[FEElement::MAX_NODES];
+    double Mu[FEElement::MAX_NODES], Mw[FEElement::MAX_NODES];
     vec3d gradM;
     double tmp;
     
@@ -1204,6 +1204,8 @@ void FEBiphasicSoluteShellDomain::Update(const FETimeInfo& tp)
 
     bool berr = false;
     int NE = (int) m_Elem.size();
+    // the worker threads use the model (and log file) of this thread
+    FEModel* pfem = FECoreKernel::GetThreadModel();
 #pragma omp parallel for shared(NE, berr)
     for (int i=0; i<NE; ++i)
     {
@@ -1215,6 +1217,7 @@ void FEBiphasicSoluteShellDomain::Update(const FETimeInfo& tp)
         {
 #pragma omp critical
             {
+                FEModelScope scope(pfem);
                 berr = true;
                 if (NegativeJacobian::m_boutput) e.print();
             }
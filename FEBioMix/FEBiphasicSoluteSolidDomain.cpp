@@ -614,7 +614,7 @@ bool FEBiphasicSoluteSolidDomain::ElementBiphasicSoluteStiffness(FESolidElement&
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradN(neln);
+    vec3d gradN[FEElement::MAX_NODES];
     double tmp;
     
     // gauss-weights
@@ -829,7 +829,7 @@ bool FEBiphasicSoluteSolidDomain::ElementBiphasicSoluteStiffnessSS(FESolidElemen
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradN(neln);
+    vec3d gradN[FEElement::MAX_NODES];
     double tmp;
     
     // gauss-weights
@@ -1019,6 +1019,8 @@ void FEBiphasicSoluteSolidDomain::Update(const FETimeInfo& tp)
 {
     bool berr = false;
     int NE = (int) m_Elem.size();
+    // the worker threads use the model (and log file) of this thread
+    FEModel* pfem = FECoreKernel::GetThreadModel();
 #pragma omp parallel for shared(NE, berr)
     for (int i=0; i<NE; ++i)
     {
@@ -1030,6 +1032,7 @@ void FEBiphasicSoluteSolidDomain::Update(const FETimeInfo& tp)
         {
 #pragma omp critical
             {
+                FEModelScope scope(pfem);
                 berr = true;
                 if (NegativeJacobian::m_boutput) e.print();
             }
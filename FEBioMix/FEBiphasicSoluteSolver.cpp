@@ -431,6 +431,8 @@ bool FEBiphasicSoluteSolver::Residual(vector<double>& R)
 	FEMesh& mesh = m_fem.GetMesh();
 
 	// internal stress work
+	// (collected in per-thread buffers)
+	RHS.BeginParallelAssembly(m_asmbuf);
 	for (i=0; i<mesh.Domains(); ++i)
 	{
         FEDomain& dom = mesh.Domain(i);
@@ -459,6 +461,7 @@ bool FEBiphasicSoluteSolver::Residual(vector<double>& R)
         else if (ped)
             ped->InternalForces(RHS);
     }
+	RHS.EndParallelAssembly();
     
 	// calculate forces due to surface loads
 	int nsl = m_fem.SurfaceLoads();
@@ -395,6 +395,8 @@ bool FEBiphasicSolver::Residual(vector<double>& R)
 	FEMesh& mesh = m_fem.GetMesh();
 
 	// calculate internal stress force
+	// (collected in per-thread buffers)
+	RHS.BeginParallelAssembly(m_asmbuf);
 	if (m_fem.GetCurrentStep()->m_nanalysis == FE_STEADY_STATE)
 	{
 		for (int i=0; i<mesh.Domains(); ++i)
@@ -421,6 +423,7 @@ bool FEBiphasicSolver::Residual(vector<double>& R)
             }
 		}
 	}
+	RHS.EndParallelAssembly();
 
     // calculate the body forces
 	for (int j = 0; j<m_fem.BodyLoads(); ++j)
@@ -480,8 +480,15 @@ double FEMultiphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 	
 	int i, j;
 	
-	// if not neutral, solve electroneutrality polynomial for zeta
+	// the polynomial only needs to be solved once for each state of the material point
 	FESolutesMaterialPoint& set = *pt.ExtractData<FESolutesMaterialPoint>();
+	if (set.m_bzeta)
+	{
+		if (eform) return set.m_zeta;
+		return -m_Rgas*m_Tabs/m_Fc*log(set.m_zeta);
+	}
+	
+	// if not neutral, solve electroneutrality polynomial for zeta
 	const int nsol = (int)m_pSolute.size();
 	double cF = FixedChargeDensity(pt);
 
@@ -518,6 +525,10 @@ double FEMultiphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 		zeta = 1.0;
 	}
 	
+	// store the solution for the current state
+	set.m_zeta = zeta;
+	set.m_bzeta = true;
+	
 	// Return exponential (non-dimensional) form if desired
 	if (eform) return zeta;
 	
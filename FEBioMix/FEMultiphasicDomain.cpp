@@ -39,3 +39,10 @@ FEMultiphasicDomain::FEMultiphasicDomain(FEModel* pfem) : FEElasticDomain(pfem)
     m_dofC = pfem->GetDOFIndex("concentration", 0);
     m_dofD = pfem->GetDOFIndex("shell concentration", 0);
 }
+
+//-----------------------------------------------------------------------------
+void FEMultiphasicDomain::InitWorkspace()
+{
+    DOFS& dofs = GetFEModel()->GetDOFS();
+    m_ws.Init(m_pMat->Solutes(), dofs.GetVariableSize("concentration"));
+}
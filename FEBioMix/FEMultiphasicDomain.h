@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "FECore/FESolidDomain.h"
 #include "FEMultiphasic.h"
 #include "FEBioMech/FEElasticDomain.h"
+#include "FESoluteWorkspace.h"
 
 //-----------------------------------------------------------------------------
 class FEModel;
@@ -63,6 +64,10 @@ public:
     //! calculates the global stiffness matrix (steady-state case)
     virtual void StiffnessMatrixSS(FESolver* psolver, bool bsymm) = 0;
     
+protected:
+    //! size the per-thread workspaces (must be called outside parallel regions)
+    void InitWorkspace();
+    
 protected:
     FEMultiphasic*      m_pMat;
     int                 m_dofP;		//!< pressure dof index
@@ -72,4 +77,6 @@ protected:
     int                 m_dofVX;
     int                 m_dofVY;
     int                 m_dofVZ;
+    
+    FESoluteWorkspaceList   m_ws;   //!< per-thread scratch data of the element kernels
 };
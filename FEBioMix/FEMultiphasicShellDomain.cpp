@@ -225,6 +225,9 @@ bool FEMultiphasicShellDomain::Init()
         }
     }
 
+    // allocate the scratch data of the element kernels
+    InitWorkspace();
+    
     return true;
 }
 
@@ -372,6 +375,9 @@ void FEMultiphasicShellDomain::InitMaterialPoints()
                 ps.m_gradc[isol] = gradient(el, c0[isol], d0[isol], n);
             }
             
+            // the state has changed, so the electroneutrality condition must be solved again
+            ps.m_bzeta = false;
+            
             ps.m_psi = m_pMat->ElectricPotential(mp);
             for (int isol = 0; isol<nsol; ++isol) {
                 ps.m_ca[isol] = m_pMat->Concentration(mp, isol);
@@ -540,12 +546,15 @@ void FEMultiphasicShellDomain::InternalForces(FEGlobalVector& R)
     int nsol = m_pMat->Solutes();
     int ndpn = 2*(4+nsol);
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        vector<double>& fe = ws.fe;
+        vector<int>& lm = ws.lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -599,6 +608,9 @@ void FEMultiphasicShellDomain::ElementInternalForce(FEShellElement& el, vector<d
     
     vec3d gcnt[3];
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // repeat for all integration points
     for (n=0; n<nint; ++n)
     {
@@ -633,9 +645,9 @@ void FEMultiphasicShellDomain::ElementInternalForce(FEShellElement& el, vector<d
         // get the flux
         vec3d& w = bpt.m_w;
         
-        vector<vec3d> j(spt.m_j);
-        vector<int> z(nsol);
-        vector<double> kappa(spt.m_k);
+        const vector<vec3d>& j = spt.m_j;
+        vector<int>& z = ws.z;
+        const vector<double>& kappa = spt.m_k;
         vec3d je(0,0,0);
         
         for (isol=0; isol<nsol; ++isol) {
@@ -646,7 +658,8 @@ void FEMultiphasicShellDomain::ElementInternalForce(FEShellElement& el, vector<d
         
         // evaluate the porosity, its derivative w.r.t. J, and its gradient
         double phiw = m_pMat->Porosity(mp);
-        vector<double> chat(nsol,0);
+        vector<double>& chat = ws.chat;
+        chat.assign(nsol, 0);
         
         // get the solvent supply
         double phiwhat = 0;
@@ -704,12 +717,15 @@ void FEMultiphasicShellDomain::InternalForcesSS(FEGlobalVector& R)
     int nsol = m_pMat->Solutes();
     int ndpn = 2*(4+nsol);
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        vector<double>& fe = ws.fe;
+        vector<int>& lm = ws.lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -761,6 +777,9 @@ void FEMultiphasicShellDomain::ElementInternalForceSS(FEShellElement& el, vector
     
     double dt = GetFEModel()->GetTime().timeIncrement;
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // repeat for all integration points
     for (n=0; n<nint; ++n)
     {
@@ -788,9 +807,9 @@ void FEMultiphasicShellDomain::ElementInternalForceSS(FEShellElement& el, vector
         // get the flux
         vec3d& w = bpt.m_w;
         
-        vector<vec3d> j(spt.m_j);
-        vector<int> z(nsol);
-        vector<double> kappa(spt.m_k);
+        const vector<vec3d>& j = spt.m_j;
+        vector<int>& z = ws.z;
+        const vector<double>& kappa = spt.m_k;
         vec3d je(0,0,0);
         
         for (isol=0; isol<nsol; ++isol) {
@@ -801,7 +820,8 @@ void FEMultiphasicShellDomain::ElementInternalForceSS(FEShellElement& el, vector
         
         // evaluate the porosity, its derivative w.r.t. J, and its gradient
         double phiw = m_pMat->Porosity(mp);
-        vector<double> chat(nsol,0);
+        vector<double>& chat = ws.chat;
+        chat.assign(nsol, 0);
         
         // get the solvent supply
         double phiwhat = 0;
@@ -859,12 +879,15 @@ void FEMultiphasicShellDomain::StiffnessMatrix(FESolver* psolver, bool bsymm)
     // repeat over all solid elements
     int NE = (int)m_Elem.size();
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int iel=0; iel<NE; ++iel)
     {
         // element stiffness matrix
-        matrix ke;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        matrix& ke = ws.ke;
+        vector<int>& lm = ws.lm;
         
         FEShellElement& el = m_Elem[iel];
         UnpackLM(el, lm);
@@ -894,12 +917,15 @@ void FEMultiphasicShellDomain::StiffnessMatrixSS(FESolver* psolver, bool bsymm)
     // repeat over all solid elements
     int NE = (int)m_Elem.size();
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int iel=0; iel<NE; ++iel)
     {
         // element stiffness matrix
-        matrix ke;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        matrix& ke = ws.ke;
+        vector<int>& lm = ws.lm;
         
         FEShellElement& el = m_Elem[iel];
         UnpackLM(el, lm);
@@ -934,8 +960,8 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffness(FEShellElement& el, m
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradMu(neln), gradMw(neln);
-    vector<double> Mu(neln), Mw(neln);
+    vec3d gradMu[FEElement::MAX_NODES], gradMw[FEElement::MAX_NODES];
+    double Mu[FEElement::MAX_NODES], Mw[FEElement::MAX_NODES];
     vec3d gradM;
     double tmp;
     
@@ -956,6 +982,9 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffness(FEShellElement& el, m
     // zero stiffness matrix
     ke.zero();
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // loop over gauss-points
     for (n=0; n<nint; ++n)
     {
@@ -999,21 +1028,21 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffness(FEShellElement& el, m
         vec3d w = ppt.m_w;
         vec3d gradp = ppt.m_gradp;
         
-        vector<double> c(spt.m_c);
-        vector<vec3d> gradc(spt.m_gradc);
-        vector<int> z(nsol);
+        const vector<double>& c = spt.m_c;
+        const vector<vec3d>& gradc = spt.m_gradc;
+        vector<int>& z = ws.z;
         
-        vector<double> kappa(spt.m_k);
+        const vector<double>& kappa = spt.m_k;
         
         // get the charge number
         for (isol=0; isol<nsol; ++isol)
             z[isol] = m_pMat->GetSolute(isol)->ChargeNumber();
         
-        vector<double> dkdJ(spt.m_dkdJ);
-        vector< vector<double> > dkdc(spt.m_dkdc);
-        vector< vector<double> > dkdr(spt.m_dkdr);
-        vector< vector<double> > dkdJr(spt.m_dkdJr);
-        vector< vector< vector<double> > > dkdrc(spt.m_dkdrc);
+        const vector<double>& dkdJ = spt.m_dkdJ;
+        const vector< vector<double> >& dkdc = spt.m_dkdc;
+        const vector< vector<double> >& dkdr = spt.m_dkdr;
+        const vector< vector<double> >& dkdJr = spt.m_dkdJr;
+        const vector< vector< vector<double> > >& dkdrc = spt.m_dkdrc;
         
         // evaluate the porosity and its derivative
         double phiw = m_pMat->Porosity(mp);
@@ -1028,22 +1057,23 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffness(FEShellElement& el, m
         mat3ds K = m_pMat->GetPermeability()->Permeability(mp);
         tens4ds dKdE = m_pMat->GetPermeability()->Tangent_Permeability_Strain(mp);
         
-        vector<mat3ds> dKdc(nsol);
-        vector<mat3ds> D(nsol);
-        vector<tens4ds> dDdE(nsol);
-        vector< vector<mat3ds> > dDdc(nsol, vector<mat3ds>(nsol));
-        vector<double> D0(nsol);
-        vector< vector<double> > dD0dc(nsol, vector<double>(nsol));
-        vector<double> dodc(nsol);
-        vector<mat3ds> dTdc(nsol);
-        vector<mat3ds> ImD(nsol);
+        vector<mat3ds>& dKdc = ws.dKdc;
+        vector<mat3ds>& D = ws.D;
+        vector<tens4ds>& dDdE = ws.dDdE;
+        vector< vector<mat3ds> >& dDdc = ws.dDdc;
+        vector<double>& D0 = ws.D0;
+        vector< vector<double> >& dD0dc = ws.dD0dc;
+        vector<double>& dodc = ws.dodc;
+        vector<mat3ds>& dTdc = ws.dTdc;
+        vector<mat3ds>& ImD = ws.ImD;
         mat3dd I(1);
         
         // evaluate the solvent supply and its derivatives
         mat3ds Phie; Phie.zero();
         double Phip = 0;
-        vector<double> Phic(nsol,0);
-        vector<mat3ds> dchatde(nsol);
+        vector<double>& Phic = ws.Phic;
+        Phic.assign(nsol, 0);
+        vector<mat3ds>& dchatde = ws.dchatde;
         if (m_pMat->GetSolventSupply()) {
             Phie = m_pMat->GetSolventSupply()->Tangent_Supply_Strain(mp);
             Phip = m_pMat->GetSolventSupply()->Tangent_Supply_Pressure(mp);
@@ -1102,8 +1132,8 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffness(FEShellElement& el, m
         mat3ds Ki = K.inverse();
         mat3ds Ke(0,0,0,0,0,0);
         tens4ds G = dyad1s(Ki,I) - dyad4s(Ki,I)*2 - ddots(dyad2s(Ki),dKdE)*0.5;
-        vector<mat3ds> Gc(nsol);
-        vector<mat3ds> dKedc(nsol);
+        vector<mat3ds>& Gc = ws.Gc;
+        vector<mat3ds>& dKedc = ws.dKedc;
         for (isol=0; isol<nsol; ++isol) {
             Ke += ImD[isol]*(kappa[isol]*c[isol]/D0[isol]);
             G += dyad1s(ImD[isol],I)*(R*T*c[isol]*J/D0[isol]/2/phiw*(dkdJ[isol]-kappa[isol]/phiw*dpdJ))
@@ -1122,14 +1152,21 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffness(FEShellElement& el, m
         
         // calculate all the matrices
         vec3d vtmp,gp,qpu, qpw;
-        vector<vec3d> gc(nsol),qcu(nsol),qcw(nsol),wc(nsol),wd(nsol),jce(nsol),jde(nsol);
-        vector< vector<vec3d> > jc(nsol, vector<vec3d>(nsol));
-        vector< vector<vec3d> > jd(nsol, vector<vec3d>(nsol));
+        vector<vec3d>& gc = ws.gc;
+        vector<vec3d>& qcu = ws.qcu;
+        vector<vec3d>& qcw = ws.qcw;
+        vector<vec3d>& wc = ws.wc;
+        vector<vec3d>& wd = ws.wd;
+        vector<vec3d>& jce = ws.jce;
+        vector<vec3d>& jde = ws.jde;
+        vector< vector<vec3d> >& jc = ws.jc;
+        vector< vector<vec3d> >& jd = ws.jd;
         mat3d wu, ww, jue, jwe;
-        vector<mat3d> ju(nsol), jw(nsol);
-        vector< vector<double> > qcc(nsol, vector<double>(nsol));
-        vector< vector<double> > qcd(nsol, vector<double>(nsol));
-        vector< vector<double> > dchatdc(nsol, vector<double>(nsol));
+        vector<mat3d>& ju = ws.ju;
+        vector<mat3d>& jw = ws.jw;
+        vector< vector<double> >& qcc = ws.qcc;
+        vector< vector<double> >& qcd = ws.qcd;
+        vector< vector<double> >& dchatdc = ws.dchatdc;
         double sum;
         mat3ds De;
         for (i=0; i<neln; ++i)
@@ -1426,8 +1463,8 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffnessSS(FEShellElement& el,
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradMu(neln), gradMw(neln);
-    vector<double> Mu(neln), Mw(neln);
+    vec3d gradMu[FEElement::MAX_NODES], gradMw[FEElement::MAX_NODES];
+    double Mu[FEElement::MAX_NODES], Mw[FEElement::MAX_NODES];
     vec3d gradM;
     double tmp;
     
@@ -1447,6 +1484,9 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffnessSS(FEShellElement& el,
     // zero stiffness matrix
     ke.zero();
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // loop over gauss-points
     for (n=0; n<nint; ++n)
     {
@@ -1490,19 +1530,18 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffnessSS(FEShellElement& el,
         vec3d w = ppt.m_w;
         vec3d gradp = ppt.m_gradp;
         
-        vector<double> c(spt.m_c);
-        vector<vec3d> gradc(spt.m_gradc);
-        vector<int> z(nsol);
+        const vector<double>& c = spt.m_c;
+        const vector<vec3d>& gradc = spt.m_gradc;
+        vector<int>& z = ws.z;
         
-        vector<double> zz(nsol);
-        vector<double> kappa(spt.m_k);
+        const vector<double>& kappa = spt.m_k;
         
         // get the charge number
         for (isol=0; isol<nsol; ++isol)
             z[isol] = m_pMat->GetSolute(isol)->ChargeNumber();
         
-        vector<double> dkdJ(spt.m_dkdJ);
-        vector< vector<double> > dkdc(spt.m_dkdc);
+        const vector<double>& dkdJ = spt.m_dkdJ;
+        const vector< vector<double> >& dkdc = spt.m_dkdc;
         
         // evaluate the porosity and its derivative
         double phiw = m_pMat->Porosity(mp);
@@ -1516,21 +1555,22 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffnessSS(FEShellElement& el,
         mat3ds K = m_pMat->GetPermeability()->Permeability(mp);
         tens4ds dKdE = m_pMat->GetPermeability()->Tangent_Permeability_Strain(mp);
         
-        vector<mat3ds> dKdc(nsol);
-        vector<mat3ds> D(nsol);
-        vector<tens4ds> dDdE(nsol);
-        vector< vector<mat3ds> > dDdc(nsol, vector<mat3ds>(nsol));
-        vector<double> D0(nsol);
-        vector< vector<double> > dD0dc(nsol, vector<double>(nsol));
-        vector<double> dodc(nsol);
-        vector<mat3ds> dTdc(nsol);
-        vector<mat3ds> ImD(nsol);
+        vector<mat3ds>& dKdc = ws.dKdc;
+        vector<mat3ds>& D = ws.D;
+        vector<tens4ds>& dDdE = ws.dDdE;
+        vector< vector<mat3ds> >& dDdc = ws.dDdc;
+        vector<double>& D0 = ws.D0;
+        vector< vector<double> >& dD0dc = ws.dD0dc;
+        vector<double>& dodc = ws.dodc;
+        vector<mat3ds>& dTdc = ws.dTdc;
+        vector<mat3ds>& ImD = ws.ImD;
         mat3dd I(1);
         
         // evaluate the solvent supply and its derivatives
         mat3ds Phie; Phie.zero();
         double Phip = 0;
-        vector<double> Phic(nsol,0);
+        vector<double>& Phic = ws.Phic;
+        Phic.assign(nsol, 0);
         if (m_pMat->GetSolventSupply()) {
             Phie = m_pMat->GetSolventSupply()->Tangent_Supply_Strain(mp);
             Phip = m_pMat->GetSolventSupply()->Tangent_Supply_Pressure(mp);
@@ -1580,8 +1620,8 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffnessSS(FEShellElement& el,
         mat3ds Ki = K.inverse();
         mat3ds Ke(0,0,0,0,0,0);
         tens4ds G = dyad1s(Ki,I) - dyad4s(Ki,I)*2 - ddots(dyad2s(Ki),dKdE)*0.5;
-        vector<mat3ds> Gc(nsol);
-        vector<mat3ds> dKedc(nsol);
+        vector<mat3ds>& Gc = ws.Gc;
+        vector<mat3ds>& dKedc = ws.dKedc;
         for (isol=0; isol<nsol; ++isol) {
             Ke += ImD[isol]*(kappa[isol]*c[isol]/D0[isol]);
             G += dyad1s(ImD[isol],I)*(R*T*c[isol]*J/D0[isol]/2/phiw*(dkdJ[isol]-kappa[isol]/phiw*dpdJ))
@@ -1600,12 +1640,17 @@ bool FEMultiphasicShellDomain::ElementMultiphasicStiffnessSS(FEShellElement& el,
         
         // calculate all the matrices
         vec3d vtmp,gp,qpu, qpw;
-        vector<vec3d> gc(nsol),wc(nsol),wd(nsol),jce(nsol),jde(nsol);
-        vector< vector<vec3d> > jc(nsol, vector<vec3d>(nsol));
-        vector< vector<vec3d> > jd(nsol, vector<vec3d>(nsol));
+        vector<vec3d>& gc = ws.gc;
+        vector<vec3d>& wc = ws.wc;
+        vector<vec3d>& wd = ws.wd;
+        vector<vec3d>& jce = ws.jce;
+        vector<vec3d>& jde = ws.jde;
+        vector< vector<vec3d> >& jc = ws.jc;
+        vector< vector<vec3d> >& jd = ws.jd;
         mat3d wu, ww, jue, jwe;
-        vector<mat3d> ju(nsol), jw(nsol);
-        vector< vector<double> > dchatdc(nsol, vector<double>(nsol));
+        vector<mat3d>& ju = ws.ju;
+        vector<mat3d>& jw = ws.jw;
+        vector< vector<double> >& dchatdc = ws.dchatdc;
         double sum;
         mat3ds De;
         for (i=0; i<neln; ++i)
@@ -1842,8 +1887,9 @@ void FEMultiphasicShellDomain::MembraneReactionFluxes(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        vector<double>& fe = ws.fe;
+        vector<int>& lm = ws.lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -1968,8 +2014,9 @@ void FEMultiphasicShellDomain::MembraneReactionStiffnessMatrix(FESolver* psolver
     for (int iel=0; iel<NE; ++iel)
     {
         // element stiffness matrix
-        matrix ke;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        matrix& ke = ws.ke;
+        vector<int>& lm = ws.lm;
         
         FEShellElement& el = m_Elem[iel];
         UnpackMembraneLM(el, lm);
@@ -2150,6 +2197,10 @@ void FEMultiphasicShellDomain::Update(const FETimeInfo& tp)
     bool berr = false;
     int NE = (int) m_Elem.size();
     double dt = fem.GetTime().timeIncrement;
+	InitWorkspace();
+	
+    // the worker threads use the model (and log file) of this thread
+    FEModel* pfem = FECoreKernel::GetThreadModel();
 #pragma omp parallel for shared(NE, berr)
     for (int i=0; i<NE; ++i)
     {
@@ -2161,6 +2212,7 @@ void FEMultiphasicShellDomain::Update(const FETimeInfo& tp)
         {
 #pragma omp critical
             {
+                FEModelScope scope(pfem);
                 berr = true;
                 if (NegativeJacobian::m_boutput) e.print();
             }
@@ -2192,7 +2244,8 @@ void FEMultiphasicShellDomain::UpdateElementStress(int iel, double dt)
     // get the multiphasic material
     FEMultiphasic* pmb = m_pMat;
     const int nsol = (int)pmb->Solutes();
-    vector<int> sid(nsol);
+    FESoluteWorkspace& ws = m_ws.Get();
+    vector<int>& sid = ws.sid;
     for (j=0; j<nsol; ++j) sid[j] = pmb->GetSolute(j)->GetSoluteID();
     
     // get the shell element
@@ -2203,8 +2256,8 @@ void FEMultiphasicShellDomain::UpdateElementStress(int iel, double dt)
     
     // get the number of nodes
     neln = el.Nodes();
-    vector< vector<double> > cn(MAX_CDOFS, vector<double>(neln));
-    vector< vector<double> > dn(MAX_CDOFS, vector<double>(neln));
+    vector< vector<double> >& cn = ws.cn;
+    vector< vector<double> >& dn = ws.dn;
 
     // get the integration weights
     gw = el.GaussWeights();
@@ -2293,6 +2346,9 @@ void FEMultiphasicShellDomain::UpdateElementStress(int iel, double dt)
         // calculate the gradient of p at gauss-point
         ppt.m_gradp = gradient(el, pn, qn, n);
         
+        // the state has changed, so the electroneutrality condition must be solved again
+        spt.m_bzeta = false;
+        
         // update the fluid and solute fluxes
         // and evaluate the actual fluid pressure and solute concentration
         ppt.m_w = pmb->FluidFlux(mp);
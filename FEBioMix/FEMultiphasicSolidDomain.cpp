@@ -184,6 +184,9 @@ bool FEMultiphasicSolidDomain::Init()
 	}
 	SetDOFList(dofs);
 
+    // allocate the scratch data of the element kernels
+    InitWorkspace();
+    
     return true;
 }
 
@@ -327,6 +330,9 @@ void FEMultiphasicSolidDomain::InitMaterialPoints()
                 ps.m_gradc[isol] = gradient(el, c0[isol], n);
             }
             
+            // the state has changed, so the electroneutrality condition must be solved again
+            ps.m_bzeta = false;
+            
             ps.m_psi = m_pMat->ElectricPotential(mp);
             for (int isol = 0; isol<nsol; ++isol) {
                 ps.m_ca[isol] = m_pMat->Concentration(mp, isol);
@@ -481,12 +487,15 @@ void FEMultiphasicSolidDomain::InternalForces(FEGlobalVector& R)
     int nsol = m_pMat->Solutes();
     int ndpn = 4+nsol;
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        vector<double>& fe = ws.fe;
+        vector<int>& lm = ws.lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -534,6 +543,9 @@ void FEMultiphasicSolidDomain::ElementInternalForce(FESolidElement& el, vector<d
     
     double dt = GetFEModel()->GetTime().timeIncrement;
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // repeat for all integration points
     for (n=0; n<nint; ++n)
     {
@@ -566,9 +578,9 @@ void FEMultiphasicSolidDomain::ElementInternalForce(FESolidElement& el, vector<d
         // get the flux
         vec3d& w = bpt.m_w;
         
-        vector<vec3d> j(spt.m_j);
-        vector<int> z(nsol);
-        vector<double> kappa(spt.m_k);
+        const vector<vec3d>& j = spt.m_j;
+        vector<int>& z = ws.z;
+        const vector<double>& kappa = spt.m_k;
         vec3d je(0,0,0);
         
         for (isol=0; isol<nsol; ++isol) {
@@ -579,7 +591,8 @@ void FEMultiphasicSolidDomain::ElementInternalForce(FESolidElement& el, vector<d
         
         // evaluate the porosity, its derivative w.r.t. J, and its gradient
         double phiw = m_pMat->Porosity(mp);
-        vector<double> chat(nsol,0);
+        vector<double>& chat = ws.chat;
+        chat.assign(nsol, 0);
         
         // get the solvent supply
         double phiwhat = 0;
@@ -628,12 +641,15 @@ void FEMultiphasicSolidDomain::InternalForcesSS(FEGlobalVector& R)
     int nsol = m_pMat->Solutes();
     int ndpn = 4+nsol;
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        vector<double>& fe = ws.fe;
+        vector<int>& lm = ws.lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -681,6 +697,9 @@ void FEMultiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector
     
     double dt = GetFEModel()->GetTime().timeIncrement;
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // repeat for all integration points
     for (n=0; n<nint; ++n)
     {
@@ -706,9 +725,9 @@ void FEMultiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector
         // get the flux
         vec3d& w = bpt.m_w;
         
-        vector<vec3d> j(spt.m_j);
-        vector<int> z(nsol);
-        vector<double> kappa(spt.m_k);
+        const vector<vec3d>& j = spt.m_j;
+        vector<int>& z = ws.z;
+        const vector<double>& kappa = spt.m_k;
         vec3d je(0,0,0);
         
         for (isol=0; isol<nsol; ++isol) {
@@ -719,7 +738,8 @@ void FEMultiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector
         
         // evaluate the porosity, its derivative w.r.t. J, and its gradient
         double phiw = m_pMat->Porosity(mp);
-        vector<double> chat(nsol,0);
+        vector<double>& chat = ws.chat;
+        chat.assign(nsol, 0);
         
         // get the solvent supply
         double phiwhat = 0;
@@ -768,12 +788,15 @@ void FEMultiphasicSolidDomain::StiffnessMatrix(FESolver* psolver, bool bsymm)
     // repeat over all solid elements
     int NE = (int)m_Elem.size();
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int iel=0; iel<NE; ++iel)
     {
         // element stiffness matrix
-        matrix ke;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        matrix& ke = ws.ke;
+        vector<int>& lm = ws.lm;
         
         FESolidElement& el = m_Elem[iel];
         UnpackLM(el, lm);
@@ -801,12 +824,15 @@ void FEMultiphasicSolidDomain::StiffnessMatrixSS(FESolver* psolver, bool bsymm)
     // repeat over all solid elements
     int NE = (int)m_Elem.size();
     
+    InitWorkspace();
+    
 #pragma omp parallel for
     for (int iel=0; iel<NE; ++iel)
     {
         // element stiffness matrix
-        matrix ke;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        matrix& ke = ws.ke;
+        vector<int>& lm = ws.lm;
         
         FESolidElement& el = m_Elem[iel];
         UnpackLM(el, lm);
@@ -841,7 +867,7 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradN(neln);
+    vec3d gradN[FEElement::MAX_NODES];
     
     // gauss-weights
     double* gw = el.GaussWeights();
@@ -857,6 +883,9 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
     // zero stiffness matrix
     ke.zero();
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // loop over gauss-points
     for (n=0; n<nint; ++n)
     {
@@ -895,21 +924,21 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
         vec3d w = ppt.m_w;
         vec3d gradp = ppt.m_gradp;
         
-        vector<double> c(spt.m_c);
-        vector<vec3d> gradc(spt.m_gradc);
-        vector<int> z(nsol);
+        const vector<double>& c = spt.m_c;
+        const vector<vec3d>& gradc = spt.m_gradc;
+        vector<int>& z = ws.z;
         
-        vector<double> kappa(spt.m_k);
+        const vector<double>& kappa = spt.m_k;
         
         // get the charge number
         for (isol=0; isol<nsol; ++isol)
             z[isol] = m_pMat->GetSolute(isol)->ChargeNumber();
         
-        vector<double> dkdJ(spt.m_dkdJ);
-        vector< vector<double> > dkdc(spt.m_dkdc);
-        vector< vector<double> > dkdr(spt.m_dkdr);
-        vector< vector<double> > dkdJr(spt.m_dkdJr);
-        vector< vector< vector<double> > > dkdrc(spt.m_dkdrc);
+        const vector<double>& dkdJ = spt.m_dkdJ;
+        const vector< vector<double> >& dkdc = spt.m_dkdc;
+        const vector< vector<double> >& dkdr = spt.m_dkdr;
+        const vector< vector<double> >& dkdJr = spt.m_dkdJr;
+        const vector< vector< vector<double> > >& dkdrc = spt.m_dkdrc;
         
         // evaluate the porosity and its derivative
         double phiw = m_pMat->Porosity(mp);
@@ -924,22 +953,23 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
         mat3ds K = m_pMat->GetPermeability()->Permeability(mp);
         tens4ds dKdE = m_pMat->GetPermeability()->Tangent_Permeability_Strain(mp);
         
-        vector<mat3ds> dKdc(nsol);
-        vector<mat3ds> D(nsol);
-        vector<tens4ds> dDdE(nsol);
-        vector< vector<mat3ds> > dDdc(nsol, vector<mat3ds>(nsol));
-        vector<double> D0(nsol);
-        vector< vector<double> > dD0dc(nsol, vector<double>(nsol));
-        vector<double> dodc(nsol);
-        vector<mat3ds> dTdc(nsol);
-        vector<mat3ds> ImD(nsol);
+        vector<mat3ds>& dKdc = ws.dKdc;
+        vector<mat3ds>& D = ws.D;
+        vector<tens4ds>& dDdE = ws.dDdE;
+        vector< vector<mat3ds> >& dDdc = ws.dDdc;
+        vector<double>& D0 = ws.D0;
+        vector< vector<double> >& dD0dc = ws.dD0dc;
+        vector<double>& dodc = ws.dodc;
+        vector<mat3ds>& dTdc = ws.dTdc;
+        vector<mat3ds>& ImD = ws.ImD;
         mat3dd I(1);
         
         // evaluate the solvent supply and its derivatives
         mat3ds Phie; Phie.zero();
         double Phip = 0;
-        vector<double> Phic(nsol,0);
-        vector<mat3ds> dchatde(nsol);
+        vector<double>& Phic = ws.Phic;
+        Phic.assign(nsol, 0);
+        vector<mat3ds>& dchatde = ws.dchatde;
         if (m_pMat->GetSolventSupply()) {
             Phie = m_pMat->GetSolventSupply()->Tangent_Supply_Strain(mp);
             Phip = m_pMat->GetSolventSupply()->Tangent_Supply_Pressure(mp);
@@ -998,8 +1028,8 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
         mat3ds Ki = K.inverse();
         mat3ds Ke(0,0,0,0,0,0);
         tens4ds G = dyad1s(Ki,I) - dyad4s(Ki,I)*2 - ddots(dyad2s(Ki),dKdE)*0.5;
-        vector<mat3ds> Gc(nsol);
-        vector<mat3ds> dKedc(nsol);
+        vector<mat3ds>& Gc = ws.Gc;
+        vector<mat3ds>& dKedc = ws.dKedc;
         for (isol=0; isol<nsol; ++isol) {
             Ke += ImD[isol]*(kappa[isol]*c[isol]/D0[isol]);
             G += dyad1s(ImD[isol],I)*(R*T*c[isol]*J/D0[isol]/2/phiw*(dkdJ[isol]-kappa[isol]/phiw*dpdJ))
@@ -1018,12 +1048,15 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
         
         // calculate all the matrices
         vec3d vtmp,gp,qpu;
-        vector<vec3d> gc(nsol),qcu(nsol),wc(nsol),jce(nsol);
-        vector< vector<vec3d> > jc(nsol, vector<vec3d>(nsol));
+        vector<vec3d>& gc = ws.gc;
+        vector<vec3d>& qcu = ws.qcu;
+        vector<vec3d>& wc = ws.wc;
+        vector<vec3d>& jce = ws.jce;
+        vector< vector<vec3d> >& jc = ws.jc;
         mat3d wu, jue;
-        vector<mat3d> ju(nsol);
-        vector< vector<double> > qcc(nsol, vector<double>(nsol));
-        vector< vector<double> > dchatdc(nsol, vector<double>(nsol));
+        vector<mat3d>& ju = ws.ju;
+        vector< vector<double> >& qcc = ws.qcc;
+        vector< vector<double> >& dchatdc = ws.dchatdc;
         double sum;
         mat3ds De;
         for (i=0; i<neln; ++i)
@@ -1218,7 +1251,7 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradN(neln);
+    vec3d gradN[FEElement::MAX_NODES];
     
     // gauss-weights
     double* gw = el.GaussWeights();
@@ -1233,6 +1266,9 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
     // zero stiffness matrix
     ke.zero();
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // loop over gauss-points
     for (n=0; n<nint; ++n)
     {
@@ -1271,19 +1307,18 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
         vec3d w = ppt.m_w;
         vec3d gradp = ppt.m_gradp;
         
-        vector<double> c(spt.m_c);
-        vector<vec3d> gradc(spt.m_gradc);
-        vector<int> z(nsol);
+        const vector<double>& c = spt.m_c;
+        const vector<vec3d>& gradc = spt.m_gradc;
+        vector<int>& z = ws.z;
         
-        vector<double> zz(nsol);
-        vector<double> kappa(spt.m_k);
+        const vector<double>& kappa = spt.m_k;
         
         // get the charge number
         for (isol=0; isol<nsol; ++isol)
             z[isol] = m_pMat->GetSolute(isol)->ChargeNumber();
         
-        vector<double> dkdJ(spt.m_dkdJ);
-        vector< vector<double> > dkdc(spt.m_dkdc);
+        const vector<double>& dkdJ = spt.m_dkdJ;
+        const vector< vector<double> >& dkdc = spt.m_dkdc;
         
         // evaluate the porosity and its derivative
         double phiw = m_pMat->Porosity(mp);
@@ -1297,22 +1332,23 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
         mat3ds K = m_pMat->GetPermeability()->Permeability(mp);
         tens4ds dKdE = m_pMat->GetPermeability()->Tangent_Permeability_Strain(mp);
         
-        vector<mat3ds> dKdc(nsol);
-        vector<mat3ds> D(nsol);
-        vector<tens4ds> dDdE(nsol);
-        vector< vector<mat3ds> > dDdc(nsol, vector<mat3ds>(nsol));
-        vector<double> D0(nsol);
-        vector< vector<double> > dD0dc(nsol, vector<double>(nsol));
-        vector<double> dodc(nsol);
-        vector<mat3ds> dTdc(nsol);
-        vector<mat3ds> ImD(nsol);
+        vector<mat3ds>& dKdc = ws.dKdc;
+        vector<mat3ds>& D = ws.D;
+        vector<tens4ds>& dDdE = ws.dDdE;
+        vector< vector<mat3ds> >& dDdc = ws.dDdc;
+        vector<double>& D0 = ws.D0;
+        vector< vector<double> >& dD0dc = ws.dD0dc;
+        vector<double>& dodc = ws.dodc;
+        vector<mat3ds>& dTdc = ws.dTdc;
+        vector<mat3ds>& ImD = ws.ImD;
         mat3dd I(1);
         
         // evaluate the solvent supply and its derivatives
         double phiwhat = 0;
         mat3ds Phie; Phie.zero();
         double Phip = 0;
-        vector<double> Phic(nsol,0);
+        vector<double>& Phic = ws.Phic;
+        Phic.assign(nsol, 0);
         if (m_pMat->GetSolventSupply()) {
             phiwhat = m_pMat->GetSolventSupply()->Supply(mp);
             Phie = m_pMat->GetSolventSupply()->Tangent_Supply_Strain(mp);
@@ -1363,8 +1399,8 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
         mat3ds Ki = K.inverse();
         mat3ds Ke(0,0,0,0,0,0);
         tens4ds G = dyad1s(Ki,I) - dyad4s(Ki,I)*2 - ddots(dyad2s(Ki),dKdE)*0.5;
-        vector<mat3ds> Gc(nsol);
-        vector<mat3ds> dKedc(nsol);
+        vector<mat3ds>& Gc = ws.Gc;
+        vector<mat3ds>& dKedc = ws.dKedc;
         for (isol=0; isol<nsol; ++isol) {
             Ke += ImD[isol]*(kappa[isol]*c[isol]/D0[isol]);
             G += dyad1s(ImD[isol],I)*(R*T*c[isol]*J/D0[isol]/2/phiw*(dkdJ[isol]-kappa[isol]/phiw*dpdJ))
@@ -1383,11 +1419,13 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
         
         // calculate all the matrices
         vec3d vtmp,gp,qpu;
-        vector<vec3d> gc(nsol),wc(nsol),jce(nsol);
-        vector< vector<vec3d> > jc(nsol, vector<vec3d>(nsol));
+        vector<vec3d>& gc = ws.gc;
+        vector<vec3d>& wc = ws.wc;
+        vector<vec3d>& jce = ws.jce;
+        vector< vector<vec3d> >& jc = ws.jc;
         mat3d wu, jue;
-        vector<mat3d> ju(nsol);
-        vector< vector<double> > dchatdc(nsol, vector<double>(nsol));
+        vector<mat3d>& ju = ws.ju;
+        vector< vector<double> >& dchatdc = ws.dchatdc;
         double sum;
         mat3ds De;
         for (i=0; i<neln; ++i)
@@ -1530,6 +1568,10 @@ void FEMultiphasicSolidDomain::Update(const FETimeInfo& tp)
     bool berr = false;
     int NE = (int) m_Elem.size();
     double dt = fem.GetTime().timeIncrement;
+    InitWorkspace();
+    
+    // the worker threads use the model (and log file) of this thread
+    FEModel* pfem = FECoreKernel::GetThreadModel();
 #pragma omp parallel for shared(NE, berr)
     for (int i=0; i<NE; ++i)
     {
@@ -1541,6 +1583,7 @@ void FEMultiphasicSolidDomain::Update(const FETimeInfo& tp)
         {
 #pragma omp critical
             {
+                FEModelScope scope(pfem);
                 berr = true;
                 if (NegativeJacobian::m_boutput) e.print();
             }
@@ -1570,8 +1613,9 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
     // get the multiphasic material
     FEMultiphasic* pmb = m_pMat;
     const int nsol = (int)pmb->Solutes();
-    vector< vector<double> > ct(nsol, vector<double>(FEElement::MAX_NODES));
-    vector<int> sid(nsol);
+    FESoluteWorkspace& ws = m_ws.Get();
+    vector< vector<double> >& ct = ws.cn;
+    vector<int>& sid = ws.sid;
     for (j=0; j<nsol; ++j) sid[j] = pmb->GetSolute(j)->GetSoluteID();
     
     // get the solid element
@@ -1604,6 +1648,11 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
         }
     }
     
+    // get the deformation gradients and determinants at all integration points
+    mat3d Fn[FEElement::MAX_INTPOINTS];
+    double Jn[FEElement::MAX_INTPOINTS];
+    defgrads(el, Fn, Jn);
+    
     // loop over the integration points and calculate
     // the stress at the integration point
     for (n=0; n<nint; ++n)
@@ -1618,7 +1667,8 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
         pt.m_rt = el.Evaluate(rt, n);
         
         // get the deformation gradient and determinant
-        pt.m_J = defgrad(el, pt.m_F, n);
+        pt.m_F = Fn[n];
+        pt.m_J = Jn[n];
         
         // multiphasic material point data
         FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
@@ -1643,6 +1693,9 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
             spt.m_gradc[k] = gradient(el, &ct[k][0], n);
         }
         
+        // the state has changed, so the electroneutrality condition must be solved again
+        spt.m_bzeta = false;
+        
         // update the fluid and solute fluxes
         // and evaluate the actual fluid pressure and solute concentration
         ppt.m_w = pmb->FluidFlux(mp);
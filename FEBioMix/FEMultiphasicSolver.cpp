@@ -490,6 +490,8 @@ bool FEMultiphasicSolver::Residual(vector<double>& R)
 	FEMesh& mesh = m_fem.GetMesh();
 
 	// internal stress work
+	// (collected in per-thread buffers)
+	RHS.BeginParallelAssembly(m_asmbuf);
 	for (i=0; i<mesh.Domains(); ++i)
 	{
         FEDomain& dom = mesh.Domain(i);
@@ -525,6 +527,7 @@ bool FEMultiphasicSolver::Residual(vector<double>& R)
         else if (ped)
             ped->InternalForces(RHS);
     }
+	RHS.EndParallelAssembly();
     
 	// calculate forces due to surface loads
 	int nsl = m_fem.SurfaceLoads();
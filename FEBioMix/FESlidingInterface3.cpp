@@ -30,10 +30,12 @@ SOFTWARE.*/
 #include "FEBiphasic.h"
 #include "FEBiphasicSolute.h"
 #include "FECore/FEModel.h"
+#include "FECore/FEBlockAssembler.h"
 #include "FECore/log.h"
 #include "FECore/DOFS.h"
 #include "FECore/FENormalProjection.h"
 #include <FECore/FEAnalysis.h>
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -578,7 +580,7 @@ void FESlidingSurface3::GetNodalContactTraction(int nface, vec3d* tn)
 
 FESlidingInterface3::FESlidingInterface3(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 	
 	// initial values
@@ -600,6 +602,9 @@ FESlidingInterface3::FESlidingInterface3(FEModel* pfem) : FEContactInterface(pfe
 	m_bautopen = false;
     m_breloc = false;
     m_bsmaug = false;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
 	
 	m_naugmin = 0;
 	m_naugmax = 10;
@@ -1156,8 +1161,6 @@ void FESlidingInterface3::Update(int niter, const FETimeInfo& tp)
     
 	double R = m_srad*fem.GetMesh().GetBoundingBox().radius();
 	
-	static int naug = 0;
-	static int biter = 0;
 
 	// get the iteration number
 	// we need this number to see if we can do segment updates or not
@@ -1165,13 +1168,13 @@ void FESlidingInterface3::Update(int niter, const FETimeInfo& tp)
 	FEAnalysis* pstep = fem.GetCurrentStep();
 	FESolver* psolver = pstep->GetFESolver();
 	if (psolver->m_niter == 0) {
-		biter = 0;
-		naug = psolver->m_naug;
-	} else if (psolver->m_naug > naug) {
-		biter = psolver->m_niter;
-		naug = psolver->m_naug;
+		m_biter = 0;
+		m_naug = psolver->m_naug;
+	} else if (psolver->m_naug > m_naug) {
+		m_biter = psolver->m_niter;
+		m_naug = psolver->m_naug;
 	}
-	niter = psolver->m_niter - biter;
+	niter = psolver->m_niter - m_biter;
 	bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
 	// get the logfile
 	//	Logfile& log = GetLogfile();
@@ -1179,10 +1182,9 @@ void FESlidingInterface3::Update(int niter, const FETimeInfo& tp)
 	
 	// project the surfaces onto each other
 	// this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
 	if (m_btwo_pass || m_ss.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-    bfirst = false;
+    m_bfirst = false;
 	
 	// Update the net contact pressures
 	UpdateContactPressures();
@@ -1290,11 +1292,7 @@ void FESlidingInterface3::Update(int niter, const FETimeInfo& tp)
 //-----------------------------------------------------------------------------
 void FESlidingInterface3::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 {
-	vector<int> sLM, mLM, LM, en;
-	vector<double> fe;
 	const int MN = FEElement::MAX_NODES;
-	double detJ[MN], w[MN], *Hs, Hm[MN];
-	double N[10*MN];
 
 	FEModel& fem = *GetFEModel();
 
@@ -1312,213 +1310,227 @@ void FESlidingInterface3::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 		FESlidingSurface3& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all slave elements
-		for (int i = 0; i<ss.Elements(); ++i)
+		// (the element vectors are evaluated in parallel and assembled in element order)
+		int ne = ss.Elements();
+		vector<vec3d> Fs(ne, vec3d(0,0,0)), Fm(ne, vec3d(0,0,0));
+		FEBlockAssembler A(R, ne);
+		while (A.NextBlock())
 		{
-			// get the surface element
-			FESurfaceElement& se = ss.Element(i);
+			int n0 = A.BlockStart();
+			int n1 = A.BlockEnd();
+			#pragma omp parallel
+			{
+				vector<int> sLM, mLM, LM, en;
+				vector<double> fe;
+				double detJ[MN], w[MN], *Hs, Hm[MN];
+				double N[10*MN];
+
+				#pragma omp for schedule(dynamic)
+				for (int i=n0; i<n1; ++i)
+				{
+					// get the surface element
+					FESurfaceElement& se = ss.Element(i);
 
-			bool sporo = ss.m_poro[i];
-			int sid = ss.m_solu[i];
-			bool ssolu = (sid > -1) ? true : false;
+					bool sporo = ss.m_poro[i];
+					int sid = ss.m_solu[i];
+					bool ssolu = (sid > -1) ? true : false;
 			
-			// get the nr of nodes and integration points
-			int nseln = se.Nodes();
-			int nint = se.GaussPoints();
+					// get the nr of nodes and integration points
+					int nseln = se.Nodes();
+					int nint = se.GaussPoints();
 			
-			// copy the LM vector; we'll need it later
-			ss.UnpackLM(se, sLM);
+					// copy the LM vector; we'll need it later
+					ss.UnpackLM(se, sLM);
 			
-			// we calculate all the metrics we need before we
-			// calculate the nodal forces
-			for (int j = 0; j<nint; ++j)
-			{
-				// get the base vectors
-				vec3d g[2];
-				ss.CoBaseVectors(se, j, g);
+					// we calculate all the metrics we need before we
+					// calculate the nodal forces
+					for (int j = 0; j<nint; ++j)
+					{
+						// get the base vectors
+						vec3d g[2];
+						ss.CoBaseVectors(se, j, g);
 				
-				// jacobians: J = |g0xg1|
-				detJ[j] = (g[0] ^ g[1]).norm();
+						// jacobians: J = |g0xg1|
+						detJ[j] = (g[0] ^ g[1]).norm();
 				
-				// integration weights
-				w[j] = se.GaussWeights()[j];
-			}
+						// integration weights
+						w[j] = se.GaussWeights()[j];
+					}
 			
-			// loop over all integration points
-			// note that we are integrating over the current surface
-			for (int j = 0; j<nint; ++j)
-			{
-				FESlidingSurface3::Data& pt = ss.m_Data[i][j];
-				// get the master element
-				FESurfaceElement* pme = pt.m_pme;
-				if (pme)
-				{
-					// get the master element
-					FESurfaceElement& me = *pme;
+					// loop over all integration points
+					// note that we are integrating over the current surface
+					for (int j = 0; j<nint; ++j)
+					{
+						FESlidingSurface3::Data& pt = ss.m_Data[i][j];
+						// get the master element
+						FESurfaceElement* pme = pt.m_pme;
+						if (pme)
+						{
+							// get the master element
+							FESurfaceElement& me = *pme;
 
-					bool mporo = ms.m_poro[pme->m_lid];
-					int mid = ms.m_solu[pme->m_lid];
-					bool msolu = (mid > -1) ? true : false;
+							bool mporo = ms.m_poro[pme->m_lid];
+							int mid = ms.m_solu[pme->m_lid];
+							bool msolu = (mid > -1) ? true : false;
 					
-					// get the nr of master element nodes
-					int nmeln = me.Nodes();
+							// get the nr of master element nodes
+							int nmeln = me.Nodes();
 					
-					// copy LM vector
-					ms.UnpackLM(me, mLM);
+							// copy LM vector
+							ms.UnpackLM(me, mLM);
 					
-					// calculate degrees of freedom
-					int ndof = 3*(nseln + nmeln);
+							// calculate degrees of freedom
+							int ndof = 3*(nseln + nmeln);
 					
-					// build the LM vector
-					LM.resize(ndof);
-					for (int k = 0; k<nseln; ++k)
-					{
-						LM[3*k  ] = sLM[3*k  ];
-						LM[3*k+1] = sLM[3*k+1];
-						LM[3*k+2] = sLM[3*k+2];
-					}
+							// build the LM vector
+							LM.resize(ndof);
+							for (int k = 0; k<nseln; ++k)
+							{
+								LM[3*k  ] = sLM[3*k  ];
+								LM[3*k+1] = sLM[3*k+1];
+								LM[3*k+2] = sLM[3*k+2];
+							}
 					
-					for (int k = 0; k<nmeln; ++k)
-					{
-						LM[3*(k+nseln)  ] = mLM[3*k  ];
-						LM[3*(k+nseln)+1] = mLM[3*k+1];
-						LM[3*(k+nseln)+2] = mLM[3*k+2];
-					}
+							for (int k = 0; k<nmeln; ++k)
+							{
+								LM[3*(k+nseln)  ] = mLM[3*k  ];
+								LM[3*(k+nseln)+1] = mLM[3*k+1];
+								LM[3*(k+nseln)+2] = mLM[3*k+2];
+							}
 					
-					// build the en vector
-					en.resize(nseln+nmeln);
-					for (int k = 0; k<nseln; ++k) en[k] = se.m_node[k];
-					for (int k = 0; k<nmeln; ++k) en[k + nseln] = me.m_node[k];
+							// build the en vector
+							en.resize(nseln+nmeln);
+							for (int k = 0; k<nseln; ++k) en[k] = se.m_node[k];
+							for (int k = 0; k<nmeln; ++k) en[k + nseln] = me.m_node[k];
 					
-					// get slave element shape functions
-					Hs = se.H(j);
+							// get slave element shape functions
+							Hs = se.H(j);
 					
-					// get master element shape functions
-					double r = pt.m_rs[0];
-					double s = pt.m_rs[1];
-					me.shape_fnc(Hm, r, s);
+							// get master element shape functions
+							double r = pt.m_rs[0];
+							double s = pt.m_rs[1];
+							me.shape_fnc(Hm, r, s);
 					
-					// get normal vector
-					vec3d nu = pt.m_nu;
+							// get normal vector
+							vec3d nu = pt.m_nu;
 					
-					// gap function
-					double g = pt.m_gap;
+							// gap function
+							double g = pt.m_gap;
 					
-					// lagrange multiplier
-					double Lm = pt.m_Lmd;
+							// lagrange multiplier
+							double Lm = pt.m_Lmd;
 					
-					// penalty 
-					double eps = m_epsn*pt.m_epsn;
+							// penalty 
+							double eps = m_epsn*pt.m_epsn;
 					
-					// contact traction
-					double tn = Lm + eps*g;
-					tn = MBRACKET(tn);
+							// contact traction
+							double tn = Lm + eps*g;
+							tn = MBRACKET(tn);
 					
-					// calculate the force vector
-					fe.resize(ndof);
-					zero(fe);
+							// calculate the force vector
+							fe.resize(ndof);
+							zero(fe);
 					
-					for (int k = 0; k<nseln; ++k)
-					{
-						N[3*k  ] = -Hs[k]*nu.x;
-						N[3*k+1] = -Hs[k]*nu.y;
-						N[3*k+2] = -Hs[k]*nu.z;
-					}
+							for (int k = 0; k<nseln; ++k)
+							{
+								N[3*k  ] = -Hs[k]*nu.x;
+								N[3*k+1] = -Hs[k]*nu.y;
+								N[3*k+2] = -Hs[k]*nu.z;
+							}
 					
-					for (int k = 0; k<nmeln; ++k)
-					{
-						N[3*(k+nseln)  ] = Hm[k]*nu.x;
-						N[3*(k+nseln)+1] = Hm[k]*nu.y;
-						N[3*(k+nseln)+2] = Hm[k]*nu.z;
-					}
+							for (int k = 0; k<nmeln; ++k)
+							{
+								N[3*(k+nseln)  ] = Hm[k]*nu.x;
+								N[3*(k+nseln)+1] = Hm[k]*nu.y;
+								N[3*(k+nseln)+2] = Hm[k]*nu.z;
+							}
 					
-					for (int k = 0; k<ndof; ++k) fe[k] += tn*N[k] * detJ[j] * w[j];
+							for (int k = 0; k<ndof; ++k) fe[k] += tn*N[k] * detJ[j] * w[j];
 					
-                    for (int k=0; k<nseln; ++k)
-                    {
-                        ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
-                    }
+                            for (int k=0; k<nseln; ++k)
+                            {
+                                Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                            }
                     
-                    for (int k = 0; k<nmeln; ++k)
-                    {
-                        ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
-                    }
+                            for (int k = 0; k<nmeln; ++k)
+                            {
+                                Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                            }
                     
-					// assemble the global residual
-					R.Assemble(en, LM, fe);
+							// assemble the global residual
+							A.Add(i, en, LM, fe);
 					
-					// do the biphasic stuff
-					if (tn > 0)
-					{
-						if (sporo && mporo)
-						{
-							// calculate nr of pressure dofs
-							int ndof = nseln + nmeln;
+							// do the biphasic stuff
+							if (tn > 0)
+							{
+								if (sporo && mporo)
+								{
+									// calculate nr of pressure dofs
+									int ndof = nseln + nmeln;
 							
-							// calculate the flow rate
-							double epsp = m_epsp*pt.m_epsp;
+									// calculate the flow rate
+									double epsp = m_epsp*pt.m_epsp;
 							
-							double wn = pt.m_Lmp + epsp*pt.m_pg;
+									double wn = pt.m_Lmp + epsp*pt.m_pg;
 							
-							// fill the LM
-							LM.resize(ndof);
-							for (int k = 0; k<nseln; ++k) LM[k] = sLM[3 * nseln + k];
-							for (int k = 0; k<nmeln; ++k) LM[k + nseln] = mLM[3 * nmeln + k];
+									// fill the LM
+									LM.resize(ndof);
+									for (int k = 0; k<nseln; ++k) LM[k] = sLM[3 * nseln + k];
+									for (int k = 0; k<nmeln; ++k) LM[k + nseln] = mLM[3 * nmeln + k];
 							
-							// fill the force array
-							fe.resize(ndof);
-							zero(fe);
-							for (int k = 0; k<nseln; ++k) N[k] = Hs[k];
-							for (int k = 0; k<nmeln; ++k) N[k + nseln] = -Hm[k];
+									// fill the force array
+									fe.resize(ndof);
+									zero(fe);
+									for (int k = 0; k<nseln; ++k) N[k] = Hs[k];
+									for (int k = 0; k<nmeln; ++k) N[k + nseln] = -Hm[k];
 							
-							for (int k = 0; k<ndof; ++k) fe[k] += dt*wn*N[k] * detJ[j] * w[j];
+									for (int k = 0; k<ndof; ++k) fe[k] += dt*wn*N[k] * detJ[j] * w[j];
 							
-							// assemble residual
-							R.Assemble(en, LM, fe);
-						}
-						if (ssolu && msolu && (sid == mid))
-						{
-							// calculate nr of concentration dofs
-							int ndof = nseln + nmeln;
+									// assemble residual
+									A.Add(i, en, LM, fe);
+								}
+								if (ssolu && msolu && (sid == mid))
+								{
+									// calculate nr of concentration dofs
+									int ndof = nseln + nmeln;
 							
-							// calculate the flow rate
-							double epsc = m_epsc*pt.m_epsc;
+									// calculate the flow rate
+									double epsc = m_epsc*pt.m_epsc;
 							
-							double jn = pt.m_Lmc + epsc*pt.m_cg;
+									double jn = pt.m_Lmc + epsc*pt.m_cg;
 							
-							// fill the LM
-							LM.resize(ndof);
-							for (int k=0; k<nseln; ++k) LM[k        ] = sLM[(4+sid)*nseln+k];
-							for (int k=0; k<nmeln; ++k) LM[k + nseln] = mLM[(4+mid)*nmeln+k];
+									// fill the LM
+									LM.resize(ndof);
+									for (int k=0; k<nseln; ++k) LM[k        ] = sLM[(4+sid)*nseln+k];
+									for (int k=0; k<nmeln; ++k) LM[k + nseln] = mLM[(4+mid)*nmeln+k];
 							
-							// fill the force array
-							fe.resize(ndof);
-							zero(fe);
-							for (int k=0; k<nseln; ++k) N[k      ] =  Hs[k];
-							for (int k=0; k<nmeln; ++k) N[k+nseln] = -Hm[k];
+									// fill the force array
+									fe.resize(ndof);
+									zero(fe);
+									for (int k=0; k<nseln; ++k) N[k      ] =  Hs[k];
+									for (int k=0; k<nmeln; ++k) N[k+nseln] = -Hm[k];
 							
-							for (int k = 0; k<ndof; ++k) fe[k] += dt*jn*N[k] * detJ[j] * w[j];
+									for (int k = 0; k<ndof; ++k) fe[k] += dt*jn*N[k] * detJ[j] * w[j];
 							
-							// assemble residual
-							R.Assemble(en, LM, fe);
+									// assemble residual
+									A.Add(i, en, LM, fe);
+								}
+							}
 						}
 					}
 				}
 			}
 		}
+
+		// add up the contact forces
+		for (int i=0; i<ne; ++i) { ss.m_Ft += Fs[i]; ms.m_Ft += Fm[i]; }
 	}
 }
 
 //-----------------------------------------------------------------------------
 void FESlidingInterface3::StiffnessMatrix(FESolver* psolver, const FETimeInfo& tp)
 {
-	int i, j, k, l;
-	vector<int> sLM, mLM, LM, en;
 	const int MN = FEElement::MAX_NODES;
-	double detJ[MN], w[MN], *Hs, Hm[MN];
-	double pt[MN], dpr[MN], dps[MN];
-	double ct[MN], dcr[MN], dcs[MN];
-	double N[10*MN];
-	matrix ke;
 
 	FEModel& fem = *GetFEModel();
 
@@ -1550,553 +1562,573 @@ void FESlidingInterface3::StiffnessMatrix(FESolver* psolver, const FETimeInfo& t
 		FESlidingSurface3& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all slave elements
-		for (i=0; i<ss.Elements(); ++i)
+		// (the element matrices are evaluated in parallel and assembled in element order)
+		int ne = ss.Elements();
+		FEBlockAssembler A(psolver, ne);
+		while (A.NextBlock())
 		{
-			// get ths slave element
-			FESurfaceElement& se = ss.Element(i);
+			int n0 = A.BlockStart();
+			int n1 = A.BlockEnd();
+			#pragma omp parallel
+			{
+				int j, k, l;
+				vector<int> sLM, mLM, LM, en;
+				double detJ[MN], w[MN], *Hs, Hm[MN];
+				double pt[MN], dpr[MN], dps[MN];
+				double ct[MN], dcr[MN], dcs[MN];
+				double N[10*MN];
+				matrix ke;
+
+				#pragma omp for schedule(dynamic)
+				for (int i=n0; i<n1; ++i)
+				{
+					// get ths slave element
+					FESurfaceElement& se = ss.Element(i);
 
-			bool sporo = ss.m_poro[i];
-			int sid = ss.m_solu[i];
-			bool ssolu = (sid > -1) ? true : false;
+					bool sporo = ss.m_poro[i];
+					int sid = ss.m_solu[i];
+					bool ssolu = (sid > -1) ? true : false;
 			
-			// get nr of nodes and integration points
-			int nseln = se.Nodes();
-			int nint = se.GaussPoints();
+					// get nr of nodes and integration points
+					int nseln = se.Nodes();
+					int nint = se.GaussPoints();
 
-			double pn[FEElement::MAX_NODES], cn[FEElement::MAX_NODES];
-			for (j=0; j<nseln; ++j)
-			{
-				pn[j] = ss.GetMesh()->Node(se.m_node[j]).get(m_dofP);
-				cn[j] = ss.GetMesh()->Node(se.m_node[j]).get(m_dofC + sid);
-			}
+					double pn[FEElement::MAX_NODES], cn[FEElement::MAX_NODES];
+					for (j=0; j<nseln; ++j)
+					{
+						pn[j] = ss.GetMesh()->Node(se.m_node[j]).get(m_dofP);
+						cn[j] = ss.GetMesh()->Node(se.m_node[j]).get(m_dofC + sid);
+					}
 			
-			// copy the LM vector
-			ss.UnpackLM(se, sLM);
+					// copy the LM vector
+					ss.UnpackLM(se, sLM);
 			
-			// we calculate all the metrics we need before we
-			// calculate the nodal forces
-			for (j=0; j<nint; ++j)
-			{
-				// get the base vectors
-				vec3d g[2];
-				ss.CoBaseVectors(se, j, g);
+					// we calculate all the metrics we need before we
+					// calculate the nodal forces
+					for (j=0; j<nint; ++j)
+					{
+						// get the base vectors
+						vec3d g[2];
+						ss.CoBaseVectors(se, j, g);
 				
-				// jacobians: J = |g0xg1|
-				detJ[j] = (g[0] ^ g[1]).norm();
+						// jacobians: J = |g0xg1|
+						detJ[j] = (g[0] ^ g[1]).norm();
 				
-				// integration weights
-				w[j] = se.GaussWeights()[j];
+						// integration weights
+						w[j] = se.GaussWeights()[j];
 				
-				// pressure
-				if (sporo)
-				{
-					pt[j] = se.eval(pn, j);
-					dpr[j] = se.eval_deriv1(pn, j);
-					dps[j] = se.eval_deriv2(pn, j);
-				}
-				// concentration
-				if (ssolu)
-				{
-					ct[j] = se.eval(cn, j);
-					dcr[j] = se.eval_deriv1(cn, j);
-					dcs[j] = se.eval_deriv2(cn, j);
-				}
-			}
+						// pressure
+						if (sporo)
+						{
+							pt[j] = se.eval(pn, j);
+							dpr[j] = se.eval_deriv1(pn, j);
+							dps[j] = se.eval_deriv2(pn, j);
+						}
+						// concentration
+						if (ssolu)
+						{
+							ct[j] = se.eval(cn, j);
+							dcr[j] = se.eval_deriv1(cn, j);
+							dcs[j] = se.eval_deriv2(cn, j);
+						}
+					}
 			
-			// loop over all integration points
-			for (j=0; j<nint; ++j)
-			{
-				FESlidingSurface3::Data& pt = ss.m_Data[i][j];
+					// loop over all integration points
+					for (j=0; j<nint; ++j)
+					{
+						FESlidingSurface3::Data& pt = ss.m_Data[i][j];
 
-				// get the master element
-				FESurfaceElement* pme = pt.m_pme;
-				if (pme)
-				{
-					FESurfaceElement& me = *pme;
+						// get the master element
+						FESurfaceElement* pme = pt.m_pme;
+						if (pme)
+						{
+							FESurfaceElement& me = *pme;
 
-					bool mporo = ms.m_poro[pme->m_lid];
-					int mid = ms.m_solu[pme->m_lid];
-					bool msolu = (mid > -1) ? true : false;
+							bool mporo = ms.m_poro[pme->m_lid];
+							int mid = ms.m_solu[pme->m_lid];
+							bool msolu = (mid > -1) ? true : false;
 					
-					// get the nr of master nodes
-					int nmeln = me.Nodes();
+							// get the nr of master nodes
+							int nmeln = me.Nodes();
 
-					// nodal data
-					double pm[FEElement::MAX_NODES], cm[FEElement::MAX_NODES];
-					for (k=0; k<nmeln; ++k)
-					{
-						pm[k] = ms.GetMesh()->Node(me.m_node[k]).get(m_dofP);
-						cm[k] = ms.GetMesh()->Node(me.m_node[k]).get(m_dofC + mid);
-					}
+							// nodal data
+							double pm[FEElement::MAX_NODES], cm[FEElement::MAX_NODES];
+							for (k=0; k<nmeln; ++k)
+							{
+								pm[k] = ms.GetMesh()->Node(me.m_node[k]).get(m_dofP);
+								cm[k] = ms.GetMesh()->Node(me.m_node[k]).get(m_dofC + mid);
+							}
 					
-					// copy the LM vector
-					ms.UnpackLM(me, mLM);
+							// copy the LM vector
+							ms.UnpackLM(me, mLM);
 					
-					int ndpn;	// number of dofs per node
-					int ndof;	// number of dofs in stiffness matrix
+							int ndpn;	// number of dofs per node
+							int ndof;	// number of dofs in stiffness matrix
 					
-					if (ssolu && msolu && (sid == mid)) {
-						// calculate dofs for biphasic-solute contact
-						ndpn = 5;
-						ndof = ndpn*(nseln+nmeln);
+							if (ssolu && msolu && (sid == mid)) {
+								// calculate dofs for biphasic-solute contact
+								ndpn = 5;
+								ndof = ndpn*(nseln+nmeln);
 						
-						// build the LM vector
-						LM.resize(ndof);
+								// build the LM vector
+								LM.resize(ndof);
 						
-						for (k=0; k<nseln; ++k)
-						{
-							LM[ndpn*k  ] = sLM[3*k  ];			// x-dof
-							LM[ndpn*k+1] = sLM[3*k+1];			// y-dof
-							LM[ndpn*k+2] = sLM[3*k+2];			// z-dof
-							LM[ndpn*k+3] = sLM[3*nseln+k];		// p-dof
-							LM[ndpn*k+4] = sLM[(4+sid)*nseln+k];		// c-dof
-						}
-						for (k=0; k<nmeln; ++k)
-						{
-							LM[ndpn*(k+nseln)  ] = mLM[3*k  ];			// x-dof
-							LM[ndpn*(k+nseln)+1] = mLM[3*k+1];			// y-dof
-							LM[ndpn*(k+nseln)+2] = mLM[3*k+2];			// z-dof
-							LM[ndpn*(k+nseln)+3] = mLM[3*nmeln+k];		// p-dof
-							LM[ndpn*(k+nseln)+4] = mLM[(4+mid)*nmeln+k];		// c-dof
-						}
-					}
+								for (k=0; k<nseln; ++k)
+								{
+									LM[ndpn*k  ] = sLM[3*k  ];			// x-dof
+									LM[ndpn*k+1] = sLM[3*k+1];			// y-dof
+									LM[ndpn*k+2] = sLM[3*k+2];			// z-dof
+									LM[ndpn*k+3] = sLM[3*nseln+k];		// p-dof
+									LM[ndpn*k+4] = sLM[(4+sid)*nseln+k];		// c-dof
+								}
+								for (k=0; k<nmeln; ++k)
+								{
+									LM[ndpn*(k+nseln)  ] = mLM[3*k  ];			// x-dof
+									LM[ndpn*(k+nseln)+1] = mLM[3*k+1];			// y-dof
+									LM[ndpn*(k+nseln)+2] = mLM[3*k+2];			// z-dof
+									LM[ndpn*(k+nseln)+3] = mLM[3*nmeln+k];		// p-dof
+									LM[ndpn*(k+nseln)+4] = mLM[(4+mid)*nmeln+k];		// c-dof
+								}
+							}
 					
-					else if (sporo && mporo) {
-						// calculate dofs for biphasic contact
-						ndpn = 4;
-						ndof = ndpn*(nseln+nmeln);
+							else if (sporo && mporo) {
+								// calculate dofs for biphasic contact
+								ndpn = 4;
+								ndof = ndpn*(nseln+nmeln);
 						
-						// build the LM vector
-						LM.resize(ndof);
+								// build the LM vector
+								LM.resize(ndof);
 						
-						for (k=0; k<nseln; ++k)
-						{
-							LM[ndpn*k  ] = sLM[3*k  ];			// x-dof
-							LM[ndpn*k+1] = sLM[3*k+1];			// y-dof
-							LM[ndpn*k+2] = sLM[3*k+2];			// z-dof
-							LM[ndpn*k+3] = sLM[3*nseln+k];		// p-dof
-						}
-						for (k=0; k<nmeln; ++k)
-						{
-							LM[ndpn*(k+nseln)  ] = mLM[3*k  ];			// x-dof
-							LM[ndpn*(k+nseln)+1] = mLM[3*k+1];			// y-dof
-							LM[ndpn*(k+nseln)+2] = mLM[3*k+2];			// z-dof
-							LM[ndpn*(k+nseln)+3] = mLM[3*nmeln+k];		// p-dof
-						}
-					}
+								for (k=0; k<nseln; ++k)
+								{
+									LM[ndpn*k  ] = sLM[3*k  ];			// x-dof
+									LM[ndpn*k+1] = sLM[3*k+1];			// y-dof
+									LM[ndpn*k+2] = sLM[3*k+2];			// z-dof
+									LM[ndpn*k+3] = sLM[3*nseln+k];		// p-dof
+								}
+								for (k=0; k<nmeln; ++k)
+								{
+									LM[ndpn*(k+nseln)  ] = mLM[3*k  ];			// x-dof
+									LM[ndpn*(k+nseln)+1] = mLM[3*k+1];			// y-dof
+									LM[ndpn*(k+nseln)+2] = mLM[3*k+2];			// z-dof
+									LM[ndpn*(k+nseln)+3] = mLM[3*nmeln+k];		// p-dof
+								}
+							}
 					
-					else {
-						// calculate dofs for elastic contact
-						ndpn = 3;
-						ndof = ndpn*(nseln + nmeln);
+							else {
+								// calculate dofs for elastic contact
+								ndpn = 3;
+								ndof = ndpn*(nseln + nmeln);
 						
-						// build the LM vector
-						LM.resize(ndof);
+								// build the LM vector
+								LM.resize(ndof);
 						
-						for (k=0; k<nseln; ++k)
-						{
-							LM[3*k  ] = sLM[3*k  ];
-							LM[3*k+1] = sLM[3*k+1];
-							LM[3*k+2] = sLM[3*k+2];
-						}
+								for (k=0; k<nseln; ++k)
+								{
+									LM[3*k  ] = sLM[3*k  ];
+									LM[3*k+1] = sLM[3*k+1];
+									LM[3*k+2] = sLM[3*k+2];
+								}
 						
-						for (k=0; k<nmeln; ++k)
-						{
-							LM[3*(k+nseln)  ] = mLM[3*k  ];
-							LM[3*(k+nseln)+1] = mLM[3*k+1];
-							LM[3*(k+nseln)+2] = mLM[3*k+2];
-						}
-					}
+								for (k=0; k<nmeln; ++k)
+								{
+									LM[3*(k+nseln)  ] = mLM[3*k  ];
+									LM[3*(k+nseln)+1] = mLM[3*k+1];
+									LM[3*(k+nseln)+2] = mLM[3*k+2];
+								}
+							}
 					
-					// build the en vector
-					en.resize(nseln+nmeln);
-					for (k=0; k<nseln; ++k) en[k      ] = se.m_node[k];
-					for (k=0; k<nmeln; ++k) en[k+nseln] = me.m_node[k];
+							// build the en vector
+							en.resize(nseln+nmeln);
+							for (k=0; k<nseln; ++k) en[k      ] = se.m_node[k];
+							for (k=0; k<nmeln; ++k) en[k+nseln] = me.m_node[k];
 					
-					// slave shape functions
-					Hs = se.H(j);
+							// slave shape functions
+							Hs = se.H(j);
 					
-					// master shape functions
-					double r = pt.m_rs[0];
-					double s = pt.m_rs[1];
-					me.shape_fnc(Hm, r, s);
+							// master shape functions
+							double r = pt.m_rs[0];
+							double s = pt.m_rs[1];
+							me.shape_fnc(Hm, r, s);
 					
-					// get slave normal vector
-					vec3d nu = pt.m_nu;
+							// get slave normal vector
+							vec3d nu = pt.m_nu;
 					
-					// gap function
-					double g = pt.m_gap;
+							// gap function
+							double g = pt.m_gap;
 					
-					// lagrange multiplier
-					double Lm = pt.m_Lmd;
+							// lagrange multiplier
+							double Lm = pt.m_Lmd;
 					
-					// penalty 
-					double eps = m_epsn*pt.m_epsn;
+							// penalty 
+							double eps = m_epsn*pt.m_epsn;
 					
-					// contact traction
-					double tn = Lm + eps*g;
-					tn = MBRACKET(tn);
+							// contact traction
+							double tn = Lm + eps*g;
+							tn = MBRACKET(tn);
 					
-					//	double dtn = m_eps*HEAVYSIDE(Lm + eps*g);
-					double dtn = (tn > 0.? eps :0.);
+							//	double dtn = m_eps*HEAVYSIDE(Lm + eps*g);
+							double dtn = (tn > 0.? eps :0.);
 					
-					// create the stiffness matrix
-					ke.resize(ndof, ndof); ke.zero();
+							// create the stiffness matrix
+							ke.resize(ndof, ndof); ke.zero();
 					
-					// --- S O L I D - S O L I D   C O N T A C T ---
+							// --- S O L I D - S O L I D   C O N T A C T ---
 					
-					// a. NxN-term
-					//------------------------------------
+							// a. NxN-term
+							//------------------------------------
 					
-					// calculate the N-vector
-					for (k=0; k<nseln; ++k)
-					{
-						N[ndpn*k  ] = Hs[k]*nu.x;
-						N[ndpn*k+1] = Hs[k]*nu.y;
-						N[ndpn*k+2] = Hs[k]*nu.z;
-					}
+							// calculate the N-vector
+							for (k=0; k<nseln; ++k)
+							{
+								N[ndpn*k  ] = Hs[k]*nu.x;
+								N[ndpn*k+1] = Hs[k]*nu.y;
+								N[ndpn*k+2] = Hs[k]*nu.z;
+							}
 					
-					for (k=0; k<nmeln; ++k)
-					{
-						N[ndpn*(k+nseln)  ] = -Hm[k]*nu.x;
-						N[ndpn*(k+nseln)+1] = -Hm[k]*nu.y;
-						N[ndpn*(k+nseln)+2] = -Hm[k]*nu.z;
-					}
+							for (k=0; k<nmeln; ++k)
+							{
+								N[ndpn*(k+nseln)  ] = -Hm[k]*nu.x;
+								N[ndpn*(k+nseln)+1] = -Hm[k]*nu.y;
+								N[ndpn*(k+nseln)+2] = -Hm[k]*nu.z;
+							}
 					
-					if (ndpn == 5) {
-						for (k=0; k<nseln; ++k)
-						{
-							N[ndpn*k+3] = 0;
-							N[ndpn*k+4] = 0;
-						}
-						for (k=0; k<nmeln; ++k)
-						{
-							N[ndpn*(k+nseln)+3] = 0;
-							N[ndpn*(k+nseln)+4] = 0;
-						}
-					}
-					else if (ndpn == 4) {
-						for (k=0; k<nseln; ++k)
-							N[ndpn*k+3] = 0;
-						for (k=0; k<nmeln; ++k)
-							N[ndpn*(k+nseln)+3] = 0;
-					}
+							if (ndpn == 5) {
+								for (k=0; k<nseln; ++k)
+								{
+									N[ndpn*k+3] = 0;
+									N[ndpn*k+4] = 0;
+								}
+								for (k=0; k<nmeln; ++k)
+								{
+									N[ndpn*(k+nseln)+3] = 0;
+									N[ndpn*(k+nseln)+4] = 0;
+								}
+							}
+							else if (ndpn == 4) {
+								for (k=0; k<nseln; ++k)
+									N[ndpn*k+3] = 0;
+								for (k=0; k<nmeln; ++k)
+									N[ndpn*(k+nseln)+3] = 0;
+							}
 					
-					for (k=0; k<ndof; ++k)
-						for (l=0; l<ndof; ++l) ke[k][l] += dtn*N[k]*N[l]*detJ[j]*w[j];
+							for (k=0; k<ndof; ++k)
+								for (l=0; l<ndof; ++l) ke[k][l] += dtn*N[k]*N[l]*detJ[j]*w[j];
 					
-					// b. A-term
-					//-------------------------------------
+							// b. A-term
+							//-------------------------------------
 					
-					for (k=0; k<nseln; ++k) N[k      ] =  Hs[k];
-					for (k=0; k<nmeln; ++k) N[k+nseln] = -Hm[k];
+							for (k=0; k<nseln; ++k) N[k      ] =  Hs[k];
+							for (k=0; k<nmeln; ++k) N[k+nseln] = -Hm[k];
 					
-					double* Gr = se.Gr(j);
-					double* Gs = se.Gs(j);
-					vec3d gs[2];
-					ss.CoBaseVectors(se, j, gs);
+							double* Gr = se.Gr(j);
+							double* Gs = se.Gs(j);
+							vec3d gs[2];
+							ss.CoBaseVectors(se, j, gs);
 					
-					mat3d S1, S2;
-					S1.skew(gs[0]);
-					S2.skew(gs[1]);
-					mat3d As[FEElement::MAX_NODES];
-					for (l=0; l<nseln; ++l)
-						As[l] = S2*Gr[l] - S1*Gs[l];
+							mat3d S1, S2;
+							S1.skew(gs[0]);
+							S2.skew(gs[1]);
+							mat3d As[FEElement::MAX_NODES];
+							for (l=0; l<nseln; ++l)
+								As[l] = S2*Gr[l] - S1*Gs[l];
 					
-					if (!m_bsymm)
-					{	// non-symmetric
-						for (l=0; l<nseln; ++l)
-						{
-							for (k=0; k<nseln+nmeln; ++k)
-							{
-								ke[k*ndpn  ][l*ndpn  ] -= knmult*tn*w[j]*N[k]*As[l][0][0];
-								ke[k*ndpn  ][l*ndpn+1] -= knmult*tn*w[j]*N[k]*As[l][0][1];
-								ke[k*ndpn  ][l*ndpn+2] -= knmult*tn*w[j]*N[k]*As[l][0][2];
+							if (!m_bsymm)
+							{	// non-symmetric
+								for (l=0; l<nseln; ++l)
+								{
+									for (k=0; k<nseln+nmeln; ++k)
+									{
+										ke[k*ndpn  ][l*ndpn  ] -= knmult*tn*w[j]*N[k]*As[l][0][0];
+										ke[k*ndpn  ][l*ndpn+1] -= knmult*tn*w[j]*N[k]*As[l][0][1];
+										ke[k*ndpn  ][l*ndpn+2] -= knmult*tn*w[j]*N[k]*As[l][0][2];
 								
-								ke[k*ndpn+1][l*ndpn  ] -= knmult*tn*w[j]*N[k]*As[l][1][0];
-								ke[k*ndpn+1][l*ndpn+1] -= knmult*tn*w[j]*N[k]*As[l][1][1];
-								ke[k*ndpn+1][l*ndpn+2] -= knmult*tn*w[j]*N[k]*As[l][1][2];
+										ke[k*ndpn+1][l*ndpn  ] -= knmult*tn*w[j]*N[k]*As[l][1][0];
+										ke[k*ndpn+1][l*ndpn+1] -= knmult*tn*w[j]*N[k]*As[l][1][1];
+										ke[k*ndpn+1][l*ndpn+2] -= knmult*tn*w[j]*N[k]*As[l][1][2];
 								
-								ke[k*ndpn+2][l*ndpn  ] -= knmult*tn*w[j]*N[k]*As[l][2][0];
-								ke[k*ndpn+2][l*ndpn+1] -= knmult*tn*w[j]*N[k]*As[l][2][1];
-								ke[k*ndpn+2][l*ndpn+2] -= knmult*tn*w[j]*N[k]*As[l][2][2];
-							}
-						}
-					} 
-					else 
-					{	// symmetric
-						for (l=0; l<nseln; ++l)
-						{
-							for (k=0; k<nseln+nmeln; ++k)
-							{
-								ke[k*ndpn  ][l*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][0];
-								ke[k*ndpn  ][l*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][1];
-								ke[k*ndpn  ][l*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][2];
+										ke[k*ndpn+2][l*ndpn  ] -= knmult*tn*w[j]*N[k]*As[l][2][0];
+										ke[k*ndpn+2][l*ndpn+1] -= knmult*tn*w[j]*N[k]*As[l][2][1];
+										ke[k*ndpn+2][l*ndpn+2] -= knmult*tn*w[j]*N[k]*As[l][2][2];
+									}
+								}
+							} 
+							else 
+							{	// symmetric
+								for (l=0; l<nseln; ++l)
+								{
+									for (k=0; k<nseln+nmeln; ++k)
+									{
+										ke[k*ndpn  ][l*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][0];
+										ke[k*ndpn  ][l*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][1];
+										ke[k*ndpn  ][l*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][2];
 								
-								ke[k*ndpn+1][l*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][0];
-								ke[k*ndpn+1][l*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][1];
-								ke[k*ndpn+1][l*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][2];
+										ke[k*ndpn+1][l*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][0];
+										ke[k*ndpn+1][l*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][1];
+										ke[k*ndpn+1][l*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][2];
 								
-								ke[k*ndpn+2][l*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][0];
-								ke[k*ndpn+2][l*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][1];
-								ke[k*ndpn+2][l*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][2];
+										ke[k*ndpn+2][l*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][0];
+										ke[k*ndpn+2][l*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][1];
+										ke[k*ndpn+2][l*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][2];
 								
-								ke[l*ndpn  ][k*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][0];
-								ke[l*ndpn+1][k*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][1];
-								ke[l*ndpn+2][k*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][2];
+										ke[l*ndpn  ][k*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][0];
+										ke[l*ndpn+1][k*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][1];
+										ke[l*ndpn+2][k*ndpn  ] -= 0.5*knmult*tn*w[j]*N[k]*As[l][0][2];
 								
-								ke[l*ndpn  ][k*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][0];
-								ke[l*ndpn+1][k*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][1];
-								ke[l*ndpn+2][k*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][2];
+										ke[l*ndpn  ][k*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][0];
+										ke[l*ndpn+1][k*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][1];
+										ke[l*ndpn+2][k*ndpn+1] -= 0.5*knmult*tn*w[j]*N[k]*As[l][1][2];
 								
-								ke[l*ndpn  ][k*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][0];
-								ke[l*ndpn+1][k*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][1];
-								ke[l*ndpn+2][k*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][2];
+										ke[l*ndpn  ][k*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][0];
+										ke[l*ndpn+1][k*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][1];
+										ke[l*ndpn+2][k*ndpn+2] -= 0.5*knmult*tn*w[j]*N[k]*As[l][2][2];
+									}
+								}
 							}
-						}
-					}
 					
-					// c. M-term
-					//---------------------------------------
+							// c. M-term
+							//---------------------------------------
 					
-					vec3d Gm[2];
-					ms.ContraBaseVectors(me, r, s, Gm);
+							vec3d Gm[2];
+							ms.ContraBaseVectors(me, r, s, Gm);
 					
-					// evaluate master surface normal
-					vec3d mnu = Gm[0] ^ Gm[1];
-					mnu.unit();
+							// evaluate master surface normal
+							vec3d mnu = Gm[0] ^ Gm[1];
+							mnu.unit();
 					
-					double Hmr[FEElement::MAX_NODES], Hms[FEElement::MAX_NODES];
-					me.shape_deriv(Hmr, Hms, r, s);
-					vec3d mm[FEElement::MAX_NODES];
-					for (k=0; k<nmeln; ++k) 
-						mm[k] = Gm[0]*Hmr[k] + Gm[1]*Hms[k];
+							double Hmr[FEElement::MAX_NODES], Hms[FEElement::MAX_NODES];
+							me.shape_deriv(Hmr, Hms, r, s);
+							vec3d mm[FEElement::MAX_NODES];
+							for (k=0; k<nmeln; ++k) 
+								mm[k] = Gm[0]*Hmr[k] + Gm[1]*Hms[k];
 					
-					if (!m_bsymm)
-					{	// non-symmetric
-						for (k=0; k<nmeln; ++k) 
-						{
-							for (l=0; l<nseln+nmeln; ++l)
-							{
-								ke[(k+nseln)*ndpn  ][l*ndpn  ] += tn*knmult*detJ[j]*w[j]*mnu.x*mm[k].x*N[l];
-								ke[(k+nseln)*ndpn  ][l*ndpn+1] += tn*knmult*detJ[j]*w[j]*mnu.x*mm[k].y*N[l];
-								ke[(k+nseln)*ndpn  ][l*ndpn+2] += tn*knmult*detJ[j]*w[j]*mnu.x*mm[k].z*N[l];
+							if (!m_bsymm)
+							{	// non-symmetric
+								for (k=0; k<nmeln; ++k) 
+								{
+									for (l=0; l<nseln+nmeln; ++l)
+									{
+										ke[(k+nseln)*ndpn  ][l*ndpn  ] += tn*knmult*detJ[j]*w[j]*mnu.x*mm[k].x*N[l];
+										ke[(k+nseln)*ndpn  ][l*ndpn+1] += tn*knmult*detJ[j]*w[j]*mnu.x*mm[k].y*N[l];
+										ke[(k+nseln)*ndpn  ][l*ndpn+2] += tn*knmult*detJ[j]*w[j]*mnu.x*mm[k].z*N[l];
 								
-								ke[(k+nseln)*ndpn+1][l*ndpn  ] += tn*knmult*detJ[j]*w[j]*mnu.y*mm[k].x*N[l];
-								ke[(k+nseln)*ndpn+1][l*ndpn+1] += tn*knmult*detJ[j]*w[j]*mnu.y*mm[k].y*N[l];
-								ke[(k+nseln)*ndpn+1][l*ndpn+2] += tn*knmult*detJ[j]*w[j]*mnu.y*mm[k].z*N[l];
+										ke[(k+nseln)*ndpn+1][l*ndpn  ] += tn*knmult*detJ[j]*w[j]*mnu.y*mm[k].x*N[l];
+										ke[(k+nseln)*ndpn+1][l*ndpn+1] += tn*knmult*detJ[j]*w[j]*mnu.y*mm[k].y*N[l];
+										ke[(k+nseln)*ndpn+1][l*ndpn+2] += tn*knmult*detJ[j]*w[j]*mnu.y*mm[k].z*N[l];
 								
-								ke[(k+nseln)*ndpn+2][l*ndpn  ] += tn*knmult*detJ[j]*w[j]*mnu.z*mm[k].x*N[l];
-								ke[(k+nseln)*ndpn+2][l*ndpn+1] += tn*knmult*detJ[j]*w[j]*mnu.z*mm[k].y*N[l];
-								ke[(k+nseln)*ndpn+2][l*ndpn+2] += tn*knmult*detJ[j]*w[j]*mnu.z*mm[k].z*N[l];
+										ke[(k+nseln)*ndpn+2][l*ndpn  ] += tn*knmult*detJ[j]*w[j]*mnu.z*mm[k].x*N[l];
+										ke[(k+nseln)*ndpn+2][l*ndpn+1] += tn*knmult*detJ[j]*w[j]*mnu.z*mm[k].y*N[l];
+										ke[(k+nseln)*ndpn+2][l*ndpn+2] += tn*knmult*detJ[j]*w[j]*mnu.z*mm[k].z*N[l];
+									}
+								}
 							}
-						}
-					}
-					else
-					{	// symmetric
-						for (k=0; k<nmeln; ++k) 
-						{
-							for (l=0; l<nseln+nmeln; ++l)
-							{
-								ke[(k+nseln)*ndpn  ][l*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].x*N[l];
-								ke[(k+nseln)*ndpn  ][l*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].y*N[l];
-								ke[(k+nseln)*ndpn  ][l*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].z*N[l];
+							else
+							{	// symmetric
+								for (k=0; k<nmeln; ++k) 
+								{
+									for (l=0; l<nseln+nmeln; ++l)
+									{
+										ke[(k+nseln)*ndpn  ][l*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].x*N[l];
+										ke[(k+nseln)*ndpn  ][l*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].y*N[l];
+										ke[(k+nseln)*ndpn  ][l*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].z*N[l];
 								
-								ke[(k+nseln)*ndpn+1][l*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].x*N[l];
-								ke[(k+nseln)*ndpn+1][l*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].y*N[l];
-								ke[(k+nseln)*ndpn+1][l*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].z*N[l];
+										ke[(k+nseln)*ndpn+1][l*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].x*N[l];
+										ke[(k+nseln)*ndpn+1][l*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].y*N[l];
+										ke[(k+nseln)*ndpn+1][l*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].z*N[l];
 								
-								ke[(k+nseln)*ndpn+2][l*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].x*N[l];
-								ke[(k+nseln)*ndpn+2][l*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].y*N[l];
-								ke[(k+nseln)*ndpn+2][l*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].z*N[l];
+										ke[(k+nseln)*ndpn+2][l*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].x*N[l];
+										ke[(k+nseln)*ndpn+2][l*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].y*N[l];
+										ke[(k+nseln)*ndpn+2][l*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].z*N[l];
 								
-								ke[l*ndpn  ][(k+nseln)*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].x*N[l];
-								ke[l*ndpn+1][(k+nseln)*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].x*N[l];
-								ke[l*ndpn+2][(k+nseln)*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].x*N[l];
+										ke[l*ndpn  ][(k+nseln)*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].x*N[l];
+										ke[l*ndpn+1][(k+nseln)*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].x*N[l];
+										ke[l*ndpn+2][(k+nseln)*ndpn  ] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].x*N[l];
 								
-								ke[l*ndpn  ][(k+nseln)*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].y*N[l];
-								ke[l*ndpn+1][(k+nseln)*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].y*N[l];
-								ke[l*ndpn+2][(k+nseln)*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].y*N[l];
+										ke[l*ndpn  ][(k+nseln)*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].y*N[l];
+										ke[l*ndpn+1][(k+nseln)*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].y*N[l];
+										ke[l*ndpn+2][(k+nseln)*ndpn+1] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].y*N[l];
 								
-								ke[l*ndpn  ][(k+nseln)*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].z*N[l];
-								ke[l*ndpn+1][(k+nseln)*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].z*N[l];
-								ke[l*ndpn+2][(k+nseln)*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].z*N[l];
+										ke[l*ndpn  ][(k+nseln)*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.x*mm[k].z*N[l];
+										ke[l*ndpn+1][(k+nseln)*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.y*mm[k].z*N[l];
+										ke[l*ndpn+2][(k+nseln)*ndpn+2] += 0.5*knmult*tn*detJ[j]*w[j]*mnu.z*mm[k].z*N[l];
+									}
+								}
 							}
-						}
-					}
 					
-					// --- B I P H A S I C - S O L U T E  S T I F F N E S S ---
-					if (ssolu && msolu && (sid == mid))
-					{
-						double dt = fem.GetTime().timeIncrement;
+							// --- B I P H A S I C - S O L U T E  S T I F F N E S S ---
+							if (ssolu && msolu && (sid == mid))
+							{
+								double dt = fem.GetTime().timeIncrement;
 						
-						double epsp = (tn > 0) ? m_epsp*pt.m_epsp : 0.;
-						double epsc = (tn > 0) ? m_epsc*pt.m_epsc : 0.;
+								double epsp = (tn > 0) ? m_epsp*pt.m_epsp : 0.;
+								double epsc = (tn > 0) ? m_epsc*pt.m_epsc : 0.;
 						
-						// --- S O L I D - P R E S S U R E / S O L U T E   C O N T A C T ---
+								// --- S O L I D - P R E S S U R E / S O L U T E   C O N T A C T ---
 						
-						if (!m_bsymm)
-						{
+								if (!m_bsymm)
+								{
 							
-							// a. q-term
-							//-------------------------------------
+									// a. q-term
+									//-------------------------------------
 							
-							double dpmr, dpms;
-							dpmr = me.eval_deriv1(pm, r, s);
-							dpms = me.eval_deriv2(pm, r, s);
+									double dpmr, dpms;
+									dpmr = me.eval_deriv1(pm, r, s);
+									dpms = me.eval_deriv2(pm, r, s);
 							
-							double dcmr, dcms;
-							dcmr = me.eval_deriv1(cm, r, s);
-							dcms = me.eval_deriv2(cm, r, s);
+									double dcmr, dcms;
+									dcmr = me.eval_deriv1(cm, r, s);
+									dcms = me.eval_deriv2(cm, r, s);
 							
-							for (k=0; k<nseln+nmeln; ++k)
-								for (l=0; l<nseln+nmeln; ++l)
-								{
-									ke[ndpn*k + 3][ndpn*l  ] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].x + dpms*Gm[1].x);
-									ke[ndpn*k + 3][ndpn*l+1] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].y + dpms*Gm[1].y);
-									ke[ndpn*k + 3][ndpn*l+2] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].z + dpms*Gm[1].z);
-
-									ke[ndpn*k + 4][ndpn*l  ] += dt*w[j]*detJ[j]*epsc*N[k]*N[l]*(dcmr*Gm[0].x + dcms*Gm[1].x);
-									ke[ndpn*k + 4][ndpn*l+1] += dt*w[j]*detJ[j]*epsc*N[k]*N[l]*(dcmr*Gm[0].y + dcms*Gm[1].y);
-									ke[ndpn*k + 4][ndpn*l+2] += dt*w[j]*detJ[j]*epsc*N[k]*N[l]*(dcmr*Gm[0].z + dcms*Gm[1].z);
-								}
+									for (k=0; k<nseln+nmeln; ++k)
+										for (l=0; l<nseln+nmeln; ++l)
+										{
+											ke[ndpn*k + 3][ndpn*l  ] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].x + dpms*Gm[1].x);
+											ke[ndpn*k + 3][ndpn*l+1] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].y + dpms*Gm[1].y);
+											ke[ndpn*k + 3][ndpn*l+2] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].z + dpms*Gm[1].z);
+
+											ke[ndpn*k + 4][ndpn*l  ] += dt*w[j]*detJ[j]*epsc*N[k]*N[l]*(dcmr*Gm[0].x + dcms*Gm[1].x);
+											ke[ndpn*k + 4][ndpn*l+1] += dt*w[j]*detJ[j]*epsc*N[k]*N[l]*(dcmr*Gm[0].y + dcms*Gm[1].y);
+											ke[ndpn*k + 4][ndpn*l+2] += dt*w[j]*detJ[j]*epsc*N[k]*N[l]*(dcmr*Gm[0].z + dcms*Gm[1].z);
+										}
 							
-							double wn = pt.m_Lmp + epsp*pt.m_pg;
-							double jn = pt.m_Lmc + epsc*pt.m_cg;
+									double wn = pt.m_Lmp + epsp*pt.m_pg;
+									double jn = pt.m_Lmc + epsc*pt.m_cg;
 							
-							// b. A-term
-							//-------------------------------------
+									// b. A-term
+									//-------------------------------------
 							
-							for (l=0; l<nseln; ++l)
-								for (k=0; k<nseln+nmeln; ++k)
-								{
-									ke[ndpn*k + 3][ndpn*l  ] -= dt*w[j]*wn*N[k]*(As[l][0][0]*nu.x + As[l][0][1]*nu.y + As[l][0][2]*nu.z);
-									ke[ndpn*k + 3][ndpn*l+1] -= dt*w[j]*wn*N[k]*(As[l][1][0]*nu.x + As[l][1][1]*nu.y + As[l][1][2]*nu.z);
-									ke[ndpn*k + 3][ndpn*l+2] -= dt*w[j]*wn*N[k]*(As[l][2][0]*nu.x + As[l][2][1]*nu.y + As[l][2][2]*nu.z);
-
-									ke[ndpn*k + 4][ndpn*l  ] -= dt*w[j]*jn*N[k]*(As[l][0][0]*nu.x + As[l][0][1]*nu.y + As[l][0][2]*nu.z);
-									ke[ndpn*k + 4][ndpn*l+1] -= dt*w[j]*jn*N[k]*(As[l][1][0]*nu.x + As[l][1][1]*nu.y + As[l][1][2]*nu.z);
-									ke[ndpn*k + 4][ndpn*l+2] -= dt*w[j]*jn*N[k]*(As[l][2][0]*nu.x + As[l][2][1]*nu.y + As[l][2][2]*nu.z);
-								}
+									for (l=0; l<nseln; ++l)
+										for (k=0; k<nseln+nmeln; ++k)
+										{
+											ke[ndpn*k + 3][ndpn*l  ] -= dt*w[j]*wn*N[k]*(As[l][0][0]*nu.x + As[l][0][1]*nu.y + As[l][0][2]*nu.z);
+											ke[ndpn*k + 3][ndpn*l+1] -= dt*w[j]*wn*N[k]*(As[l][1][0]*nu.x + As[l][1][1]*nu.y + As[l][1][2]*nu.z);
+											ke[ndpn*k + 3][ndpn*l+2] -= dt*w[j]*wn*N[k]*(As[l][2][0]*nu.x + As[l][2][1]*nu.y + As[l][2][2]*nu.z);
+
+											ke[ndpn*k + 4][ndpn*l  ] -= dt*w[j]*jn*N[k]*(As[l][0][0]*nu.x + As[l][0][1]*nu.y + As[l][0][2]*nu.z);
+											ke[ndpn*k + 4][ndpn*l+1] -= dt*w[j]*jn*N[k]*(As[l][1][0]*nu.x + As[l][1][1]*nu.y + As[l][1][2]*nu.z);
+											ke[ndpn*k + 4][ndpn*l+2] -= dt*w[j]*jn*N[k]*(As[l][2][0]*nu.x + As[l][2][1]*nu.y + As[l][2][2]*nu.z);
+										}
 							
-							// c. m-term
-							//---------------------------------------
+									// c. m-term
+									//---------------------------------------
 							
-							for (k=0; k<nmeln; ++k)
-								for (l=0; l<nseln+nmeln; ++l)
-								{
-									ke[ndpn*(k+nseln) + 3][ndpn*l  ] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].x;
-									ke[ndpn*(k+nseln) + 3][ndpn*l+1] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].y;
-									ke[ndpn*(k+nseln) + 3][ndpn*l+2] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].z;
-
-									ke[ndpn*(k+nseln) + 4][ndpn*l  ] += dt*w[j]*detJ[j]*jn*N[l]*mm[k].x;
-									ke[ndpn*(k+nseln) + 4][ndpn*l+1] += dt*w[j]*detJ[j]*jn*N[l]*mm[k].y;
-									ke[ndpn*(k+nseln) + 4][ndpn*l+2] += dt*w[j]*detJ[j]*jn*N[l]*mm[k].z;
+									for (k=0; k<nmeln; ++k)
+										for (l=0; l<nseln+nmeln; ++l)
+										{
+											ke[ndpn*(k+nseln) + 3][ndpn*l  ] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].x;
+											ke[ndpn*(k+nseln) + 3][ndpn*l+1] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].y;
+											ke[ndpn*(k+nseln) + 3][ndpn*l+2] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].z;
+
+											ke[ndpn*(k+nseln) + 4][ndpn*l  ] += dt*w[j]*detJ[j]*jn*N[l]*mm[k].x;
+											ke[ndpn*(k+nseln) + 4][ndpn*l+1] += dt*w[j]*detJ[j]*jn*N[l]*mm[k].y;
+											ke[ndpn*(k+nseln) + 4][ndpn*l+2] += dt*w[j]*detJ[j]*jn*N[l]*mm[k].z;
+										}
 								}
-						}
 						
 						
-						// --- P R E S S U R E - P R E S S U R E   C O N T A C T ---
+								// --- P R E S S U R E - P R E S S U R E   C O N T A C T ---
 						
-						// calculate the N-vector
-						for (k=0; k<nseln; ++k)
-						{
-							N[ndpn*k+3] = Hs[k];
-							N[ndpn*k+4] = Hs[k];
-						}
+								// calculate the N-vector
+								for (k=0; k<nseln; ++k)
+								{
+									N[ndpn*k+3] = Hs[k];
+									N[ndpn*k+4] = Hs[k];
+								}
 						
-						for (k=0; k<nmeln; ++k)
-						{
-							N[ndpn*(k+nseln)+3] = -Hm[k];
-							N[ndpn*(k+nseln)+4] = -Hm[k];
-						}
+								for (k=0; k<nmeln; ++k)
+								{
+									N[ndpn*(k+nseln)+3] = -Hm[k];
+									N[ndpn*(k+nseln)+4] = -Hm[k];
+								}
 						
-						for (k=3; k<ndof; k+=ndpn)
-							for (l=3; l<ndof; l+=ndpn) ke[k][l] -= dt*epsp*w[j]*detJ[j]*N[k]*N[l];
+								for (k=3; k<ndof; k+=ndpn)
+									for (l=3; l<ndof; l+=ndpn) ke[k][l] -= dt*epsp*w[j]*detJ[j]*N[k]*N[l];
 
-						// --- C O N C E N T R A T I O N - C O N C E N T R A T I O N   C O N T A C T ---
+								// --- C O N C E N T R A T I O N - C O N C E N T R A T I O N   C O N T A C T ---
 						
-						for (k=4; k<ndof; k+=ndpn)
-							for (l=4; l<ndof; l+=ndpn) ke[k][l] -= dt*epsc*w[j]*detJ[j]*N[k]*N[l];
+								for (k=4; k<ndof; k+=ndpn)
+									for (l=4; l<ndof; l+=ndpn) ke[k][l] -= dt*epsc*w[j]*detJ[j]*N[k]*N[l];
 						
-					}
+							}
 					
-					// --- B I P H A S I C   S T I F F N E S S ---
-					else if (sporo && mporo)
-					{
-						// the variable dt is either the timestep or one
-						// depending on whether we are using the symmetric
-						// poro version or not.
-						double dt = fem.GetTime().timeIncrement;
+							// --- B I P H A S I C   S T I F F N E S S ---
+							else if (sporo && mporo)
+							{
+								// the variable dt is either the timestep or one
+								// depending on whether we are using the symmetric
+								// poro version or not.
+								double dt = fem.GetTime().timeIncrement;
 						
-						double epsp = (tn > 0) ? m_epsp*pt.m_epsp : 0.;
+								double epsp = (tn > 0) ? m_epsp*pt.m_epsp : 0.;
 						
-						// --- S O L I D - P R E S S U R E   C O N T A C T ---
+								// --- S O L I D - P R E S S U R E   C O N T A C T ---
 						
-						if (!m_bsymm)
-						{
+								if (!m_bsymm)
+								{
 							
-							// a. q-term
-							//-------------------------------------
+									// a. q-term
+									//-------------------------------------
 							
-							double dpmr, dpms;
-							dpmr = me.eval_deriv1(pm, r, s);
-							dpms = me.eval_deriv2(pm, r, s);
+									double dpmr, dpms;
+									dpmr = me.eval_deriv1(pm, r, s);
+									dpms = me.eval_deriv2(pm, r, s);
 							
-							for (k=0; k<nseln+nmeln; ++k)
-								for (l=0; l<nseln+nmeln; ++l)
-								{
-									ke[ndpn*k + 3][ndpn*l  ] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].x + dpms*Gm[1].x);
-									ke[ndpn*k + 3][ndpn*l+1] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].y + dpms*Gm[1].y);
-									ke[ndpn*k + 3][ndpn*l+2] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].z + dpms*Gm[1].z);
-								}
+									for (k=0; k<nseln+nmeln; ++k)
+										for (l=0; l<nseln+nmeln; ++l)
+										{
+											ke[ndpn*k + 3][ndpn*l  ] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].x + dpms*Gm[1].x);
+											ke[ndpn*k + 3][ndpn*l+1] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].y + dpms*Gm[1].y);
+											ke[ndpn*k + 3][ndpn*l+2] += dt*w[j]*detJ[j]*epsp*N[k]*N[l]*(dpmr*Gm[0].z + dpms*Gm[1].z);
+										}
 							
-							double wn = pt.m_Lmp + epsp*pt.m_pg;
+									double wn = pt.m_Lmp + epsp*pt.m_pg;
 							
-							// b. A-term
-							//-------------------------------------
+									// b. A-term
+									//-------------------------------------
 							
-							for (l=0; l<nseln; ++l)
-								for (k=0; k<nseln+nmeln; ++k)
-								{
-									ke[ndpn*k + 3][ndpn*l  ] -= dt*w[j]*wn*N[k]*(As[l][0][0]*nu.x + As[l][0][1]*nu.y + As[l][0][2]*nu.z);
-									ke[ndpn*k + 3][ndpn*l+1] -= dt*w[j]*wn*N[k]*(As[l][1][0]*nu.x + As[l][1][1]*nu.y + As[l][1][2]*nu.z);
-									ke[ndpn*k + 3][ndpn*l+2] -= dt*w[j]*wn*N[k]*(As[l][2][0]*nu.x + As[l][2][1]*nu.y + As[l][2][2]*nu.z);
-								}
+									for (l=0; l<nseln; ++l)
+										for (k=0; k<nseln+nmeln; ++k)
+										{
+											ke[ndpn*k + 3][ndpn*l  ] -= dt*w[j]*wn*N[k]*(As[l][0][0]*nu.x + As[l][0][1]*nu.y + As[l][0][2]*nu.z);
+											ke[ndpn*k + 3][ndpn*l+1] -= dt*w[j]*wn*N[k]*(As[l][1][0]*nu.x + As[l][1][1]*nu.y + As[l][1][2]*nu.z);
+											ke[ndpn*k + 3][ndpn*l+2] -= dt*w[j]*wn*N[k]*(As[l][2][0]*nu.x + As[l][2][1]*nu.y + As[l][2][2]*nu.z);
+										}
 							
-							// c. m-term
-							//---------------------------------------
+									// c. m-term
+									//---------------------------------------
 							
-							for (k=0; k<nmeln; ++k)
-								for (l=0; l<nseln+nmeln; ++l)
-								{
-									ke[ndpn*(k+nseln) + 3][ndpn*l  ] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].x;
-									ke[ndpn*(k+nseln) + 3][ndpn*l+1] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].y;
-									ke[ndpn*(k+nseln) + 3][ndpn*l+2] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].z;
+									for (k=0; k<nmeln; ++k)
+										for (l=0; l<nseln+nmeln; ++l)
+										{
+											ke[ndpn*(k+nseln) + 3][ndpn*l  ] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].x;
+											ke[ndpn*(k+nseln) + 3][ndpn*l+1] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].y;
+											ke[ndpn*(k+nseln) + 3][ndpn*l+2] += dt*w[j]*detJ[j]*wn*N[l]*mm[k].z;
+										}
 								}
-						}
 						
 						
-						// --- P R E S S U R E - P R E S S U R E   C O N T A C T ---
+								// --- P R E S S U R E - P R E S S U R E   C O N T A C T ---
 						
-						// calculate the N-vector
-						for (k=0; k<nseln; ++k)
-						{
-							N[ndpn*k+3] = Hs[k];
-						}
+								// calculate the N-vector
+								for (k=0; k<nseln; ++k)
+								{
+									N[ndpn*k+3] = Hs[k];
+								}
 						
-						for (k=0; k<nmeln; ++k)
-						{
-							N[ndpn*(k+nseln)+3] = -Hm[k];
-						}
+								for (k=0; k<nmeln; ++k)
+								{
+									N[ndpn*(k+nseln)+3] = -Hm[k];
+								}
 						
-						for (k=3; k<ndof; k+=ndpn)
-							for (l=3; l<ndof; l+=ndpn) ke[k][l] -= dt*epsp*w[j]*detJ[j]*N[k]*N[l];
+								for (k=3; k<ndof; k+=ndpn)
+									for (l=3; l<ndof; l+=ndpn) ke[k][l] -= dt*epsp*w[j]*detJ[j]*N[k]*N[l];
 						
-					}
+							}
 					
-					// assemble the global stiffness
-					psolver->AssembleStiffness(en, LM, ke);
+							// assemble the global stiffness
+							A.Add(i, en, LM, ke);
+						}
+					}
 				}
 			}
 		}
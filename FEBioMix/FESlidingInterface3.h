@@ -212,5 +212,9 @@ protected:
 	int	m_dofP;
 	int	m_dofC;
 
+	int	m_naug;		//!< augmentation nr at the last call to Update
+	int	m_biter;	//!< iteration nr at the start of the last augmentation
+	bool	m_bfirst;	//!< first call to Update
+
 	DECLARE_PARAMETER_LIST();
 };
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/FEAnalysis.h"
 #include "FECore/FENormalProjection.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -632,7 +633,7 @@ void FESlidingSurfaceBiphasic::GetNodalContactTraction(int nface, vec3d* tn)
 
 FESlidingInterfaceBiphasic::FESlidingInterfaceBiphasic(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-    static int count = 1;
+    static std::atomic<int> count(1);
     SetID(count++);
     
     // initial values
@@ -650,6 +651,9 @@ FESlidingInterfaceBiphasic::FESlidingInterfaceBiphasic(FEModel* pfem) : FEContac
     m_bautopen = false;
     m_breloc = false;
     m_bsmaug = false;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
     m_bupdtpen = false;
     m_mu = 0.0;
     m_phi = 0.0;
@@ -1068,8 +1072,6 @@ void FESlidingInterfaceBiphasic::Update(int nsolve_iter, const FETimeInfo& tp)
 {
     double R = m_srad*GetFEModel()->GetMesh().GetBoundingBox().radius();
     
-    static int naug = 0;
-    static int biter = 0;
     
     FEModel& fem = *GetFEModel();
     
@@ -1079,8 +1081,8 @@ void FESlidingInterfaceBiphasic::Update(int nsolve_iter, const FETimeInfo& tp)
     FEAnalysis* pstep = fem.GetCurrentStep();
     FESolver* psolver = pstep->GetFESolver();
     if (psolver->m_niter == 0) {
-        biter = 0;
-        naug = psolver->m_naug;
+        m_biter = 0;
+        m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bupdtpen) {
             // calculate the penalty
@@ -1092,11 +1094,11 @@ void FESlidingInterfaceBiphasic::Update(int nsolve_iter, const FETimeInfo& tp)
                 if (m_ms.m_bporo) CalcAutoPressurePenalty(m_ms);
             }
         }
-    } else if (psolver->m_naug > naug) {
-        biter = psolver->m_niter;
-        naug = psolver->m_naug;
+    } else if (psolver->m_naug > m_naug) {
+        m_biter = psolver->m_niter;
+        m_naug = psolver->m_naug;
     }
-    int niter = psolver->m_niter - biter;
+    int niter = psolver->m_niter - m_biter;
     bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
     // get the logfile
     //	Logfile& log = GetLogfile();
@@ -1104,10 +1106,9 @@ void FESlidingInterfaceBiphasic::Update(int nsolve_iter, const FETimeInfo& tp)
     
     // project the surfaces onto each other
     // this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
     if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-    bfirst = false;
+    m_bfirst = false;
     
     // Call InitSlidingSurface on the first iteration of each time step
     if (nsolve_iter == 0)
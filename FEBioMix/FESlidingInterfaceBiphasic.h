@@ -218,5 +218,9 @@ public:
 protected:
     int	m_dofP;
     
+    int	m_naug;		//!< augmentation nr at the last call to Update
+    int	m_biter;	//!< iteration nr at the start of the last augmentation
+    bool	m_bfirst;	//!< first call to Update
+
     DECLARE_PARAMETER_LIST();
 };
@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include "FECore/DOFS.h"
 #include "FECore/FENormalProjection.h"
 #include "FECore/FEAnalysis.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -597,7 +598,7 @@ void FESlidingSurfaceMP::GetNodalContactTraction(int nface, vec3d* tn)
 
 FESlidingInterfaceMP::FESlidingInterfaceMP(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 	
     // get number of DOFS
@@ -623,6 +624,9 @@ FESlidingInterfaceMP::FESlidingInterfaceMP(FEModel* pfem) : FEContactInterface(p
 	m_bautopen = false;
     m_breloc = false;
     m_bsmaug = false;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
     m_bupdtpen = false;
 	
 	m_naugmin = 0;
@@ -1274,17 +1278,14 @@ void FESlidingInterfaceMP::Update(int niter, const FETimeInfo& tp)
     
 	double R = m_srad*GetFEModel()->GetMesh().GetBoundingBox().radius();
 	
-	static int naug = 0;
-	static int biter = 0;
-	
 	// get the iteration number
 	// we need this number to see if we can do segment updates or not
 	// also reset number of iterations after each augmentation
 	FEAnalysis* pstep = fem.GetCurrentStep();
 	FESolver* psolver = pstep->GetFESolver();
 	if (psolver->m_niter == 0) {
-		biter = 0;
-		naug = psolver->m_naug;
+		m_biter = 0;
+		m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bupdtpen) {
             // calculate the penalty
@@ -1300,11 +1301,11 @@ void FESlidingInterfaceMP::Update(int niter, const FETimeInfo& tp)
                     CalcAutoConcentrationPenalty(m_ms, m_msl[im]);
             }
         }
-	} else if (psolver->m_naug > naug) {
-		biter = psolver->m_niter;
-		naug = psolver->m_naug;
+	} else if (psolver->m_naug > m_naug) {
+		m_biter = psolver->m_niter;
+		m_naug = psolver->m_naug;
 	}
-	niter = psolver->m_niter - biter;
+	niter = psolver->m_niter - m_biter;
 	bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
 	// get the logfile
 	//	Logfile& log = GetLogfile();
@@ -1312,10 +1313,9 @@ void FESlidingInterfaceMP::Update(int niter, const FETimeInfo& tp)
 	
 	// project the surfaces onto each other
 	// this will update the gap functions as well
-    static bool bfirst = true;
-	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
 	if (m_btwo_pass || m_ss.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-    bfirst = false;
+    m_bfirst = false;
 	
 	// Update the net contact pressures
 	UpdateContactPressures();
@@ -0,0 +1,93 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FESoluteWorkspace.h"
+#include <assert.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+FESoluteWorkspace::FESoluteWorkspace()
+{
+	m_nsol = -1;
+	m_nconc = -1;
+}
+
+//-----------------------------------------------------------------------------
+void FESoluteWorkspace::Init(int nsol, int nconc)
+{
+	if ((nsol == m_nsol) && (nconc == m_nconc)) return;
+	m_nsol = nsol;
+	m_nconc = nconc;
+
+	z.resize(nsol);
+	sid.resize(nsol);
+	cn.assign(nconc, vector<double>(FEElement::MAX_NODES));
+	dn.assign(nconc, vector<double>(FEElement::MAX_NODES));
+
+	chat.resize(nsol); D0.resize(nsol); dodc.resize(nsol); Phic.resize(nsol);
+	dKdc.resize(nsol); D.resize(nsol); dTdc.resize(nsol); ImD.resize(nsol);
+	dchatde.resize(nsol); Gc.resize(nsol); dKedc.resize(nsol);
+	dDdE.resize(nsol);
+	ju.resize(nsol); jw.resize(nsol);
+	gc.resize(nsol); qcu.resize(nsol); qcw.resize(nsol); wc.resize(nsol);
+	wd.resize(nsol); jce.resize(nsol); jde.resize(nsol);
+
+	dDdc.assign(nsol, vector<mat3ds>(nsol));
+	dD0dc.assign(nsol, vector<double>(nsol));
+	qcc.assign(nsol, vector<double>(nsol));
+	qcd.assign(nsol, vector<double>(nsol));
+	dchatdc.assign(nsol, vector<double>(nsol));
+	jc.assign(nsol, vector<vec3d>(nsol));
+	jd.assign(nsol, vector<vec3d>(nsol));
+}
+
+//-----------------------------------------------------------------------------
+void FESoluteWorkspaceList::Init(int nsol, int nconc)
+{
+#ifdef _OPENMP
+	int nt = omp_get_max_threads();
+#else
+	int nt = 1;
+#endif
+	if ((int)m_ws.size() < nt) m_ws.resize(nt);
+	for (size_t i=0; i<m_ws.size(); ++i) m_ws[i].Init(nsol, nconc);
+}
+
+//-----------------------------------------------------------------------------
+FESoluteWorkspace& FESoluteWorkspaceList::Get()
+{
+#ifdef _OPENMP
+	int n = omp_get_thread_num();
+#else
+	int n = 0;
+#endif
+	assert(n < (int)m_ws.size());
+	return m_ws[n];
+}
@@ -0,0 +1,94 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "FECore/matrix.h"
+#include "FECore/tens4d.h"
+#include "FECore/FEElement.h"
+#include <vector>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//! Scratch data for the element kernels of the solute domains.
+
+//! The element kernels of the multiphasic and triphasic domains need many
+//! temporary arrays whose size depends on the number of solutes. Instead of
+//! allocating these for each element and integration point, each thread uses
+//! its own workspace which is sized once.
+class FESoluteWorkspace
+{
+public:
+	FESoluteWorkspace();
+
+	//! size the arrays for nsol solutes and nconc concentration dofs
+	//! (does nothing when the sizes did not change)
+	void Init(int nsol, int nconc);
+
+public:
+	// element data
+	vector<double>	fe;		//!< element force vector
+	vector<int>		lm;		//!< element equation numbers
+	matrix			ke;		//!< element stiffness matrix
+
+	// solute data
+	vector<int>		z;		//!< charge numbers
+	vector<int>		sid;	//!< solute IDs
+	vector< vector<double> >	cn;	//!< nodal concentrations (for each concentration dof)
+	vector< vector<double> >	dn;	//!< nodal shell concentrations (for each concentration dof)
+
+	// integration point data
+	vector<double>	chat, D0, dodc, Phic;
+	vector<mat3ds>	dKdc, D, dTdc, ImD, dchatde, Gc, dKedc;
+	vector<tens4ds>	dDdE;
+	vector<mat3d>	ju, jw;
+	vector<vec3d>	gc, qcu, qcw, wc, wd, jce, jde;
+	vector< vector<mat3ds> >	dDdc;
+	vector< vector<double> >	dD0dc, qcc, qcd, dchatdc;
+	vector< vector<vec3d> >		jc, jd;
+
+private:
+	int	m_nsol;
+	int	m_nconc;
+};
+
+//-----------------------------------------------------------------------------
+//! A workspace for each thread.
+
+//! Init must be called outside of parallel regions, before the element loop.
+//! Inside the loop, Get returns the workspace of the calling thread.
+class FESoluteWorkspaceList
+{
+public:
+	//! make sure each thread has a workspace of the right size
+	void Init(int nsol, int nconc);
+
+	//! get the workspace of the calling thread
+	FESoluteWorkspace& Get();
+
+private:
+	vector<FESoluteWorkspace>	m_ws;
+};
@@ -49,6 +49,8 @@ void FESolutesMaterialPoint::Init()
 {
 	m_nsol = m_nsbm = 0;
 	m_psi = m_cF = 0;
+	m_zeta = 1;
+	m_bzeta = false;
 	m_Ie = vec3d(0,0,0);
 	m_rhor = 0;
     m_c.clear();
@@ -88,6 +90,9 @@ void FESolutesMaterialPoint::Init()
 //! Serialize material point data to the archive
 void FESolutesMaterialPoint::Serialize(DumpStream& ar)
 {
+	// the cached electroneutrality solution is not stored
+	m_bzeta = false;
+
     if (ar.IsShallow())
     {
         if (ar.IsSaving())
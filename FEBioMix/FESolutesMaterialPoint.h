@@ -35,7 +35,7 @@ class FESolutesMaterialPoint : public FEMaterialPoint
 {
 public:
 	//! Constructor
-	FESolutesMaterialPoint(FEMaterialPoint* ppt) : FEMaterialPoint(ppt) {}
+	FESolutesMaterialPoint(FEMaterialPoint* ppt) : FEMaterialPoint(ppt) { m_bzeta = false; }
 	
 	//! Create a shallow copy
 	FEMaterialPoint* Copy();
@@ -55,6 +55,8 @@ public:
 	vector<double>	m_ca;		//!< actual solute concentration
     vector<double>  m_crp;      //!< referential actual solute concentration at previous time step
 	double			m_psi;		//!< electric potential
+	double			m_zeta;		//!< cached electroneutrality solution (exponential form of m_psi)
+	bool			m_bzeta;	//!< m_zeta is valid for the current state (must be cleared when the state changes)
 	vec3d			m_Ie;		//!< current density
 	double			m_cF;		//!< fixed charge density in current configuration
 	int				m_nsbm;		//!< number of solid-bound molecules
@@ -29,9 +29,11 @@ SOFTWARE.*/
 #include "FETiedBiphasicInterface.h"
 #include "FEBiphasic.h"
 #include "FECore/FEModel.h"
+#include "FECore/FEBlockAssembler.h"
 #include "FECore/FEAnalysis.h"
 #include "FECore/FENormalProjection.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -300,7 +302,7 @@ void FETiedBiphasicSurface::GetContactTraction(int nface, vec3d& pt)
 
 FETiedBiphasicInterface::FETiedBiphasicInterface(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-	static int count = 1;
+	static std::atomic<int> count(1);
 	SetID(count++);
 	
 	// initial values
@@ -676,12 +678,7 @@ void FETiedBiphasicInterface::Update(int niter, const FETimeInfo& tp)
 //-----------------------------------------------------------------------------
 void FETiedBiphasicInterface::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 {
-	int i, j, k;
-	vector<int> sLM, mLM, LM, en;
-	vector<double> fe;
 	const int MN = FEElement::MAX_NODES;
-	double detJ[MN], w[MN], *Hs, Hm[MN];
-	double N[8*MN];
 
 	// get time step
 	// if we're using the symmetric formulation
@@ -700,154 +697,172 @@ void FETiedBiphasicInterface::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 		FETiedBiphasicSurface& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all slave elements
-		for (i=0; i<ss.Elements(); ++i)
+		// (the element vectors are evaluated in parallel and assembled in element order)
+		int ne = ss.Elements();
+		FEBlockAssembler A(R, ne);
+		while (A.NextBlock())
 		{
-			// get the surface element
-			FESurfaceElement& se = ss.Element(i);
+			int n0 = A.BlockStart();
+			int n1 = A.BlockEnd();
+			#pragma omp parallel
+			{
+				int j, k;
+				vector<int> sLM, mLM, LM, en;
+				vector<double> fe;
+				double detJ[MN], w[MN], *Hs, Hm[MN];
+				double N[8*MN];
+
+				#pragma omp for schedule(dynamic)
+				for (int i=n0; i<n1; ++i)
+				{
+					// get the surface element
+					FESurfaceElement& se = ss.Element(i);
 			
-			bool sporo = ss.m_poro[i];
+					bool sporo = ss.m_poro[i];
 			
-			// get the nr of nodes and integration points
-			int nseln = se.Nodes();
-			int nint = se.GaussPoints();
+					// get the nr of nodes and integration points
+					int nseln = se.Nodes();
+					int nint = se.GaussPoints();
 			
-			// copy the LM vector; we'll need it later
-			ss.UnpackLM(se, sLM);
+					// copy the LM vector; we'll need it later
+					ss.UnpackLM(se, sLM);
 			
-			// we calculate all the metrics we need before we
-			// calculate the nodal forces
-			for (j=0; j<nint; ++j)
-			{
-				// get the base vectors
-				vec3d g[2];
-				ss.CoBaseVectors(se, j, g);
+					// we calculate all the metrics we need before we
+					// calculate the nodal forces
+					for (j=0; j<nint; ++j)
+					{
+						// get the base vectors
+						vec3d g[2];
+						ss.CoBaseVectors(se, j, g);
 				
-				// jacobians: J = |g0xg1|
-				detJ[j] = (g[0] ^ g[1]).norm();
+						// jacobians: J = |g0xg1|
+						detJ[j] = (g[0] ^ g[1]).norm();
 				
-				// integration weights
-				w[j] = se.GaussWeights()[j];
-			}
+						// integration weights
+						w[j] = se.GaussWeights()[j];
+					}
 			
-			// loop over all integration points
-			// note that we are integrating over the current surface
-			for (j=0; j<nint; ++j)
-			{
-                FETiedBiphasicSurface::Data& pt = ss.m_Data[i][j];
+					// loop over all integration points
+					// note that we are integrating over the current surface
+					for (j=0; j<nint; ++j)
+					{
+                        FETiedBiphasicSurface::Data& pt = ss.m_Data[i][j];
                 
-				// get the master element
-				FESurfaceElement* pme = pt.m_pme;
-				if (pme)
-				{
-					// get the master element
-					FESurfaceElement& me = *pme;
+						// get the master element
+						FESurfaceElement* pme = pt.m_pme;
+						if (pme)
+						{
+							// get the master element
+							FESurfaceElement& me = *pme;
 					
-					bool mporo = ms.m_poro[pme->m_lid];
+							bool mporo = ms.m_poro[pme->m_lid];
 					
-					// get the nr of master element nodes
-					int nmeln = me.Nodes();
+							// get the nr of master element nodes
+							int nmeln = me.Nodes();
 					
-					// copy LM vector
-					ms.UnpackLM(me, mLM);
+							// copy LM vector
+							ms.UnpackLM(me, mLM);
 					
-					// calculate degrees of freedom
-					int ndof = 3*(nseln + nmeln);
+							// calculate degrees of freedom
+							int ndof = 3*(nseln + nmeln);
 					
-					// build the LM vector
-					LM.resize(ndof);
-					for (k=0; k<nseln; ++k)
-					{
-						LM[3*k  ] = sLM[3*k  ];
-						LM[3*k+1] = sLM[3*k+1];
-						LM[3*k+2] = sLM[3*k+2];
-					}
+							// build the LM vector
+							LM.resize(ndof);
+							for (k=0; k<nseln; ++k)
+							{
+								LM[3*k  ] = sLM[3*k  ];
+								LM[3*k+1] = sLM[3*k+1];
+								LM[3*k+2] = sLM[3*k+2];
+							}
 					
-					for (k=0; k<nmeln; ++k)
-					{
-						LM[3*(k+nseln)  ] = mLM[3*k  ];
-						LM[3*(k+nseln)+1] = mLM[3*k+1];
-						LM[3*(k+nseln)+2] = mLM[3*k+2];
-					}
+							for (k=0; k<nmeln; ++k)
+							{
+								LM[3*(k+nseln)  ] = mLM[3*k  ];
+								LM[3*(k+nseln)+1] = mLM[3*k+1];
+								LM[3*(k+nseln)+2] = mLM[3*k+2];
+							}
 					
-					// build the en vector
-					en.resize(nseln+nmeln);
-					for (k=0; k<nseln; ++k) en[k      ] = se.m_node[k];
-					for (k=0; k<nmeln; ++k) en[k+nseln] = me.m_node[k];
+							// build the en vector
+							en.resize(nseln+nmeln);
+							for (k=0; k<nseln; ++k) en[k      ] = se.m_node[k];
+							for (k=0; k<nmeln; ++k) en[k+nseln] = me.m_node[k];
 					
-					// get slave element shape functions
-					Hs = se.H(j);
+							// get slave element shape functions
+							Hs = se.H(j);
 					
-					// get master element shape functions
-					double r = pt.m_rs[0];
-					double s = pt.m_rs[1];
-					me.shape_fnc(Hm, r, s);
+							// get master element shape functions
+							double r = pt.m_rs[0];
+							double s = pt.m_rs[1];
+							me.shape_fnc(Hm, r, s);
 					
-					// get normal vector
-					vec3d nu = pt.m_nu;
+							// get normal vector
+							vec3d nu = pt.m_nu;
 					
-					// gap function
-					vec3d dg = pt.m_dg;
+							// gap function
+							vec3d dg = pt.m_dg;
 					
-					// lagrange multiplier
-					vec3d Lm = pt.m_Lmd;
+							// lagrange multiplier
+							vec3d Lm = pt.m_Lmd;
 					
-					// penalty 
-					double eps = m_epsn*pt.m_epsn;
+							// penalty 
+							double eps = m_epsn*pt.m_epsn;
 					
-					// contact traction
-					vec3d t = Lm + dg*eps;
-                    pt.m_tr = t;
+							// contact traction
+							vec3d t = Lm + dg*eps;
+                            pt.m_tr = t;
 					
-					// calculate the force vector
-					fe.resize(ndof);
-					zero(fe);
+							// calculate the force vector
+							fe.resize(ndof);
+							zero(fe);
 					
-					for (k=0; k<nseln; ++k)
-					{
-						N[3*k  ] = Hs[k]*t.x;
-						N[3*k+1] = Hs[k]*t.y;
-						N[3*k+2] = Hs[k]*t.z;
-					}
+							for (k=0; k<nseln; ++k)
+							{
+								N[3*k  ] = Hs[k]*t.x;
+								N[3*k+1] = Hs[k]*t.y;
+								N[3*k+2] = Hs[k]*t.z;
+							}
 					
-					for (k=0; k<nmeln; ++k)
-					{
-						N[3*(k+nseln)  ] = -Hm[k]*t.x;
-						N[3*(k+nseln)+1] = -Hm[k]*t.y;
-						N[3*(k+nseln)+2] = -Hm[k]*t.z;
-					}
+							for (k=0; k<nmeln; ++k)
+							{
+								N[3*(k+nseln)  ] = -Hm[k]*t.x;
+								N[3*(k+nseln)+1] = -Hm[k]*t.y;
+								N[3*(k+nseln)+2] = -Hm[k]*t.z;
+							}
 					
-					for (k=0; k<ndof; ++k) fe[k] += N[k]*detJ[j]*w[j];
+							for (k=0; k<ndof; ++k) fe[k] += N[k]*detJ[j]*w[j];
 					
-					// assemble the global residual
-					R.Assemble(en, LM, fe);
+							// assemble the global residual
+							A.Add(i, en, LM, fe);
 					
-					// do the biphasic stuff
-					// TODO: I should only do this when the node is actually in contact
-					if (sporo && mporo && pt.m_pme)
-					{
-						// calculate nr of pressure dofs
-						int ndof = nseln + nmeln;
+							// do the biphasic stuff
+							// TODO: I should only do this when the node is actually in contact
+							if (sporo && mporo && pt.m_pme)
+							{
+								// calculate nr of pressure dofs
+								int ndof = nseln + nmeln;
 						
-						// calculate the flow rate
-						double epsp = m_epsp*pt.m_epsp;
+								// calculate the flow rate
+								double epsp = m_epsp*pt.m_epsp;
 						
-						double wn = pt.m_Lmp + epsp*pt.m_pg;
+								double wn = pt.m_Lmp + epsp*pt.m_pg;
 						
-						// fill the LM
-						LM.resize(ndof);
-						for (k=0; k<nseln; ++k) LM[k        ] = sLM[3*nseln+k];
-						for (k=0; k<nmeln; ++k) LM[k + nseln] = mLM[3*nmeln+k];
+								// fill the LM
+								LM.resize(ndof);
+								for (k=0; k<nseln; ++k) LM[k        ] = sLM[3*nseln+k];
+								for (k=0; k<nmeln; ++k) LM[k + nseln] = mLM[3*nmeln+k];
 						
-						// fill the force array
-						fe.resize(ndof);
-						zero(fe);
-						for (k=0; k<nseln; ++k) N[k      ] =  Hs[k];
-						for (k=0; k<nmeln; ++k) N[k+nseln] = -Hm[k];
+								// fill the force array
+								fe.resize(ndof);
+								zero(fe);
+								for (k=0; k<nseln; ++k) N[k      ] =  Hs[k];
+								for (k=0; k<nmeln; ++k) N[k+nseln] = -Hm[k];
 						
-						for (k=0; k<ndof; ++k) fe[k] += dt*wn*N[k]*detJ[j]*w[j];
+								for (k=0; k<ndof; ++k) fe[k] += dt*wn*N[k]*detJ[j]*w[j];
 						
-						// assemble residual
-						R.Assemble(en, LM, fe);
+								// assemble residual
+								A.Add(i, en, LM, fe);
+							}
+						}
 					}
 				}
 			}
@@ -858,11 +873,7 @@ void FETiedBiphasicInterface::Residual(FEGlobalVector& R, const FETimeInfo& tp)
 //-----------------------------------------------------------------------------
 void FETiedBiphasicInterface::StiffnessMatrix(FESolver* psolver, const FETimeInfo& tp)
 {
-	int i, j, k, l;
-	vector<int> sLM, mLM, LM, en;
 	const int MN = FEElement::MAX_NODES;
-	double detJ[MN], w[MN], *Hs, Hm[MN], pt[MN], dpr[MN], dps[MN];
-	matrix ke;
 
 	// get time step
     double dt = GetFEModel()->GetTime().timeIncrement;
@@ -898,377 +909,394 @@ void FETiedBiphasicInterface::StiffnessMatrix(FESolver* psolver, const FETimeInf
 		FETiedBiphasicSurface& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all slave elements
-		for (i=0; i<ss.Elements(); ++i)
+		// (the element matrices are evaluated in parallel and assembled in element order)
+		int ne = ss.Elements();
+		FEBlockAssembler A(psolver, ne);
+		while (A.NextBlock())
 		{
-			// get ths slave element
-			FESurfaceElement& se = ss.Element(i);
+			int n0 = A.BlockStart();
+			int n1 = A.BlockEnd();
+			#pragma omp parallel
+			{
+				int j, k, l;
+				vector<int> sLM, mLM, LM, en;
+				double detJ[MN], w[MN], *Hs, Hm[MN], pt[MN], dpr[MN], dps[MN];
+				matrix ke;
+
+				#pragma omp for schedule(dynamic)
+				for (int i=n0; i<n1; ++i)
+				{
+					// get ths slave element
+					FESurfaceElement& se = ss.Element(i);
 			
-			bool sporo = ss.m_poro[i];
+					bool sporo = ss.m_poro[i];
 			
-			// get nr of nodes and integration points
-			int nseln = se.Nodes();
-			int nint = se.GaussPoints();
+					// get nr of nodes and integration points
+					int nseln = se.Nodes();
+					int nint = se.GaussPoints();
 			
-			// nodal pressures
-			double pn[FEElement::MAX_NODES];
-			for (j=0; j<nseln; ++j) pn[j] = ss.GetMesh()->Node(se.m_node[j]).get(m_dofP);
+					// nodal pressures
+					double pn[FEElement::MAX_NODES];
+					for (j=0; j<nseln; ++j) pn[j] = ss.GetMesh()->Node(se.m_node[j]).get(m_dofP);
 			
-			// copy the LM vector
-			ss.UnpackLM(se, sLM);
+					// copy the LM vector
+					ss.UnpackLM(se, sLM);
 			
-			// we calculate all the metrics we need before we
-			// calculate the nodal forces
-			for (j=0; j<nint; ++j)
-			{
-				// get the base vectors
-				vec3d g[2];
-				ss.CoBaseVectors(se, j, g);
+					// we calculate all the metrics we need before we
+					// calculate the nodal forces
+					for (j=0; j<nint; ++j)
+					{
+						// get the base vectors
+						vec3d g[2];
+						ss.CoBaseVectors(se, j, g);
 				
-				// jacobians: J = |g0xg1|
-				detJ[j] = (g[0] ^ g[1]).norm();
+						// jacobians: J = |g0xg1|
+						detJ[j] = (g[0] ^ g[1]).norm();
 				
-				// integration weights
-				w[j] = se.GaussWeights()[j];
+						// integration weights
+						w[j] = se.GaussWeights()[j];
 				
-				// pressure
-				if (sporo)
-				{
-					pt[j] = se.eval(pn, j);
-					dpr[j] = se.eval_deriv1(pn, j);
-					dps[j] = se.eval_deriv2(pn, j);
-				}
-			}
+						// pressure
+						if (sporo)
+						{
+							pt[j] = se.eval(pn, j);
+							dpr[j] = se.eval_deriv1(pn, j);
+							dps[j] = se.eval_deriv2(pn, j);
+						}
+					}
 			
-			// loop over all integration points
-			for (j=0; j<nint; ++j)
-			{
-                FETiedBiphasicSurface::Data& pt = ss.m_Data[i][j];
+					// loop over all integration points
+					for (j=0; j<nint; ++j)
+					{
+                        FETiedBiphasicSurface::Data& pt = ss.m_Data[i][j];
                 
-				// get the master element
-				FESurfaceElement* pme = pt.m_pme;
-				if (pme)
-				{
-					FESurfaceElement& me = *pme;
+						// get the master element
+						FESurfaceElement* pme = pt.m_pme;
+						if (pme)
+						{
+							FESurfaceElement& me = *pme;
 					
-					bool mporo = ms.m_poro[pme->m_lid];
+							bool mporo = ms.m_poro[pme->m_lid];
 					
-					// get the nr of master nodes
-					int nmeln = me.Nodes();
+							// get the nr of master nodes
+							int nmeln = me.Nodes();
 					
-					// nodal pressure
-					double pm[FEElement::MAX_NODES];
-					if (mporo) for (k=0; k<nmeln; ++k) pm[k] = ms.GetMesh()->Node(me.m_node[k]).get(m_dofP);
+							// nodal pressure
+							double pm[FEElement::MAX_NODES];
+							if (mporo) for (k=0; k<nmeln; ++k) pm[k] = ms.GetMesh()->Node(me.m_node[k]).get(m_dofP);
 					
-					// copy the LM vector
-					ms.UnpackLM(me, mLM);
+							// copy the LM vector
+							ms.UnpackLM(me, mLM);
 					
-					int ndpn;	// number of dofs per node
-					int ndof;	// number of dofs in stiffness matrix
+							int ndpn;	// number of dofs per node
+							int ndof;	// number of dofs in stiffness matrix
 					
-					if (sporo && mporo) {
-						// calculate degrees of freedom for biphasic-on-biphasic contact
-						ndpn = 4;
-						ndof = ndpn*(nseln+nmeln);
+							if (sporo && mporo) {
+								// calculate degrees of freedom for biphasic-on-biphasic contact
+								ndpn = 4;
+								ndof = ndpn*(nseln+nmeln);
 						
-						// build the LM vector
-						LM.resize(ndof);
+								// build the LM vector
+								LM.resize(ndof);
 						
-						for (k=0; k<nseln; ++k)
-						{
-							LM[4*k  ] = sLM[3*k  ];			// x-dof
-							LM[4*k+1] = sLM[3*k+1];			// y-dof
-							LM[4*k+2] = sLM[3*k+2];			// z-dof
-							LM[4*k+3] = sLM[3*nseln+k];		// p-dof
-						}
-						for (k=0; k<nmeln; ++k)
-						{
-							LM[4*(k+nseln)  ] = mLM[3*k  ];			// x-dof
-							LM[4*(k+nseln)+1] = mLM[3*k+1];			// y-dof
-							LM[4*(k+nseln)+2] = mLM[3*k+2];			// z-dof
-							LM[4*(k+nseln)+3] = mLM[3*nmeln+k];		// p-dof
-						}
-					}
+								for (k=0; k<nseln; ++k)
+								{
+									LM[4*k  ] = sLM[3*k  ];			// x-dof
+									LM[4*k+1] = sLM[3*k+1];			// y-dof
+									LM[4*k+2] = sLM[3*k+2];			// z-dof
+									LM[4*k+3] = sLM[3*nseln+k];		// p-dof
+								}
+								for (k=0; k<nmeln; ++k)
+								{
+									LM[4*(k+nseln)  ] = mLM[3*k  ];			// x-dof
+									LM[4*(k+nseln)+1] = mLM[3*k+1];			// y-dof
+									LM[4*(k+nseln)+2] = mLM[3*k+2];			// z-dof
+									LM[4*(k+nseln)+3] = mLM[3*nmeln+k];		// p-dof
+								}
+							}
 					
-					else {
-						// calculate degrees of freedom for biphasic-on-elastic or elastic-on-elastic contact
-						ndpn = 3;
-						ndof = ndpn*(nseln + nmeln);
+							else {
+								// calculate degrees of freedom for biphasic-on-elastic or elastic-on-elastic contact
+								ndpn = 3;
+								ndof = ndpn*(nseln + nmeln);
 						
-						// build the LM vector
-						LM.resize(ndof);
+								// build the LM vector
+								LM.resize(ndof);
 						
-						for (k=0; k<nseln; ++k)
-						{
-							LM[3*k  ] = sLM[3*k  ];
-							LM[3*k+1] = sLM[3*k+1];
-							LM[3*k+2] = sLM[3*k+2];
-						}
+								for (k=0; k<nseln; ++k)
+								{
+									LM[3*k  ] = sLM[3*k  ];
+									LM[3*k+1] = sLM[3*k+1];
+									LM[3*k+2] = sLM[3*k+2];
+								}
 						
-						for (k=0; k<nmeln; ++k)
-						{
-							LM[3*(k+nseln)  ] = mLM[3*k  ];
-							LM[3*(k+nseln)+1] = mLM[3*k+1];
-							LM[3*(k+nseln)+2] = mLM[3*k+2];
-						}
-					}
+								for (k=0; k<nmeln; ++k)
+								{
+									LM[3*(k+nseln)  ] = mLM[3*k  ];
+									LM[3*(k+nseln)+1] = mLM[3*k+1];
+									LM[3*(k+nseln)+2] = mLM[3*k+2];
+								}
+							}
 					
-					// build the en vector
-					en.resize(nseln+nmeln);
-					for (k=0; k<nseln; ++k) en[k      ] = se.m_node[k];
-					for (k=0; k<nmeln; ++k) en[k+nseln] = me.m_node[k];
+							// build the en vector
+							en.resize(nseln+nmeln);
+							for (k=0; k<nseln; ++k) en[k      ] = se.m_node[k];
+							for (k=0; k<nmeln; ++k) en[k+nseln] = me.m_node[k];
 					
-					// slave shape functions
-					Hs = se.H(j);
+							// slave shape functions
+							Hs = se.H(j);
 					
-					// master shape functions
-					double r = pt.m_rs[0];
-					double s = pt.m_rs[1];
-					me.shape_fnc(Hm, r, s);
+							// master shape functions
+							double r = pt.m_rs[0];
+							double s = pt.m_rs[1];
+							me.shape_fnc(Hm, r, s);
 					
-					// get slave normal vector
-					vec3d nu = pt.m_nu;
+							// get slave normal vector
+							vec3d nu = pt.m_nu;
 					
-					// gap function
-					vec3d dg = pt.m_dg;
+							// gap function
+							vec3d dg = pt.m_dg;
 					
-					// lagrange multiplier
-					vec3d Lm = pt.m_Lmd;
+							// lagrange multiplier
+							vec3d Lm = pt.m_Lmd;
 					
-					// penalty 
-					double eps = m_epsn*pt.m_epsn;
+							// penalty 
+							double eps = m_epsn*pt.m_epsn;
 					
-					// contact traction
-					vec3d t = Lm + dg*eps;
+							// contact traction
+							vec3d t = Lm + dg*eps;
 					
-					// create the stiffness matrix
-					ke.resize(ndof, ndof); ke.zero();
+							// create the stiffness matrix
+							ke.resize(ndof, ndof); ke.zero();
 					
-					// --- S O L I D - S O L I D   C O N T A C T ---
+							// --- S O L I D - S O L I D   C O N T A C T ---
 					
-					// a. I-term
-					//------------------------------------
+							// a. I-term
+							//------------------------------------
 					
-					for (k=0; k<nseln; ++k) {
-						for (l=0; l<nseln; ++l)
-						{
-							ke[ndpn*k    ][ndpn*l    ] += eps*Hs[k]*Hs[l]*detJ[j]*w[j];
-							ke[ndpn*k + 1][ndpn*l + 1] += eps*Hs[k]*Hs[l]*detJ[j]*w[j];
-							ke[ndpn*k + 2][ndpn*l + 2] += eps*Hs[k]*Hs[l]*detJ[j]*w[j];
-						}
-						for (l=0; l<nmeln; ++l)
-						{
-							ke[ndpn*k    ][ndpn*(nseln+l)    ] += -eps*Hs[k]*Hm[l]*detJ[j]*w[j];
-							ke[ndpn*k + 1][ndpn*(nseln+l) + 1] += -eps*Hs[k]*Hm[l]*detJ[j]*w[j];
-							ke[ndpn*k + 2][ndpn*(nseln+l) + 2] += -eps*Hs[k]*Hm[l]*detJ[j]*w[j];
-						}
-					}
+							for (k=0; k<nseln; ++k) {
+								for (l=0; l<nseln; ++l)
+								{
+									ke[ndpn*k    ][ndpn*l    ] += eps*Hs[k]*Hs[l]*detJ[j]*w[j];
+									ke[ndpn*k + 1][ndpn*l + 1] += eps*Hs[k]*Hs[l]*detJ[j]*w[j];
+									ke[ndpn*k + 2][ndpn*l + 2] += eps*Hs[k]*Hs[l]*detJ[j]*w[j];
+								}
+								for (l=0; l<nmeln; ++l)
+								{
+									ke[ndpn*k    ][ndpn*(nseln+l)    ] += -eps*Hs[k]*Hm[l]*detJ[j]*w[j];
+									ke[ndpn*k + 1][ndpn*(nseln+l) + 1] += -eps*Hs[k]*Hm[l]*detJ[j]*w[j];
+									ke[ndpn*k + 2][ndpn*(nseln+l) + 2] += -eps*Hs[k]*Hm[l]*detJ[j]*w[j];
+								}
+							}
 					
-					for (k=0; k<nmeln; ++k) {
-						for (l=0; l<nseln; ++l)
-						{
-							ke[ndpn*(nseln+k)    ][ndpn*l    ] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
-							ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
-							ke[ndpn*(nseln+k) + 2][ndpn*l + 2] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
-						}
-						for (l=0; l<nmeln; ++l)
-						{
-							ke[ndpn*(nseln+k)    ][ndpn*(nseln+l)    ] += eps*Hm[k]*Hm[l]*detJ[j]*w[j];
-							ke[ndpn*(nseln+k) + 1][ndpn*(nseln+l) + 1] += eps*Hm[k]*Hm[l]*detJ[j]*w[j];
-							ke[ndpn*(nseln+k) + 2][ndpn*(nseln+l) + 2] += eps*Hm[k]*Hm[l]*detJ[j]*w[j];
-						}
-					}
+							for (k=0; k<nmeln; ++k) {
+								for (l=0; l<nseln; ++l)
+								{
+									ke[ndpn*(nseln+k)    ][ndpn*l    ] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
+									ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
+									ke[ndpn*(nseln+k) + 2][ndpn*l + 2] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
+								}
+								for (l=0; l<nmeln; ++l)
+								{
+									ke[ndpn*(nseln+k)    ][ndpn*(nseln+l)    ] += eps*Hm[k]*Hm[l]*detJ[j]*w[j];
+									ke[ndpn*(nseln+k) + 1][ndpn*(nseln+l) + 1] += eps*Hm[k]*Hm[l]*detJ[j]*w[j];
+									ke[ndpn*(nseln+k) + 2][ndpn*(nseln+l) + 2] += eps*Hm[k]*Hm[l]*detJ[j]*w[j];
+								}
+							}
 					
-					// b. A-term
-					//-------------------------------------
+							// b. A-term
+							//-------------------------------------
 					
-					double* Gr = se.Gr(j);
-					double* Gs = se.Gs(j);
-					vec3d gs[2];
-					ss.CoBaseVectors(se, j, gs);
+							double* Gr = se.Gr(j);
+							double* Gs = se.Gs(j);
+							vec3d gs[2];
+							ss.CoBaseVectors(se, j, gs);
 					
-					vec3d as[FEElement::MAX_NODES];
-					mat3d As[FEElement::MAX_NODES];
-					for (l=0; l<nseln; ++l) {
-						as[l] = nu ^ (gs[1]*Gr[l] - gs[0]*Gs[l]);
-						As[l] = t & as[l];
-					}
+							vec3d as[FEElement::MAX_NODES];
+							mat3d As[FEElement::MAX_NODES];
+							for (l=0; l<nseln; ++l) {
+								as[l] = nu ^ (gs[1]*Gr[l] - gs[0]*Gs[l]);
+								As[l] = t & as[l];
+							}
 					
-					if (!m_bsymm)
-					{
-						// non-symmetric
-						for (k=0; k<nseln; ++k) {
-							for (l=0; l<nseln; ++l)
+							if (!m_bsymm)
 							{
-								ke[ndpn*k    ][ndpn*l    ] += Hs[k]*As[l](0,0)*w[j];
-								ke[ndpn*k    ][ndpn*l + 1] += Hs[k]*As[l](0,1)*w[j];
-								ke[ndpn*k    ][ndpn*l + 2] += Hs[k]*As[l](0,2)*w[j];
+								// non-symmetric
+								for (k=0; k<nseln; ++k) {
+									for (l=0; l<nseln; ++l)
+									{
+										ke[ndpn*k    ][ndpn*l    ] += Hs[k]*As[l](0,0)*w[j];
+										ke[ndpn*k    ][ndpn*l + 1] += Hs[k]*As[l](0,1)*w[j];
+										ke[ndpn*k    ][ndpn*l + 2] += Hs[k]*As[l](0,2)*w[j];
 
-								ke[ndpn*k + 1][ndpn*l    ] += Hs[k]*As[l](1,0)*w[j];
-								ke[ndpn*k + 1][ndpn*l + 1] += Hs[k]*As[l](1,1)*w[j];
-								ke[ndpn*k + 1][ndpn*l + 2] += Hs[k]*As[l](1,2)*w[j];
+										ke[ndpn*k + 1][ndpn*l    ] += Hs[k]*As[l](1,0)*w[j];
+										ke[ndpn*k + 1][ndpn*l + 1] += Hs[k]*As[l](1,1)*w[j];
+										ke[ndpn*k + 1][ndpn*l + 2] += Hs[k]*As[l](1,2)*w[j];
 
-								ke[ndpn*k + 2][ndpn*l    ] += Hs[k]*As[l](2,0)*w[j];
-								ke[ndpn*k + 2][ndpn*l + 1] += Hs[k]*As[l](2,1)*w[j];
-								ke[ndpn*k + 2][ndpn*l + 2] += Hs[k]*As[l](2,2)*w[j];
-							}
-						}
+										ke[ndpn*k + 2][ndpn*l    ] += Hs[k]*As[l](2,0)*w[j];
+										ke[ndpn*k + 2][ndpn*l + 1] += Hs[k]*As[l](2,1)*w[j];
+										ke[ndpn*k + 2][ndpn*l + 2] += Hs[k]*As[l](2,2)*w[j];
+									}
+								}
 						
-						for (k=0; k<nmeln; ++k) {
-							for (l=0; l<nseln; ++l)
-							{
-								ke[ndpn*(nseln+k)    ][ndpn*l    ] += -Hm[k]*As[l](0,0)*w[j];
-								ke[ndpn*(nseln+k)    ][ndpn*l + 1] += -Hm[k]*As[l](0,1)*w[j];
-								ke[ndpn*(nseln+k)    ][ndpn*l + 2] += -Hm[k]*As[l](0,2)*w[j];
+								for (k=0; k<nmeln; ++k) {
+									for (l=0; l<nseln; ++l)
+									{
+										ke[ndpn*(nseln+k)    ][ndpn*l    ] += -Hm[k]*As[l](0,0)*w[j];
+										ke[ndpn*(nseln+k)    ][ndpn*l + 1] += -Hm[k]*As[l](0,1)*w[j];
+										ke[ndpn*(nseln+k)    ][ndpn*l + 2] += -Hm[k]*As[l](0,2)*w[j];
 
-								ke[ndpn*(nseln+k) + 1][ndpn*l    ] += -Hm[k]*As[l](1,0)*w[j];
-								ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -Hm[k]*As[l](1,1)*w[j];
-								ke[ndpn*(nseln+k) + 1][ndpn*l + 2] += -Hm[k]*As[l](1,2)*w[j];
+										ke[ndpn*(nseln+k) + 1][ndpn*l    ] += -Hm[k]*As[l](1,0)*w[j];
+										ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -Hm[k]*As[l](1,1)*w[j];
+										ke[ndpn*(nseln+k) + 1][ndpn*l + 2] += -Hm[k]*As[l](1,2)*w[j];
 
-								ke[ndpn*(nseln+k) + 2][ndpn*l    ] += -Hm[k]*As[l](2,0)*w[j];
-								ke[ndpn*(nseln+k) + 2][ndpn*l + 1] += -Hm[k]*As[l](2,1)*w[j];
-								ke[ndpn*(nseln+k) + 2][ndpn*l + 2] += -Hm[k]*As[l](2,2)*w[j];
-							}
-						}
+										ke[ndpn*(nseln+k) + 2][ndpn*l    ] += -Hm[k]*As[l](2,0)*w[j];
+										ke[ndpn*(nseln+k) + 2][ndpn*l + 1] += -Hm[k]*As[l](2,1)*w[j];
+										ke[ndpn*(nseln+k) + 2][ndpn*l + 2] += -Hm[k]*As[l](2,2)*w[j];
+									}
+								}
 						
-					}
-					else 
-					{
-						// symmetric
-						for (k=0; k<nseln; ++k) {
-							for (l=0; l<nseln; ++l)
+							}
+							else 
 							{
-								ke[ndpn*k    ][ndpn*l    ] += 0.5*(Hs[k]*As[l](0,0)+Hs[l]*As[k](0,0))*w[j];
-								ke[ndpn*k    ][ndpn*l + 1] += 0.5*(Hs[k]*As[l](0,1)+Hs[l]*As[k](1,0))*w[j];
-								ke[ndpn*k    ][ndpn*l + 2] += 0.5*(Hs[k]*As[l](0,2)+Hs[l]*As[k](2,0))*w[j];
+								// symmetric
+								for (k=0; k<nseln; ++k) {
+									for (l=0; l<nseln; ++l)
+									{
+										ke[ndpn*k    ][ndpn*l    ] += 0.5*(Hs[k]*As[l](0,0)+Hs[l]*As[k](0,0))*w[j];
+										ke[ndpn*k    ][ndpn*l + 1] += 0.5*(Hs[k]*As[l](0,1)+Hs[l]*As[k](1,0))*w[j];
+										ke[ndpn*k    ][ndpn*l + 2] += 0.5*(Hs[k]*As[l](0,2)+Hs[l]*As[k](2,0))*w[j];
 								
-								ke[ndpn*k + 1][ndpn*l    ] += 0.5*(Hs[k]*As[l](1,0)+Hs[l]*As[k](0,1))*w[j];
-								ke[ndpn*k + 1][ndpn*l + 1] += 0.5*(Hs[k]*As[l](1,1)+Hs[l]*As[k](1,1))*w[j];
-								ke[ndpn*k + 1][ndpn*l + 2] += 0.5*(Hs[k]*As[l](1,2)+Hs[l]*As[k](2,1))*w[j];
+										ke[ndpn*k + 1][ndpn*l    ] += 0.5*(Hs[k]*As[l](1,0)+Hs[l]*As[k](0,1))*w[j];
+										ke[ndpn*k + 1][ndpn*l + 1] += 0.5*(Hs[k]*As[l](1,1)+Hs[l]*As[k](1,1))*w[j];
+										ke[ndpn*k + 1][ndpn*l + 2] += 0.5*(Hs[k]*As[l](1,2)+Hs[l]*As[k](2,1))*w[j];
 								
-								ke[ndpn*k + 2][ndpn*l    ] += 0.5*(Hs[k]*As[l](2,0)+Hs[l]*As[k](0,2))*w[j];
-								ke[ndpn*k + 2][ndpn*l + 1] += 0.5*(Hs[k]*As[l](2,1)+Hs[l]*As[k](1,2))*w[j];
-								ke[ndpn*k + 2][ndpn*l + 2] += 0.5*(Hs[k]*As[l](2,2)+Hs[l]*As[k](2,2))*w[j];
-							}
-						}
+										ke[ndpn*k + 2][ndpn*l    ] += 0.5*(Hs[k]*As[l](2,0)+Hs[l]*As[k](0,2))*w[j];
+										ke[ndpn*k + 2][ndpn*l + 1] += 0.5*(Hs[k]*As[l](2,1)+Hs[l]*As[k](1,2))*w[j];
+										ke[ndpn*k + 2][ndpn*l + 2] += 0.5*(Hs[k]*As[l](2,2)+Hs[l]*As[k](2,2))*w[j];
+									}
+								}
 						
-						for (k=0; k<nmeln; ++k) {
-							for (l=0; l<nseln; ++l)
-							{
-								ke[ndpn*(nseln+k)    ][ndpn*l    ] += -0.5*Hm[k]*As[l](0,0)*w[j];
-								ke[ndpn*(nseln+k)    ][ndpn*l + 1] += -0.5*Hm[k]*As[l](0,1)*w[j];
-								ke[ndpn*(nseln+k)    ][ndpn*l + 2] += -0.5*Hm[k]*As[l](0,2)*w[j];
+								for (k=0; k<nmeln; ++k) {
+									for (l=0; l<nseln; ++l)
+									{
+										ke[ndpn*(nseln+k)    ][ndpn*l    ] += -0.5*Hm[k]*As[l](0,0)*w[j];
+										ke[ndpn*(nseln+k)    ][ndpn*l + 1] += -0.5*Hm[k]*As[l](0,1)*w[j];
+										ke[ndpn*(nseln+k)    ][ndpn*l + 2] += -0.5*Hm[k]*As[l](0,2)*w[j];
 								
-								ke[ndpn*(nseln+k) + 1][ndpn*l    ] += -0.5*Hm[k]*As[l](1,0)*w[j];
-								ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -0.5*Hm[k]*As[l](1,1)*w[j];
-								ke[ndpn*(nseln+k) + 1][ndpn*l + 2] += -0.5*Hm[k]*As[l](1,2)*w[j];
+										ke[ndpn*(nseln+k) + 1][ndpn*l    ] += -0.5*Hm[k]*As[l](1,0)*w[j];
+										ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -0.5*Hm[k]*As[l](1,1)*w[j];
+										ke[ndpn*(nseln+k) + 1][ndpn*l + 2] += -0.5*Hm[k]*As[l](1,2)*w[j];
 								
-								ke[ndpn*(nseln+k) + 2][ndpn*l    ] += -0.5*Hm[k]*As[l](2,0)*w[j];
-								ke[ndpn*(nseln+k) + 2][ndpn*l + 1] += -0.5*Hm[k]*As[l](2,1)*w[j];
-								ke[ndpn*(nseln+k) + 2][ndpn*l + 2] += -0.5*Hm[k]*As[l](2,2)*w[j];
-							}
-						}
+										ke[ndpn*(nseln+k) + 2][ndpn*l    ] += -0.5*Hm[k]*As[l](2,0)*w[j];
+										ke[ndpn*(nseln+k) + 2][ndpn*l + 1] += -0.5*Hm[k]*As[l](2,1)*w[j];
+										ke[ndpn*(nseln+k) + 2][ndpn*l + 2] += -0.5*Hm[k]*As[l](2,2)*w[j];
+									}
+								}
 						
-						for (k=0; k<nseln; ++k) {
-							for (l=0; l<nmeln; ++l)
-							{
-								ke[ndpn*k    ][ndpn*(nseln+l)    ] += -0.5*Hm[l]*As[k](0,0)*w[j];
-								ke[ndpn*k    ][ndpn*(nseln+l) + 1] += -0.5*Hm[l]*As[k](1,0)*w[j];
-								ke[ndpn*k    ][ndpn*(nseln+l) + 2] += -0.5*Hm[l]*As[k](2,0)*w[j];
+								for (k=0; k<nseln; ++k) {
+									for (l=0; l<nmeln; ++l)
+									{
+										ke[ndpn*k    ][ndpn*(nseln+l)    ] += -0.5*Hm[l]*As[k](0,0)*w[j];
+										ke[ndpn*k    ][ndpn*(nseln+l) + 1] += -0.5*Hm[l]*As[k](1,0)*w[j];
+										ke[ndpn*k    ][ndpn*(nseln+l) + 2] += -0.5*Hm[l]*As[k](2,0)*w[j];
 								
-								ke[ndpn*k + 1][ndpn*(nseln+l)    ] += -0.5*Hm[l]*As[k](0,1)*w[j];
-								ke[ndpn*k + 1][ndpn*(nseln+l) + 1] += -0.5*Hm[l]*As[k](1,1)*w[j];
-								ke[ndpn*k + 1][ndpn*(nseln+l) + 2] += -0.5*Hm[l]*As[k](2,1)*w[j];
+										ke[ndpn*k + 1][ndpn*(nseln+l)    ] += -0.5*Hm[l]*As[k](0,1)*w[j];
+										ke[ndpn*k + 1][ndpn*(nseln+l) + 1] += -0.5*Hm[l]*As[k](1,1)*w[j];
+										ke[ndpn*k + 1][ndpn*(nseln+l) + 2] += -0.5*Hm[l]*As[k](2,1)*w[j];
 								
-								ke[ndpn*k + 2][ndpn*(nseln+l)    ] += -0.5*Hm[l]*As[k](0,2)*w[j];
-								ke[ndpn*k + 2][ndpn*(nseln+l) + 1] += -0.5*Hm[l]*As[k](1,2)*w[j];
-								ke[ndpn*k + 2][ndpn*(nseln+l) + 2] += -0.5*Hm[l]*As[k](2,2)*w[j];
+										ke[ndpn*k + 2][ndpn*(nseln+l)    ] += -0.5*Hm[l]*As[k](0,2)*w[j];
+										ke[ndpn*k + 2][ndpn*(nseln+l) + 1] += -0.5*Hm[l]*As[k](1,2)*w[j];
+										ke[ndpn*k + 2][ndpn*(nseln+l) + 2] += -0.5*Hm[l]*As[k](2,2)*w[j];
+									}
+								}
 							}
-						}
-					}
 
 					
-					// --- B I P H A S I C   S T I F F N E S S ---
-					if (sporo && mporo)
-					{
-						double epsp = (pt.m_pme) ? m_epsp*pt.m_epsp : 0.;
+							// --- B I P H A S I C   S T I F F N E S S ---
+							if (sporo && mporo)
+							{
+								double epsp = (pt.m_pme) ? m_epsp*pt.m_epsp : 0.;
 						
-						// --- S O L I D - P R E S S U R E   C O N T A C T ---
+								// --- S O L I D - P R E S S U R E   C O N T A C T ---
 						
-						// b. A-term
-						//-------------------------------------
+								// b. A-term
+								//-------------------------------------
 
-						double wn = pt.m_Lmp + epsp*pt.m_pg;
+								double wn = pt.m_Lmp + epsp*pt.m_pg;
 						
-						if (!m_bsymm)
-						{
-							// non-symmetric
-							for (k=0; k<nseln; ++k)
-								for (l=0; l<nseln; ++l) {
+								if (!m_bsymm)
 								{
-									ke[4*k + 3][4*l  ] += dt*w[j]*wn*Hs[k]*as[l].x;
-									ke[4*k + 3][4*l+1] += dt*w[j]*wn*Hs[k]*as[l].y;
-									ke[4*k + 3][4*l+2] += dt*w[j]*wn*Hs[k]*as[l].z;
-								}
-							}
-							for (k=0; k<nmeln; ++k)
-								for (l=0; l<nseln; ++l) {
-									{
-										ke[4*(k+nseln) + 3][4*l  ] += -dt*w[j]*wn*Hm[k]*as[l].x;
-										ke[4*(k+nseln) + 3][4*l+1] += -dt*w[j]*wn*Hm[k]*as[l].y;
-										ke[4*(k+nseln) + 3][4*l+2] += -dt*w[j]*wn*Hm[k]*as[l].z;
+									// non-symmetric
+									for (k=0; k<nseln; ++k)
+										for (l=0; l<nseln; ++l) {
+										{
+											ke[4*k + 3][4*l  ] += dt*w[j]*wn*Hs[k]*as[l].x;
+											ke[4*k + 3][4*l+1] += dt*w[j]*wn*Hs[k]*as[l].y;
+											ke[4*k + 3][4*l+2] += dt*w[j]*wn*Hs[k]*as[l].z;
+										}
 									}
+									for (k=0; k<nmeln; ++k)
+										for (l=0; l<nseln; ++l) {
+											{
+												ke[4*(k+nseln) + 3][4*l  ] += -dt*w[j]*wn*Hm[k]*as[l].x;
+												ke[4*(k+nseln) + 3][4*l+1] += -dt*w[j]*wn*Hm[k]*as[l].y;
+												ke[4*(k+nseln) + 3][4*l+2] += -dt*w[j]*wn*Hm[k]*as[l].z;
+											}
+										}
 								}
-						}
-						else 
-						{
-							// symmetric
-							for (k=0; k<nseln; ++k)
-								for (l=0; l<nseln; ++l) {
-									{
-										ke[4*k + 3][4*l  ] += dt*w[j]*wn*0.5*(Hs[k]*as[l].x+Hs[l]*as[k].x);
-										ke[4*k + 3][4*l+1] += dt*w[j]*wn*0.5*(Hs[k]*as[l].y+Hs[l]*as[k].y);
-										ke[4*k + 3][4*l+2] += dt*w[j]*wn*0.5*(Hs[k]*as[l].z+Hs[l]*as[k].z);
-									}
-								}
-							for (k=0; k<nmeln; ++k)
-								for (l=0; l<nseln; ++l) {
-									{
-										ke[4*(k+nseln) + 3][4*l  ] += -dt*w[j]*wn*0.5*Hm[k]*as[l].x;
-										ke[4*(k+nseln) + 3][4*l+1] += -dt*w[j]*wn*0.5*Hm[k]*as[l].y;
-										ke[4*(k+nseln) + 3][4*l+2] += -dt*w[j]*wn*0.5*Hm[k]*as[l].z;
-									}
-								}
-							for (k=0; k<nseln; ++k)
-								for (l=0; l<nmeln; ++l) {
-									{
-										ke[4*k + 3][4*(nseln+l)  ] += -dt*w[j]*wn*0.5*Hm[l]*as[k].x;
-										ke[4*k + 3][4*(nseln+l)+1] += -dt*w[j]*wn*0.5*Hm[l]*as[k].y;
-										ke[4*k + 3][4*(nseln+l)+2] += -dt*w[j]*wn*0.5*Hm[l]*as[k].z;
-									}
+								else 
+								{
+									// symmetric
+									for (k=0; k<nseln; ++k)
+										for (l=0; l<nseln; ++l) {
+											{
+												ke[4*k + 3][4*l  ] += dt*w[j]*wn*0.5*(Hs[k]*as[l].x+Hs[l]*as[k].x);
+												ke[4*k + 3][4*l+1] += dt*w[j]*wn*0.5*(Hs[k]*as[l].y+Hs[l]*as[k].y);
+												ke[4*k + 3][4*l+2] += dt*w[j]*wn*0.5*(Hs[k]*as[l].z+Hs[l]*as[k].z);
+											}
+										}
+									for (k=0; k<nmeln; ++k)
+										for (l=0; l<nseln; ++l) {
+											{
+												ke[4*(k+nseln) + 3][4*l  ] += -dt*w[j]*wn*0.5*Hm[k]*as[l].x;
+												ke[4*(k+nseln) + 3][4*l+1] += -dt*w[j]*wn*0.5*Hm[k]*as[l].y;
+												ke[4*(k+nseln) + 3][4*l+2] += -dt*w[j]*wn*0.5*Hm[k]*as[l].z;
+											}
+										}
+									for (k=0; k<nseln; ++k)
+										for (l=0; l<nmeln; ++l) {
+											{
+												ke[4*k + 3][4*(nseln+l)  ] += -dt*w[j]*wn*0.5*Hm[l]*as[k].x;
+												ke[4*k + 3][4*(nseln+l)+1] += -dt*w[j]*wn*0.5*Hm[l]*as[k].y;
+												ke[4*k + 3][4*(nseln+l)+2] += -dt*w[j]*wn*0.5*Hm[l]*as[k].z;
+											}
+										}
 								}
-						}
 
 						
-						// --- P R E S S U R E - P R E S S U R E   C O N T A C T ---
+								// --- P R E S S U R E - P R E S S U R E   C O N T A C T ---
 						
-						for (k=0; k<nseln; ++k) {
-							for (l=0; l<nseln; ++l)
-								ke[4*k + 3][4*l+3] += -dt*epsp*w[j]*detJ[j]*Hs[k]*Hs[l];
-							for (l=0; l<nmeln; ++l)
-								ke[4*k + 3][4*(nseln+l)+3] += dt*epsp*w[j]*detJ[j]*Hs[k]*Hm[l];
-						}
+								for (k=0; k<nseln; ++k) {
+									for (l=0; l<nseln; ++l)
+										ke[4*k + 3][4*l+3] += -dt*epsp*w[j]*detJ[j]*Hs[k]*Hs[l];
+									for (l=0; l<nmeln; ++l)
+										ke[4*k + 3][4*(nseln+l)+3] += dt*epsp*w[j]*detJ[j]*Hs[k]*Hm[l];
+								}
 						
-						for (k=0; k<nmeln; ++k) {
-							for (l=0; l<nseln; ++l)
-								ke[4*(nseln+k)+3][4*l + 3] += dt*epsp*w[j]*detJ[j]*Hm[k]*Hs[l];
-							for (l=0; l<nmeln; ++l)
-								ke[4*(nseln+k)+3][4*(nseln+l) + 3] += -dt*epsp*w[j]*detJ[j]*Hm[k]*Hm[l];
-						}
+								for (k=0; k<nmeln; ++k) {
+									for (l=0; l<nseln; ++l)
+										ke[4*(nseln+k)+3][4*l + 3] += dt*epsp*w[j]*detJ[j]*Hm[k]*Hs[l];
+									for (l=0; l<nmeln; ++l)
+										ke[4*(nseln+k)+3][4*(nseln+l) + 3] += -dt*epsp*w[j]*detJ[j]*Hm[k]*Hm[l];
+								}
 						
-					}
+							}
 					
-					// assemble the global stiffness
-					psolver->AssembleStiffness(en, LM, ke);
+							// assemble the global stiffness
+							A.Add(i, en, LM, ke);
+						}
+					}
 				}
 			}
 		}
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include "FECore/FEAnalysis.h"
 #include "FECore/FENormalProjection.h"
 #include "FECore/log.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 // Define sliding interface parameters
@@ -377,7 +378,7 @@ void FETiedMultiphasicSurface::Serialize(DumpStream& ar)
 
 FETiedMultiphasicInterface::FETiedMultiphasicInterface(FEModel* pfem) : FEContactInterface(pfem), m_ss(pfem), m_ms(pfem)
 {
-    static int count = 1;
+    static std::atomic<int> count(1);
     SetID(count++);
     
     // initial values
@@ -166,8 +166,15 @@ double FETriphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 {
 	int i, j;
 	
-	// Solve electroneutrality polynomial for zeta
+	// the polynomial only needs to be solved once for each state of the material point
 	FESolutesMaterialPoint& set = *pt.ExtractData<FESolutesMaterialPoint>();
+	if (set.m_bzeta)
+	{
+		if (eform) return set.m_zeta;
+		return -m_Rgas*m_Tabs/m_Fc*log(set.m_zeta);
+	}
+	
+	// Solve electroneutrality polynomial for zeta
 	const int nsol = 2;
 	double cF = FixedChargeDensity(pt);
 	double c[2];		// effective concentration
@@ -196,6 +203,10 @@ double FETriphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 		zeta = -a[0]/a[1];			// linear
 	}
 	
+	// store the solution for the current state
+	set.m_zeta = zeta;
+	set.m_bzeta = true;
+	
 	// Return exponential (non-dimensional) form if desired
 	if (eform) return zeta;
 	
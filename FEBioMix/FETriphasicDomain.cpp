@@ -89,6 +89,9 @@ void FETriphasicDomain::UnpackLM(FEElement& el, vector<int>& lm)
 //-----------------------------------------------------------------------------
 void FETriphasicDomain::Activate()
 {
+	// allocate the scratch data of the element kernels
+	m_ws.Init(2, 0);
+
 	int dofc0 = m_dofC + m_pMat->m_pSolute[0]->GetSoluteID();
 	int dofc1 = m_dofC + m_pMat->m_pSolute[1]->GetSoluteID();
 
@@ -167,6 +170,9 @@ void FETriphasicDomain::Activate()
 				ps.m_gradc[isol] = gradient(el, c0[isol], n);
 			}
 
+			// the state has changed, so the electroneutrality condition must be solved again
+			ps.m_bzeta = false;
+			
 			ps.m_psi = pmb->ElectricPotential(mp);
 			for (int isol = 0; isol<nsol; ++isol) {
 				ps.m_ca[isol] = pmb->Concentration(mp, isol);
@@ -286,12 +292,15 @@ void FETriphasicDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 void FETriphasicDomain::InternalForces(FEGlobalVector& R)
 {
 	size_t NE = m_Elem.size();
+	m_ws.Init(2, 0);
+	
 	#pragma omp parallel for shared (NE)
 	for (int i=0; i<NE; ++i)
 	{
 		// element force vector
-		vector<double> fe;
-		vector<int> lm;
+		FESoluteWorkspace& ws = m_ws.Get();
+		vector<double>& fe = ws.fe;
+		vector<int>& lm = ws.lm;
 		
 		// get the element
 		FESolidElement& el = m_Elem[i];
@@ -407,12 +416,15 @@ void FETriphasicDomain::ElementInternalForce(FESolidElement& el, vector<double>&
 void FETriphasicDomain::InternalForcesSS(FEGlobalVector& R)
 {
     size_t NE = m_Elem.size();
+    m_ws.Init(2, 0);
+    
 #pragma omp parallel for shared (NE)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FESoluteWorkspace& ws = m_ws.Get();
+        vector<double>& fe = ws.fe;
+        vector<int>& lm = ws.lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -516,12 +528,15 @@ void FETriphasicDomain::StiffnessMatrix(FESolver* psolver, bool bsymm)
 	// repeat over all solid elements
 	size_t NE = m_Elem.size();
     
+	m_ws.Init(2, 0);
+	
 	#pragma omp parallel for shared(NE)
 	for (int iel=0; iel<NE; ++iel)
 	{
 		// element stiffness matrix
-		matrix ke;
-		vector<int> lm;
+		FESoluteWorkspace& ws = m_ws.Get();
+		matrix& ke = ws.ke;
+		vector<int>& lm = ws.lm;
 		
 		FESolidElement& el = m_Elem[iel];
 		UnpackLM(el, lm);
@@ -547,12 +562,15 @@ void FETriphasicDomain::StiffnessMatrixSS(FESolver* psolver, bool bsymm)
 	// repeat over all solid elements
 	size_t NE = m_Elem.size();
     
+	m_ws.Init(2, 0);
+	
     #pragma omp parallel for shared(NE)
 	for (int iel=0; iel<NE; ++iel)
 	{
 		// element stiffness matrix
-		matrix ke;
-		vector<int> lm;
+		FESoluteWorkspace& ws = m_ws.Get();
+		matrix& ke = ws.ke;
+		vector<int>& lm = ws.lm;
 		
 		FESolidElement& el = m_Elem[iel];
 		UnpackLM(el, lm);
@@ -588,7 +606,7 @@ bool FETriphasicDomain::ElementTriphasicStiffness(FESolidElement& el, matrix& ke
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradN(neln);
+    vec3d gradN[FEElement::MAX_NODES];
     double tmp;
     
     // gauss-weights
@@ -603,6 +621,9 @@ bool FETriphasicDomain::ElementTriphasicStiffness(FESolidElement& el, matrix& ke
     // zero stiffness matrix
     ke.zero();
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // loop over gauss-points
     for (n=0; n<nint; ++n)
     {
@@ -641,21 +662,21 @@ bool FETriphasicDomain::ElementTriphasicStiffness(FESolidElement& el, matrix& ke
         vec3d w = ppt.m_w;
         vec3d gradp = ppt.m_gradp;
         
-        vector<double> c(spt.m_c);
-        vector<vec3d> gradc(spt.m_gradc);
-        vector<int> z(nsol);
+        const vector<double>& c = spt.m_c;
+        const vector<vec3d>& gradc = spt.m_gradc;
+        vector<int>& z = ws.z;
         
-        vector<double> kappa(spt.m_k);
+        const vector<double>& kappa = spt.m_k;
         
         // get the charge number
         for (isol=0; isol<nsol; ++isol)
             z[isol] = pm->m_pSolute[isol]->ChargeNumber();
         
-        vector<double> dkdJ(spt.m_dkdJ);
-        vector< vector<double> > dkdc(spt.m_dkdc);
-        vector< vector<double> > dkdr(spt.m_dkdr);
-        vector< vector<double> > dkdJr(spt.m_dkdJr);
-        vector< vector< vector<double> > > dkdrc(spt.m_dkdrc);
+        const vector<double>& dkdJ = spt.m_dkdJ;
+        const vector< vector<double> >& dkdc = spt.m_dkdc;
+        const vector< vector<double> >& dkdr = spt.m_dkdr;
+        const vector< vector<double> >& dkdJr = spt.m_dkdJr;
+        const vector< vector< vector<double> > >& dkdrc = spt.m_dkdrc;
         
         // evaluate the porosity and its derivative
         double phiw = pm->Porosity(mp);
@@ -669,15 +690,15 @@ bool FETriphasicDomain::ElementTriphasicStiffness(FESolidElement& el, matrix& ke
         mat3ds K = pm->m_pPerm->Permeability(mp);
         tens4ds dKdE = pm->m_pPerm->Tangent_Permeability_Strain(mp);
         
-        vector<mat3ds> dKdc(nsol);
-        vector<mat3ds> D(nsol);
-        vector<tens4ds> dDdE(nsol);
-        vector< vector<mat3ds> > dDdc(nsol, vector<mat3ds>(nsol));
-        vector<double> D0(nsol);
-        vector< vector<double> > dD0dc(nsol, vector<double>(nsol));
-        vector<double> dodc(nsol);
-        vector<mat3ds> dTdc(nsol);
-        vector<mat3ds> ImD(nsol);
+        vector<mat3ds>& dKdc = ws.dKdc;
+        vector<mat3ds>& D = ws.D;
+        vector<tens4ds>& dDdE = ws.dDdE;
+        vector< vector<mat3ds> >& dDdc = ws.dDdc;
+        vector<double>& D0 = ws.D0;
+        vector< vector<double> >& dD0dc = ws.dD0dc;
+        vector<double>& dodc = ws.dodc;
+        vector<mat3ds>& dTdc = ws.dTdc;
+        vector<mat3ds>& ImD = ws.ImD;
         mat3dd I(1);
         
         for (isol=0; isol<nsol; ++isol) {
@@ -715,8 +736,8 @@ bool FETriphasicDomain::ElementTriphasicStiffness(FESolidElement& el, matrix& ke
         mat3ds Ki = K.inverse();
         mat3ds Ke(0,0,0,0,0,0);
         tens4ds G = dyad1s(Ki,I) - dyad4s(Ki,I)*2 - ddots(dyad2s(Ki),dKdE)*0.5;
-        vector<mat3ds> Gc(nsol);
-        vector<mat3ds> dKedc(nsol);
+        vector<mat3ds>& Gc = ws.Gc;
+        vector<mat3ds>& dKedc = ws.dKedc;
         for (isol=0; isol<nsol; ++isol) {
             Ke += ImD[isol]*(kappa[isol]*c[isol]/D0[isol]);
             G += dyad1s(ImD[isol],I)*(R*T*c[isol]*J/D0[isol]/2/phiw*(dkdJ[isol]-kappa[isol]/phiw*dpdJ))
@@ -735,11 +756,14 @@ bool FETriphasicDomain::ElementTriphasicStiffness(FESolidElement& el, matrix& ke
         
         // calculate all the matrices
         vec3d vtmp,gp,qpu;
-        vector<vec3d> gc(nsol),qcu(nsol),wc(nsol),jce(nsol);
-        vector< vector<vec3d> > jc(nsol, vector<vec3d>(nsol));
+        vector<vec3d>& gc = ws.gc;
+        vector<vec3d>& qcu = ws.qcu;
+        vector<vec3d>& wc = ws.wc;
+        vector<vec3d>& jce = ws.jce;
+        vector< vector<vec3d> >& jc = ws.jc;
         mat3d wu, jue;
-        vector<mat3d> ju(nsol);
-        vector< vector<double> > qcc(nsol, vector<double>(nsol));
+        vector<mat3d>& ju = ws.ju;
+        vector< vector<double> >& qcc = ws.qcc;
         double sum;
         mat3ds De;
         for (i=0; i<neln; ++i)
@@ -892,7 +916,7 @@ bool FETriphasicDomain::ElementTriphasicStiffnessSS(FESolidElement& el, matrix&
     double Ji[3][3], detJ;
     
     // Gradient of shape functions
-    vector<vec3d> gradN(neln);
+    vec3d gradN[FEElement::MAX_NODES];
     double tmp;
     
     // gauss-weights
@@ -907,6 +931,9 @@ bool FETriphasicDomain::ElementTriphasicStiffnessSS(FESolidElement& el, matrix&
     // zero stiffness matrix
     ke.zero();
     
+    // get the workspace of this thread
+    FESoluteWorkspace& ws = m_ws.Get();
+    
     // loop over gauss-points
     for (n=0; n<nint; ++n)
     {
@@ -945,21 +972,21 @@ bool FETriphasicDomain::ElementTriphasicStiffnessSS(FESolidElement& el, matrix&
         vec3d w = ppt.m_w;
         vec3d gradp = ppt.m_gradp;
         
-        vector<double> c(spt.m_c);
-        vector<vec3d> gradc(spt.m_gradc);
-        vector<int> z(nsol);
+        const vector<double>& c = spt.m_c;
+        const vector<vec3d>& gradc = spt.m_gradc;
+        vector<int>& z = ws.z;
         
-        vector<double> kappa(spt.m_k);
+        const vector<double>& kappa = spt.m_k;
         
         // get the charge number
         for (isol=0; isol<nsol; ++isol)
             z[isol] = pm->m_pSolute[isol]->ChargeNumber();
         
-        vector<double> dkdJ(spt.m_dkdJ);
-        vector< vector<double> > dkdc(spt.m_dkdc);
-        vector< vector<double> > dkdr(spt.m_dkdr);
-        vector< vector<double> > dkdJr(spt.m_dkdJr);
-        vector< vector< vector<double> > > dkdrc(spt.m_dkdrc);
+        const vector<double>& dkdJ = spt.m_dkdJ;
+        const vector< vector<double> >& dkdc = spt.m_dkdc;
+        const vector< vector<double> >& dkdr = spt.m_dkdr;
+        const vector< vector<double> >& dkdJr = spt.m_dkdJr;
+        const vector< vector< vector<double> > >& dkdrc = spt.m_dkdrc;
         
         // evaluate the porosity and its derivative
         double phiw = pm->Porosity(mp);
@@ -973,15 +1000,15 @@ bool FETriphasicDomain::ElementTriphasicStiffnessSS(FESolidElement& el, matrix&
         mat3ds K = pm->m_pPerm->Permeability(mp);
         tens4ds dKdE = pm->m_pPerm->Tangent_Permeability_Strain(mp);
         
-        vector<mat3ds> dKdc(nsol);
-        vector<mat3ds> D(nsol);
-        vector<tens4ds> dDdE(nsol);
-        vector< vector<mat3ds> > dDdc(nsol, vector<mat3ds>(nsol));
-        vector<double> D0(nsol);
-        vector< vector<double> > dD0dc(nsol, vector<double>(nsol));
-        vector<double> dodc(nsol);
-        vector<mat3ds> dTdc(nsol);
-        vector<mat3ds> ImD(nsol);
+        vector<mat3ds>& dKdc = ws.dKdc;
+        vector<mat3ds>& D = ws.D;
+        vector<tens4ds>& dDdE = ws.dDdE;
+        vector< vector<mat3ds> >& dDdc = ws.dDdc;
+        vector<double>& D0 = ws.D0;
+        vector< vector<double> >& dD0dc = ws.dD0dc;
+        vector<double>& dodc = ws.dodc;
+        vector<mat3ds>& dTdc = ws.dTdc;
+        vector<mat3ds>& ImD = ws.ImD;
         mat3dd I(1);
         
         for (isol=0; isol<nsol; ++isol) {
@@ -1019,8 +1046,8 @@ bool FETriphasicDomain::ElementTriphasicStiffnessSS(FESolidElement& el, matrix&
         mat3ds Ki = K.inverse();
         mat3ds Ke(0,0,0,0,0,0);
         tens4ds G = dyad1s(Ki,I) - dyad4s(Ki,I)*2 - ddots(dyad2s(Ki),dKdE)*0.5;
-        vector<mat3ds> Gc(nsol);
-        vector<mat3ds> dKedc(nsol);
+        vector<mat3ds>& Gc = ws.Gc;
+        vector<mat3ds>& dKedc = ws.dKedc;
         for (isol=0; isol<nsol; ++isol) {
             Ke += ImD[isol]*(kappa[isol]*c[isol]/D0[isol]);
             G += dyad1s(ImD[isol],I)*(R*T*c[isol]*J/D0[isol]/2/phiw*(dkdJ[isol]-kappa[isol]/phiw*dpdJ))
@@ -1039,10 +1066,13 @@ bool FETriphasicDomain::ElementTriphasicStiffnessSS(FESolidElement& el, matrix&
         
         // calculate all the matrices
         vec3d vtmp,gp;
-        vector<vec3d> gc(nsol),qcu(nsol),wc(nsol),jce(nsol);
-        vector< vector<vec3d> > jc(nsol, vector<vec3d>(nsol));
+        vector<vec3d>& gc = ws.gc;
+        vector<vec3d>& qcu = ws.qcu;
+        vector<vec3d>& wc = ws.wc;
+        vector<vec3d>& jce = ws.jce;
+        vector< vector<vec3d> >& jc = ws.jc;
         mat3d wu, jue;
-        vector<mat3d> ju(nsol);
+        vector<mat3d>& ju = ws.ju;
         double sum;
         mat3ds De;
         for (i=0; i<neln; ++i)
@@ -1175,6 +1205,8 @@ void FETriphasicDomain::Update(const FETimeInfo& tp)
 {
 	bool berr = false;
 	int NE = (int) m_Elem.size();
+	// the worker threads use the model (and log file) of this thread
+	FEModel* pfem = FECoreKernel::GetThreadModel();
 	#pragma omp parallel for shared(NE, berr)
 	for (int i=0; i<NE; ++i)
 	{
@@ -1186,6 +1218,7 @@ void FETriphasicDomain::Update(const FETimeInfo& tp)
 		{
 			#pragma omp critical
 			{
+				FEModelScope scope(pfem);
 				berr = true;
 				if (NegativeJacobian::m_boutput) e.print();
 			}
@@ -1264,6 +1297,9 @@ void FETriphasicDomain::UpdateElementStress(int iel)
 		spt.m_gradc[0] = gradient(el, ct[0], n);
 		spt.m_gradc[1] = gradient(el, ct[1], n);
 			
+		// the state has changed, so the electroneutrality condition must be solved again
+		spt.m_bzeta = false;
+		
 		// for biphasic-solute materials also update the porosity, fluid and solute fluxes
 		// and evaluate the actual fluid pressure and solute concentration
 		ppt.m_w = m_pMat->FluidFlux(mp);
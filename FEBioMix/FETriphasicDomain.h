@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "FECore/FESolidDomain.h"
 #include "FETriphasic.h"
 #include "FEBioMech/FEElasticDomain.h"
+#include "FESoluteWorkspace.h"
 
 //-----------------------------------------------------------------------------
 //! Domain class for triphasic 3D solid elements
@@ -102,4 +103,6 @@ protected:
 	FETriphasic*	m_pMat;
 	int				m_dofP;		//!< pressure dof index
 	int				m_dofC;		//!< concentration dof index
+
+	FESoluteWorkspaceList	m_ws;	//!< per-thread scratch data of the element kernels
 };
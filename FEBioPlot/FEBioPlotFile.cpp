@@ -812,6 +812,13 @@ void FEBioPlotFile::WriteNodeSection(FEMesh& m)
 	}
 
 	m_ar.WriteChunk(PLT_NODE_COORDS, X);
+
+	// write the node IDs
+	// (The nodes are written in mesh order, which is not the ID order when the mesh
+	// was reordered. The IDs are needed to map the nodes back to the input file.)
+	vector<int> ID(NN);
+	for (int i=0; i<NN; ++i) ID[i] = m.Node(i).GetID();
+	m_ar.WriteChunk(PLT_NODE_IDS, ID);
 }
 
 //-----------------------------------------------------------------------------
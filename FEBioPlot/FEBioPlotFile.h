@@ -89,6 +89,7 @@ public:
 		PLT_GEOMETRY					= 0x01040000,
 			PLT_NODE_SECTION			= 0x01041000,
 				PLT_NODE_COORDS			= 0x01041001,
+				PLT_NODE_IDS			= 0x01041002,	// optional, readers may skip it
 			PLT_DOMAIN_SECTION			= 0x01042000,
 				PLT_DOMAIN				= 0x01042100,
 				PLT_DOMAIN_HDR			= 0x01042101,
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FEBioDiagnostic.h"
 #include "FETangentDiagnostic.h"
 #include "FERestartDiagnostics.h"
+#include "FEConcurrencyDiagnostic.h"
 
 namespace FEBioTest
 {
@@ -39,5 +40,6 @@ void InitModule()
 {
 	REGISTER_FECORE_CLASS(FEBioDiagnostic, FETASK_ID, "diagnose");
 	REGISTER_FECORE_CLASS(FERestartDiagnostic, FETASK_ID, "restart_test");
+	REGISTER_FECORE_CLASS(FEConcurrencyDiagnostic, FETASK_ID, "concurrency_test");
 }
 }
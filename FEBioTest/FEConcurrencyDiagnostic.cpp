@@ -0,0 +1,173 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEConcurrencyDiagnostic.h"
+#include <FEBioLib/FEBioModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/Logfile.h>
+#include <FECore/log.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FEConcurrencyDiagnostic::FEConcurrencyDiagnostic(FEModel* pfem) : FECoreTask(pfem)
+{
+	m_ncopies = 4;
+	m_tol = 1e-9;
+}
+
+//-----------------------------------------------------------------------------
+FEConcurrencyDiagnostic::~FEConcurrencyDiagnostic()
+{
+	for (size_t i=0; i<m_copy.size(); ++i)
+	{
+		Logfile* plog = m_copy[i]->GetLogfile();
+		delete m_copy[i];
+		delete plog;
+	}
+	m_copy.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEConcurrencyDiagnostic::Init(const char* sz)
+{
+	FEBioModel& fem = dynamic_cast<FEBioModel&>(*GetFEModel());
+
+	// get the number of copies
+	if (sz && sz[0]) m_ncopies = atoi(sz);
+	if (m_ncopies < 1)
+	{
+		felog.printf("Invalid number of model copies for concurrency test.\n");
+		return false;
+	}
+
+	// initialize the original model
+	if (fem.Init() == false) return false;
+
+	// strip the extension from the input file name
+	const char* szfile = fem.GetInputFileName();
+	char szbase[1024] = {0};
+	strcpy(szbase, szfile);
+	char* ch = strrchr(szbase, '.');
+	if (ch) *ch = 0;
+
+	// read and initialize the copies. Each copy writes its own output files
+	for (int i=0; i<m_ncopies; ++i)
+	{
+		FEBioModel* pcopy = new FEBioModel;
+		pcopy->SetLogfile(new Logfile);
+		m_copy.push_back(pcopy);
+
+		if (pcopy->Input(szfile) == false) return false;
+
+		char sz[1024];
+		sprintf(sz, "%s_c%d.log" , szbase, i + 1); pcopy->SetLogFilename (sz);
+		sprintf(sz, "%s_c%d.xplt", szbase, i + 1); pcopy->SetPlotFilename(sz);
+		sprintf(sz, "%s_c%d.dmp" , szbase, i + 1); pcopy->SetDumpFilename(sz);
+
+		if (pcopy->Init() == false) return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEConcurrencyDiagnostic::Run()
+{
+	FEBioModel& fem = dynamic_cast<FEBioModel&>(*GetFEModel());
+
+	// the original model is solved together with its copies
+	int N = m_ncopies + 1;
+	std::vector<FEBioModel*> models(N);
+	models[0] = &fem;
+	for (int i=0; i<m_ncopies; ++i) models[i + 1] = m_copy[i];
+
+	// solve all models concurrently, one model per thread
+	std::vector<int> bok(N, 0);
+#pragma omp parallel for schedule(static, 1)
+	for (int i=0; i<N; ++i)
+	{
+		bok[i] = (models[i]->Solve() ? 1 : 0);
+	}
+
+	// compare the results
+	bool bret = true;
+	felog.printf("\nConcurrency test (%d copies):\n", m_ncopies);
+	if (bok[0] == 0)
+	{
+		felog.printf("\toriginal model: FAILED\n");
+		bret = false;
+	}
+	for (int i=0; i<m_ncopies; ++i)
+	{
+		if (bok[i + 1] == 0)
+		{
+			felog.printf("\tcopy %d: FAILED\n", i + 1);
+			bret = false;
+			continue;
+		}
+
+		double err = Compare(fem, *m_copy[i]);
+		bool bpass = (err >= 0.0) && (err <= m_tol);
+		felog.printf("\tcopy %d: relative difference = %lg (%s)\n", i + 1, err, (bpass ? "passed" : "FAILED"));
+		if (bpass == false) bret = false;
+	}
+
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+// Returns the largest relative difference in the nodal positions and nodal
+// values, or -1 if the meshes don't match.
+double FEConcurrencyDiagnostic::Compare(FEModel& fem, FEModel& copy)
+{
+	FEMesh& m0 = fem.GetMesh();
+	FEMesh& m1 = copy.GetMesh();
+	if (m0.Nodes() != m1.Nodes()) return -1.0;
+
+	double umax = 0.0, du = 0.0;
+	for (int i=0; i<m0.Nodes(); ++i)
+	{
+		FENode& n0 = m0.Node(i);
+		FENode& n1 = m1.Node(i);
+
+		umax = fmax(umax, (n0.m_rt - n0.m_r0).norm());
+		du = fmax(du, (n1.m_rt - n0.m_rt).norm());
+
+		if (n0.m_val.size() != n1.m_val.size()) return -1.0;
+		for (size_t j=0; j<n0.m_val.size(); ++j)
+		{
+			umax = fmax(umax, fabs(n0.m_val[j]));
+			du = fmax(du, fabs(n1.m_val[j] - n0.m_val[j]));
+		}
+	}
+
+	return (umax > 0.0 ? du / umax : du);
+}
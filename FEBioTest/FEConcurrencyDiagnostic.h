@@ -0,0 +1,61 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+#include <vector>
+
+class FEBioModel;
+
+//-----------------------------------------------------------------------------
+// This diagnostic solves several copies of the same model concurrently and
+// checks that all copies produce the same results as the original model.
+class FEConcurrencyDiagnostic : public FECoreTask
+{
+public:
+	// constructor
+	FEConcurrencyDiagnostic(FEModel* pfem);
+
+	// destructor
+	~FEConcurrencyDiagnostic();
+
+	// initialize the diagnostic (sz = number of copies)
+	bool Init(const char* sz);
+
+	// run the diagnostic
+	bool Run();
+
+private:
+	// compare the nodal results of a copy with the original model
+	double Compare(FEModel& fem, FEModel& copy);
+
+private:
+	int		m_ncopies;	// number of model copies
+	double	m_tol;		// relative tolerance for comparing results
+
+	std::vector<FEBioModel*>	m_copy;	// the model copies
+};
@@ -98,6 +98,12 @@ bool FEBioControlSection::ParseCommonParams(XMLTag& tag)
 			{
 				const char* szf = tag.AttributeValue("file", true);
 				if (szf) imp->SetDumpfileName(szf);
+
+				// checkpoint options
+				const char* szn = tag.AttributeValue("files", true);
+				if (szn) imp->m_ndmpFiles = atoi(szn);
+				const char* sza = tag.AttributeValue("async", true);
+				if (sza) imp->m_bdmpAsync = (atoi(sza) != 0);
 				char szval[256];
 				tag.value(szval);
 				if		(strcmp(szval, "DUMP_DEFAULT"    ) == 0) {} // don't change the restart level
@@ -85,9 +85,9 @@ void FEBioGeometrySection1x::ParseNodeSection(XMLTag& tag)
 	int N0 = mesh.Nodes();
 
 	// get the largest nodal ID
-	// (It is assumed that nodes are sorted by ID so the last node should have the largest ID)
+	// (We can't assume that the last node has the largest ID, since the mesh may have been reordered)
 	int max_id = 0;
-	if (N0 > 0) max_id = mesh.Node(N0 - 1).GetID();
+	for (int i = 0; i < N0; ++i) if (mesh.Node(i).GetID() > max_id) max_id = mesh.Node(i).GetID();
 
 	// first we need to figure out how many nodes there are
 	XMLTag t(tag);
@@ -486,20 +486,27 @@ void FEBioGeometrySection2::Parse(XMLTag& tag)
 	FEModelBuilder* feb = GetBuilder();
 	feb->m_maxid = 0;
 
-	++tag;
-	do
+	// the geometry can be read from a binary mesh file
+	const char* szfrom = tag.AttributeValue("from", true);
+	if (szfrom) GetFEBioImport()->ReadMeshFile(szfrom);
+
+	if (tag.isleaf() == false)
 	{
-		if      (tag == "Nodes"      ) ParseNodeSection       (tag);
-		else if (tag == "Elements"   ) ParseElementSection    (tag);
-		else if (tag == "NodeSet"    ) ParseNodeSetSection    (tag);
-		else if (tag == "Surface"    ) ParseSurfaceSection    (tag);
-		else if (tag == "Edge"       ) ParseEdgeSection       (tag);
-		else if (tag == "ElementSet" ) ParseElementSetSection (tag);
-		else if (tag == "ElementData") ParseElementDataSection(tag);
-		else throw XMLReader::InvalidTag(tag);
 		++tag;
+		do
+		{
+			if      (tag == "Nodes"      ) ParseNodeSection       (tag);
+			else if (tag == "Elements"   ) ParseElementSection    (tag);
+			else if (tag == "NodeSet"    ) ParseNodeSetSection    (tag);
+			else if (tag == "Surface"    ) ParseSurfaceSection    (tag);
+			else if (tag == "Edge"       ) ParseEdgeSection       (tag);
+			else if (tag == "ElementSet" ) ParseElementSetSection (tag);
+			else if (tag == "ElementData") ParseElementDataSection(tag);
+			else throw XMLReader::InvalidTag(tag);
+			++tag;
+		}
+		while (!tag.isend());
 	}
-	while (!tag.isend());
 
 	// At this point the mesh is completely read in.
 	// Now we can allocate the degrees of freedom.
@@ -520,9 +527,9 @@ void FEBioGeometrySection2::ParseNodeSection(XMLTag& tag)
 	int N0 = mesh.Nodes();
 
 	// get the largest nodal ID
-	// (It is assumed that nodes are sorted by ID so the last node should have the largest ID)
+	// (We can't assume that the last node has the largest ID, since the mesh may have been reordered)
 	int max_id = 0;
-	if (N0 > 0) max_id = mesh.Node(N0 - 1).GetID();
+	for (int i = 0; i < N0; ++i) if (mesh.Node(i).GetID() > max_id) max_id = mesh.Node(i).GetID();
 
 	// first we need to figure out how many nodes there are
 	XMLTag t(tag);
@@ -987,26 +994,33 @@ void FEBioGeometrySection25::Parse(XMLTag& tag)
 	FEModelBuilder* feb = GetBuilder();
 	feb->m_maxid = 0;
 
+	// the geometry can be read from a binary mesh file
+	const char* szfrom = tag.AttributeValue("from", true);
+	if (szfrom) GetFEBioImport()->ReadMeshFile(szfrom);
+
 	// read all sections
-	++tag;
-	do
+	if (tag.isleaf() == false)
 	{
-		if      (tag == "Nodes"      ) ParseNodeSection       (tag);
-		else if (tag == "Elements"   ) ParseElementSection    (tag);
-		else if (tag == "NodeSet"    ) ParseNodeSetSection    (tag);
-		else if (tag == "Surface"    ) ParseSurfaceSection    (tag);
-		else if (tag == "Edge"       ) ParseEdgeSection       (tag);
-		else if (tag == "ElementSet" ) ParseElementSetSection (tag);
-		else if (tag == "DiscreteSet") ParseDiscreteSetSection(tag);
-		else if (tag == "SurfacePair") ParseSurfacePairSection(tag);
-		else if (tag == "NodeSetPair") ParseNodeSetPairSection(tag);
-		else if (tag == "NodeSetSet" ) ParseNodeSetSetSection (tag);
-		else if (tag == "Part"       ) ParsePartSection       (tag);
-		else if (tag == "Instance"   ) ParseInstanceSection   (tag);
-		else throw XMLReader::InvalidTag(tag);
 		++tag;
+		do
+		{
+			if      (tag == "Nodes"      ) ParseNodeSection       (tag);
+			else if (tag == "Elements"   ) ParseElementSection    (tag);
+			else if (tag == "NodeSet"    ) ParseNodeSetSection    (tag);
+			else if (tag == "Surface"    ) ParseSurfaceSection    (tag);
+			else if (tag == "Edge"       ) ParseEdgeSection       (tag);
+			else if (tag == "ElementSet" ) ParseElementSetSection (tag);
+			else if (tag == "DiscreteSet") ParseDiscreteSetSection(tag);
+			else if (tag == "SurfacePair") ParseSurfacePairSection(tag);
+			else if (tag == "NodeSetPair") ParseNodeSetPairSection(tag);
+			else if (tag == "NodeSetSet" ) ParseNodeSetSetSection (tag);
+			else if (tag == "Part"       ) ParsePartSection       (tag);
+			else if (tag == "Instance"   ) ParseInstanceSection   (tag);
+			else throw XMLReader::InvalidTag(tag);
+			++tag;
+		}
+		while (!tag.isend());
 	}
-	while (!tag.isend());
 
 	// At this point the mesh is completely read in.
 	// Now we can allocate the degrees of freedom.
@@ -1179,9 +1193,9 @@ void FEBioGeometrySection25::ParseNodeSection(XMLTag& tag)
 	int N0 = mesh.Nodes();
 
 	// get the largest nodal ID
-	// (It is assumed that nodes are sorted by ID so the last node should have the largest ID)
+	// (We can't assume that the last node has the largest ID, since the mesh may have been reordered)
 	int max_id = 0;
-	if (N0 > 0) max_id = mesh.Node(N0 - 1).GetID();
+	for (int i = 0; i < N0; ++i) if (mesh.Node(i).GetID() > max_id) max_id = mesh.Node(i).GetID();
 
 	// first we need to figure out how many nodes there are
 	XMLTag t(tag);
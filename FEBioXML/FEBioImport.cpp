@@ -46,6 +46,7 @@ SOFTWARE.*/
 #include "FEBioMeshDataSection.h"
 #include "FEBioCodeSection.h"
 #include "FEBioRigidSection.h"
+#include "FEBioMeshFile.h"
 #include "FECore/DataStore.h"
 #include "FECore/FEModel.h"
 #include "FECore/FECoreKernel.h"
@@ -133,6 +134,12 @@ FEBioImport::FailedBuildingPart::FailedBuildingPart(const std::string& partName)
 	SetErrorString("Failed building part %s", partName.c_str());
 }
 
+//-----------------------------------------------------------------------------
+FEBioImport::FailedReadingMeshFile::FailedReadingMeshFile(const char* szfile, const char* szerr)
+{
+	SetErrorString("Failed reading mesh file %s: %s", szfile, szerr);
+}
+
 //-----------------------------------------------------------------------------
 FEBioImport::PlotVariable::PlotVariable(const FEBioImport::PlotVariable& pv)
 {
@@ -226,6 +233,8 @@ bool FEBioImport::Parse(const char* szfile)
 
 	// intialize some variables
 	m_szdmp[0] = 0;
+	m_ndmpFiles = 1;
+	m_bdmpAsync = false;
 	m_szlog[0] = 0;
 	m_szplt[0] = 0;
 
@@ -247,7 +256,13 @@ bool FEBioImport::Parse(const char* szfile)
 	fem.ClearDataArrays();
 
 	// read the file
-	return ReadFile(szfile);
+	if (ReadFile(szfile) == false) return false;
+
+	// The mesh may be completed by the last section, so reorder it now if that
+	// wasn't done yet.
+	GetBuilder()->ReorderMesh();
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -426,6 +441,11 @@ bool FEBioImport::ReadFile(const char* szfile, bool broot)
 			// make sure we found a section reader
 			if (is == m_map.end()) throw XMLReader::InvalidTag(tag);
 
+			// The mesh can be read in by several Geometry and Include sections. Other
+			// sections may store node indices, so the mesh is reordered (if requested)
+			// before the first of those is read.
+			if ((tag != "Geometry") && (tag != "Include")) GetBuilder()->ReorderMesh();
+
 			// see if the file has the "from" attribute (for version 2.0 and up)
 			if (nversion >= 0x0200)
 			{
@@ -731,3 +751,29 @@ void FEBioImport::ParseDataArray(XMLTag& tag, FEDataArray& map, const char* szta
 		while (!tag.isend());
 	}
 }
+
+//-----------------------------------------------------------------------------
+void FEBioImport::ReadMeshFile(const char* szfile)
+{
+	// see if we need to pre-pend a path
+	char szin[512];
+	strcpy(szin, szfile);
+	char* ch = strrchr(szin, '\\');
+	if (ch==0) ch = strrchr(szin, '/');
+	if (ch==0)
+	{
+		// pre-pend the name with the input path
+		sprintf(szin, "%s%s", GetFilePath(), szfile);
+	}
+
+	// read the mesh
+	FEModel& fem = *GetFEModel();
+	FEMesh& mesh = fem.GetMesh();
+	int N0 = mesh.Nodes();
+	FEBioMeshFile meshFile;
+	if (meshFile.Read(szin, fem, *GetBuilder()) == false) throw FailedReadingMeshFile(szin, meshFile.GetErrorString());
+
+	// allocate the degrees of freedom of the new nodes
+	int MAX_DOFS = fem.GetDOFS().GetTotalDOFS();
+	for (int i=N0; i<mesh.Nodes(); ++i) mesh.Node(i).SetDOFS(MAX_DOFS);
+}
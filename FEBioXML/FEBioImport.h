@@ -131,6 +131,13 @@ public:
 		FailedBuildingPart(const std::string& partName);
 	};
 
+	//! failed reading a binary mesh file
+	class FailedReadingMeshFile : public FEFileException
+	{
+	public:
+		FailedReadingMeshFile(const char* szfile, const char* szerr);
+	};
+
 public:
 	//-------------------------------------------------------------------------
 	class PlotVariable
@@ -179,6 +186,9 @@ public:
 
 	void ParseDataArray(XMLTag& tag, FEDataArray& map, const char* sztag);
 
+	// Read a binary mesh file (relative file names are relative to the input file)
+	void ReadMeshFile(const char* szfile);
+
 protected:
 	void ParseVersion(XMLTag& tag);
 
@@ -189,6 +199,8 @@ public:
 
 public:
 	char	m_szdmp[512];
+	int		m_ndmpFiles;	//!< nr of rotating restart files
+	bool	m_bdmpAsync;	//!< write restart files in the background
 	char	m_szlog[512];
 	char	m_szplt[512];
 
@@ -27,10 +27,12 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEBioIncludeSection.h"
+#include "FEBioMeshFile.h"
 
 //-----------------------------------------------------------------------------
 //! Parse the Include section (new in version 2.0)
-//! This section includes the contents of another FEB file.
+//! This section includes the contents of another FEB file, or the geometry
+//! stored in a binary mesh file (see FEBioMeshFile).
 void FEBioIncludeSection::Parse(XMLTag& tag)
 {
 	// see if we need to pre-pend a path
@@ -44,6 +46,13 @@ void FEBioIncludeSection::Parse(XMLTag& tag)
 		sprintf(szin, "%s%s", GetFileReader()->GetFilePath(), tag.szvalue());
 	}
 
+	// binary mesh files are read directly
+	if (FEBioMeshFile::IsMeshFile(szin))
+	{
+		GetFEBioImport()->ReadMeshFile(szin);
+		return;
+	}
+
 	// read the file
 	if (GetFEBioImport()->ReadFile(szin, false) == false)
 		throw XMLReader::InvalidValue(tag);
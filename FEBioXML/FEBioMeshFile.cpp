@@ -0,0 +1,701 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEBioMeshFile.h"
+#include "FEModelBuilder.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/FEDomain.h>
+#include <FECore/FEShellDomain.h>
+#include <FECore/FEMaterial.h>
+#include <FECore/FECoreKernel.h>
+#include <FECore/FEElementLibrary.h>
+#include <FECore/FENodeDataMap.h>
+#include <FECore/FESurfaceMap.h>
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+// Returns the element type name that the FEModelBuilder understands.
+// Returns zero for element types that cannot be stored in a mesh file.
+static const char* element_type_name(int nshape)
+{
+	switch (nshape)
+	{
+	case ET_HEX8   : return "hex8";
+	case ET_HEX20  : return "hex20";
+	case ET_HEX27  : return "hex27";
+	case ET_PENTA6 : return "penta6";
+	case ET_PENTA15: return "penta15";
+	case ET_PYRA5  : return "pyra5";
+	case ET_TET4   : return "tet4";
+	case ET_TET10  : return "tet10";
+	case ET_TET15  : return "tet15";
+	case ET_TET20  : return "tet20";
+	case ET_QUAD4  : return "quad4";
+	case ET_QUAD8  : return "quad8";
+	case ET_QUAD9  : return "quad9";
+	case ET_TRI3   : return "tri3";
+	case ET_TRI6   : return "tri6";
+	case ET_TRUSS2 : return "truss2";
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+FEBioMeshFile::FEBioMeshFile()
+{
+	m_fp = 0;
+	m_bwrite = false;
+	m_bok = true;
+	m_szerr[0] = 0;
+}
+
+//-----------------------------------------------------------------------------
+FEBioMeshFile::~FEBioMeshFile()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::IsMeshFile(const char* szfile)
+{
+	FILE* fp = fopen(szfile, "rb");
+	if (fp == 0) return false;
+
+	unsigned int nmagic = 0;
+	size_t nread = fread(&nmagic, sizeof(unsigned int), 1, fp);
+	fclose(fp);
+
+	return ((nread == 1) && (nmagic == MAGIC));
+}
+
+//-----------------------------------------------------------------------------
+void FEBioMeshFile::Close()
+{
+	if (m_fp)
+	{
+		// terminate the file
+		if (m_bwrite) BeginBlock(MESH_END, 0);
+
+		fclose(m_fp);
+		m_fp = 0;
+	}
+	m_bwrite = false;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::error(const char* szerr)
+{
+	strncpy(m_szerr, szerr, sizeof(m_szerr) - 1);
+	m_szerr[sizeof(m_szerr) - 1] = 0;
+	return false;
+}
+
+//=============================================================================
+//                              W R I T I N G
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::Create(const char* szfile)
+{
+	Close();
+
+	m_fp = fopen(szfile, "wb");
+	if (m_fp == 0) return error("Failed creating mesh file");
+	m_bwrite = true;
+	m_bok = true;
+
+	// write the header
+	unsigned int nmagic = MAGIC;
+	unsigned int nversion = VERSION;
+	write(&nmagic, sizeof(unsigned int), 1);
+	write(&nversion, sizeof(unsigned int), 1);
+
+	return m_bok;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioMeshFile::BeginBlock(unsigned int nid, unsigned long long nsize)
+{
+	write(&nid, sizeof(unsigned int), 1);
+	write(&nsize, sizeof(unsigned long long), 1);
+}
+
+//-----------------------------------------------------------------------------
+void FEBioMeshFile::write(const void* pd, size_t size, size_t count)
+{
+	if (count == 0) return;
+	if (fwrite(pd, size, count, m_fp) != count) m_bok = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioMeshFile::write(const string& s)
+{
+	write((int) s.size());
+	write(s.c_str(), sizeof(char), s.size());
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::WriteMesh(FEModel& fem)
+{
+	if ((m_fp == 0) || (m_bwrite == false)) return error("Mesh file is not open for writing");
+
+	FEMesh& mesh = fem.GetMesh();
+
+	// --- nodes ---
+	// The nodes are written in ID order, since the mesh may have been reordered.
+	int NN = mesh.Nodes();
+	if (NN > 0)
+	{
+		vector< pair<int,int> > order(NN);
+		for (int i=0; i<NN; ++i) order[i] = pair<int,int>(mesh.Node(i).GetID(), i);
+		sort(order.begin(), order.end());
+
+		vector<int> id(NN);
+		vector<double> r(3*NN);
+		for (int i=0; i<NN; ++i)
+		{
+			FENode& node = mesh.Node(order[i].second);
+			id[i] = node.GetID();
+			r[3*i  ] = node.m_r0.x;
+			r[3*i+1] = node.m_r0.y;
+			r[3*i+2] = node.m_r0.z;
+		}
+
+		BeginBlock(MESH_NODES, sizeof(int) + (unsigned long long) NN*(sizeof(int) + 3*sizeof(double)));
+		write(NN);
+		write(&id[0], sizeof(int), NN);
+		write(&r[0], sizeof(double), 3*NN);
+	}
+
+	// --- domains ---
+	for (int nd=0; nd<mesh.Domains(); ++nd)
+	{
+		FEDomain& dom = mesh.Domain(nd);
+		int NE = dom.Elements();
+		if (NE == 0) continue;
+
+		// we assume that all elements of a domain are of the same type
+		FEElement& el0 = dom.ElementRef(0);
+		const char* sztype = element_type_name(el0.Shape());
+		if (sztype == 0) return error("Unsupported element type in mesh file");
+
+		// materials are referenced by name, or by ID if they don't have a name
+		FEMaterial* pmat = dom.GetMaterial();
+		if (pmat == 0) return error("Domain without material in mesh file");
+		string matName = pmat->GetName();
+		if (matName.empty())
+		{
+			char szid[16];
+			sprintf(szid, "%d", pmat->GetID());
+			matName = szid;
+		}
+
+		string name = dom.GetName();
+		string type = sztype;
+		int neln = el0.Nodes();
+		int hasThickness = (el0.Class() == FE_ELEM_SHELL ? 1 : 0);
+
+		vector<int> id(NE), node(NE*neln);
+		vector<double> h0;
+		if (hasThickness) h0.resize(NE*neln);
+		for (int i=0; i<NE; ++i)
+		{
+			FEElement& el = dom.ElementRef(i);
+			id[i] = el.GetID();
+			for (int j=0; j<neln; ++j) node[i*neln + j] = mesh.Node(el.m_node[j]).GetID();
+
+			if (hasThickness)
+			{
+				FEShellElement& shell = static_cast<FEShellElement&>(el);
+				for (int j=0; j<neln; ++j) h0[i*neln + j] = shell.m_h0[j];
+			}
+		}
+
+		unsigned long long nsize = strsize(name) + strsize(matName) + strsize(type) + 3*sizeof(int);
+		nsize += (unsigned long long) NE*(1 + neln)*sizeof(int);
+		nsize += (unsigned long long) h0.size()*sizeof(double);
+
+		BeginBlock(MESH_DOMAIN, nsize);
+		write(name);
+		write(matName);
+		write(type);
+		write(NE);
+		write(neln);
+		write(&id[0], sizeof(int), NE);
+		write(&node[0], sizeof(int), NE*neln);
+		write(hasThickness);
+		if (hasThickness) write(&h0[0], sizeof(double), h0.size());
+	}
+
+	// --- node sets ---
+	for (int i=0; i<mesh.NodeSets(); ++i)
+	{
+		FENodeSet& set = *mesh.NodeSet(i);
+		string name = set.GetName();
+		int n = set.size();
+
+		vector<int> id(n);
+		for (int j=0; j<n; ++j) id[j] = mesh.Node(set[j]).GetID();
+
+		BeginBlock(MESH_NODESET, strsize(name) + sizeof(int) + (unsigned long long) n*sizeof(int));
+		write(name);
+		write(n);
+		if (n > 0) write(&id[0], sizeof(int), n);
+	}
+
+	// --- element sets ---
+	for (int i=0; i<mesh.ElementSets(); ++i)
+	{
+		FEElementSet& set = mesh.ElementSet(i);
+		string name = set.GetName();
+
+		// domains create their own element sets when they are read in
+		if (mesh.FindDomain(name)) continue;
+
+		int n = set.size();
+		BeginBlock(MESH_ELEMSET, strsize(name) + sizeof(int) + (unsigned long long) n*sizeof(int));
+		write(name);
+		write(n);
+		if (n > 0) write(&set[0], sizeof(int), n);
+	}
+
+	// --- surfaces ---
+	for (int i=0; i<mesh.FacetSets(); ++i)
+	{
+		FEFacetSet& surf = mesh.FacetSet(i);
+		string name = surf.GetName();
+		int NF = surf.Faces();
+
+		vector<int> ntype(NF), node;
+		node.reserve(4*NF);
+		for (int j=0; j<NF; ++j)
+		{
+			FEFacetSet::FACET& face = surf.Face(j);
+			ntype[j] = face.ntype;
+			for (int k=0; k<face.ntype; ++k) node.push_back(mesh.Node(face.node[k]).GetID());
+		}
+
+		BeginBlock(MESH_SURFACE, strsize(name) + sizeof(int) + (unsigned long long) (NF + node.size())*sizeof(int));
+		write(name);
+		write(NF);
+		if (NF > 0)
+		{
+			write(&ntype[0], sizeof(int), NF);
+			write(&node[0], sizeof(int), node.size());
+		}
+	}
+
+	if (m_bok == false) return error("Failed writing mesh file");
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::WriteNodeData(const char* szname, FENodeSet& set, FENodeDataMap& map)
+{
+	if ((m_fp == 0) || (m_bwrite == false)) return error("Mesh file is not open for writing");
+
+	string name = szname;
+	string setName = set.GetName();
+	vector<double>& val = map.GetBuffer();
+	int nvals = (int) val.size();
+
+	BeginBlock(MESH_NODEDATA, strsize(name) + strsize(setName) + 2*sizeof(int) + (unsigned long long) nvals*sizeof(double));
+	write(name);
+	write(setName);
+	write(map.DataSize());
+	write(nvals);
+	if (nvals > 0) write(&val[0], sizeof(double), nvals);
+
+	if (m_bok == false) return error("Failed writing mesh file");
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::WriteSurfaceData(const char* szname, FEFacetSet& surf, FESurfaceMap& map)
+{
+	if ((m_fp == 0) || (m_bwrite == false)) return error("Mesh file is not open for writing");
+
+	string name = szname;
+	string surfName = surf.GetName();
+	vector<double>& val = map.GetBuffer();
+	int nvals = (int) val.size();
+
+	BeginBlock(MESH_SURFDATA, strsize(name) + strsize(surfName) + 2*sizeof(int) + (unsigned long long) nvals*sizeof(double));
+	write(name);
+	write(surfName);
+	write(map.DataSize());
+	write(nvals);
+	if (nvals > 0) write(&val[0], sizeof(double), nvals);
+
+	if (m_bok == false) return error("Failed writing mesh file");
+	return true;
+}
+
+//=============================================================================
+//                              R E A D I N G
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::read(void* pd, size_t size, size_t count)
+{
+	if (count == 0) return true;
+	return (fread(pd, size, count, m_fp) == count);
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::read(string& s)
+{
+	int l = 0;
+	if (read(l) == false) return false;
+	if ((l < 0) || (l > 65536)) return false;
+	s.resize(l);
+	if (l > 0) return read(&s[0], sizeof(char), l);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::skip(unsigned long long nsize)
+{
+	char buf[4096];
+	while (nsize > 0)
+	{
+		size_t n = (nsize > sizeof(buf) ? sizeof(buf) : (size_t) nsize);
+		if (read(buf, 1, n) == false) return false;
+		nsize -= n;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::Read(const char* szfile, FEModel& fem, FEModelBuilder& feb)
+{
+	Close();
+	m_szerr[0] = 0;
+
+	m_fp = fopen(szfile, "rb");
+	if (m_fp == 0) return error("Failed opening mesh file");
+
+	// check the header
+	unsigned int nmagic = 0, nversion = 0;
+	if ((read(&nmagic, sizeof(unsigned int), 1) == false) || (nmagic != MAGIC)) { Close(); return error("Not a mesh file"); }
+	if ((read(&nversion, sizeof(unsigned int), 1) == false) || (nversion > VERSION)) { Close(); return error("Unsupported mesh file version"); }
+
+	// read all blocks
+	bool bret = true;
+	while (bret)
+	{
+		unsigned int nid = 0;
+		unsigned long long nsize = 0;
+		if ((read(&nid, sizeof(unsigned int), 1) == false) || (read(&nsize, sizeof(unsigned long long), 1) == false))
+		{
+			bret = error("Unexpected end of mesh file");
+			break;
+		}
+
+		if (nid == MESH_END) break;
+
+		switch (nid)
+		{
+		case MESH_NODES   : bret = ReadNodes  (fem, feb); break;
+		case MESH_DOMAIN  : bret = ReadDomain (fem, feb); break;
+		case MESH_NODESET : bret = ReadNodeSet(fem, feb); break;
+		case MESH_ELEMSET : bret = ReadElemSet(fem, feb); break;
+		case MESH_SURFACE : bret = ReadSurface(fem, feb); break;
+		case MESH_NODEDATA:
+		case MESH_SURFDATA: bret = ReadDataMap(fem, nid); break;
+		default:
+			// skip unknown blocks
+			if (skip(nsize) == false) bret = error("Unexpected end of mesh file");
+		}
+	}
+
+	Close();
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::ReadNodes(FEModel& fem, FEModelBuilder& feb)
+{
+	FEMesh& mesh = fem.GetMesh();
+	int N0 = mesh.Nodes();
+
+	// get the largest nodal ID
+	// (We can't assume that the last node has the largest ID, since the mesh may have been reordered)
+	int max_id = 0;
+	for (int i = 0; i < N0; ++i) if (mesh.Node(i).GetID() > max_id) max_id = mesh.Node(i).GetID();
+
+	int nodes = 0;
+	if ((read(nodes) == false) || (nodes <= 0)) return error("Invalid node block");
+
+	vector<int> id(nodes);
+	vector<double> r(3*nodes);
+	if (read(&id[0], sizeof(int), nodes) == false) return error("Invalid node block");
+	if (read(&r[0], sizeof(double), 3*nodes) == false) return error("Invalid node block");
+
+	// Make sure the IDs are valid. They don't have to be sorted, but they must be
+	// unique and larger than the IDs of the nodes that were already read in.
+	vector<int> sid(id);
+	sort(sid.begin(), sid.end());
+	if (sid[0] <= max_id) return error("Invalid node ID");
+	for (int i=1; i<nodes; ++i) if (sid[i] == sid[i-1]) return error("Invalid node ID");
+
+	mesh.AddNodes(nodes);
+	for (int i=0; i<nodes; ++i)
+	{
+		FENode& node = mesh.Node(N0 + i);
+		node.SetID(id[i]);
+		node.m_r0 = vec3d(r[3*i], r[3*i+1], r[3*i+2]);
+		node.m_rt = node.m_r0;
+	}
+
+	// rebuild the node ID table
+	feb.BuildNodeList();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::ReadDomain(FEModel& fem, FEModelBuilder& feb)
+{
+	FEMesh& mesh = fem.GetMesh();
+
+	string name, matName, type;
+	int elems = 0, neln = 0;
+	if ((read(name) == false) || (read(matName) == false) || (read(type) == false)) return error("Invalid domain block");
+	if ((read(elems) == false) || (read(neln) == false)) return error("Invalid domain block");
+	if ((elems <= 0) || (neln <= 0) || (neln > FEElement::MAX_NODES)) return error("Invalid domain block");
+
+	// materials are referenced by name first, then by ID
+	FEMaterial* pmat = fem.FindMaterial(matName);
+	if (pmat == 0)
+	{
+		int nmat = atoi(matName.c_str()) - 1;
+		if ((nmat < 0) || (nmat >= fem.Materials())) return error("Invalid domain material");
+		pmat = fem.GetMaterial(nmat);
+	}
+
+	// get the element type
+	FE_Element_Spec espec = feb.ElementSpec(type.c_str());
+	if (FEElementLibrary::IsValid(espec) == false) return error("Invalid element type");
+
+	// read the element data in bulk
+	vector<int> id(elems), node(elems*neln);
+	if (read(&id[0], sizeof(int), elems) == false) return error("Invalid domain block");
+	if (read(&node[0], sizeof(int), elems*neln) == false) return error("Invalid domain block");
+
+	int hasThickness = 0;
+	vector<double> h0;
+	if (read(hasThickness) == false) return error("Invalid domain block");
+	if (hasThickness)
+	{
+		h0.resize(elems*neln);
+		if (read(&h0[0], sizeof(double), elems*neln) == false) return error("Invalid domain block");
+	}
+
+	// create the new domain
+	FECoreKernel& febio = FECoreKernel::GetInstance();
+	FEDomain* pdom = febio.CreateDomain(espec, &mesh, pmat);
+	if (pdom == 0) return error("Failed creating domain");
+	pdom->SetName(name);
+	pdom->Create(elems, espec.etype);
+	pdom->SetMatID(pmat->GetID() - 1);
+	mesh.AddDomain(pdom);
+
+	if (pdom->ElementRef(0).Nodes() != neln) return error("Element type does not match number of element nodes");
+
+	// for named domains, we'll also create an element set
+	FEElementSet* pg = 0;
+	if (mesh.FindElementSet(name.c_str()) == 0)
+	{
+		pg = new FEElementSet(&mesh);
+		pg->SetName(name.c_str());
+		pg->create(elems);
+		mesh.AddElementSet(pg);
+	}
+
+	for (int i=0; i<elems; ++i)
+	{
+		FEElement& el = pdom->ElementRef(i);
+		el.SetID(id[i]);
+		feb.GlobalToLocalID(&node[i*neln], neln, el.m_node);
+		for (int j=0; j<neln; ++j) if (el.m_node[j] < 0) return error("Invalid element node");
+
+		if (hasThickness && (el.Class() == FE_ELEM_SHELL))
+		{
+			FEShellElement& shell = static_cast<FEShellElement&>(el);
+			for (int j=0; j<neln; ++j) shell.m_h0[j] = h0[i*neln + j];
+		}
+
+		// keep track of the largest element ID
+		if (id[i] > feb.m_maxid) feb.m_maxid = id[i];
+
+		if (pg) (*pg)[i] = id[i];
+	}
+
+	// assign material point data
+	pdom->CreateMaterialPointData();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::ReadNodeSet(FEModel& fem, FEModelBuilder& feb)
+{
+	FEMesh& mesh = fem.GetMesh();
+
+	string name;
+	int n = 0;
+	if ((read(name) == false) || (read(n) == false) || (n < 0)) return error("Invalid node set block");
+
+	vector<int> id(n);
+	if ((n > 0) && (read(&id[0], sizeof(int), n) == false)) return error("Invalid node set block");
+
+	FENodeSet* ps = new FENodeSet(&mesh);
+	ps->SetName(name.c_str());
+	ps->create(n);
+	mesh.AddNodeSet(ps);
+
+	for (int i=0; i<n; ++i)
+	{
+		int nid = feb.FindNodeFromID(id[i]);
+		if (nid < 0) return error("Invalid node in node set");
+		(*ps)[i] = nid;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::ReadElemSet(FEModel& fem, FEModelBuilder& feb)
+{
+	FEMesh& mesh = fem.GetMesh();
+
+	string name;
+	int n = 0;
+	if ((read(name) == false) || (read(n) == false) || (n < 0)) return error("Invalid element set block");
+
+	// only add non-empty element sets
+	if (n == 0) return true;
+
+	FEElementSet* pg = new FEElementSet(&mesh);
+	pg->SetName(name.c_str());
+	pg->create(n);
+	if (read(&(*pg)[0], sizeof(int), n) == false) { delete pg; return error("Invalid element set block"); }
+	mesh.AddElementSet(pg);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::ReadSurface(FEModel& fem, FEModelBuilder& feb)
+{
+	FEMesh& mesh = fem.GetMesh();
+
+	string name;
+	int faces = 0;
+	if ((read(name) == false) || (read(faces) == false) || (faces < 0)) return error("Invalid surface block");
+
+	if (faces == 0) return error("Empty surface");
+
+	vector<int> ntype(faces);
+	if (read(&ntype[0], sizeof(int), faces) == false) return error("Invalid surface block");
+
+	size_t nn = 0;
+	for (int i=0; i<faces; ++i)
+	{
+		if ((ntype[i] <= 0) || (ntype[i] > FEElement::MAX_NODES)) return error("Invalid facet type");
+		nn += ntype[i];
+	}
+
+	vector<int> id(nn);
+	if (read(&id[0], sizeof(int), nn) == false) return error("Invalid surface block");
+
+	FEFacetSet* ps = new FEFacetSet(&mesh);
+	ps->Create(faces);
+	ps->SetName(name.c_str());
+	mesh.AddFacetSet(ps);
+
+	int m = 0;
+	for (int i=0; i<faces; ++i)
+	{
+		FEFacetSet::FACET& face = ps->Face(i);
+		face.ntype = ntype[i];
+		for (int j=0; j<face.ntype; ++j)
+		{
+			int nid = feb.FindNodeFromID(id[m++]);
+			if (nid < 0) return error("Invalid facet node");
+			face.node[j] = nid;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::ReadDataMap(FEModel& fem, int nid)
+{
+	FEMesh& mesh = fem.GetMesh();
+
+	string name, setName;
+	int dataType = 0, nvals = 0;
+	if ((read(name) == false) || (read(setName) == false)) return error("Invalid data map block");
+	if ((read(dataType) == false) || (read(nvals) == false) || (nvals < 0)) return error("Invalid data map block");
+	if ((dataType != FE_DOUBLE) && (dataType != FE_VEC2D) && (dataType != FE_VEC3D)) return error("Invalid data map type");
+
+	FEDataArray* pdata = 0;
+	if (nid == MESH_NODEDATA)
+	{
+		FENodeSet* nodeSet = mesh.FindNodeSet(setName.c_str());
+		if (nodeSet == 0) return error("Invalid node set for node data map");
+
+		FENodeDataMap* pmap = new FENodeDataMap(dataType);
+		pmap->Create(nodeSet->size());
+		pdata = pmap;
+	}
+	else
+	{
+		FEFacetSet* surf = mesh.FindFacetSet(setName.c_str());
+		if (surf == 0) return error("Invalid surface for surface data map");
+
+		FESurfaceMap* pmap = new FESurfaceMap(dataType);
+		pmap->SetName(name);
+		pmap->Create(surf);
+		pdata = pmap;
+	}
+	fem.AddDataArray(name.c_str(), pdata);
+
+	// read the values straight into the map's buffer
+	vector<double>& val = pdata->GetBuffer();
+	if ((int) val.size() != nvals) return error("Data map size mismatch");
+	if ((nvals > 0) && (read(&val[0], sizeof(double), nvals) == false)) return error("Invalid data map block");
+
+	return true;
+}
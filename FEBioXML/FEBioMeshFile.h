@@ -0,0 +1,163 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <stdio.h>
+#include <vector>
+#include <string>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+class FEModel;
+class FEModelBuilder;
+class FENodeSet;
+class FEFacetSet;
+class FENodeDataMap;
+class FESurfaceMap;
+
+//-----------------------------------------------------------------------------
+// Binary mesh file (.febm)
+//
+// This class reads and writes the FEBio binary mesh format. This format stores
+// the same geometry that can be defined in the Geometry section of the input
+// file, but in a form that can be read with a few bulk reads. It is referenced
+// from the input file either by the "from" attribute of the Geometry section
+//
+//   <Geometry from="model.febm"/>
+//
+// or from the Include section
+//
+//   <Include>model.febm</Include>
+//
+// A mesh file can be created from an existing input file with the convert_mesh
+// task:
+//
+//   febio2 -i model.feb -task=convert_mesh model.febm
+//
+// File layout (all data is written in the native byte order):
+//
+//   header : uint32 magic ('FEBM'), uint32 version
+//   block  : uint32 block ID, uint64 size of block data (in bytes), block data
+//   ...
+//   block  : MESH_END (size = 0)
+//
+// Strings are stored as an int32 length followed by the characters (no terminating
+// zero). All counts are int32. Nodes, elements and facets are referenced by their IDs,
+// not by their indices. Block data:
+//
+//   NODES    : count; int32 id[count]; double r0[3*count]
+//              (IDs must be increasing and larger than any previously defined node ID)
+//   DOMAIN   : name; material (name or 1-based ID); element type (e.g. "hex8");
+//              count; nodes per element (neln); int32 id[count]; int32 node[count*neln];
+//              int32 has_thickness; [double h0[count*neln]] (shell domains only)
+//   NODESET  : name; count; int32 node[count]
+//   ELEMSET  : name; count; int32 elem[count]
+//   SURFACE  : name; count; int32 ntype[count]; int32 node[sum(ntype)]
+//              (ntype is the number of nodes of each facet)
+//   NODEDATA : map name; node set name; data type (FEDataType); nvals; double val[nvals]
+//   SURFDATA : map name; surface name; data type (FEDataType); nvals; double val[nvals]
+//              (val is the map's data buffer, i.e. nvals = BufferSize())
+//
+// Readers skip blocks with unknown IDs, so new blocks can be added without changing
+// the version number.
+class FEBioMeshFile
+{
+public:
+	enum { MAGIC = 0x4D424546 };	// 'FEBM'
+	enum { VERSION = 1 };
+
+	enum BlockID {
+		MESH_END = 0,
+		MESH_NODES,
+		MESH_DOMAIN,
+		MESH_NODESET,
+		MESH_ELEMSET,
+		MESH_SURFACE,
+		MESH_NODEDATA,
+		MESH_SURFDATA
+	};
+
+public:
+	FEBioMeshFile();
+	~FEBioMeshFile();
+
+	//! see if a file is a binary mesh file
+	static bool IsMeshFile(const char* szfile);
+
+	//! close the file
+	void Close();
+
+public: // --- writing ---
+
+	//! create a new mesh file
+	bool Create(const char* szfile);
+
+	//! write the mesh of a model (nodes, domains, node sets, element sets and surfaces)
+	bool WriteMesh(FEModel& fem);
+
+	//! write a node data map
+	bool WriteNodeData(const char* szname, FENodeSet& set, FENodeDataMap& map);
+
+	//! write a surface data map
+	bool WriteSurfaceData(const char* szname, FEFacetSet& surf, FESurfaceMap& map);
+
+public: // --- reading ---
+
+	//! read a mesh file and add its contents to the model
+	bool Read(const char* szfile, FEModel& fem, FEModelBuilder& feb);
+
+	//! get the error string of the last failed operation
+	const char* GetErrorString() const { return m_szerr; }
+
+private:
+	bool ReadNodes   (FEModel& fem, FEModelBuilder& feb);
+	bool ReadDomain  (FEModel& fem, FEModelBuilder& feb);
+	bool ReadNodeSet (FEModel& fem, FEModelBuilder& feb);
+	bool ReadElemSet (FEModel& fem, FEModelBuilder& feb);
+	bool ReadSurface (FEModel& fem, FEModelBuilder& feb);
+	bool ReadDataMap (FEModel& fem, int nid);
+
+	// low-level I/O
+	void BeginBlock(unsigned int nid, unsigned long long nsize);
+	void write(const void* pd, size_t size, size_t count);
+	void write(int n) { write(&n, sizeof(int), 1); }
+	void write(const string& s);
+	static unsigned long long strsize(const string& s) { return sizeof(int) + s.size(); }
+
+	bool read(void* pd, size_t size, size_t count);
+	bool read(int& n) { return read(&n, sizeof(int), 1); }
+	bool read(string& s);
+	bool skip(unsigned long long nsize);
+
+	bool error(const char* szerr);
+
+private:
+	FILE*	m_fp;
+	bool	m_bwrite;		//!< file was opened for writing
+	bool	m_bok;			//!< false when a write failed
+	char	m_szerr[256];	//!< last error
+};
@@ -35,12 +35,14 @@ SOFTWARE.*/
 #include <FECore/FEModelLoad.h>
 #include <FECore/FERigidSystem.h>
 #include <FECore/RigidBC.h>
+#include <FECore/FEMeshReorder.h>
 
 //-----------------------------------------------------------------------------
 FEModelBuilder::FEModelBuilder(FEModel& fem) : m_fem(fem)
 {
 	m_pStep = 0;	// zero step pointer
 	m_nsteps = 0;	// reset step section counter
+	m_bmeshReordered = false;
 
 	// default element type
 	m_ntet4  = FE_TET4G1;
@@ -352,11 +354,18 @@ FEModelBuilder::NodeSetSet* FEModelBuilder::FindNodeSetSet(const char* szname)
 void FEModelBuilder::BuildNodeList()
 {
 	// find the min, max ID
-	// (We assume that they are given by the first and last node)
+	// (We can't assume that they are given by the first and last node, since
+	// the nodes may have been reordered)
 	FEMesh& mesh = m_fem.GetMesh();
 	int NN = mesh.Nodes();
 	int nmin = mesh.Node(0).GetID();
-	int nmax = mesh.Node(NN - 1).GetID();
+	int nmax = nmin;
+	for (int i = 1; i<NN; ++i)
+	{
+		int nid = mesh.Node(i).GetID();
+		if (nid < nmin) nmin = nid;
+		if (nid > nmax) nmax = nid;
+	}
 	assert(nmax >= nmin);
 
 	// get the range
@@ -396,6 +405,26 @@ void FEModelBuilder::GlobalToLocalID(int* l, int n, vector<int>& m)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// This reorders the nodes and elements of the mesh when the reorder_mesh 
+// parameter was set in the Control section. Since this changes the node indices,
+// it should be called when the geometry is completely read in. Only the first
+// call after the nodes are read in does anything.
+void FEModelBuilder::ReorderMesh()
+{
+	if (m_bmeshReordered || (m_fem.GetMesh().Nodes() == 0)) return;
+	m_bmeshReordered = true;
+
+	if (m_fem.ReorderMesh() == false) return;
+
+	FEMeshReorder mod;
+	if (mod.Apply(m_fem.GetMesh()))
+	{
+		// the node indices have changed, so rebuild the node ID table
+		BuildNodeList();
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Get the element type from a XML tag
 FE_Element_Spec FEModelBuilder::ElementSpec(const char* sztype)
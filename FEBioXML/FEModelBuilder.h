@@ -121,10 +121,14 @@ public:
 	// convert an array of nodal ID to nodal indices
 	void GlobalToLocalID(int* l, int n, vector<int>& m);
 
+	// reorder the nodes and elements for memory locality (if requested by the model)
+	void ReorderMesh();
+
 private:
 	FEModel&		m_fem;				//!< model that is being constructed
 	FEAnalysis*		m_pStep;			//!< pointer to current analysis step
 	int				m_nsteps;			//!< nr of step sections read
+	bool			m_bmeshReordered;	//!< the mesh was reordered (this is only done once)
 
 public:
 	int		m_maxid;		//!< max element ID
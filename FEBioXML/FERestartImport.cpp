@@ -164,6 +164,9 @@ bool FERestartImport::Parse(const char* szfile)
 		char szar[256];
 		tag.value(szar);
 
+		// make sure the archive is not corrupted
+		if (DumpFile::CheckIntegrity(szar) == false) return errf("FATAL ERROR: restart archive is corrupted\n");
+
 		// open the archive
 		DumpFile ar(fem);
 		if (ar.Open(szar) == false) return errf("FATAL ERROR: failed opening restart archive\n");
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "BFGSSolver.h"
 #include "FESolver.h"
 #include "FEException.h"
+#include "FEProfiler.h"
 
 //-----------------------------------------------------------------------------
 // BFGSSolver
@@ -166,9 +167,12 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// perform a backsubstitution
-	if (m_plinsolve->BackSolve(x, tmp) == false)
 	{
-		throw LinearSolverFailed();
+		PROFILE_SCOPE("backsolve");
+		if (m_plinsolve->BackSolve(x, tmp) == false)
+		{
+			throw LinearSolverFailed();
+		}
 	}
 
 	// loop again over all update vectors
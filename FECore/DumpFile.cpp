@@ -27,6 +27,8 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "DumpFile.h"
+#include <string.h>
+#include <vector>
 
 DumpFile::DumpFile(FEModel& fem) : DumpStream(fem)
 {
@@ -91,3 +93,87 @@ size_t DumpFile::read(void* pd, size_t size, size_t count)
 	m_nindex += (int)(size*count);
 	return fread(pd, size, count, m_fp);
 }
+
+//-----------------------------------------------------------------------------
+// identifies the trailer of a file written by WriteBuffer
+static const char DUMP_TRAILER_TAG[8] = {'F','E','B','C','H','K','S','M'};
+
+//-----------------------------------------------------------------------------
+// Update a Fletcher-like checksum over 32-bit words. Only the last block that
+// is added may have a size that is not a multiple of 4.
+static void checksum_update(unsigned long long& a, unsigned long long& b, const unsigned char* pc, size_t nsize)
+{
+	size_t nw = nsize / 4;
+	for (size_t i=0; i<nw; ++i, pc += 4)
+	{
+		unsigned int w;
+		memcpy(&w, pc, 4);
+		a += w;
+		b += a;
+	}
+	for (size_t i=nw*4; i<nsize; ++i, ++pc)
+	{
+		a += *pc;
+		b += a;
+	}
+}
+
+//-----------------------------------------------------------------------------
+unsigned long long DumpFile::Checksum(const void* pd, size_t nsize)
+{
+	unsigned long long a = 1, b = 0;
+	checksum_update(a, b, (const unsigned char*) pd, nsize);
+	return (b << 32) ^ a;
+}
+
+//-----------------------------------------------------------------------------
+bool DumpFile::WriteBuffer(const char* szfile, const void* pd, size_t nsize)
+{
+	FILE* fp = fopen(szfile, "wb");
+	if (fp == 0) return false;
+
+	unsigned long long n = nsize;
+	unsigned long long chk = Checksum(pd, nsize);
+
+	bool bok = (fwrite(pd, 1, nsize, fp) == nsize);
+	if (bok) bok = (fwrite(&n, sizeof(n), 1, fp) == 1);
+	if (bok) bok = (fwrite(&chk, sizeof(chk), 1, fp) == 1);
+	if (bok) bok = (fwrite(DUMP_TRAILER_TAG, 1, 8, fp) == 8);
+	if (fclose(fp) != 0) bok = false;
+
+	return bok;
+}
+
+//-----------------------------------------------------------------------------
+bool DumpFile::CheckIntegrity(const char* szfile)
+{
+	FILE* fp = fopen(szfile, "rb");
+	if (fp == 0) return false;
+
+	// read the trailer
+	unsigned long long n = 0, chk = 0;
+	char tag[8] = {0};
+	bool bok = (fseek(fp, -24, SEEK_END) == 0);
+	if (bok) bok = (fread(&n, sizeof(n), 1, fp) == 1);
+	if (bok) bok = (fread(&chk, sizeof(chk), 1, fp) == 1);
+	if (bok) bok = (fread(tag, 1, 8, fp) == 8);
+
+	// files without a trailer are not checked
+	if ((bok == false) || (memcmp(tag, DUMP_TRAILER_TAG, 8) != 0)) { fclose(fp); return true; }
+
+	// read the data in blocks and compare the checksum
+	const size_t BLOCK = 1 << 22;
+	std::vector<unsigned char> buf(BLOCK);
+	unsigned long long a = 1, b = 0;
+	rewind(fp);
+	while (bok && (n > 0))
+	{
+		size_t m = (n < BLOCK ? (size_t) n : BLOCK);
+		bok = (fread(&buf[0], 1, m, fp) == m);
+		if (bok) checksum_update(a, b, &buf[0], m);
+		n -= m;
+	}
+	fclose(fp);
+
+	return bok && (((b << 32) ^ a) == chk);
+}
@@ -70,6 +70,18 @@ public:
 	//! get the current index
 	int GetDataIndex() const { return m_nindex; }
 
+public:
+	//! Calculate the checksum of a buffer
+	static unsigned long long Checksum(const void* pd, size_t nsize);
+
+	//! Write a buffer that contains a serialized model to a file, followed by a trailer
+	//! with the size and checksum of the data.
+	static bool WriteBuffer(const char* szfile, const void* pd, size_t nsize);
+
+	//! Check the integrity of a file written with WriteBuffer. This returns
+	//! true if the checksum is correct or if the file does not have a trailer.
+	static bool CheckIntegrity(const char* szfile);
+
 protected:
 	FILE*		m_fp;		//!< The actual file pointer
 	int			m_nindex;	//!< file index (gives amount of bytes written or read in so far)
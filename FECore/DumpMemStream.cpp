@@ -42,7 +42,21 @@ DumpMemStream::DumpMemStream(FEModel& fem) : DumpStream(fem)
 }
 
 //-----------------------------------------------------------------------------
+//! Empties the stream. The buffer is kept, so that the stream can be filled again
+//! (e.g. with the model state of the next time step) without reallocating.
 void DumpMemStream::clear()
+{
+	m_pd = m_pb;
+	m_nsize = 0;
+
+	// Since we can't read from an empty stream
+	// we restore write mode.
+	Open(true, true);
+}
+
+//-----------------------------------------------------------------------------
+//! Empties the stream and frees the buffer.
+void DumpMemStream::release()
 {
 	delete [] m_pb;
 	m_pb = 0;
@@ -50,8 +64,6 @@ void DumpMemStream::clear()
 	m_nsize = 0;
 	m_nreserved = 0;
 
-	// Since we can't read from an empty stream
-	// we restore write mode.
 	Open(true, true);
 }
 
@@ -65,7 +77,7 @@ void DumpMemStream::Open(bool bsave, bool bshallow)
 //-----------------------------------------------------------------------------
 DumpMemStream::~DumpMemStream()
 {
-	clear();
+	release();
 }
 
 //-----------------------------------------------------------------------------
@@ -77,19 +89,26 @@ void DumpMemStream::set_position(size_t l)
 }
 
 //-----------------------------------------------------------------------------
+//! Makes sure that at least l more bytes can be written. The buffer is (at least)
+//! doubled in size, so that the number of reallocations (and copies) is logarithmic
+//! in the final size of the stream.
 void DumpMemStream::grow_buffer(size_t l)
 {
 	if (l <= 0) return;
 
-	char* pnew = new char[m_nreserved + l];
+	size_t nnew = 2*m_nreserved;
+	if (nnew < m_nsize + l) nnew = m_nsize + l;
+
+	char* pnew = new char[nnew];
 	if (m_pb)
 	{
-		memcpy(pnew, m_pb, m_nreserved);
+		// only the part that was written needs to be copied
+		memcpy(pnew, m_pb, m_nsize);
 		delete [] m_pb;
 	}
 	m_pb = pnew;
 	m_pd = m_pb + m_nsize;
-	m_nreserved += l;
+	m_nreserved = nnew;
 }
 
 //-----------------------------------------------------------------------------
@@ -97,7 +116,7 @@ size_t DumpMemStream::write(const void* pd, size_t size, size_t count)
 {
 	assert(IsSaving());
 	size_t nsize = count*size;
-	if (m_nsize + nsize > m_nreserved) grow_buffer(nsize + m_nreserved/10);
+	if (m_nsize + nsize > m_nreserved) grow_buffer(nsize);
 	memcpy(m_pd, pd, nsize);
 	m_pd += nsize;
 	m_nsize += nsize;
@@ -43,11 +43,17 @@ public: // overloaded from base class
 	size_t read(void* pd, size_t size, size_t count);
 	void clear();
 	void Open(bool bsave, bool bshallow);
+
+	//! empty the stream and free the buffer
+	void release();
 	void check();
 
 	size_t size() const { return m_nsize; }
 	size_t reserved() const { return m_nreserved; }
 
+	//! pointer to the data of the stream
+	const char* data() const { return m_pb; }
+
 protected:
 	void grow_buffer(size_t l);
 	void set_position(size_t l);
@@ -0,0 +1,238 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "EBEMatrix.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+EBEMatrix::EBEMatrix()
+{
+}
+
+//-----------------------------------------------------------------------------
+void EBEMatrix::Create(SparseMatrixProfile& MP)
+{
+	Clear();
+	m_nrow = MP.Rows();
+	m_ncol = MP.Columns();
+	m_nsize = 0;
+	m_diag.assign(m_nrow, 0.0);
+	m_sd.assign(m_nrow, 0.0);
+	m_bsd.assign(m_nrow, 0);
+}
+
+//-----------------------------------------------------------------------------
+void EBEMatrix::Zero()
+{
+	// we keep the capacity so that the next assembly does not need to reallocate
+	m_blk.clear();
+	m_lm.clear();
+	m_val.clear();
+	m_ci.clear(); m_cj.clear(); m_cv.clear();
+	for (size_t n=0; n<m_sdrow.size(); ++n) { m_sd[m_sdrow[n]] = 0.0; m_bsd[m_sdrow[n]] = 0; }
+	m_sdrow.clear();
+	m_so.clear();
+	m_diag.assign(m_nrow, 0.0);
+	m_nsize = 0;
+}
+
+//-----------------------------------------------------------------------------
+void EBEMatrix::Clear()
+{
+	m_blk.clear(); m_blk.shrink_to_fit();
+	m_lm.clear(); m_lm.shrink_to_fit();
+	m_val.clear(); m_val.shrink_to_fit();
+	m_ci.clear(); m_cj.clear(); m_cv.clear();
+	m_sd.clear(); m_bsd.clear(); m_sdrow.clear();
+	m_so.clear();
+	m_diag.clear();
+	m_tmp.clear(); m_tmp.shrink_to_fit();
+	SparseMatrix::Clear();
+}
+
+//-----------------------------------------------------------------------------
+void EBEMatrix::Assemble(matrix& ke, std::vector<int>& lm)
+{
+	Assemble(ke, lm, lm);
+}
+
+//-----------------------------------------------------------------------------
+void EBEMatrix::Assemble(matrix& ke, std::vector<int>& lmi, std::vector<int>& lmj)
+{
+	// only keep the rows and columns of free dofs
+	m_li.clear(); m_lj.clear();
+	int N = (int) lmi.size();
+	int M = (int) lmj.size();
+	for (int i=0; i<N; ++i) if (lmi[i] >= 0) m_li.push_back(i);
+	for (int j=0; j<M; ++j) if (lmj[j] >= 0) m_lj.push_back(j);
+	if (m_li.empty() || m_lj.empty()) return;
+
+	Block b;
+	b.nr = (int) m_li.size();
+	b.nc = (int) m_lj.size();
+	b.nlm = m_lm.size();
+	b.nval = m_val.size();
+	m_blk.push_back(b);
+
+	for (int i=0; i<b.nr; ++i) m_lm.push_back(lmi[m_li[i]]);
+	for (int j=0; j<b.nc; ++j) m_lm.push_back(lmj[m_lj[j]]);
+
+	for (int i=0; i<b.nr; ++i)
+	{
+		int I = lmi[m_li[i]];
+		for (int j=0; j<b.nc; ++j)
+		{
+			double kij = ke[m_li[i]][m_lj[j]];
+			m_val.push_back(kij);
+			if (lmj[m_lj[j]] == I) m_diag[I] += kij;
+		}
+	}
+
+	m_nsize += b.nr*b.nc;
+}
+
+//-----------------------------------------------------------------------------
+void EBEMatrix::add(int i, int j, double v)
+{
+	m_ci.push_back(i);
+	m_cj.push_back(j);
+	m_cv.push_back(v);
+	if (i == j) m_diag[i] += v;
+}
+
+//-----------------------------------------------------------------------------
+// The solvers call this for the diagonal of each prescribed dof once for every
+// element that touches it, so the diagonal entries are stored per row.
+void EBEMatrix::set(int i, int j, double v)
+{
+	if (i == j)
+	{
+		if (m_bsd[i] == 0) { m_bsd[i] = 1; m_sdrow.push_back(i); }
+		m_diag[i] += v - m_sd[i];
+		m_sd[i] = v;
+	}
+	else m_so[(long long) i*m_ncol + j] = v;
+}
+
+//-----------------------------------------------------------------------------
+double EBEMatrix::get(int i, int j)
+{
+	if (i == j) return m_diag[i];
+
+	double v = 0.0;
+	for (size_t n=0; n<m_blk.size(); ++n)
+	{
+		const Block& b = m_blk[n];
+		const int* lmi = &m_lm[b.nlm];
+		const int* lmj = lmi + b.nr;
+		for (int k=0; k<b.nr; ++k)
+		{
+			if (lmi[k] == i)
+			{
+				for (int l=0; l<b.nc; ++l) if (lmj[l] == j) v += m_val[b.nval + k*b.nc + l];
+			}
+		}
+	}
+	for (size_t n=0; n<m_cv.size(); ++n) if ((m_ci[n] == i) && (m_cj[n] == j)) v += m_cv[n];
+	std::unordered_map<long long, double>::const_iterator it = m_so.find((long long) i*m_ncol + j);
+	if (it != m_so.end()) v += it->second;
+	return v;
+}
+
+//-----------------------------------------------------------------------------
+// calculate r += K*x for the element matrices [n0, n1)
+void EBEMatrix::mult_blocks(int n0, int n1, const double* x, double* r) const
+{
+	for (int n=n0; n<n1; ++n)
+	{
+		const Block& b = m_blk[n];
+		const int* lmi = &m_lm[b.nlm];
+		const int* lmj = lmi + b.nr;
+		const double* k = &m_val[b.nval];
+		for (int i=0; i<b.nr; ++i, k += b.nc)
+		{
+			double ri = 0.0;
+			for (int j=0; j<b.nc; ++j) ri += k[j]*x[lmj[j]];
+			r[lmi[i]] += ri;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool EBEMatrix::mult_vector(double* x, double* r)
+{
+	const int N = m_nrow;
+	const int NB = (int) m_blk.size();
+	for (int i=0; i<N; ++i) r[i] = 0.0;
+
+#ifdef _OPENMP
+	// Each thread accumulates into its own vector, since the element matrices share equations.
+	int nt = omp_get_max_threads();
+	if ((nt > 1) && (NB > nt))
+	{
+		m_tmp.assign((size_t)nt*N, 0.0);
+		#pragma omp parallel num_threads(nt)
+		{
+			int id = omp_get_thread_num();
+			int nth = omp_get_num_threads();
+			double* y = &m_tmp[(size_t)id*N];
+
+			int n0 = (int)(((long long)NB*id) / nth);
+			int n1 = (int)(((long long)NB*(id + 1)) / nth);
+			mult_blocks(n0, n1, x, y);
+
+			#pragma omp barrier
+
+			#pragma omp for
+			for (int i=0; i<N; ++i)
+			{
+				double ri = 0.0;
+				for (int t=0; t<nt; ++t) ri += m_tmp[(size_t)t*N + i];
+				r[i] = ri;
+			}
+		}
+	}
+	else mult_blocks(0, NB, x, r);
+#else
+	mult_blocks(0, NB, x, r);
+#endif
+
+	// add the entries that were not assembled from element matrices
+	for (size_t n=0; n<m_cv.size(); ++n) r[m_ci[n]] += m_cv[n]*x[m_cj[n]];
+	for (size_t n=0; n<m_sdrow.size(); ++n) { int i = m_sdrow[n]; r[i] += m_sd[i]*x[i]; }
+	for (std::unordered_map<long long, double>::const_iterator it = m_so.begin(); it != m_so.end(); ++it)
+	{
+		int i = (int) (it->first / m_ncol);
+		int j = (int) (it->first % m_ncol);
+		r[i] += it->second*x[j];
+	}
+
+	return true;
+}
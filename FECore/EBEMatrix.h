@@ -0,0 +1,113 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "SparseMatrix.h"
+#include <unordered_map>
+
+//-----------------------------------------------------------------------------
+// This class stores the global stiffness matrix element-by-element.
+// Instead of assembling the element matrices into a global sparse matrix, the
+// element matrices are stored compactly (i.e. only the rows and columns of
+// free dofs) and the matrix-vector product is evaluated by looping over the
+// stored element matrices. This avoids the global matrix structure altogether
+// so that the memory is proportional to the mesh. Only mult_vector and diag can
+// be used by the linear solver, so this matrix requires an iterative solver.
+// It is used by the EBEStrategy.
+class FECORE_API EBEMatrix : public SparseMatrix
+{
+	// an element matrix
+	struct Block
+	{
+		int		nr, nc;		// nr of rows and columns
+		size_t	nlm;		// offset in equation number array (rows, then columns)
+		size_t	nval;		// offset in value array (row-major)
+	};
+
+public:
+	EBEMatrix();
+
+	//! multiply with vector
+	bool mult_vector(double* x, double* r) override;
+
+public:
+	//! set all matrix elements to zero (removes the stored element matrices)
+	void Zero() override;
+
+	//! Create a sparse matrix from a sparse-matrix profile (only the size is used)
+	void Create(SparseMatrixProfile& MP) override;
+
+	//! store an element matrix
+	void Assemble(matrix& ke, std::vector<int>& lm) override;
+
+	//! store an element matrix
+	void Assemble(matrix& ke, std::vector<int>& lmi, std::vector<int>& lmj) override;
+
+	//! all entries can be set
+	bool check(int i, int j) override { return true; }
+
+	//! set entry to value
+	//! NOTE: This only overrides values that were not assembled from element matrices.
+	//! It is used for the diagonals of prescribed dofs.
+	void set(int i, int j, double v) override;
+
+	//! add value to entry
+	void add(int i, int j, double v) override;
+
+	//! retrieve value (this is slow, since it loops over all element matrices)
+	double get(int i, int j) override;
+
+	//! get the diagonal value
+	double diag(int i) override { return m_diag[i]; }
+
+	//! release memory for storing data
+	void Clear() override;
+
+public:
+	//! number of stored element matrices
+	int Blocks() const { return (int) m_blk.size(); }
+
+private:
+	// calculate r += K*x for the element matrices [n0, n1)
+	void mult_blocks(int n0, int n1, const double* x, double* r) const;
+
+private:
+	vector<Block>	m_blk;	//!< element matrices
+	vector<int>		m_lm;	//!< equation numbers of element matrices
+	vector<double>	m_val;	//!< values of element matrices
+
+	vector<int>		m_ci, m_cj;	//!< entries that were added with add
+	vector<double>	m_cv;
+	vector<double>	m_sd;		//!< diagonal entries that were set with set
+	vector<char>	m_bsd;		//!< flags the rows in m_sd that were set
+	vector<int>		m_sdrow;	//!< the rows that were set
+	std::unordered_map<long long, double>	m_so;	//!< off-diagonal entries that were set with set
+
+	vector<double>	m_diag;		//!< the diagonal
+	vector<int>		m_li, m_lj;	//!< temp storage for local equation indices
+	vector<double>	m_tmp;		//!< per-thread results of mult_vector
+};
@@ -0,0 +1,87 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "EBEStrategy.h"
+#include "FENewtonSolver.h"
+#include "EBEMatrix.h"
+#include "FEException.h"
+#include "FEProfiler.h"
+#include "log.h"
+
+EBEStrategy::EBEStrategy(FENewtonSolver* pns) : FENewtonStrategy(pns)
+{
+	m_plinsolve = 0;
+	m_neq = 0;
+}
+
+//! New initialization method
+void EBEStrategy::Init(int neq, LinearSolver* pls)
+{
+	m_neq = neq;
+	m_plinsolve = pls;
+}
+
+SparseMatrix* EBEStrategy::CreateSparseMatrix(Matrix_Type mtype)
+{
+	// The element matrices can only be used by iterative solvers.
+	// Preconditioners can only use the diagonal of the matrix.
+	IterativeLinearSolver* ls = dynamic_cast<IterativeLinearSolver*>(m_pns->m_plinsolve);
+	if (ls == 0)
+	{
+		felog.printbox("FATAL ERROR", "The element-by-element strategy requires an iterative linear solver.\n");
+		return 0;
+	}
+
+	EBEMatrix* pA = new EBEMatrix;
+	if (ls->SetSparseMatrix(pA) == false)
+	{
+		delete pA;
+		return 0;
+	}
+
+	return pA;
+}
+
+//! perform a Newton udpate
+bool EBEStrategy::Update(double s, vector<double>& ui, vector<double>& R0, vector<double>& R1)
+{
+	// The element matrices are kept until the next reformation (modified Newton)
+	m_nups++;
+	return true;
+}
+
+//! solve the equations
+void EBEStrategy::SolveEquations(vector<double>& x, vector<double>& b)
+{
+	// perform a backsubstitution
+	PROFILE_SCOPE("backsolve");
+	if (m_plinsolve->BackSolve(x, b) == false)
+	{
+		throw LinearSolverFailed();
+	}
+}
@@ -0,0 +1,59 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "FENewtonStrategy.h"
+#include "SparseMatrix.h"
+
+//-----------------------------------------------------------------------------
+// Implements a matrix-free Newton-Krylov strategy. The element stiffness matrices
+// are stored element-by-element (see EBEMatrix) and the iterative linear solver
+// applies them directly, so the global stiffness matrix is never assembled.
+// Unlike the JFNKStrategy, this uses the consistent tangent and does not require
+// a residual evaluation per Krylov iteration. Set max_ups to zero for a full
+// Newton method (i.e. the element matrices are reformed in every iteration).
+class EBEStrategy : public FENewtonStrategy
+{
+public:
+	EBEStrategy(FENewtonSolver* pns);
+
+	//! New initialization method
+	void Init(int neq, LinearSolver* pls) override;
+
+	//! initialize the linear system
+	SparseMatrix* CreateSparseMatrix(Matrix_Type mtype) override;
+
+	//! perform a Newton udpate
+	bool Update(double s, vector<double>& ui, vector<double>& R0, vector<double>& R1) override;
+
+	//! solve the equations
+	void SolveEquations(vector<double>& x, vector<double>& b) override;
+
+public:
+	LinearSolver*	m_plinsolve;	//!< pointer to linear solver
+	int				m_neq;			//!< number of equations
+};
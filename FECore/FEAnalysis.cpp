@@ -37,6 +37,7 @@ SOFTWARE.*/
 #include "FEDataLoadCurve.h"
 #include "FELinearConstraintManager.h"
 #include "FEShellDomain.h"
+#include "FEProfiler.h"
 
 BEGIN_PARAMETER_LIST(FEAnalysis, FECoreBase)
 	ADD_PARAMETER2(m_ntime     , FE_PARAM_INT   , FE_RANGE_GREATER_OR_EQUAL(-1) , "time_steps");
@@ -344,6 +345,7 @@ bool FEAnalysis::Solve()
 	{
 		// keep a copy of the current state, in case
 		// we need to retry this time step
+		// (the stream keeps its buffer, so this does not reallocate)
 		if (m_bautostep && (m_timeController.m_maxretries > 0))
 		{ 
 			dmp.clear();
@@ -468,6 +470,7 @@ int FEAnalysis::CallFESolver()
 	{
 
 		// solve this timestep,
+		PROFILE_SCOPE("time step");
 		bool bconv = GetFESolver()->SolveStep();
 		nerr = (bconv ? 0 : 1);
 	}
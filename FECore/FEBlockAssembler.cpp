@@ -0,0 +1,121 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEBlockAssembler.h"
+#include "FEGlobalVector.h"
+#include "FESolver.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+FEBlockAssembler::FEBlockAssembler(FEGlobalVector& R, int NE) : m_pR(&R), m_psolver(0)
+{
+	Init(NE);
+}
+
+//-----------------------------------------------------------------------------
+FEBlockAssembler::FEBlockAssembler(FESolver* psolver, int NE) : m_pR(0), m_psolver(psolver)
+{
+	Init(NE);
+}
+
+//-----------------------------------------------------------------------------
+void FEBlockAssembler::Init(int NE)
+{
+#ifdef _OPENMP
+	int nt = omp_get_max_threads();
+#else
+	int nt = 1;
+#endif
+	m_bdirect = (nt == 1);
+
+	// The blocks should have enough elements to balance the threads, but should be
+	// small enough so that the stored contact matrices don't take too much memory.
+	m_NE = NE;
+	m_nblock = (m_bdirect ? NE : 32*nt);
+	m_n0 = m_n1 = 0;
+	if (m_bdirect == false) m_slot.resize(m_nblock);
+}
+
+//-----------------------------------------------------------------------------
+bool FEBlockAssembler::NextBlock()
+{
+	if (m_bdirect == false)
+	{
+		// assemble the current block in element order
+		for (int i=0; i<m_n1 - m_n0; ++i)
+		{
+			Slot& s = m_slot[i];
+			for (int k=0; k<s.n; ++k)
+			{
+				Entry& e = s.e[k];
+				if (m_pR) m_pR->Assemble(e.en, e.lm, e.fe);
+				else m_psolver->AssembleStiffness(e.en, e.lm, e.ke);
+			}
+			s.n = 0;
+		}
+	}
+
+	if (m_n1 >= m_NE) return false;
+
+	m_n0 = m_n1;
+	m_n1 = (m_n0 + m_nblock < m_NE ? m_n0 + m_nblock : m_NE);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FEBlockAssembler::Entry& FEBlockAssembler::NewEntry(int i)
+{
+	// the entries are reused between blocks to avoid reallocations
+	Slot& s = m_slot[i - m_n0];
+	if (s.n == (int)s.e.size()) s.e.push_back(Entry());
+	return s.e[s.n++];
+}
+
+//-----------------------------------------------------------------------------
+void FEBlockAssembler::Add(int i, vector<int>& en, vector<int>& lm, vector<double>& fe)
+{
+	if (m_bdirect) { m_pR->Assemble(en, lm, fe); return; }
+
+	Entry& e = NewEntry(i);
+	e.en = en;
+	e.lm = lm;
+	e.fe = fe;
+}
+
+//-----------------------------------------------------------------------------
+void FEBlockAssembler::Add(int i, vector<int>& en, vector<int>& lm, matrix& ke)
+{
+	if (m_bdirect) { m_psolver->AssembleStiffness(en, lm, ke); return; }
+
+	Entry& e = NewEntry(i);
+	e.en = en;
+	e.lm = lm;
+	e.ke = ke;
+}
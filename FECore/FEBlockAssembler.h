@@ -0,0 +1,110 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include "matrix.h"
+#include <vector>
+using namespace std;
+
+class FEGlobalVector;
+class FESolver;
+
+//-----------------------------------------------------------------------------
+//! Helper class for parallel element loops whose element vectors (or matrices)
+//! cannot be assembled from several threads at once, e.g. surface loads and contact.
+//! The elements are processed in blocks. The contributions of a block's elements
+//! are evaluated in parallel and stored, and then assembled in element order by
+//! one thread. The assembly order is therefore the same as for a serial loop, so
+//! the result does not depend on the number of threads. A loop looks like this:
+//!
+//!		FEBlockAssembler A(R, NE);
+//!		while (A.NextBlock())
+//!		{
+//!			#pragma omp parallel for
+//!			for (int i=A.BlockStart(); i<A.BlockEnd(); ++i) { ... A.Add(i, en, lm, fe); }
+//!		}
+//!
+//! With only one thread the contributions are assembled right away.
+class FECORE_API FEBlockAssembler
+{
+	// an element vector or matrix
+	struct Entry
+	{
+		vector<int>		en;
+		vector<int>		lm;
+		vector<double>	fe;
+		matrix			ke;
+	};
+
+	// the contributions of one element
+	struct Slot
+	{
+		Slot() : n(0) {}
+		vector<Entry>	e;
+		int				n;	//!< nr of entries in use
+	};
+
+public:
+	//! assemble element vectors of NE elements into R
+	FEBlockAssembler(FEGlobalVector& R, int NE);
+
+	//! assemble element matrices of NE elements into the global stiffness matrix
+	FEBlockAssembler(FESolver* psolver, int NE);
+
+	//! Assemble the stored contributions of the current block and move to the
+	//! next block. Returns false when all elements were processed.
+	bool NextBlock();
+
+	//! first element of the current block
+	int BlockStart() const { return m_n0; }
+
+	//! one past the last element of the current block
+	int BlockEnd() const { return m_n1; }
+
+	//! Add an element vector for element i. This can be called from parallel
+	//! loops, as long as element i is processed by one thread.
+	void Add(int i, vector<int>& en, vector<int>& lm, vector<double>& fe);
+
+	//! Add an element matrix for element i (see above)
+	void Add(int i, vector<int>& en, vector<int>& lm, matrix& ke);
+
+private:
+	void Init(int NE);
+	Entry& NewEntry(int i);
+
+private:
+	FEGlobalVector*	m_pR;
+	FESolver*		m_psolver;
+	bool			m_bdirect;	//!< assemble right away (only one thread)
+
+	int		m_NE;		//!< total nr of elements
+	int		m_nblock;	//!< nr of elements per block
+	int		m_n0, m_n1;	//!< current block
+
+	vector<Slot>	m_slot;	//!< stored contributions of current block
+};
@@ -29,12 +29,42 @@ SOFTWARE.*/
 #include "FECoreKernel.h"
 #include "Logfile.h"
 #include "Timer.h"
+#include "FEModel.h"
 #include <stdarg.h>
 using namespace std;
 
 // set the default linear solver (0 is equivalent to skyline solver)
 int FECoreKernel::m_ndefault_solver = 0;
 
+//-----------------------------------------------------------------------------
+// data that is kept for each thread
+namespace {
+	struct ThreadData
+	{
+		FEModel*		pfem;		// model this thread works on (or zero)
+		Logfile*		plog;		// log file of this thread (or zero)
+		vector<Timer*>	timers;		// timers used outside of a model
+		string			err;		// error string
+		bool			berr;		// is the error string set?
+
+		ThreadData() : pfem(0), plog(0), berr(false) {}
+		~ThreadData() { for (size_t i=0; i<timers.size(); ++i) delete timers[i]; }
+	};
+
+	ThreadData& threadData()
+	{
+		static thread_local ThreadData data;
+		return data;
+	}
+
+	// the timers of the model of this thread
+	vector<Timer*>& timerList()
+	{
+		ThreadData& td = threadData();
+		return (td.pfem ? td.pfem->GetTimers() : td.timers);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Helper function for reporting errors
 bool fecore_error(const char* sz, ...)
@@ -83,14 +113,34 @@ void FECoreKernel::SetInstance(FECoreKernel* pkernel)
 //-----------------------------------------------------------------------------
 Logfile& FECoreKernel::GetLogfile()
 {
-	return *m_pKernel->m_plog;
+	Logfile* plog = threadData().plog;
+	return (plog ? *plog : *m_pKernel->m_plog);
+}
+
+//-----------------------------------------------------------------------------
+void FECoreKernel::SetThreadModel(FEModel* pfem, Logfile* plog)
+{
+	ThreadData& td = threadData();
+	td.pfem = pfem;
+	td.plog = plog;
+}
+
+//-----------------------------------------------------------------------------
+FEModel* FECoreKernel::GetThreadModel()
+{
+	return threadData().pfem;
+}
+
+//-----------------------------------------------------------------------------
+Logfile* FECoreKernel::GetThreadLogfile()
+{
+	return threadData().plog;
 }
 
 //-----------------------------------------------------------------------------
 FECoreKernel::FECoreKernel()
 {
 	m_plog = Logfile::GetInstance();
-	m_szerr = 0;
 	m_activeModule = -1;
 }
 
@@ -99,21 +149,16 @@ FECoreKernel::FECoreKernel()
 // Calling SetErrorString(null) can be used to clear the error string.
 void FECoreKernel::SetErrorString(const char* sz)
 {
-	// always clear the current error first
-	if (m_szerr) delete [] m_szerr; m_szerr = 0;
-
-	// make sure there is a new error string
-	if (sz == 0) return;
-	int l = strlen(sz);
-	m_szerr = new char[l+1];
-	strncpy(m_szerr, sz, l);
-	m_szerr[l] = 0;
+	ThreadData& td = threadData();
+	td.berr = (sz != 0);
+	td.err = (sz ? sz : "");
 }
 
 //-----------------------------------------------------------------------------
 const char* FECoreKernel::GetErrorString()
 {
-	return m_szerr;
+	ThreadData& td = threadData();
+	return (td.berr ? td.err.c_str() : 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -440,9 +485,10 @@ FELinearSolverFactory* FECoreKernel::FindLinearSolverFactory(int nsolver)
 // reset all the timers
 void FECoreKernel::ResetAllTimers()
 {
-	for (size_t i = 0; i<m_timers.size(); ++i)
+	vector<Timer*>& timers = timerList();
+	for (size_t i = 0; i<timers.size(); ++i)
 	{
-		Timer* ti = m_timers[i];
+		Timer* ti = timers[i];
 		ti->reset();
 	}
 }
@@ -450,10 +496,12 @@ void FECoreKernel::ResetAllTimers()
 //-----------------------------------------------------------------------------
 Timer* FECoreKernel::FindTimer(const std::string& name)
 {
+	vector<Timer*>& timers = timerList();
+
 	// see if the timer already exists
-	for (size_t i = 0; i<m_timers.size(); ++i)
+	for (size_t i = 0; i<timers.size(); ++i)
 	{
-		if (m_timers[i]->name() == name) return m_timers[i];
+		if (timers[i]->name() == name) return timers[i];
 	}
 
 	// create new timer
@@ -461,7 +509,7 @@ Timer* FECoreKernel::FindTimer(const std::string& name)
 	newTimer->setName(name);
 
 	// add it to the list
-	m_timers.push_back(newTimer);
+	timers.push_back(newTimer);
 
 	// return it
 	return newTimer;
@@ -470,11 +518,11 @@ Timer* FECoreKernel::FindTimer(const std::string& name)
 //-----------------------------------------------------------------------------
 int FECoreKernel::Timers()
 {
-	return (int)m_timers.size();
+	return (int)timerList().size();
 }
 
 //-----------------------------------------------------------------------------
 Timer* FECoreKernel::GetTimer(int i)
 {
-	return m_timers[i];
+	return timerList()[i];
 }
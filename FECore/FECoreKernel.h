@@ -62,9 +62,22 @@ public:
 	// set the instance of the kernel
 	static void SetInstance(FECoreKernel* pkernel);
 
-	// Get the logfile
+	// Get the logfile. This is the log file of the calling thread if one was set,
+	// or otherwise the kernel's log file.
 	static Logfile& GetLogfile();
 
+	// Set the model that the calling thread works on and the log file that felog
+	// uses on this thread (0 to use the kernel's log file). The named timers and the
+	// profiler of this model are used on this thread. Use FEModelScope instead of
+	// calling this directly.
+	static void SetThreadModel(FEModel* pfem, Logfile* plog);
+
+	// the model that the calling thread works on (or 0)
+	static FEModel* GetThreadModel();
+
+	// the log file that was set for the calling thread (or 0)
+	static Logfile* GetThreadLogfile();
+
 public:
 	//! Register a class with the framework
 	void RegisterFactory(FECoreFactory* ptf);
@@ -135,6 +148,10 @@ public:
 	static int m_ndefault_solver;
 
 public:
+	// The timers are those of the model that the calling thread works on (see
+	// SetThreadModel) and the error string is kept per thread, so that models
+	// that are solved on separate threads do not share them.
+
 	// reset all the timers
 	void ResetAllTimers();
 
@@ -151,7 +168,6 @@ private:
 	std::vector<FECoreFactory*>			m_Fac;	// list of registered factory classes
 	std::vector<FEDomainFactory*>		m_Dom;	// list of domain factory classes
 	std::vector<FELinearSolverFactory*> m_LS;	// list of linear solver factories
-	std::vector<Timer*>					m_timers;	// list of timers
 
 	// module list
 	vector<Module>	m_modules;
@@ -159,8 +175,6 @@ private:
 
 	Logfile*	m_plog;	// keep a pointer to the logfile (used by plugins)
 
-	char*	m_szerr;	//!< error string
-
 private: // make singleton
 	FECoreKernel();
 	FECoreKernel(const FECoreKernel&){}
@@ -90,6 +90,9 @@ public:
 	//! return the buffer size (actual number of doubles)
 	int BufferSize() const { return (int) m_val.size(); }
 
+	//! direct access to the data buffer (used for bulk I/O)
+	std::vector<double>& GetBuffer() { return m_val; }
+
 	//! serialization
 	void Serialize(DumpStream& ar);
 
@@ -29,6 +29,8 @@ SOFTWARE.*/
 #include "FEElement.h"
 #include "DumpStream.h"
 #include <math.h>
+#include <algorithm>
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 FEElementState::FEElementState(const FEElementState& s)
@@ -109,7 +111,7 @@ int FEElement::FindNode(int n) const
 //-----------------------------------------------------------------------------
 FEElement::FEElement() : m_pT(0) 
 { 
-	static int n = 1;
+	static std::atomic<int> n(1);
 	m_nID = n++;
 	m_lm = -1;
 }
@@ -123,6 +125,21 @@ void FEElement::SetTraits(FEElementTraits* ptraits)
 	m_State.Create(GaussPoints());
 }
 
+//-----------------------------------------------------------------------------
+//! Exchange all element data with another element. The state data is swapped
+//! and not copied, so this is cheap even after the material points were created.
+void FEElement::swap(FEElement& el)
+{
+	std::swap(m_nID, el.m_nID);
+	std::swap(m_mat, el.m_mat);
+	std::swap(m_dom, el.m_dom);
+	std::swap(m_lm , el.m_lm );
+	std::swap(m_pT , el.m_pT );
+	m_node.swap(el.m_node);
+	m_lnode.swap(el.m_lnode);
+	m_State.swap(el.m_State);
+}
+
 //! serialize
 void FEElement::Serialize(DumpStream& ar)
 {
@@ -203,6 +220,14 @@ int FESolidElement::BackShellNodes() const
 	return n;
 }
 
+//-----------------------------------------------------------------------------
+void FESolidElement::swap(FESolidElement& el)
+{
+	FEElement::swap(el);
+	m_bitfc.swap(el.m_bitfc);
+	m_J0i.swap(el.m_J0i);
+}
+
 //! serialize
 void FESolidElement::Serialize(DumpStream& ar)
 {
@@ -364,7 +389,7 @@ FEShellElementNew::FEShellElementNew()
 
 FEShellElementNew::FEShellElementNew(const FEShellElementNew& el) : FEShellElement(el)
 {
-	// TODO: What about all the EAS parameters?
+	m_E = el.m_E;
 }
 
 //! assignment operator
@@ -372,7 +397,7 @@ FEShellElementNew& FEShellElementNew::operator = (const FEShellElementNew& el)
 {
 	FEShellElement::operator=(el);
 
-	// TODO: What about all the EAS parameters?
+	m_E = el.m_E;
 
 	return (*this);
 }
@@ -380,8 +405,6 @@ FEShellElementNew& FEShellElementNew::operator = (const FEShellElementNew& el)
 void FEShellElementNew::SetTraits(FEElementTraits* ptraits)
 {
 	FEShellElement::SetTraits(ptraits);
-
-	// TODO: What about all the EAS parameters?
 }
 
 void FEShellElementNew::Serialize(DumpStream &ar)
@@ -391,85 +414,17 @@ void FEShellElementNew::Serialize(DumpStream &ar)
 	if (ar.IsShallow())
 	{
 		if (ar.IsSaving()) {
-			for (int i = 0; i<m_Kaai.rows(); ++i)
-				for (int j = 0; j<m_Kaai.columns(); ++j)
-					ar << m_Kaai(i, j);
-			for (int i = 0; i<m_fa.rows(); ++i) ar << m_fa(i, 0);
-			for (int i = 0; i<m_alpha.rows(); ++i) ar << m_alpha(i, 0);
-			for (int i = 0; i<m_alphat.rows(); ++i) ar << m_alphat(i, 0);
-			for (int i = 0; i<m_alphai.rows(); ++i) ar << m_alphai(i, 0);
-			for (int k = 0; k<m_Kua.size(); ++k)
-				for (int i = 0; i<m_Kua[k].rows(); ++i)
-					for (int j = 0; j<m_Kua[k].columns(); ++j)
-						ar << m_Kua[k](i, j);
-			for (int k = 0; k<m_Kwa.size(); ++k)
-				for (int i = 0; i<m_Kwa[k].rows(); ++i)
-					for (int j = 0; j<m_Kwa[k].columns(); ++j)
-						ar << m_Kwa[k](i, j);
 			for (int k = 0; k<m_E.size(); ++k) ar << m_E[k];
 		}
 		else {
-			for (int i = 0; i<m_Kaai.rows(); ++i)
-				for (int j = 0; j<m_Kaai.columns(); ++j)
-					ar >> m_Kaai(i, j);
-			for (int i = 0; i<m_fa.rows(); ++i) ar >> m_fa(i, 0);
-			for (int i = 0; i<m_alpha.rows(); ++i) ar >> m_alpha(i, 0);
-			for (int i = 0; i<m_alphat.rows(); ++i) ar >> m_alphat(i, 0);
-			for (int i = 0; i<m_alphai.rows(); ++i) ar >> m_alphai(i, 0);
-			for (int k = 0; k<m_Kua.size(); ++k)
-				for (int i = 0; i<m_Kua[k].rows(); ++i)
-					for (int j = 0; j<m_Kua[k].columns(); ++j)
-						ar >> m_Kua[k](i, j);
-			for (int k = 0; k<m_Kwa.size(); ++k)
-				for (int i = 0; i<m_Kwa[k].rows(); ++i)
-					for (int j = 0; j<m_Kwa[k].columns(); ++j)
-						ar >> m_Kwa[k](i, j);
 			for (int k = 0; k<m_E.size(); ++k) ar >> m_E[k];
 		}
 	}
 	else {
 		if (ar.IsSaving()) {
-			int nEAS = m_fa.rows();
-			int neln = Nodes();
-			int nint = GaussPoints();
-			ar << nEAS;
-			for (int i = 0; i<nEAS; ++i)
-				for (int j = 0; j<nEAS; ++j)
-					ar << m_Kaai(i, j);
-			for (int i = 0; i<nEAS; ++i) ar << m_fa(i, 0);
-			for (int i = 0; i<nEAS; ++i) ar << m_alpha(i, 0);
-			for (int i = 0; i<nEAS; ++i) ar << m_alphat(i, 0);
-			for (int i = 0; i<nEAS; ++i) ar << m_alphai(i, 0);
-			for (int k = 0; k<neln; ++k)
-				for (int i = 0; i<3; ++i)
-					for (int j = 0; j<nEAS; ++j)
-						ar << m_Kua[k](i, j);
-			for (int k = 0; k<neln; ++k)
-				for (int i = 0; i<3; ++i)
-					for (int j = 0; j<nEAS; ++j)
-						ar << m_Kwa[k](i, j);
 			ar << m_E;
 		}
 		else {
-			int nEAS;
-			ar >> nEAS;
-			int neln = Nodes();
-			int nint = GaussPoints();
-			for (int i = 0; i<nEAS; ++i)
-				for (int j = 0; j<nEAS; ++j)
-					ar >> m_Kaai(i, j);
-			for (int i = 0; i<nEAS; ++i) ar >> m_fa(i, 0);
-			for (int i = 0; i<nEAS; ++i) ar >> m_alpha(i, 0);
-			for (int i = 0; i<nEAS; ++i) ar >> m_alphat(i, 0);
-			for (int i = 0; i<nEAS; ++i) ar >> m_alphai(i, 0);
-			for (int k = 0; k<neln; ++k)
-				for (int i = 0; i<3; ++i)
-					for (int j = 0; j<nEAS; ++j)
-						ar >> m_Kua[k](i, j);
-			for (int k = 0; k<neln; ++k)
-				for (int i = 0; i<3; ++i)
-					for (int j = 0; j<nEAS; ++j)
-						ar >> m_Kwa[k](i, j);
 			ar >> m_E;
 		}
 	}
@@ -62,6 +62,9 @@ public:
 	//! create 
 	void Create(int n) { m_data.assign(n, static_cast<FEMaterialPoint*>(0) ); }
 
+	//! exchange the state data with another state (no copies are made)
+	void swap(FEElementState& s) { m_data.swap(s.m_data); }
+
 	//! operator for easy access to element data
 	FEMaterialPoint*& operator [] (int n) { return m_data[n]; }
 
@@ -162,6 +165,9 @@ public:
 
 	// find local element index of node n    
     int FindNode(int n) const;
+
+	//! exchange the data of two elements (used when reordering elements)
+	void swap(FEElement& el);
    
 protected:
 	int		m_nID;		//!< element ID
@@ -243,6 +249,9 @@ public:
 	// TODO: This isn't used anywhere. Delete?    
 	int BackShellNodes() const;
 
+	//! exchange the data of two solid elements
+	void swap(FESolidElement& el);
+
 public:
 	vector<bool>    m_bitfc;    //!< flag for interface nodes
 	vector<mat3d>	m_J0i;		//!< inverse of reference Jacobian
@@ -485,16 +494,9 @@ public:
 	//! serialize data associated with this element
 	void Serialize(DumpStream &ar) override;
 	
-public: // EAS parameters
-
-	matrix          m_Kaai;
-	matrix          m_fa;
-	matrix          m_alpha;
-	matrix          m_alphat;
-	matrix          m_alphai;
-	vector<matrix>  m_Kua;
-	vector<matrix>  m_Kwa;
-	vector<mat3ds>  m_E;
+public:
+	// NOTE: The EAS parameters are stored by the EAS shell domain.
+	vector<mat3ds>  m_E;	//!< (enhanced) Green-Lagrange strain at integration points
 };
 
 //-----------------------------------------------------------------------------
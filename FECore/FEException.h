@@ -72,6 +72,15 @@ public:
 	char m_szerr[256];	// the error message
 };
 
+//! thrown when an element matrix that needs to be inverted is singular
+class FECORE_API SingularMatrix : public FEException
+{
+public:
+	SingularMatrix(int iel) : m_iel(iel) {}
+
+	int		m_iel;	// element ID
+};
+
 class FECORE_API EnergyDiverging : public FEException {};
 
 class FECORE_API MaxStiffnessReformations : public FEException {};
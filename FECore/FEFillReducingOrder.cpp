@@ -0,0 +1,466 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEFillReducingOrder.h"
+#include "FENodeNodeList.h"
+#include "FEMesh.h"
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <assert.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+FEFillReducingOrder::FEFillReducingOrder(int method) : m_method(method)
+{
+	m_leafSize = 128;
+	m_xadj = 0;
+	m_adj = 0;
+	m_label = 0;
+}
+
+//-----------------------------------------------------------------------------
+//! This function calculates the fill-reducing ordering of the nodes of a mesh.
+//! The new node number is stored in P. To be precise, P stores for each new
+//! node the old node that corresponds to this node (same as FENodeReorder).
+void FEFillReducingOrder::Apply(FEMesh& mesh, vector<int>& P)
+{
+	// create the node-node list
+	FENodeNodeList NL;
+	NL.Create(mesh);
+
+	// convert it to compressed format
+	int NN = mesh.Nodes();
+	vector<int> xadj(NN + 1);
+	xadj[0] = 0;
+	for (int i=0; i<NN; ++i) xadj[i+1] = xadj[i] + NL.Valence(i);
+
+	vector<int> adj(xadj[NN]);
+	for (int i=0; i<NN; ++i)
+	{
+		int nv = NL.Valence(i);
+		if (nv > 0)
+		{
+			int* pn = NL.NodeList(i);
+			for (int j=0; j<nv; ++j) adj[xadj[i] + j] = pn[j];
+		}
+	}
+
+	Apply(xadj, adj, P);
+}
+
+//-----------------------------------------------------------------------------
+void FEFillReducingOrder::Apply(const vector<int>& xadj, const vector<int>& adj, vector<int>& P)
+{
+	P.clear();
+	int N = (int)xadj.size() - 1;
+	if (N <= 0) return;
+	P.reserve(N);
+
+	m_xadj = &xadj[0];
+	m_adj = (adj.empty() ? 0 : &adj[0]);
+	m_mark.assign(N, 0);
+	m_level.assign(N, -1);
+	m_index.assign(N, -1);
+	m_label = 0;
+
+	vector<int> S(N);
+	for (int i=0; i<N; ++i) S[i] = i;
+
+	if (m_method == MINIMUM_DEGREE) MinimumDegree(S, P);
+	else NestedDissection(S, P);
+
+	assert((int)P.size() == N);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculate the level structure rooted at root. Only nodes of the current subgraph
+//! that have not been assigned a level yet are visited. On return, order contains 
+//! the visited nodes, sorted by level, and level l is stored in order[lptr[l]] to 
+//! order[lptr[l+1]-1].
+int FEFillReducingOrder::LevelStructure(int root, vector<int>& order, vector<int>& lptr)
+{
+	order.clear();
+	lptr.clear();
+
+	order.push_back(root);
+	m_level[root] = 0;
+	lptr.push_back(0);
+
+	int nlevels = 0;
+	size_t l0 = 0;
+	while (l0 < order.size())
+	{
+		size_t l1 = order.size();
+		++nlevels;
+		for (size_t k=l0; k<l1; ++k)
+		{
+			int i = order[k];
+			for (int j=m_xadj[i]; j<m_xadj[i+1]; ++j)
+			{
+				int m = m_adj[j];
+				if ((m_mark[m] == m_label) && (m_level[m] == -1))
+				{
+					m_level[m] = nlevels;
+					order.push_back(m);
+				}
+			}
+		}
+		lptr.push_back((int)l1);
+		l0 = l1;
+	}
+
+	return nlevels;
+}
+
+//-----------------------------------------------------------------------------
+//! Order the nodes in S with nested dissection. The subgraph is split into two 
+//! parts by a separator that is taken from a level structure rooted at a 
+//! pseudo-peripheral node. Both parts are ordered recursively and the separator
+//! nodes are numbered last.
+void FEFillReducingOrder::NestedDissection(const vector<int>& S, vector<int>& P)
+{
+	int n = (int)S.size();
+	if (n <= m_leafSize) { MinimumDegree(S, P); return; }
+
+	// label the nodes of this subgraph
+	int label = ++m_label;
+	for (int i=0; i<n; ++i) { m_mark[S[i]] = label; m_level[S[i]] = -1; }
+
+	// if the subgraph is not connected, we order each component separately
+	vector<int> order, lptr;
+	int nlevels = LevelStructure(S[0], order, lptr);
+	if ((int)order.size() < n)
+	{
+		vector< vector<int> > comp;
+		comp.push_back(order);
+		for (int i=0; i<n; ++i)
+		{
+			if (m_level[S[i]] == -1)
+			{
+				LevelStructure(S[i], order, lptr);
+				comp.push_back(order);
+			}
+		}
+		for (size_t i=0; i<comp.size(); ++i) NestedDissection(comp[i], P);
+		return;
+	}
+
+	// find a pseudo-peripheral node, i.e. a node with a deep level structure
+	vector<int> order2, lptr2;
+	for (int iter=0; iter<10; ++iter)
+	{
+		// pick the node with the lowest degree in the last level
+		int root = -1, dmin = 0;
+		for (int k=lptr[nlevels-1]; k<lptr[nlevels]; ++k)
+		{
+			int i = order[k];
+			int d = m_xadj[i+1] - m_xadj[i];
+			if ((root == -1) || (d < dmin)) { root = i; dmin = d; }
+		}
+
+		// the level structure of this node is at least as deep
+		for (int i=0; i<n; ++i) m_level[order[i]] = -1;
+		int nl2 = LevelStructure(root, order2, lptr2);
+		bool bdeeper = (nl2 > nlevels);
+		order.swap(order2);
+		lptr.swap(lptr2);
+		nlevels = nl2;
+		if (bdeeper == false) break;
+	}
+
+	// we can't split a graph with less than three levels
+	if (nlevels < 3) { MinimumDegree(S, P); return; }
+
+	// Pick the smallest level that leaves at least a quarter of the nodes on either side.
+	int msep = -1;
+	for (int l=1; l<nlevels-1; ++l)
+	{
+		int nlow  = lptr[l];
+		int nhigh = n - lptr[l+1];
+		if ((4*nlow >= n) && (4*nhigh >= n))
+		{
+			int ns = lptr[l+1] - lptr[l];
+			if ((msep == -1) || (ns < lptr[msep+1] - lptr[msep])) msep = l;
+		}
+	}
+
+	// if there is no such level, we use the median level
+	if (msep == -1)
+	{
+		msep = 1;
+		while ((msep < nlevels - 2) && (2*lptr[msep+1] < n)) ++msep;
+	}
+
+	// split the graph
+	vector<int> A, B, Sep;
+	for (int k=0; k<lptr[msep]; ++k) A.push_back(order[k]);
+	for (int k=lptr[msep]; k<lptr[msep+1]; ++k)
+	{
+		// separator nodes that are not connected to the next level are not needed
+		int i = order[k];
+		bool bsep = false;
+		for (int j=m_xadj[i]; j<m_xadj[i+1]; ++j)
+		{
+			int m = m_adj[j];
+			if ((m_mark[m] == label) && (m_level[m] == msep + 1)) { bsep = true; break; }
+		}
+		if (bsep) Sep.push_back(i); else A.push_back(i);
+	}
+	for (int k=lptr[msep+1]; k<n; ++k) B.push_back(order[k]);
+
+	// order the parts and number the separator last
+	NestedDissection(A, P);
+	NestedDissection(B, P);
+	for (size_t i=0; i<Sep.size(); ++i) P.push_back(Sep[i]);
+}
+//-----------------------------------------------------------------------------
+//! Order the nodes in S with the approximate minimum degree algorithm. 
+//! The elimination is done on the quotient graph, where each eliminated node 
+//! becomes an "element" that represents the clique that is formed by its neighbors.
+//! Elements that are adjacent to the pivot are absorbed by the new element. The degree
+//! of a node is approximated by the AMD bound |A_i| + |L_p\i| + sum |L_e\L_p|.
+//! Nodes with the same adjacency are merged into supervariables, which are 
+//! eliminated together.
+void FEFillReducingOrder::MinimumDegree(const vector<int>& S, vector<int>& P)
+{
+	int n = (int)S.size();
+	if (n == 0) return;
+
+	// label the nodes and set the local numbering
+	int label = ++m_label;
+	for (int i=0; i<n; ++i) { m_mark[S[i]] = label; m_index[S[i]] = i; }
+
+	// A = adjacent variables, E = adjacent elements, L = variables of element
+	vector< vector<int> > A(n), E(n), L(n);
+	vector<int> deg(n);
+	for (int i=0; i<n; ++i)
+	{
+		int gi = S[i];
+		for (int j=m_xadj[gi]; j<m_xadj[gi+1]; ++j)
+		{
+			int m = m_adj[j];
+			if (m_mark[m] == label) A[i].push_back(m_index[m]);
+		}
+		deg[i] = (int)A[i].size();
+	}
+
+	// state: 0 = variable, 1 = element, 2 = absorbed element, 3 = merged into a supervariable
+	vector<char> state(n, 0);
+	vector<int> nv(n, 1);		// supervariable weights
+	vector<int> next(n, -1);	// list of variables that are merged into a supervariable
+	vector<int> last(n);		// last variable of this list
+	for (int i=0; i<n; ++i) last[i] = i;
+	vector<int> lw(n, 0);		// weight of elements
+	vector<int> w(n, -1);		// |L_e \ L_p| (weighted)
+	vector<int> flag(n, 0);		// marks the variables of L_p
+	vector<int> tag(n, 0);		// used for comparing adjacency lists
+	int ntag = 0;
+
+	typedef pair<int, int> DegNode;
+	priority_queue<DegNode, vector<DegNode>, greater<DegNode> > Q;
+	for (int i=0; i<n; ++i) Q.push(DegNode(deg[i], i));
+
+	vector<int> Lp;
+	vector<DegNode> hashes;
+	int nelim = 0;
+	while (nelim < n)
+	{
+		// get the variable with the lowest degree (the queue can contain old entries)
+		int p = -1;
+		while (p == -1)
+		{
+			DegNode t = Q.top(); Q.pop();
+			if ((state[t.second] == 0) && (deg[t.second] == t.first)) p = t.second;
+		}
+
+		// eliminate the supervariable
+		state[p] = 1;
+		for (int i = p; i != -1; i = next[i]) P.push_back(S[i]);
+		nelim += nv[p];
+
+		// form the new element from the adjacent variables and elements of p
+		Lp.clear();
+		int wp = 0;
+		flag[p] = 1;
+		for (size_t j=0; j<A[p].size(); ++j)
+		{
+			int v = A[p][j];
+			if ((state[v] == 0) && (flag[v] == 0)) { flag[v] = 1; Lp.push_back(v); wp += nv[v]; }
+		}
+		for (size_t j=0; j<E[p].size(); ++j)
+		{
+			int e = E[p][j];
+			if (state[e] != 1) continue;
+			for (size_t l=0; l<L[e].size(); ++l)
+			{
+				int v = L[e][l];
+				if ((state[v] == 0) && (flag[v] == 0)) { flag[v] = 1; Lp.push_back(v); wp += nv[v]; }
+			}
+			state[e] = 2;
+			vector<int>().swap(L[e]);
+		}
+		vector<int>().swap(A[p]);
+		vector<int>().swap(E[p]);
+
+		// update the adjacency of the variables in L_p
+		for (size_t j=0; j<Lp.size(); ++j)
+		{
+			int i = Lp[j];
+
+			// remove absorbed elements and add the new element
+			vector<int>& Ei = E[i];
+			int ne = 0;
+			for (size_t l=0; l<Ei.size(); ++l) if (state[Ei[l]] == 1) Ei[ne++] = Ei[l];
+			Ei.resize(ne);
+			Ei.push_back(p);
+
+			// remove variables that are eliminated or that are in the new element
+			vector<int>& Ai = A[i];
+			int na = 0;
+			for (size_t l=0; l<Ai.size(); ++l)
+			{
+				int v = Ai[l];
+				if ((state[v] == 0) && (flag[v] == 0)) Ai[na++] = v;
+			}
+			Ai.resize(na);
+		}
+
+		// find the indistinguishable variables (same adjacent variables and elements)
+		// and merge them into supervariables
+		hashes.resize(Lp.size());
+		for (size_t j=0; j<Lp.size(); ++j)
+		{
+			int i = Lp[j];
+			unsigned int h = 0;
+			for (size_t l=0; l<A[i].size(); ++l) h += A[i][l];
+			for (size_t l=0; l<E[i].size(); ++l) h += E[i][l];
+			hashes[j] = DegNode((int)(h % (unsigned int)n), i);
+		}
+		sort(hashes.begin(), hashes.end());
+		for (size_t j0=0; j0<hashes.size(); )
+		{
+			size_t j1 = j0 + 1;
+			while ((j1 < hashes.size()) && (hashes[j1].first == hashes[j0].first)) ++j1;
+			for (size_t a=j0; a<j1; ++a)
+			{
+				int i = hashes[a].second;
+				if (state[i] != 0) continue;
+				++ntag;
+				for (size_t l=0; l<A[i].size(); ++l) tag[A[i][l]] = ntag;
+				for (size_t l=0; l<E[i].size(); ++l) tag[E[i][l]] = ntag;
+				for (size_t b=a+1; b<j1; ++b)
+				{
+					int k = hashes[b].second;
+					if ((state[k] != 0) || (A[k].size() != A[i].size()) || (E[k].size() != E[i].size())) continue;
+					bool bsame = true;
+					for (size_t l=0; bsame && (l<A[k].size()); ++l) if (tag[A[k][l]] != ntag) bsame = false;
+					for (size_t l=0; bsame && (l<E[k].size()); ++l) if (tag[E[k][l]] != ntag) bsame = false;
+					if (bsame)
+					{
+						// merge k into i
+						nv[i] += nv[k];
+						nv[k] = 0;
+						state[k] = 3;
+						next[last[i]] = k;
+						last[i] = last[k];
+						vector<int>().swap(A[k]);
+						vector<int>().swap(E[k]);
+					}
+				}
+			}
+			j0 = j1;
+		}
+
+		// remove the merged variables from the new element
+		int nl = 0;
+		for (size_t j=0; j<Lp.size(); ++j)
+		{
+			if (state[Lp[j]] == 0) Lp[nl++] = Lp[j];
+			else flag[Lp[j]] = 0;
+		}
+		Lp.resize(nl);
+
+		// calculate w(e) = |L_e \ L_p| for all elements adjacent to L_p
+		for (size_t j=0; j<Lp.size(); ++j)
+		{
+			int i = Lp[j];
+			vector<int>& Ei = E[i];
+			for (size_t l=0; l<Ei.size(); ++l)
+			{
+				int e = Ei[l];
+				if (e == p) continue;
+				if (w[e] < 0) w[e] = lw[e];
+				w[e] -= nv[i];
+			}
+		}
+
+		// update the degrees of the variables in L_p
+		int nleft = n - nelim;
+		for (size_t j=0; j<Lp.size(); ++j)
+		{
+			int i = Lp[j];
+
+			// external degree of adjacent elements
+			// (elements that are contained in the new element are absorbed)
+			vector<int>& Ei = E[i];
+			int ne = 0, dext = 0;
+			for (size_t l=0; l<Ei.size(); ++l)
+			{
+				int e = Ei[l];
+				if (e == p) { Ei[ne++] = e; continue; }
+				if (state[e] != 1) continue;
+				if (w[e] <= 0) { state[e] = 2; vector<int>().swap(L[e]); }
+				else { Ei[ne++] = e; dext += w[e]; }
+			}
+			Ei.resize(ne);
+
+			int da = 0;
+			for (size_t l=0; l<A[i].size(); ++l) da += nv[A[i][l]];
+
+			// approximate external degree
+			int d = da + (wp - nv[i]) + dext;
+			if (d > nleft - nv[i]) d = nleft - nv[i];
+			deg[i] = d;
+			Q.push(DegNode(d, i));
+		}
+
+		// reset work arrays
+		for (size_t j=0; j<Lp.size(); ++j)
+		{
+			int i = Lp[j];
+			flag[i] = 0;
+			vector<int>& Ei = E[i];
+			for (size_t l=0; l<Ei.size(); ++l) w[Ei[l]] = -1;
+		}
+		flag[p] = 0;
+
+		L[p] = Lp;
+		lw[p] = wp;
+	}
+}
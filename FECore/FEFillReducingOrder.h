@@ -0,0 +1,99 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+class FEMesh;
+
+//-----------------------------------------------------------------------------
+//! Node orderings that can be used for numbering the equations.
+//! (This is set with the equation_order parameter in the Control section.)
+enum EQUATION_ORDER
+{
+	EQ_ORDER_DEFAULT,		//!< input order (or bandwidth reduction when optimize_bw is set)
+	EQ_ORDER_ND,			//!< nested dissection
+	EQ_ORDER_AMD			//!< approximate minimum degree
+};
+
+//-----------------------------------------------------------------------------
+//! This class calculates a fill-reducing ordering of the nodes of a mesh.
+
+//! Unlike FENodeReorder, which minimizes the bandwidth (and is best suited for
+//! the skyline solver), this class tries to minimize the fill-in of a general sparse
+//! factorization. The ordering is calculated on the node-node graph, so all the
+//! degrees of freedom of a node remain together.
+//! Two methods are available:
+//! - nested dissection: the graph is recursively split with level-structure
+//!   separators. The separators are numbered last and small subgraphs are ordered
+//!   with the minimum degree algorithm.
+//! - approximate minimum degree: minimum degree ordering on the quotient graph
+//!   using the approximate external degree of Amestoy, Davis and Duff.
+class FECORE_API FEFillReducingOrder
+{
+public:
+	enum Method {
+		NESTED_DISSECTION,
+		MINIMUM_DEGREE
+	};
+
+public:
+	//! constructor
+	FEFillReducingOrder(int method = NESTED_DISSECTION);
+
+	//! set the size below which subgraphs are ordered with minimum degree (nested dissection only)
+	void SetLeafSize(int n) { m_leafSize = n; }
+
+	//! calculates the permutation vector for a mesh
+	//! (P stores for each new node the old node that corresponds to it)
+	void Apply(FEMesh& mesh, std::vector<int>& P);
+
+	//! calculates the permutation vector for a graph in compressed format
+	//! (the neighbors of node i are adj[xadj[i]] to adj[xadj[i+1]-1])
+	void Apply(const std::vector<int>& xadj, const std::vector<int>& adj, std::vector<int>& P);
+
+private:
+	void NestedDissection(const std::vector<int>& S, std::vector<int>& P);
+	void MinimumDegree   (const std::vector<int>& S, std::vector<int>& P);
+
+	// breadth-first search on the current subgraph. Returns the number of levels.
+	int LevelStructure(int root, std::vector<int>& order, std::vector<int>& lptr);
+
+private:
+	int		m_method;		//!< ordering method
+	int		m_leafSize;		//!< max size of subgraphs that are not split further
+
+	const int*	m_xadj;		//!< graph structure
+	const int*	m_adj;
+
+	std::vector<int>	m_mark;		//!< subgraph label of each node
+	std::vector<int>	m_level;	//!< level of each node in the current level structure
+	std::vector<int>	m_index;	//!< local index of each node in the current subgraph
+	int					m_label;	//!< current subgraph label
+};
@@ -36,7 +36,9 @@ FEGlobalMatrix::FEGlobalMatrix(SparseMatrix* pK)
 	m_pA = pK;
 	m_LM.resize(MAX_LM_SIZE);
 	m_pMP = 0;
+	m_pMPa = 0;
 	m_nlm = 0;
+	m_maxSlack = 0.1;
 }
 
 //-----------------------------------------------------------------------------
@@ -46,6 +48,7 @@ FEGlobalMatrix::~FEGlobalMatrix()
 	delete m_pA;
 	m_pA = 0;
 	if (m_pMP) delete m_pMP;
+	if (m_pMPa) delete m_pMPa;
 }
 
 //-----------------------------------------------------------------------------
@@ -116,10 +119,15 @@ void FEGlobalMatrix::build_end()
 {
 	if (m_nlm > 0) build_flush();
 	m_pA->Create(*m_pMP);
+
+	// keep the profile so we can check later if a new profile fits in this matrix
+	if (m_pMPa) delete m_pMPa;
+	m_pMPa = m_pMP;
+	m_pMP = 0;
 }
 
 //-----------------------------------------------------------------------------
-bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
+void FEGlobalMatrix::BuildProfile(FEModel* pfem, int neq, bool breset)
 {
 	// The first time we come here we build the "static" profile.
 	// This static profile stores the contribution to the matrix profile
@@ -160,6 +168,15 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		// Add the "dynamic" profile
 		pfem->BuildMatrixProfile(*this, false);
 	}
+	if (m_nlm > 0) build_flush();
+}
+
+//-----------------------------------------------------------------------------
+bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
+{
+	// build the profile
+	BuildProfile(pfem, neq, breset);
+
 	// All done! We can now finish building the profile and create 
 	// the actual sparse matrix. This is done in the following function
 	build_end();
@@ -167,6 +184,46 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// When contact pairs change, only the "dynamic" part of the profile changes,
+// which is usually small. If the new profile fits in the current matrix we keep
+// the matrix. Entries that are no longer used are simply zero.
+bool FEGlobalMatrix::UpdateProfile(FEModel* pfem, int neq, bool breset)
+{
+	// build the new profile
+	BuildProfile(pfem, neq, breset);
+
+	// we need a matrix of the same size
+	if ((m_pMPa == 0) || (m_pA->NonZeroes() == 0) || (m_pMPa->Rows() != neq)) return false;
+
+	if (m_pMPa->Contains(*m_pMP))
+	{
+		// Within a time step (breset = false) we keep the matrix as long as the profile fits.
+		// At the start of a time step we only keep it if not too many entries are unused.
+		if (breset == false) return true;
+
+		double nnz0 = (double) m_pMPa->NonZeroes();
+		double nnz1 = (double) m_pMP->NonZeroes();
+		if (nnz0 - nnz1 <= m_maxSlack*nnz0) return true;
+	}
+	else if (breset == false)
+	{
+		// The profile grew. We keep the entries of the current matrix so that
+		// when contact pairs separate and reconnect the new profile still fits.
+		m_pMP->Merge(*m_pMPa);
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool FEGlobalMatrix::CreateFromProfile()
+{
+	if (m_pMP == 0) return false;
+	build_end();
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Constructs the stiffness matrix from a FEMesh object. 
 bool FEGlobalMatrix::Create(FEMesh& mesh, int neq)
@@ -63,6 +63,17 @@ public:
 	//! construct the stiffness matrix from a FEM object
 	bool Create(FEModel* pfem, int neq, bool breset);
 
+	//! Build the matrix profile from a FEM object and see if it fits in the current sparse matrix.
+	//! If it does, true is returned and the current matrix (and the linear solver's ordering)
+	//! can be reused. Otherwise, the matrix must be recreated with CreateFromProfile.
+	bool UpdateProfile(FEModel* pfem, int neq, bool breset);
+
+	//! create the sparse matrix from the profile that was built in UpdateProfile
+	bool CreateFromProfile();
+
+	//! set the max fraction of unused entries that is tolerated when reusing the matrix
+	void SetMaxSlack(double f) { m_maxSlack = f; }
+
 	//! construct the stiffness matrix from a mesh
 	bool Create(FEMesh& mesh, int neq);
 
@@ -99,6 +110,9 @@ public:
 	void build_end();
 	void build_flush();
 
+protected:
+	void BuildProfile(FEModel* pfem, int neq, bool breset);
+
 protected:
 	SparseMatrix*	m_pA;	//!< the actual global stiffness matrix
 
@@ -106,7 +120,9 @@ protected:
 	// build the profile of the sparse matrix
 
 	SparseMatrixProfile*	m_pMP;		//!< profile of sparse matrix
+	SparseMatrixProfile*	m_pMPa;		//!< profile that was used to create the sparse matrix
 	SparseMatrixProfile		m_MPs;		//!< the "static" part of the matrix profile
+	double					m_maxSlack;	//!< max fraction of unused entries when reusing the matrix
 	vector< vector<int> >	m_LM;		//!< used for building the stiffness matrix
 	int	m_nlm;				//!< nr of elements in m_LM array
 };
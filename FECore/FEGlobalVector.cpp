@@ -28,46 +28,186 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEGlobalVector.h"
 #include "vec3d.h"
+#include "FEModel.h"
+#include <assert.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+FEAssemblyBuffer::FEAssemblyBuffer()
+{
+	m_neq = 0;
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEAssemblyBuffer::Clear()
+{
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEAssemblyBuffer::Init(FEMesh& mesh, int neq)
+{
+#ifdef _OPENMP
+	int nt = omp_get_max_threads();
+#else
+	int nt = 1;
+#endif
+	// find the prescribed equations
+	m_pr.assign(neq, -1);
+	m_eq.clear();
+	for (int i=0; i<mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		for (int j=0; j<(int)node.m_ID.size(); ++j)
+		{
+			int n = -node.m_ID[j] - 2;
+			if ((n >= 0) && (n < neq) && (m_pr[n] == -1))
+			{
+				m_pr[n] = (int) m_eq.size();
+				m_eq.push_back(n);
+			}
+		}
+	}
+
+	m_neq = neq;
+	m_buf.assign(nt, vector<double>(neq + m_eq.size(), 0.0));
+	m_bvalid = true;
+}
 
 //-----------------------------------------------------------------------------
 FEGlobalVector::FEGlobalVector(FEModel& fem, vector<double>& R, vector<double>& Fr) : m_fem(fem), m_R(R), m_Fr(Fr)
 {
+	m_pbuf = 0;
 }
 
 //-----------------------------------------------------------------------------
 FEGlobalVector::~FEGlobalVector()
 {
+	// An exception was thrown during a parallel assembly. The buffers
+	// were not zeroed, so they have to be set up again.
+	if (m_pbuf) m_pbuf->Clear();
+}
 
+//-----------------------------------------------------------------------------
+void FEGlobalVector::BeginParallelAssembly(FEAssemblyBuffer& buf)
+{
+	assert(m_pbuf == 0);
+#ifdef _OPENMP
+	int nt = omp_get_max_threads();
+#else
+	int nt = 1;
+#endif
+	// the buffers are zeroed by EndParallelAssembly, so they are only
+	// set up again when the equations or the number of threads change.
+	int neq = (int) m_R.size();
+	if ((buf.m_bvalid == false) || (buf.m_neq != neq) || ((int) buf.m_buf.size() != nt)) buf.Init(m_fem.GetMesh(), neq);
+	m_pbuf = &buf;
 }
 
 //-----------------------------------------------------------------------------
-void FEGlobalVector::Assemble(vector<int>& en, vector<int>& elm, vector<double>& fe, bool bdom)
+void FEGlobalVector::EndParallelAssembly()
 {
-	vector<double>& R = m_R;
+	assert(m_pbuf);
+	vector< vector<double> >& buf = m_pbuf->m_buf;
+	vector<int>& eq = m_pbuf->m_eq;
+	m_pbuf = 0;
 
-	// assemble the element residual into the global residual
-	int ndof = fe.size();
-	for (int i=0; i<ndof; ++i)
+	const int nt = (int) buf.size();
+	const int neq = (int) m_R.size();
+	const int nfr = (int) m_Fr.size();
+	const int N = neq + (int) eq.size();
+
+	// the threads each sum a part of the buffers
+	#pragma omp parallel for
+	for (int i=0; i<N; ++i)
 	{
-		int I = elm[i];
-		if ( I >= 0) {
+		double r = 0.0;
+		for (int n=0; n<nt; ++n) { double& b = buf[n][i]; r += b; b = 0.0; }
+		if (i < neq) m_R[i] += r;
+		else
+		{
+			int k = eq[i - neq];
+			if (k < nfr) m_Fr[k] -= r;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEGlobalVector::AssembleVector(vector<int>& elm, vector<double>& fe)
+{
+	const int ndof = (int) fe.size();
+	if (m_pbuf)
+	{
+#ifdef _OPENMP
+		vector<double>& buf = m_pbuf->m_buf[omp_get_thread_num()];
+#else
+		vector<double>& buf = m_pbuf->m_buf[0];
+#endif
+		const vector<int>& pr = m_pbuf->m_pr;
+		const int neq = m_pbuf->m_neq;
+		for (int i=0; i<ndof; ++i)
+		{
+			int I = elm[i];
+			int n = -I-2;
+			if (I >= 0) buf[I] += fe[i];
+			else if ((n >= 0) && (n < neq) && (pr[n] >= 0)) buf[neq + pr[n]] += fe[i];
+			else if (n >= 0) {
+				// not a prescribed equation of the mesh
 #pragma omp atomic
-			R[I] += fe[i];
+				m_Fr[n] -= fe[i];
+			}
 		}
+	}
+	else
+	{
+		vector<double>& R = m_R;
+		for (int i=0; i<ndof; ++i)
+		{
+			int I = elm[i];
+			if ( I >= 0) {
+#pragma omp atomic
+				R[I] += fe[i];
+			}
 // TODO: Find another way to store reaction forces
-		else if (-I-2 >= 0) {
+			else if (-I-2 >= 0) {
 #pragma omp atomic
-			m_Fr[-I-2] -= fe[i];
+				m_Fr[-I-2] -= fe[i];
+			}
 		}
 	}
 }
 
+//-----------------------------------------------------------------------------
+void FEGlobalVector::Assemble(vector<int>& en, vector<int>& elm, vector<double>& fe, bool bdom)
+{
+	// assemble the element residual into the global residual
+	AssembleVector(elm, fe);
+}
+
 //-----------------------------------------------------------------------------
 //! \todo This function does not add to m_Fr. Is this a problem?
 void FEGlobalVector::Assemble(vector<int>& lm, vector<double>& fe)
 {
-	vector<double>& R = m_R;
 	const int n = (int) lm.size();
+	if (m_pbuf)
+	{
+#ifdef _OPENMP
+		vector<double>& buf = m_pbuf->m_buf[omp_get_thread_num()];
+#else
+		vector<double>& buf = m_pbuf->m_buf[0];
+#endif
+		for (int i=0; i<n; ++i)
+		{
+			int nid = lm[i];
+			if (nid >= 0) buf[nid] += fe[i];
+		}
+		return;
+	}
+
+	vector<double>& R = m_R;
 	for (int i=0; i<n; ++i)
 	{
 		int nid = lm[i];
@@ -31,6 +31,34 @@ SOFTWARE.*/
 using namespace std;
 
 class FEModel;
+class FEMesh;
+
+//-----------------------------------------------------------------------------
+//! Per-thread buffers for a parallel assembly of a global vector. This is owned
+//! by the solver so that the buffers are allocated once and reused by each
+//! residual evaluation. Each buffer stores the residual, followed by the reaction
+//! forces of the prescribed equations.
+class FECORE_API FEAssemblyBuffer
+{
+public:
+	FEAssemblyBuffer();
+
+	//! Invalidate the buffers. Call this when the equation numbers change.
+	void Clear();
+
+private:
+	//! Allocate the buffers for the current equation numbers of the mesh
+	void Init(FEMesh& mesh, int neq);
+
+private:
+	vector< vector<double> >	m_buf;	//!< per-thread buffers
+	vector<int>		m_pr;		//!< index of a prescribed equation in the reaction part (or -1)
+	vector<int>		m_eq;		//!< prescribed equation of each reaction entry
+	int				m_neq;		//!< number of equations
+	bool			m_bvalid;	//!< the buffers match the equation numbers
+
+	friend class FEGlobalVector;
+};
 
 //-----------------------------------------------------------------------------
 //! This class represents a global system array. It provides functions to assemble
@@ -59,8 +87,27 @@ public:
 	//! get the size of the vector
 	int Size() const { return (int) m_R.size(); }
 
+public:
+	//! Start a parallel assembly. Until EndParallelAssembly is called, the
+	//! contributions to the residual and the reaction forces are collected in
+	//! the per-thread buffers, so that Assemble can be called from an element loop
+	//! without atomics. Must be called outside parallel regions.
+	void BeginParallelAssembly(FEAssemblyBuffer& buf);
+
+	//! Add the per-thread buffers to the residual and the reaction forces and
+	//! zero them. Must be called outside parallel regions.
+	void EndParallelAssembly();
+
+protected:
+	//! Add the element vector to the residual (equation numbers >= 0)
+	//! and to the reaction forces (equation numbers <= -2)
+	void AssembleVector(vector<int>& elm, vector<double>& fe);
+
 protected:
 	FEModel&			m_fem;	//!< model
 	vector<double>&		m_R;	//!< residual
 	vector<double>&		m_Fr;	//!< nodal reaction forces \todo I want to remove this
+
+private:
+	FEAssemblyBuffer*	m_pbuf;	//!< buffers of the active parallel assembly (or null)
 };
@@ -31,7 +31,6 @@ SOFTWARE.*/
 #include "LinearSolver.h"
 #include "FEGlobalMatrix.h"
 #include "log.h"
-#include "FENodeReorder.h"
 #include "FELinearSystem.h"
 #include "BC.h"
 
@@ -162,42 +161,21 @@ bool FELinearSolver::InitEquations()
 	int ndof = m_dof.size();
 	if (ndof == 0) return false;
 
-	// see if we need to optimize the bandwidth
-	if (m_fem.OptimizeBandwidth())
-	{
-		// reorder the node numbers
-		vector<int> P(mesh.Nodes());
-		FENodeReorder mod;
-		mod.Apply(mesh, P);
+	// get the order in which the nodes are numbered (bandwidth or fill-reducing ordering)
+	vector<int> P;
+	bool border = EquationNodeOrder(P);
 
-		// set the equation numbers
-		for (int i=0; i<mesh.Nodes(); ++i)
-		{
-			FENode& node = mesh.Node(P[i]);
-			for (int j=0; j<ndof; ++j)
-			{
-				int dofj = m_dof[j];
-				if      (node.m_ID[dofj] == DOF_FIXED     ) { node.m_ID[dofj] = -1; }
-				else if (node.m_ID[dofj] == DOF_OPEN      ) { node.m_ID[dofj] =  neq++; }
-				else if (node.m_ID[dofj] == DOF_PRESCRIBED) { node.m_ID[dofj] = -neq-2; neq++; }
-				else { assert(false); return false; }
-			}
-		}
-	}
-	else
+	// give all free dofs an equation number
+	for (int i=0; i<mesh.Nodes(); ++i)
 	{
-		// give all free dofs an equation number
-		for (int i=0; i<mesh.Nodes(); ++i)
+		FENode& node = mesh.Node(border ? P[i] : i);
+		for (int j=0; j<ndof; ++j)
 		{
-			FENode& node = mesh.Node(i);
-			for (int j=0; j<ndof; ++j)
-			{
-				int dofj = m_dof[j];
-				if      (node.m_ID[dofj] == DOF_FIXED     ) { node.m_ID[dofj] = -1; }
-				else if (node.m_ID[dofj] == DOF_OPEN      ) { node.m_ID[dofj] =  neq++; }
-				else if (node.m_ID[dofj] == DOF_PRESCRIBED) { node.m_ID[dofj] = -neq-2; neq++; }
-				else { assert(false); return false; }
-			}
+			int dofj = m_dof[j];
+			if      (node.m_ID[dofj] == DOF_FIXED     ) { node.m_ID[dofj] = -1; }
+			else if (node.m_ID[dofj] == DOF_OPEN      ) { node.m_ID[dofj] =  neq++; }
+			else if (node.m_ID[dofj] == DOF_PRESCRIBED) { node.m_ID[dofj] = -neq-2; neq++; }
+			else { assert(false); return false; }
 		}
 	}
 
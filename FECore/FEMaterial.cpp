@@ -49,7 +49,6 @@ bool MaterialError(const char* szfmt, ...)
 //-----------------------------------------------------------------------------
 FEMaterial::FEMaterial(FEModel* pfem) : FECoreBase(FEMATERIAL_ID), m_pfem(pfem)
 {
-	static int n = 1;
 	m_nRB = -1;
 
 	AddProperty(&m_map, "mat_axis", 0);
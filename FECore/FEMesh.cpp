@@ -861,6 +861,102 @@ int FEMesh::RemoveIsolatedVertices()
 	return ni;
 }
 
+//-----------------------------------------------------------------------------
+//! Reorder the nodes of the mesh. P stores for each new node index the old
+//! index of the node. All node indices stored in the mesh (elements, node sets,
+//! facet sets, etc.) are updated. The node IDs are not changed, so the model still
+//! reads and writes the same IDs. 
+//! This must be called before the mesh is initialized, since the domains'
+//! local node lists are not updated.
+void FEMesh::PermuteNodes(const vector<int>& P)
+{
+	int NN = Nodes();
+	assert(P.size() == NN);
+
+	// Q is the inverse permutation, i.e. the new index of each old node
+	vector<int> Q(NN, -1);
+	for (int i=0; i<NN; ++i) Q[P[i]] = i;
+
+	// reorder the nodes
+	vector<FENode> newNode(NN);
+	for (int i=0; i<NN; ++i) newNode[i] = m_Node[P[i]];
+	m_Node.swap(newNode);
+
+	// update the element connectivity
+	for (int i=0; i<Domains(); ++i)
+	{
+		FEDomain& dom = Domain(i);
+		for (int j=0; j<dom.Elements(); ++j)
+		{
+			FEElement& el = dom.ElementRef(j);
+			for (int k=0; k<el.Nodes(); ++k) el.m_node[k] = Q[el.m_node[k]];
+		}
+	}
+	for (int i=0; i<Surfaces(); ++i)
+	{
+		FESurface& surf = Surface(i);
+		for (int j=0; j<surf.Elements(); ++j)
+		{
+			FEElement& el = surf.ElementRef(j);
+			for (int k=0; k<el.Nodes(); ++k) el.m_node[k] = Q[el.m_node[k]];
+		}
+	}
+	for (int i=0; i<Edges(); ++i)
+	{
+		FEEdge& edge = Edge(i);
+		for (int j=0; j<edge.Elements(); ++j)
+		{
+			FEElement& el = edge.ElementRef(j);
+			for (int k=0; k<el.Nodes(); ++k) el.m_node[k] = Q[el.m_node[k]];
+		}
+	}
+
+	// update the node sets
+	for (int i=0; i<NodeSets(); ++i)
+	{
+		vector<int>& ns = NodeSet(i)->GetNodeList();
+		for (size_t j=0; j<ns.size(); ++j) ns[j] = Q[ns[j]];
+	}
+
+	// update the facet sets
+	for (int i=0; i<FacetSets(); ++i)
+	{
+		FEFacetSet& fs = FacetSet(i);
+		for (int j=0; j<fs.Faces(); ++j)
+		{
+			FEFacetSet::FACET& f = fs.Face(j);
+			for (int k=0; k<f.ntype; ++k) f.node[k] = Q[f.node[k]];
+		}
+	}
+
+	// update the segment sets
+	for (int i=0; i<SegmentSets(); ++i)
+	{
+		FESegmentSet& ss = SegmentSet(i);
+		for (int j=0; j<ss.Segments(); ++j)
+		{
+			FESegmentSet::SEGMENT& s = ss.Segment(j);
+			for (int k=0; k<s.ntype; ++k) s.node[k] = Q[s.node[k]];
+		}
+	}
+
+	// update the discrete sets
+	for (int i=0; i<DiscreteSets(); ++i)
+	{
+		FEDiscreteSet& ds = DiscreteSet(i);
+		for (int j=0; j<ds.size(); ++j)
+		{
+			FEDiscreteSet::NodePair& p = ds.Element(j);
+			p.n0 = Q[p.n0];
+			p.n1 = Q[p.n1];
+		}
+	}
+
+	// the look-up tables are no longer valid
+	m_NEL.Clear();
+	if (m_LUT) delete m_LUT; m_LUT = 0;
+}
+
 //-----------------------------------------------------------------------------
 void FEMesh::InitShells()
 {
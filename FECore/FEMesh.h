@@ -193,6 +193,7 @@ public:
 	const char* GetName() const { return m_szname; }
 
 	const NodePair& Element(int i) const { return m_pair[i]; }	
+	NodePair& Element(int i) { return m_pair[i]; }
 
 	void Serialize(DumpStream& ar);
 
@@ -389,6 +390,9 @@ public:
 	//! remove isolated vertices
 	int RemoveIsolatedVertices();
 
+	//! reorder the nodes so that node i becomes node P[i] (node IDs are not changed)
+	void PermuteNodes(const vector<int>& P);
+
 	//! Reset the mesh data
 	void Reset();
 
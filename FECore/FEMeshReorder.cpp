@@ -0,0 +1,95 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEMeshReorder.h"
+#include "FENodeReorder.h"
+#include "FESolidDomain.h"
+#include "FEMesh.h"
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+FEMeshReorder::FEMeshReorder()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+//! Reorder the nodes and the solid elements of the mesh.
+bool FEMeshReorder::Apply(FEMesh& mesh)
+{
+	int NN = mesh.Nodes();
+	if (NN == 0) return false;
+
+	// calculate the new node order
+	// P stores for each new node the old node index
+	vector<int> P;
+	FENodeReorder bw;
+	bw.Apply(mesh, P);
+
+	// make sure we got a valid permutation
+	if ((int)P.size() != NN) return false;
+	vector<int> Q(NN, -1);
+	for (int i=0; i<NN; ++i)
+	{
+		int n = P[i];
+		if ((n < 0) || (n >= NN) || (Q[n] != -1)) return false;
+		Q[n] = i;
+	}
+
+	// Sort the elements of each solid domain by the lowest new node number of
+	// the element. This way the elements are visited in the same order as the nodes,
+	// and elements that share nodes end up close together.
+	// NOTE: This is done before the nodes are permuted, since the elements still
+	// reference the old node indices (and Q maps them to the new ones).
+	for (int nd=0; nd<mesh.Domains(); ++nd)
+	{
+		FESolidDomain* dom = dynamic_cast<FESolidDomain*>(&mesh.Domain(nd));
+		if (dom == 0) continue;
+
+		int NE = dom->Elements();
+		vector<pair<int,int> > key(NE);
+		for (int i=0; i<NE; ++i)
+		{
+			FESolidElement& el = dom->Element(i);
+			int nmin = NN;
+			for (int j=0; j<el.Nodes(); ++j) nmin = min(nmin, Q[el.m_node[j]]);
+			key[i] = pair<int,int>(nmin, i);
+		}
+		sort(key.begin(), key.end());
+
+		vector<int> E(NE);
+		for (int i=0; i<NE; ++i) E[i] = key[i].second;
+		dom->PermuteElements(E);
+	}
+
+	// reorder the nodes
+	mesh.PermuteNodes(P);
+
+	return true;
+}
@@ -0,0 +1,53 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+class FEMesh;
+
+//-----------------------------------------------------------------------------
+//! This class reorders the nodes and elements of a mesh for better memory locality.
+
+//! Meshes that are exported from meshing tools often store nodes and elements
+//! in a (nearly) random order, which means that element loops gather the nodal
+//! data from all over memory. This class renumbers the nodes with the reverse
+//! Cuthill-McKee type ordering of FENodeReorder, and then sorts the elements of
+//! each solid domain so that neighboring elements are stored close together. The node
+//! and element IDs are not changed, so input and output still use the user's IDs.
+//! This must be applied before the model is initialized.
+class FECORE_API FEMeshReorder
+{
+public:
+	//! constructor
+	FEMeshReorder();
+
+	//! reorder the mesh (returns false if the mesh was not modified)
+	bool Apply(FEMesh& mesh);
+};
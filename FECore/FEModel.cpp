@@ -48,6 +48,8 @@ SOFTWARE.*/
 #include "FEDataArray.h"
 #include "FESurfaceConstraint.h"
 #include "FEMathValue.h"
+#include "FEProfiler.h"
+#include "Timer.h"
 #include <string>
 #include <map>
 using namespace std;
@@ -64,6 +66,8 @@ public:
 		m_nStep = -1;
 		m_ftime0 = 0;
 		m_bwopt = 0;
+		m_breorder = 0;
+		m_eqorder = 0;
 
 		// additional data
 		m_linearSolver = FECoreKernel::m_ndefault_solver;
@@ -73,6 +77,14 @@ public:
 
 		// create the linear constraint manager
 		m_LCM = new FELinearConstraintManager(fem);
+
+		m_plog = 0;
+
+		// the profiler of this model uses the settings of the profiler
+		// of the calling thread (e.g. set on the command line)
+		FEProfiler& prf = FEProfiler::GetInstance();
+		m_prf.SetTraceFile(prf.GetTraceFile());
+		m_prf.Enable(prf.IsEnabled());
 	}
 
 public:
@@ -93,6 +105,8 @@ public: // TODO: Find a better place for these parameters
 	int		m_linearSolver;			//!< type of (linear) solver selected
 
 	int			m_bwopt;			//!< bandwidth optimization flag
+	int			m_breorder;			//!< reorder mesh for memory locality
+	int			m_eqorder;			//!< fill-reducing equation order (see EQUATION_ORDER)
 	FETimeInfo	m_timeInfo;			//!< current time value
 	double		m_ftime0;			//!< start time of current step
 
@@ -135,6 +149,13 @@ public:
 	// linear constraint data
 	FELinearConstraintManager*	m_LCM;
 
+	// log file of this model (or zero to use the kernel's log file)
+	Logfile*	m_plog;
+
+	// named timers and profiler of this model
+	vector<Timer*>	m_timers;
+	FEProfiler		m_prf;
+
 public: // Global Data
 	std::map<string, double> m_Const;	//!< Global model constants
 	vector<FEGlobalData*>	m_GD;		//!< global data structures
@@ -147,6 +168,8 @@ public:
 BEGIN_PARAMETER_LIST(FEModel, FECoreBase)
 	ADD_PARAMETER(m_imp->m_timeInfo.currentTime, FE_PARAM_DOUBLE, "time");
 	ADD_PARAMETER(m_imp->m_bwopt, FE_PARAM_BOOL, "optimize_bw");
+	ADD_PARAMETER(m_imp->m_breorder, FE_PARAM_BOOL, "reorder_mesh");
+	ADD_PARAMETER(m_imp->m_eqorder, FE_PARAM_INT, "equation_order");
 	ADD_PARAMETER(m_udghex_hg, FE_PARAM_DOUBLE, "hourglass");
 END_PARAMETER_LIST();
 
@@ -175,9 +198,6 @@ FEModel::FEModel(void) : FECoreBase(FEMODEL_ID), m_imp(new FEModel::Implementati
 	AddProperty(&m_imp->m_LC , "loadcurve");
 	AddProperty(&m_imp->m_Step, "step");
 	AddProperty(&m_imp->m_Data, "data");
-
-	// reset all timers
-	FECoreKernel::GetInstance().ResetAllTimers();
 }
 
 //-----------------------------------------------------------------------------
@@ -185,6 +205,9 @@ FEModel::FEModel(void) : FECoreBase(FEMODEL_ID), m_imp(new FEModel::Implementati
 FEModel::~FEModel(void)
 {
 	Clear();
+
+	for (size_t i = 0; i<m_imp->m_timers.size(); ++i) delete m_imp->m_timers[i];
+	m_imp->m_timers.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -248,6 +271,32 @@ void FEModel::SetOptimizeBandwidth(bool b)
 	m_imp->m_bwopt = b;
 }
 
+//-----------------------------------------------------------------------------
+//! see if the mesh should be reordered after it is read in
+bool FEModel::ReorderMesh() const
+{
+	return (m_imp->m_breorder == 1);
+}
+
+//-----------------------------------------------------------------------------
+void FEModel::SetReorderMesh(bool b)
+{
+	m_imp->m_breorder = b;
+}
+
+//-----------------------------------------------------------------------------
+//! get the node ordering that is used for numbering the equations
+int FEModel::EquationOrder() const
+{
+	return m_imp->m_eqorder;
+}
+
+//-----------------------------------------------------------------------------
+void FEModel::SetEquationOrder(int n)
+{
+	m_imp->m_eqorder = n;
+}
+
 //-----------------------------------------------------------------------------
 //! set the module name
 void FEModel::SetModuleName(const std::string& moduleName)
@@ -413,6 +462,21 @@ FERigidSystem* FEModel::GetRigidSystem() { return m_imp->m_prs; }
 //-----------------------------------------------------------------------------
 FELinearConstraintManager& FEModel::GetLinearConstraintManager() { return *m_imp->m_LCM; }
 
+//-----------------------------------------------------------------------------
+void FEModel::SetLogfile(Logfile* plog) { m_imp->m_plog = plog; }
+
+//-----------------------------------------------------------------------------
+Logfile* FEModel::GetLogfile() { return m_imp->m_plog; }
+
+//-----------------------------------------------------------------------------
+vector<Timer*>& FEModel::GetTimers() { return m_imp->m_timers; }
+
+//-----------------------------------------------------------------------------
+const vector<Timer*>& FEModel::GetTimers() const { return m_imp->m_timers; }
+
+//-----------------------------------------------------------------------------
+FEProfiler& FEModel::GetProfiler() { return m_imp->m_prf; }
+
 //-----------------------------------------------------------------------------
 void FEModel::AddFixedBC(int node, int bc)
 {
@@ -432,6 +496,9 @@ void FEModel::ClearBCs()
 //-----------------------------------------------------------------------------
 bool FEModel::Init()
 {
+	// work on this model (log file, timers and profiler)
+	FEModelScope scope(this);
+
 	// make sure there is something to do
 	if (m_imp->m_Step.size() == 0) return false;
 
@@ -722,6 +789,9 @@ bool FEModel::InitBodyLoads()
 //! This function solves the FE problem by calling the solve method for each step.
 bool FEModel::Solve()
 {
+	// work on this model (log file, timers and profiler)
+	FEModelScope scope(this);
+
 	// error flag
 	bool bok = true;
 
@@ -837,7 +907,7 @@ void FEModel::Activate()
 bool FEModel::Reset()
 {
 	// reset all timers
-	FECoreKernel::GetInstance().ResetAllTimers();
+	for (size_t i = 0; i<m_imp->m_timers.size(); ++i) m_imp->m_timers[i]->reset();
 
 	// initialize materials
 	for (int i=0; i<Materials(); ++i)
@@ -1339,6 +1409,8 @@ void FEModel::CopyFrom(FEModel& fem)
 	// copy parameters (not sure if I need/want to copy all of these)
 	m_imp->m_linearSolver = fem.m_imp->m_linearSolver;
 	m_imp->m_bwopt = fem.m_imp->m_bwopt;
+	m_imp->m_breorder = fem.m_imp->m_breorder;
+	m_imp->m_eqorder = fem.m_imp->m_eqorder;
 	m_imp->m_nStep = fem.m_imp->m_nStep;
 	m_imp->m_timeInfo = fem.m_imp->m_timeInfo;
 	m_imp->m_ftime0 = fem.m_imp->m_ftime0;
@@ -2198,3 +2270,20 @@ FEDataArray* FEModel::FindDataArray(const char* szmap)
 	}
 	return 0;
 }
+
+//-----------------------------------------------------------------------------
+FEModelScope::FEModelScope(FEModel* pfem)
+{
+	m_pold = FECoreKernel::GetThreadModel();
+	m_plogOld = FECoreKernel::GetThreadLogfile();
+
+	// a model without a log file writes to the current log file of this thread
+	Logfile* plog = (pfem ? pfem->GetLogfile() : 0);
+	FECoreKernel::SetThreadModel(pfem, (plog ? plog : m_plogOld));
+}
+
+//-----------------------------------------------------------------------------
+FEModelScope::~FEModelScope()
+{
+	FECoreKernel::SetThreadModel(m_pold, m_plogOld);
+}
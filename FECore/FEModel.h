@@ -55,6 +55,8 @@ class FEGlobalMatrix;
 class FELinearConstraintManager;
 class FEModelData;
 class FEDataArray;
+class FEProfiler;
+class Timer;
 
 //-----------------------------------------------------------------------------
 //! The FEModel class stores all the data for the finite element model, including
@@ -98,6 +100,21 @@ public:
 	// get the linear constraint manager
 	FELinearConstraintManager& GetLinearConstraintManager();
 
+	//! Set the log file of this model. When set, the output of felog is sent to this log
+	//! file while the model is read, initialized, and solved on the calling thread.
+	//! This allows several models to be solved concurrently on separate threads.
+	void SetLogfile(Logfile* plog);
+
+	//! get the log file of this model (or zero if the model uses the kernel's log file)
+	Logfile* GetLogfile();
+
+	//! the named timers of this model (see TRACK_TIME)
+	vector<Timer*>& GetTimers();
+	const vector<Timer*>& GetTimers() const;
+
+	//! the profiler of this model
+	FEProfiler& GetProfiler();
+
 	//! Validate BC's
 	bool InitBCs();
 
@@ -324,6 +341,18 @@ public:	// --- Miscellaneous routines ---
 	//! Set the optimize band width flag
 	void SetOptimizeBandwidth(bool b);
 
+	//! see if the mesh should be reordered for memory locality
+	bool ReorderMesh() const;
+
+	//! Set the reorder mesh flag
+	void SetReorderMesh(bool b);
+
+	//! get the fill-reducing equation order (see EQUATION_ORDER)
+	int EquationOrder() const;
+
+	//! set the fill-reducing equation order
+	void SetEquationOrder(int n);
+
 	//! set the module name
 	void SetModuleName(const std::string& moduleName);
 
@@ -369,3 +398,19 @@ private:
 
 	DECLARE_PARAMETER_LIST();
 };
+
+//-----------------------------------------------------------------------------
+//! Makes the calling thread work on the given model for the lifetime of this
+//! object. While it exists, felog writes to the model's log file (if it has one),
+//! and TRACK_TIME and the profiler use the timers and the profiler of the model.
+//! This is also used in parallel regions to pass the model on to the worker threads.
+class FECORE_API FEModelScope
+{
+public:
+	FEModelScope(FEModel* pfem);
+	~FEModelScope();
+
+private:
+	FEModel*	m_pold;		//!< previous model of this thread
+	Logfile*	m_plogOld;	//!< previous log file of this thread
+};
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "FEModelComponent.h"
 #include <string.h>
 #include "DumpStream.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 //! The constructor takes two arguments: the SUPER_CLASS_ID which defines the 
@@ -37,7 +38,7 @@ SOFTWARE.*/
 FEModelComponent::FEModelComponent(SUPER_CLASS_ID sid, FEModel* pfem) : FECoreBase(sid)
 {
 	// assign a class ID
-	static int nid = 1;
+	static std::atomic<int> nid(1);
 	m_nClassID = nid++;
 
 	// the ID can be used by derived class to define a identifier for derived classes
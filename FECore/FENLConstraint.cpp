@@ -27,11 +27,12 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FENLConstraint.h"
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 FENLConstraint::FENLConstraint(FEModel* pfem) : FEModelComponent(FENLCONSTRAINT_ID, pfem)
 {
-	static int ncount = 1;
+	static std::atomic<int> ncount(1);
 	SetID(ncount++);
 }
 
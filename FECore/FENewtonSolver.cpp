@@ -28,17 +28,18 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FENewtonSolver.h"
 #include "NumCore/NumCore.h"
-#include "FENodeReorder.h"
 #include "FEModel.h"
 #include "FEGlobalMatrix.h"
 #include "BFGSSolver.h"
 #include "JFNKStrategy.h"
+#include "EBEStrategy.h"
 #include "FEBroydenStrategy.h"
 #include "FELinearConstraintManager.h"
 #include "FEAnalysis.h"
 #include "BC.h"
 #include "log.h"
 #include "sys.h"
+#include "FEProfiler.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -232,8 +233,11 @@ bool FENewtonSolver::ReformStiffness()
     {
         {
 			TRACK_TIME("solve");
-			// factorize the stiffness matrix
-            m_plinsolve->Factor();
+			{
+				// factorize the stiffness matrix
+				TRACK_TIME("factor");
+				m_plinsolve->Factor();
+			}
         }
         
         // increase total nr of reformations
@@ -254,15 +258,30 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 {
 	{
 		TRACK_TIME("reform");
-		// clean up the solver
-		if (m_pK->NonZeroes()) m_plinsolve->Destroy();
+
+		// If we already have a matrix, see if the new profile fits in it. If so, we can
+		// keep the matrix and the linear solver does not need to redo its preprocessing.
+		bool bprofile = false;
+		if (m_pK->NonZeroes())
+		{
+			if (m_pK->UpdateProfile(&GetFEModel(), m_neq, breset))
+			{
+				felog.printf("===== reusing stiffness matrix (profile unchanged)\n\n");
+				return true;
+			}
+			bprofile = true;
+
+			// clean up the solver
+			m_plinsolve->Destroy();
+		}
 
 		// clean up the stiffness matrix
 		m_pK->Clear();
 
 		// create the stiffness matrix
 		felog.printf("===== reforming stiffness matrix:\n");
-		if (m_pK->Create(&GetFEModel(), m_neq, breset) == false) 
+		bool bret = (bprofile ? m_pK->CreateFromProfile() : m_pK->Create(&GetFEModel(), m_neq, breset));
+		if (bret == false) 
 		{
 			felog.printf("FATAL ERROR: An error occured while building the stiffness matrix\n\n");
 			return false;
@@ -283,6 +302,7 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME("solve");
+		PROFILE_SCOPE("preprocess");
 		if (!m_plinsolve->PreProcess())
 		{
 			// TODO: get rid of throwing this exception. We should just return false.
@@ -312,6 +332,7 @@ bool FENewtonSolver::Init()
 	case QN_BFGS   : SetSolutionStrategy(new BFGSSolver       (this) ); break;
 	case QN_BROYDEN: SetSolutionStrategy(new FEBroydenStrategy(this)); break;
 	case QN_JFNK   : SetSolutionStrategy(new JFNKStrategy     (this)); break;
+	case QN_EBE    : SetSolutionStrategy(new EBEStrategy      (this)); break;
 	// NOTE: Temporary hack for backward compatibility since the BFGSSolver2 was deprecated
 	// This solver used to have the value 1 and Broyden 2, but 1 is now used for Broyden.
 	case 2: SetSolutionStrategy(new FEBroydenStrategy(this)); break;
@@ -440,73 +461,57 @@ bool FENewtonSolver::InitEquations()
     // initialize nr of equations
     int neq = 0;
     
-    // see if we need to optimize the bandwidth
-    if (m_fem.OptimizeBandwidth())
-    {
-		assert(m_eq_scheme == EQUATION_SCHEME::STAGGERED);
-        // reorder the node numbers
-        vector<int> P(mesh.Nodes());
-        FENodeReorder mod;
-        mod.Apply(mesh, P);
-        
-        // set the equation numbers
-        for (int i=0; i<mesh.Nodes(); ++i)
-        {
-            FENode& node = mesh.Node(P[i]);
-            for (int j=0; j<(int)node.m_ID.size(); ++j)
-            {
-                if      (node.m_ID[j] == DOF_FIXED     ) { node.m_ID[j] = -1; }
-                else if (node.m_ID[j] == DOF_OPEN      ) { node.m_ID[j] =  neq++; }
-                else if (node.m_ID[j] == DOF_PRESCRIBED) { node.m_ID[j] = -neq-2; neq++; }
-                else { assert(false); return false; }
-            }
-        }
-    }
-    else
-    {
-		if (m_eq_scheme == EQUATION_SCHEME::STAGGERED)
+    // get the order in which the nodes are numbered (bandwidth or fill-reducing ordering)
+    // In the block scheme the ordering is applied within each block, so the
+    // partitions that are passed to the linear solver are not affected.
+    vector<int> P;
+    bool border = EquationNodeOrder(P);
+
+	if (m_eq_scheme == EQUATION_SCHEME::STAGGERED)
+	{
+		// give all free dofs an equation number
+		for (int i=0; i<mesh.Nodes(); ++i)
 		{
-			// give all free dofs an equation number
-			for (int i=0; i<mesh.Nodes(); ++i)
+			FENode& node = mesh.Node(border ? P[i] : i);
+			for (int j=0; j<(int)node.m_ID.size(); ++j)
 			{
-				FENode& node = mesh.Node(i);
-				for (int j=0; j<(int)node.m_ID.size(); ++j)
-				{
-					if      (node.m_ID[j] == DOF_FIXED     ) { node.m_ID[j] = -1; }
-					else if (node.m_ID[j] == DOF_OPEN      ) { node.m_ID[j] =  neq++; }
-					else if (node.m_ID[j] == DOF_PRESCRIBED) { node.m_ID[j] = -neq-2; neq++; }
-					else { assert(false); return false; }
-				}
+				if      (node.m_ID[j] == DOF_FIXED     ) { node.m_ID[j] = -1; }
+				else if (node.m_ID[j] == DOF_OPEN      ) { node.m_ID[j] =  neq++; }
+				else if (node.m_ID[j] == DOF_PRESCRIBED) { node.m_ID[j] = -neq-2; neq++; }
+				else { assert(false); return false; }
 			}
 		}
-		else
-		{
-			assert(m_eq_scheme == EQUATION_SCHEME::BLOCK);
+	}
+	else
+	{
+		assert(m_eq_scheme == EQUATION_SCHEME::BLOCK);
 
-			// Assign equations numbers in blocks
-			DOFS& dofs = m_fem.GetDOFS();
-			for (int nv=0; nv<dofs.Variables(); ++nv)
+		// Assign equations numbers in blocks
+		DOFS& dofs = m_fem.GetDOFS();
+		for (int nv=0; nv<dofs.Variables(); ++nv)
+		{
+			int n = dofs.GetVariableSize(nv);
+			for (int l=0; l<n; ++l)
 			{
-				int n = dofs.GetVariableSize(nv);
-				for (int l=0; l<n; ++l)
+				int nl = dofs.GetDOF(nv, l);
+
+				for (int i = 0; i<mesh.Nodes(); ++i)
 				{
-					int nl = dofs.GetDOF(nv, l);
-
-					for (int i = 0; i<mesh.Nodes(); ++i)
-					{
-						FENode& node = mesh.Node(i);
-						if      (node.m_ID[nl] == DOF_FIXED     ) { node.m_ID[nl] = -1; }
-						else if (node.m_ID[nl] == DOF_OPEN      ) { node.m_ID[nl] = neq++; }
-						else if (node.m_ID[nl] == DOF_PRESCRIBED) { node.m_ID[nl] = -neq - 2; neq++; }
-						else { assert(false); return false; }
-					}
+					FENode& node = mesh.Node(border ? P[i] : i);
+					if      (node.m_ID[nl] == DOF_FIXED     ) { node.m_ID[nl] = -1; }
+					else if (node.m_ID[nl] == DOF_OPEN      ) { node.m_ID[nl] = neq++; }
+					else if (node.m_ID[nl] == DOF_PRESCRIBED) { node.m_ID[nl] = -neq - 2; neq++; }
+					else { assert(false); return false; }
 				}
 			}
 		}
-    }
+	}
     
     // store the number of equations
     m_neq = neq;
+
+	// the equation numbers have changed
+	m_asmbuf.Clear();
     
     // All initialization is done
     return true;
@@ -564,6 +569,7 @@ void FENewtonSolver::Serialize(DumpStream& ar)
 			case QN_BFGS: SetSolutionStrategy(new BFGSSolver(this)); break;
 			case QN_BROYDEN: SetSolutionStrategy(new FEBroydenStrategy(this)); break;
 			case QN_JFNK: SetSolutionStrategy(new JFNKStrategy(this)); break;
+			case QN_EBE: SetSolutionStrategy(new EBEStrategy(this)); break;
 			// NOTE: Temporary hack for backward compatibility since the BFGSSolver2 was deprecated
 			// This solver used to have the value 1 and Broyden 2, but 1 is now used for Broyden.
 			case 2: SetSolutionStrategy(new FEBroydenStrategy(this)); break;
@@ -612,6 +618,12 @@ bool FENewtonSolver::SolveStep()
 		felog.printbox("ERROR","Negative jacobian was detected at element %d at gauss point %d\njacobian = %lg\n", e.m_iel, e.m_ng+1, e.m_vol);
 		return false;
 	}
+	catch (SingularMatrix e)
+	{
+		// an element matrix could not be inverted
+		felog.printbox("ERROR", "Singular element matrix detected at element %d.", e.m_iel);
+		return false;
+	}
 	catch (MaxStiffnessReformations)
 	{
 		// max nr of reformations is reached
@@ -758,6 +770,7 @@ bool FENewtonSolver::Quasin()
 void FENewtonSolver::SolveLinearSystem(vector<double>& x, vector<double>& R)
 {
 	// solve the equations
+	PROFILE_SCOPE("backsolve");
 	if (m_plinsolve->BackSolve(x, R) == false)
 		throw LinearSolverFailed();
 }
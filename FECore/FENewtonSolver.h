@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FENewtonStrategy.h"
 #include "FETimeInfo.h"
 #include "FELineSearch.h"
+#include "FEGlobalVector.h"
 
 //-----------------------------------------------------------------------------
 // forward declarations
@@ -52,7 +53,8 @@ enum QN_STRATEGY
 {
 	QN_BFGS,
 	QN_BROYDEN,
-	QN_JFNK = 3
+	QN_JFNK = 3,
+	QN_EBE = 4		// matrix-free Newton-Krylov with element-by-element matrices
 };
 
 //-----------------------------------------------------------------------------
@@ -212,6 +214,9 @@ public:
 	vector<double> m_ui;	//!< displacement increment vector
 	vector<double> m_Fd;	//!< residual correction due to prescribed degrees of freedom
 
+	// per-thread buffers for the parallel assembly of the residual
+	FEAssemblyBuffer	m_asmbuf;
+
 private:
 	double	m_ls;	//!< line search factor calculated in last call to QNSolve
 
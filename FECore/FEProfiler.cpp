@@ -0,0 +1,404 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEProfiler.h"
+#include "log.h"
+#include "FEModel.h"
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#include <stdio.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// max nr of trace events stored per thread
+#define MAX_TRACE_EVENTS	(1 << 20)
+
+//-----------------------------------------------------------------------------
+// statistics of a scope for one thread
+struct FEProfileStat
+{
+	int		calls;	// nr of times the scope was entered
+	double	time;	// total time spent in the scope
+};
+
+//-----------------------------------------------------------------------------
+// A node of the scope tree. Child nodes are stored as a linked list that can be
+// traversed without locking. New nodes are only appended while holding a lock.
+class FEProfileNode
+{
+public:
+	FEProfileNode(const char* szname, FEProfileNode* parent, int nthreads) : m_name(szname), m_parent(parent), m_stat(nthreads)
+	{
+		m_first = 0;
+		m_next = 0;
+		for (int i = 0; i<nthreads; ++i) { m_stat[i].calls = 0; m_stat[i].time = 0.0; }
+	}
+
+	~FEProfileNode()
+	{
+		FEProfileNode* pn = m_first;
+		while (pn)
+		{
+			FEProfileNode* pnext = pn->m_next;
+			delete pn;
+			pn = pnext;
+		}
+	}
+
+	FEProfileNode* FindChild(const char* szname)
+	{
+		for (FEProfileNode* pn = m_first; pn; pn = pn->m_next)
+			if (strcmp(pn->m_name.c_str(), szname) == 0) return pn;
+		return 0;
+	}
+
+	FEProfileNode* AddChild(const char* szname, int nthreads)
+	{
+		FEProfileNode* node = new FEProfileNode(szname, this, nthreads);
+		if (m_first == 0) m_first = node;
+		else
+		{
+			FEProfileNode* pn = m_first;
+			while (pn->m_next) pn = pn->m_next;
+			pn->m_next = node;
+		}
+		return node;
+	}
+
+	// time spent in this scope, taken as the time of the slowest thread
+	double Time() const
+	{
+		double tmax = 0.0;
+		for (size_t i = 0; i<m_stat.size(); ++i) if (m_stat[i].time > tmax) tmax = m_stat[i].time;
+		return tmax;
+	}
+
+public:
+	std::string					m_name;
+	FEProfileNode*				m_parent;
+	std::atomic<FEProfileNode*>	m_first;	// first child
+	std::atomic<FEProfileNode*>	m_next;		// next sibling
+	std::vector<FEProfileStat>	m_stat;		// per-thread statistics
+};
+
+//-----------------------------------------------------------------------------
+struct FEProfileEvent
+{
+	FEProfileNode*	node;
+	double			start;
+	double			duration;
+};
+
+//-----------------------------------------------------------------------------
+// data stored for each thread
+struct FEProfileThread
+{
+	FEProfileNode*				current;	// active scope of this thread
+	std::vector<FEProfileEvent>	events;		// trace events
+	int							dropped;	// nr of events that did not fit in the trace buffer
+};
+
+//-----------------------------------------------------------------------------
+static std::chrono::steady_clock::time_point profiler_epoch = std::chrono::steady_clock::now();
+
+static bool in_parallel()
+{
+#ifdef _OPENMP
+	return (omp_in_parallel() != 0);
+#else
+	return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler& FEProfiler::GetInstance()
+{
+	FEModel* pfem = FECoreKernel::GetThreadModel();
+	if (pfem) return pfem->GetProfiler();
+
+	static FEProfiler profiler;
+	return profiler;
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler::FEProfiler() : m_nthreads(0)
+{
+	static std::atomic<int> nid(1);
+	m_id = nid++;
+	m_root = 0;
+	m_serial = 0;
+	m_benabled = false;
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler::~FEProfiler()
+{
+	delete m_root;
+	for (size_t i = 0; i<m_thread.size(); ++i) delete m_thread[i];
+}
+
+//-----------------------------------------------------------------------------
+// This must be called outside of a parallel region
+void FEProfiler::Enable(bool b)
+{
+	if (b && (m_root == 0)) Reset();
+	m_benabled = b;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::SetTraceFile(const char* szfile)
+{
+	if (szfile) m_trace = szfile; else m_trace.clear();
+}
+
+//-----------------------------------------------------------------------------
+const char* FEProfiler::GetTraceFile() const
+{
+	return (m_trace.empty() ? 0 : m_trace.c_str());
+}
+
+//-----------------------------------------------------------------------------
+// This must be called outside of a parallel region
+void FEProfiler::Reset()
+{
+	int nthreads = 1;
+#ifdef _OPENMP
+	nthreads = omp_get_max_threads();
+#endif
+	for (size_t i = 0; i<m_thread.size(); ++i) delete m_thread[i];
+	m_thread.resize(nthreads);
+	for (int i = 0; i<nthreads; ++i)
+	{
+		m_thread[i] = new FEProfileThread;
+		m_thread[i]->current = 0;
+		m_thread[i]->dropped = 0;
+	}
+
+	delete m_root;
+	m_root = new FEProfileNode("total", 0, nthreads);
+	m_serial = m_root;
+}
+
+//-----------------------------------------------------------------------------
+double FEProfiler::Time() const
+{
+	std::chrono::duration<double> t = std::chrono::steady_clock::now() - profiler_epoch;
+	return t.count();
+}
+
+//-----------------------------------------------------------------------------
+// Threads are numbered in the order in which they first open a scope of this
+// profiler. Since profiling starts on the thread that solves the model, that
+// thread is always thread 0. Each thread keeps its index for each profiler it used.
+int FEProfiler::ThreadIndex()
+{
+	static thread_local std::vector< std::pair<int, int> > ids;
+	int nid = -1;
+	for (size_t i = 0; i<ids.size(); ++i)
+		if (ids[i].first == m_id) { nid = ids[i].second; break; }
+
+	if (nid == -1)
+	{
+		nid = m_nthreads++;
+		ids.push_back(std::make_pair(m_id, nid));
+	}
+	return (nid < Threads() ? nid : -1);
+}
+
+//-----------------------------------------------------------------------------
+FEProfileNode* FEProfiler::Enter(const char* szname, int nthread, FEProfileNode*& prev)
+{
+	FEProfileThread& t = *m_thread[nthread];
+
+	// Worker threads that don't have an active scope yet attach their
+	// scopes to the active scope of the serial part of the code.
+	prev = t.current;
+	FEProfileNode* parent = (prev ? prev : m_serial);
+
+	FEProfileNode* node = parent->FindChild(szname);
+	if (node == 0)
+	{
+		#pragma omp critical (FEProfiler)
+		{
+			node = parent->FindChild(szname);
+			if (node == 0) node = parent->AddChild(szname, Threads());
+		}
+	}
+
+	t.current = node;
+	if (in_parallel() == false) m_serial = node;
+
+	return node;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Leave(FEProfileNode* node, FEProfileNode* prev, double t0, int nthread)
+{
+	double t1 = Time();
+
+	FEProfileStat& s = node->m_stat[nthread];
+	s.calls++;
+	s.time += t1 - t0;
+
+	FEProfileThread& t = *m_thread[nthread];
+	if (m_trace.empty() == false)
+	{
+		if (t.events.size() < MAX_TRACE_EVENTS)
+		{
+			FEProfileEvent e = { node, t0, t1 - t0 };
+			t.events.push_back(e);
+		}
+		else t.dropped++;
+	}
+
+	t.current = prev;
+	if (in_parallel() == false) m_serial = (prev ? prev : m_root);
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::PrintReport()
+{
+	if (m_root == 0) return;
+
+	// total time is the time spent in all top-level scopes
+	double ttot = 0.0;
+	for (FEProfileNode* pn = m_root->m_first; pn; pn = pn->m_next) ttot += pn->Time();
+
+	felog.printf(" P R O F I L E R   R E P O R T\n\n");
+	felog.printf("\tinclusive and exclusive times are those of the slowest thread.\n");
+	felog.printf("\timbalance is the ratio of the max and average thread time.\n\n");
+	felog.printf("\t%-48s %10s %12s %12s %7s %7s %9s\n", "scope", "calls", "incl. (sec)", "excl. (sec)", "%", "threads", "imbalance");
+	felog.printf("\t%s\n", std::string(110, '-').c_str());
+	for (FEProfileNode* pn = m_root->m_first; pn; pn = pn->m_next) PrintNode(pn, 0, ttot);
+	felog.printf("\n");
+
+	int ndropped = 0;
+	for (int i = 0; i<Threads(); ++i) ndropped += m_thread[i]->dropped;
+	if (ndropped > 0) felog.printf("\tWARNING: %d events did not fit in the trace buffer.\n\n", ndropped);
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::PrintNode(FEProfileNode* node, int level, double ttot)
+{
+	int ncalls = 0, nthreads = 0;
+	double tsum = 0.0;
+	for (int i = 0; i<Threads(); ++i)
+	{
+		const FEProfileStat& s = node->m_stat[i];
+		if (s.calls > 0)
+		{
+			ncalls += s.calls;
+			nthreads++;
+			tsum += s.time;
+		}
+	}
+
+	double tincl = node->Time();
+	double texcl = tincl;
+	for (FEProfileNode* pn = node->m_first; pn; pn = pn->m_next) texcl -= pn->Time();
+	if (texcl < 0.0) texcl = 0.0;
+
+	double tavg = (nthreads > 0 ? tsum / nthreads : 0.0);
+	double imbalance = (tavg > 0.0 ? tincl / tavg : 1.0);
+	double pct = (ttot > 0.0 ? 100.0*tincl / ttot : 0.0);
+
+	std::string name = std::string(2 * level, ' ') + node->m_name;
+	felog.printf("\t%-48s %10d %12.4lf %12.4lf %7.2lf %7d %9.2lf\n", name.c_str(), ncalls, tincl, texcl, pct, nthreads, imbalance);
+
+	for (FEProfileNode* pn = node->m_first; pn; pn = pn->m_next) PrintNode(pn, level + 1, ttot);
+}
+
+//-----------------------------------------------------------------------------
+// write a string to the trace file, escaping characters that are not allowed in JSON strings
+static void write_json_string(FILE* fp, const std::string& s)
+{
+	fputc('"', fp);
+	for (size_t i = 0; i<s.size(); ++i)
+	{
+		char c = s[i];
+		if ((c == '"') || (c == '\\')) { fputc('\\', fp); fputc(c, fp); }
+		else if ((unsigned char) c < 0x20) fputc(' ', fp);
+		else fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+//-----------------------------------------------------------------------------
+// Writes the trace events in the Chrome trace event format, which can be viewed
+// with chrome://tracing or similar tools.
+bool FEProfiler::WriteTrace()
+{
+	if (m_trace.empty()) return true;
+
+	FILE* fp = fopen(m_trace.c_str(), "wt");
+	if (fp == 0) return false;
+
+	fprintf(fp, "{\"traceEvents\":[\n");
+	bool bfirst = true;
+	for (int i = 0; i<Threads(); ++i)
+	{
+		std::vector<FEProfileEvent>& events = m_thread[i]->events;
+		for (size_t j = 0; j<events.size(); ++j)
+		{
+			FEProfileEvent& e = events[j];
+			if (bfirst == false) fprintf(fp, ",\n");
+			fprintf(fp, "{\"name\":");
+			write_json_string(fp, e.node->m_name);
+			fprintf(fp, ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3lf,\"dur\":%.3lf}", i, e.start*1e6, e.duration*1e6);
+			bfirst = false;
+		}
+	}
+	fprintf(fp, "\n]}\n");
+	fclose(fp);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfileScope::Enter(FEProfiler& prf, const char* szname, const char* szsub)
+{
+	m_prf = &prf;
+	m_nthread = prf.ThreadIndex();
+	if (m_nthread < 0) return;
+	if (szsub)
+	{
+		std::string name = std::string(szname) + " (" + szsub + ")";
+		m_node = prf.Enter(name.c_str(), m_nthread, m_prev);
+	}
+	else m_node = prf.Enter(szname, m_nthread, m_prev);
+	m_start = prf.Time();
+}
+
+//-----------------------------------------------------------------------------
+void FEProfileScope::Leave()
+{
+	m_prf->Leave(m_node, m_prev, m_start, m_nthread);
+}
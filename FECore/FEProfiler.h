@@ -0,0 +1,137 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <string>
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+class FEProfileNode;
+struct FEProfileThread;
+
+//-----------------------------------------------------------------------------
+//! Hierarchical scoped profiler.
+
+//! The profiler builds a tree of named scopes (e.g. solver -> residual -> domain)
+//! and records for each scope and each thread the number of calls and the elapsed
+//! wall-clock time. Scopes are opened with the PROFILE_SCOPE macro (or through
+//! TRACK_TIME). Scopes that are opened on worker threads inside an OpenMP parallel
+//! region are attached to the scope that is active on the master thread, which
+//! allows the report to show the load imbalance between threads.
+//! The profiler does nothing (apart from a flag check) unless it is enabled.
+//! Each model has its own profiler (see FEModel::GetProfiler), so that models
+//! that are solved concurrently are profiled separately.
+class FECORE_API FEProfiler
+{
+public:
+	FEProfiler();
+	~FEProfiler();
+
+	//! return the profiler of the model of the calling thread, or the global
+	//! profiler when the thread does not work on a model.
+	static FEProfiler& GetInstance();
+
+	//! see if profiling is on
+	bool IsEnabled() const { return m_benabled; }
+
+public:
+	//! turn profiling on or off
+	void Enable(bool b);
+
+	//! set the name of the trace file (Chrome trace format). Set to null to turn off tracing.
+	void SetTraceFile(const char* szfile);
+
+	//! the name of the trace file (or null)
+	const char* GetTraceFile() const;
+
+	//! clear all collected data
+	void Reset();
+
+	//! print the summary table to the log file
+	void PrintReport();
+
+	//! write the trace file (if one was set)
+	bool WriteTrace();
+
+public:
+	// These are used by FEProfileScope
+	FEProfileNode* Enter(const char* szname, int nthread, FEProfileNode*& prev);
+	void Leave(FEProfileNode* node, FEProfileNode* prev, double t0, int nthread);
+
+	//! index of the calling thread (or -1 if no data can be stored for this thread)
+	int ThreadIndex();
+
+	//! current time in seconds (relative to when the profiler was created)
+	double Time() const;
+
+	//! number of threads for which data is stored
+	int Threads() const { return (int) m_thread.size(); }
+
+private:
+	FEProfiler(const FEProfiler&) {}
+	void operator = (const FEProfiler&) {}
+
+	void PrintNode(FEProfileNode* node, int level, double ttot);
+
+private:
+	FEProfileNode*					m_root;		//!< root of scope tree
+	std::vector<FEProfileThread*>	m_thread;	//!< per-thread data
+	FEProfileNode*					m_serial;	//!< active scope outside parallel regions
+	std::string						m_trace;	//!< trace file name
+	bool							m_benabled;	//!< profiling is on
+	int								m_id;		//!< unique ID of this profiler
+	std::atomic<int>				m_nthreads;	//!< nr of threads that opened a scope
+};
+
+//-----------------------------------------------------------------------------
+//! Helper class that opens a profile scope in its constructor and closes it
+//! in its destructor.
+class FECORE_API FEProfileScope
+{
+public:
+	FEProfileScope(const char* szname) : m_node(0) { FEProfiler& prf = FEProfiler::GetInstance(); if (prf.IsEnabled()) Enter(prf, szname, 0); }
+
+	//! the scope name will be "szname (szsub)"
+	FEProfileScope(const char* szname, const char* szsub) : m_node(0) { FEProfiler& prf = FEProfiler::GetInstance(); if (prf.IsEnabled()) Enter(prf, szname, szsub); }
+
+	~FEProfileScope() { if (m_node) Leave(); }
+
+private:
+	void Enter(FEProfiler& prf, const char* szname, const char* szsub);
+	void Leave();
+
+private:
+	FEProfiler*		m_prf;		//!< profiler of this scope
+	FEProfileNode*	m_node;		//!< node of this scope
+	FEProfileNode*	m_prev;		//!< active node of this thread before this scope was opened
+	double			m_start;	//!< start time
+	int				m_nthread;	//!< thread that opened this scope
+};
+
+#define PROFILE_SCOPE(szname) FEProfileScope _profileScope(szname);
@@ -65,6 +65,32 @@ void FESolidDomain::CopyFrom(FEDomain* pd)
 	for (int i=0; i<m_Elem.size(); ++i) m_Elem[i].SetDomain(this);
 }
 
+//-----------------------------------------------------------------------------
+//! Reorder the elements of this domain. P stores for each new element position
+//! the old position of the element. The elements are swapped in place by
+//! following the cycles of the permutation, so no element data is copied.
+void FESolidDomain::PermuteElements(const vector<int>& P)
+{
+	int NE = (int) m_Elem.size();
+	assert(P.size() == NE);
+	vector<bool> done(NE, false);
+	for (int i=0; i<NE; ++i)
+	{
+		if (done[i]) continue;
+
+		// position j still needs the element that is currently at P[j]
+		int j = i;
+		while (true)
+		{
+			done[j] = true;
+			int k = P[j];
+			if (k == i) break;
+			m_Elem[j].swap(m_Elem[k]);
+			j = k;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! initialize element data
 bool FESolidDomain::Init()
@@ -1483,6 +1509,224 @@ double FESolidDomain::ShapeGradient0(FESolidElement& el, double r, double s, dou
     return detJ0;
 }
 
+//-----------------------------------------------------------------------------
+// Kernels that evaluate the Jacobians at all the integration points of an element.
+// The number of nodes is a template parameter so that the compiler can unroll the
+// loops over the nodes for the common element types. NELN = 0 is used for all
+// other element types, in which case the run-time value neln is used.
+template <int NELN> static void shape_gradients(FESolidElement& el, int neln, const vec3d* x, vec3d* G, double* J)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	const int nint = el.GaussPoints();
+	for (int n=0; n<nint; ++n, G += N)
+	{
+		const double* Gr = el.Gr(n);
+		const double* Gs = el.Gs(n);
+		const double* Gt = el.Gt(n);
+
+		// jacobian
+		double J00 = 0, J01 = 0, J02 = 0;
+		double J10 = 0, J11 = 0, J12 = 0;
+		double J20 = 0, J21 = 0, J22 = 0;
+		for (int i=0; i<N; ++i)
+		{
+			J00 += Gr[i]*x[i].x; J01 += Gs[i]*x[i].x; J02 += Gt[i]*x[i].x;
+			J10 += Gr[i]*x[i].y; J11 += Gs[i]*x[i].y; J12 += Gt[i]*x[i].y;
+			J20 += Gr[i]*x[i].z; J21 += Gs[i]*x[i].z; J22 += Gt[i]*x[i].z;
+		}
+
+		double det = J00*(J11*J22 - J12*J21) + J01*(J12*J20 - J22*J10) + J02*(J10*J21 - J11*J20);
+		if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
+		J[n] = det;
+
+		// inverse jacobian
+		double deti = 1.0 / det;
+		double Ji00 = deti*(J11*J22 - J12*J21), Ji01 = deti*(J02*J21 - J01*J22), Ji02 = deti*(J01*J12 - J11*J02);
+		double Ji10 = deti*(J12*J20 - J10*J22), Ji11 = deti*(J00*J22 - J02*J20), Ji12 = deti*(J02*J10 - J00*J12);
+		double Ji20 = deti*(J10*J21 - J11*J20), Ji21 = deti*(J01*J20 - J00*J21), Ji22 = deti*(J00*J11 - J01*J10);
+
+		// spatial gradients (note that we need the transpose of Ji)
+		for (int i=0; i<N; ++i)
+		{
+			G[i].x = Ji00*Gr[i] + Ji10*Gs[i] + Ji20*Gt[i];
+			G[i].y = Ji01*Gr[i] + Ji11*Gs[i] + Ji21*Gt[i];
+			G[i].z = Ji02*Gr[i] + Ji12*Gs[i] + Ji22*Gt[i];
+		}
+	}
+}
+
+template <int NELN> static void deformation_gradients(FESolidElement& el, int neln, const vec3d* x, mat3d* F, double* J)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	const int nint = el.GaussPoints();
+	for (int n=0; n<nint; ++n)
+	{
+		const double* Gr = el.Gr(n);
+		const double* Gs = el.Gs(n);
+		const double* Gt = el.Gt(n);
+
+		// The material gradient of x is the product of the spatial jacobian
+		// and the (stored) inverse reference jacobian.
+		double J00 = 0, J01 = 0, J02 = 0;
+		double J10 = 0, J11 = 0, J12 = 0;
+		double J20 = 0, J21 = 0, J22 = 0;
+		for (int i=0; i<N; ++i)
+		{
+			J00 += Gr[i]*x[i].x; J01 += Gs[i]*x[i].x; J02 += Gt[i]*x[i].x;
+			J10 += Gr[i]*x[i].y; J11 += Gs[i]*x[i].y; J12 += Gt[i]*x[i].y;
+			J20 += Gr[i]*x[i].z; J21 += Gs[i]*x[i].z; J22 += Gt[i]*x[i].z;
+		}
+		F[n] = mat3d(J00, J01, J02, J10, J11, J12, J20, J21, J22)*el.m_J0i[n];
+
+		double D = F[n].det();
+		if (D <= 0) throw NegativeJacobian(el.GetID(), n, D, &el);
+		J[n] = D;
+	}
+}
+
+// Same as deformation_gradients, but using the cached reference gradients G0
+// (which are scaled by w0 = detJ0*w).
+template <int NELN> static void deformation_gradients(FESolidElement& el, int neln, const vec3d* x, const vec3d* G0, const double* w0, mat3d* F, double* J)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	const int nint = el.GaussPoints();
+	for (int n=0; n<nint; ++n, G0 += N)
+	{
+		double F00 = 0, F01 = 0, F02 = 0;
+		double F10 = 0, F11 = 0, F12 = 0;
+		double F20 = 0, F21 = 0, F22 = 0;
+		for (int i=0; i<N; ++i)
+		{
+			F00 += x[i].x*G0[i].x; F01 += x[i].x*G0[i].y; F02 += x[i].x*G0[i].z;
+			F10 += x[i].y*G0[i].x; F11 += x[i].y*G0[i].y; F12 += x[i].y*G0[i].z;
+			F20 += x[i].z*G0[i].x; F21 += x[i].z*G0[i].y; F22 += x[i].z*G0[i].z;
+		}
+		F[n] = mat3d(F00, F01, F02, F10, F11, F12, F20, F21, F22)*(1.0 / w0[n]);
+
+		double D = F[n].det();
+		if (D <= 0) throw NegativeJacobian(el.GetID(), n, D, &el);
+		J[n] = D;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FESolidDomain::ShapeGradients(FESolidElement& el, vec3d* G, double* J, double alpha)
+{
+	vec3d rt[FEElement::MAX_NODES];
+	if (alpha == 1.0) GetCurrentNodalCoordinates(el, rt);
+	else GetCurrentNodalCoordinates(el, rt, alpha);
+
+	int neln = el.Nodes();
+	switch (neln)
+	{
+	case  4: shape_gradients< 4>(el, neln, rt, G, J); break;	// TET4
+	case  6: shape_gradients< 6>(el, neln, rt, G, J); break;	// PENTA6
+	case  8: shape_gradients< 8>(el, neln, rt, G, J); break;	// HEX8
+	case 10: shape_gradients<10>(el, neln, rt, G, J); break;	// TET10
+	case 20: shape_gradients<20>(el, neln, rt, G, J); break;	// HEX20
+	default:
+		shape_gradients<0>(el, neln, rt, G, J);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FESolidDomain::defgrads(FESolidElement& el, mat3d* F, double* J)
+{
+	vec3d rt[FEElement::MAX_NODES];
+	GetCurrentNodalCoordinates(el, rt);
+
+	int neln = el.Nodes();
+	if (ReferenceGradientsCached())
+	{
+		int iel = (int)(&el - &m_Elem[0]);
+		assert((iel >= 0) && (iel < (int)m_Elem.size()));
+		const vec3d* G0 = &m_G0[m_G0off[iel]];
+		const double* w0 = &m_J0w[m_J0off[iel]];
+		switch (neln)
+		{
+		case  4: deformation_gradients< 4>(el, neln, rt, G0, w0, F, J); break;
+		case  6: deformation_gradients< 6>(el, neln, rt, G0, w0, F, J); break;
+		case  8: deformation_gradients< 8>(el, neln, rt, G0, w0, F, J); break;
+		case 10: deformation_gradients<10>(el, neln, rt, G0, w0, F, J); break;
+		case 20: deformation_gradients<20>(el, neln, rt, G0, w0, F, J); break;
+		default:
+			deformation_gradients<0>(el, neln, rt, G0, w0, F, J);
+		}
+		return;
+	}
+
+	switch (neln)
+	{
+	case  4: deformation_gradients< 4>(el, neln, rt, F, J); break;
+	case  6: deformation_gradients< 6>(el, neln, rt, F, J); break;
+	case  8: deformation_gradients< 8>(el, neln, rt, F, J); break;
+	case 10: deformation_gradients<10>(el, neln, rt, F, J); break;
+	case 20: deformation_gradients<20>(el, neln, rt, F, J); break;
+	default:
+		deformation_gradients<0>(el, neln, rt, F, J);
+	}
+}
+
+//-----------------------------------------------------------------------------
+double FESolidDomain::detJ0w(FESolidElement& el, int n)
+{
+	if (ReferenceGradientsCached())
+	{
+		int iel = (int)(&el - &m_Elem[0]);
+		assert((iel >= 0) && (iel < (int)m_Elem.size()));
+		return m_J0w[m_J0off[iel] + n];
+	}
+	else return detJ0(el, n)*el.GaussWeights()[n];
+}
+
+//-----------------------------------------------------------------------------
+void FESolidDomain::CacheReferenceGradients(bool b)
+{
+	m_G0.clear(); m_J0w.clear();
+	m_G0off.clear(); m_J0off.clear();
+	if (b == false) return;
+
+	int NE = Elements();
+	m_G0off.resize(NE);
+	m_J0off.resize(NE);
+	int ng = 0, nj = 0;
+	for (int i=0; i<NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		m_G0off[i] = ng; ng += el.GaussPoints()*el.Nodes();
+		m_J0off[i] = nj; nj += el.GaussPoints();
+	}
+	m_G0.resize(ng);
+	m_J0w.resize(nj);
+
+	// We use the stored inverse reference jacobians so that the results are
+	// the same as without the cache.
+	for (int i=0; i<NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int neln = el.Nodes();
+		int nint = el.GaussPoints();
+		double* gw = el.GaussWeights();
+		vec3d* G0 = &m_G0[m_G0off[i]];
+		for (int n=0; n<nint; ++n, G0 += neln)
+		{
+			mat3d Ji = el.m_J0i[n];
+			double w0 = gw[n] / Ji.det();
+			m_J0w[m_J0off[i] + n] = w0;
+
+			const double* Gr = el.Gr(n);
+			const double* Gs = el.Gs(n);
+			const double* Gt = el.Gt(n);
+			for (int j=0; j<neln; ++j)
+			{
+				G0[j].x = (Ji[0][0]*Gr[j] + Ji[1][0]*Gs[j] + Ji[2][0]*Gt[j])*w0;
+				G0[j].y = (Ji[0][1]*Gr[j] + Ji[1][1]*Gs[j] + Ji[2][1]*Gt[j])*w0;
+				G0[j].z = (Ji[0][2]*Gr[j] + Ji[1][2]*Gs[j] + Ji[2][2]*Gt[j])*w0;
+			}
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! calculate the volume of an element
 double FESolidDomain::Volume(FESolidElement& el)
@@ -48,6 +48,10 @@ public:
     
     //! copy data from another domain (overridden from FEDomain)
     void CopyFrom(FEDomain* pd) override;
+
+	//! reorder the elements so that element i becomes element P[i]
+	//! (This must be called before the domain is initialized.)
+	void PermuteElements(const vector<int>& P);
     
     //! element access
     FESolidElement& Element(int n) { return m_Elem[n]; }
@@ -166,6 +170,35 @@ public:
     //! calculate spatial gradient of shapefunctions at integration point in reference frame (returns Jacobian determinant)
     double ShapeGradient0(FESolidElement& el, double r, double s, double t, vec3d* GradH);
 
+	//! calculate the spatial gradients of the shape functions and the Jacobian determinants at all
+	//! integration points of an element in one pass. G must have room for nint*neln values
+	//! (the gradients of integration point n start at G[n*neln]) and J for nint values.
+	//! alpha defines the intermediate configuration (as in ShapeGradient)
+	void ShapeGradients(FESolidElement& el, vec3d* G, double* J, double alpha = 1.0);
+
+	//! calculate the deformation gradients and their determinants at all integration points
+	//! (this uses the reference gradient cache when it is on)
+	void defgrads(FESolidElement& el, mat3d* F, double* J);
+
+	//! reference Jacobian determinant times the integration weight at integration point n
+	//! (this uses the reference gradient cache when it is on)
+	double detJ0w(FESolidElement& el, int n);
+
+public:
+	//! Turn on or off the cache of the reference shape function gradients.
+	//! The cache stores grad0(N)*detJ0*w for all integration points of all elements,
+	//! which saves flops in the kernels that need them at the cost of memory.
+	void CacheReferenceGradients(bool b);
+
+	//! see if the reference gradients are cached
+	bool ReferenceGradientsCached() const { return (m_G0.empty() == false); }
+
+	//! cached reference gradients (times detJ0*w) at integration point n of element iel
+	const vec3d* ReferenceGradients(int iel, int n) const { return &m_G0[m_G0off[iel] + n*m_Elem[iel].Nodes()]; }
+
+	//! cached detJ0*w at integration point n of element iel
+	double ReferenceWeight(int iel, int n) const { return m_J0w[m_J0off[iel] + n]; }
+
 	//! calculate the volume of an element
 	double Volume(FESolidElement& el);
 
@@ -182,6 +215,13 @@ public:
 
 protected:
     vector<FESolidElement>	m_Elem;		//!< array of elements
+
+	// reference gradient cache (empty when off)
+	vector<vec3d>	m_G0;		//!< grad0(N)*detJ0*w
+	vector<double>	m_J0w;		//!< detJ0*w
+	vector<int>		m_G0off;	//!< offset of each element in m_G0
+	vector<int>		m_J0off;	//!< offset of each element in m_J0w
+
     int     m_dofx;
     int     m_dofy;
     int     m_dofz;
@@ -28,6 +28,8 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FESolver.h"
 #include "FEModel.h"
+#include "FENodeReorder.h"
+#include "FEFillReducingOrder.h"
 
 BEGIN_PARAMETER_LIST(FESolver, FECoreBase)
 	ADD_PARAMETER(m_bsymm, FE_PARAM_BOOL, "symmetric_stiffness");
@@ -57,6 +59,36 @@ FEModel& FESolver::GetFEModel()
 	return m_fem; 
 }
 
+//-----------------------------------------------------------------------------
+//! Calculate the order in which the nodes are visited when the equation numbers
+//! are assigned. P stores for each new node position the node index. Since all 
+//! linear solvers work with the equation numbering, the fill-reducing orderings
+//! are available to all solvers, regardless of the ordering the solver does itself.
+bool FESolver::EquationNodeOrder(vector<int>& P)
+{
+	FEMesh& mesh = m_fem.GetMesh();
+	int norder = m_fem.EquationOrder();
+	if (norder == EQ_ORDER_ND)
+	{
+		FEFillReducingOrder mod(FEFillReducingOrder::NESTED_DISSECTION);
+		mod.Apply(mesh, P);
+		return true;
+	}
+	else if (norder == EQ_ORDER_AMD)
+	{
+		FEFillReducingOrder mod(FEFillReducingOrder::MINIMUM_DEGREE);
+		mod.Apply(mesh, P);
+		return true;
+	}
+	else if (m_fem.OptimizeBandwidth())
+	{
+		FENodeReorder mod;
+		mod.Apply(mesh, P);
+		return true;
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 void FESolver::Clean()
 {
@@ -98,6 +98,16 @@ public:
 
     //! Generate warnings if needed
     virtual void SolverWarnings() {}
+
+	//! Estimate of the relative local time integration error of the last converged
+	//! time step. This is used by the time step controller when an error tolerance
+	//! is set. A negative value means that the solver does not provide an estimate.
+	virtual double TimeStepError() { return -1.0; }
+
+protected:
+	//! calculate the order in which the nodes are assigned equation numbers
+	//! (returns false if the nodes are numbered in their natural order)
+	bool EquationNodeOrder(vector<int>& P);
     
 protected:
 	FEModel&	m_fem;
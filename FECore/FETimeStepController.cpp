@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FEDataLoadCurve.h"
 #include "FEAnalysis.h"
 #include "FEModel.h"
+#include "FESolver.h"
 #include "log.h"
 
 #define MIN(a,b) ((a)<(b) ? (a) : (b))
@@ -43,6 +44,7 @@ BEGIN_PARAMETER_LIST(FETimeStepController, FEParamContainer)
 	ADD_PARAMETER(m_dtmax, FE_PARAM_DOUBLE, "dtmax");
 	ADD_PARAMETER(m_naggr, FE_PARAM_INT, "aggressiveness");
 	ADD_PARAMETER(m_dtforce, FE_PARAM_BOOL, "dtforce");
+	ADD_PARAMETER(m_errtol, FE_PARAM_DOUBLE, "err_tol");
 END_PARAMETER_LIST();
 
 //-----------------------------------------------------------------------------
@@ -56,6 +58,7 @@ FETimeStepController::FETimeStepController(FEAnalysis* step) : m_step(step)
 	m_nmplc = -1;
 	m_iteopt = 11;
 	m_dtmax = m_dtmin = 0;
+	m_errtol = 0;
 
 	m_ddt = 0;
 	m_dtp = 0;
@@ -72,6 +75,7 @@ void FETimeStepController::CopyFrom(FETimeStepController* tc)
 	m_iteopt = tc->m_iteopt;
 	m_dtmin = tc->m_dtmin;
 	m_dtmax = tc->m_dtmax;
+	m_errtol = tc->m_errtol;
 
 	m_ddt = tc->m_ddt;
 	m_dtp = tc->m_dtp;
@@ -173,6 +177,17 @@ void FETimeStepController::AutoTimeStep(int niter)
 		// if the force flag is set, we just set the time step to the max value
 		dtn = dtmax;
 	}
+	else if ((niter > 0) && (m_errtol > 0) && (m_step->GetFESolver()->TimeStepError() >= 0))
+	{
+		// error-controlled step size
+		dtn = ErrorTimeStep(m_step->GetFESolver()->TimeStepError(), dtmax);
+
+		// Report new time step size
+		if (dtn > dt)
+			felog.printf("\nAUTO STEPPER: increasing time step, dt = %lg\n\n", dtn);
+		else if (dtn < dt)
+			felog.printf("\nAUTO STEPPER: decreasing time step, dt = %lg\n\n", dtn);
+	}
 	else if (niter > 0)
 	{
 		double scale = sqrt((double)m_iteopt / (double)niter);
@@ -218,6 +233,38 @@ void FETimeStepController::AutoTimeStep(int niter)
 	m_step->m_dt = dtn;
 }
 
+//-----------------------------------------------------------------------------
+//! Calculates the new time step size from the estimate of the relative local
+//! error of the last time step. The estimate is assumed to be of second order
+//! in the step size (e.g. the difference between a first-order predictor and
+//! the corrected solution), so that dtn = dt*(tol/err)^(1/2). A safety factor
+//! is applied and the change in step size is limited to avoid oscillations.
+double FETimeStepController::ErrorTimeStep(double err, double dtmax)
+{
+	const double safety = 0.9;
+	const double fmin = 0.2;
+	const double fmax = 2.0;
+
+	double dt = m_step->m_dt;
+
+	double f = fmax;
+	if (err > 0) f = safety*sqrt(m_errtol / err);
+	f = MAX(fmin, MIN(fmax, f));
+
+	felog.printf("\nAUTO STEPPER: error estimate = %lg (tolerance = %lg)\n", err, m_errtol);
+
+	double dtn = dt*f;
+
+	// if the last step was shortened by the must-point controller
+	// and the error allows it, we continue with the previous step size
+	if ((f >= 1.0) && (dtn < m_dtp)) dtn = m_dtp;
+
+	dtn = MAX(dtn, m_dtmin);
+	dtn = MIN(dtn, dtmax);
+
+	return dtn;
+}
+
 //-----------------------------------------------------------------------------
 //! This function makes sure that no must points are passed. It returns an
 //! updated value (less than dt) if t + dt would pass a must point. Otherwise
@@ -294,6 +341,7 @@ void FETimeStepController::Serialize(DumpStream& ar)
 		ar << m_iteopt;
 		ar << m_dtmin;
 		ar << m_dtmax;
+		ar << m_errtol;
 
 		ar << m_ddt;
 		ar << m_dtp;
@@ -309,6 +357,7 @@ void FETimeStepController::Serialize(DumpStream& ar)
 		ar >> m_iteopt;
 		ar >> m_dtmin;
 		ar >> m_dtmax;
+		ar >> m_errtol;
 
 		ar >> m_ddt;
 		ar >> m_dtp;
@@ -56,6 +56,9 @@ public:
 	//! Update Time step
 	void AutoTimeStep(int niter);
 
+	//! Calculate a new time step from the solver's error estimate
+	double ErrorTimeStep(double err, double dtmax);
+
 	//! Adjust for must points
 	double CheckMustPoints(double t, double dt);
 
@@ -72,6 +75,7 @@ public:
 	int		m_iteopt;		//!< optimum nr of iterations
 	double	m_dtmin;		//!< min time step size
 	double	m_dtmax;		//!< max time step size
+	double	m_errtol;		//!< local time integration error tolerance (0 = use iteration count)
 
 private:
 	double	m_ddt;			//!< used by auto-time stepper
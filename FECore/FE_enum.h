@@ -262,7 +262,9 @@ enum FE_Linear_Solver_Type {
 	HYPRE_GMRES,
 	STOKES_SOLVER,
 	CG_STOKES_SOLVER,
-	SCHUR_SOLVER
+	SCHUR_SOLVER,
+	BLOCK_GMRES_SOLVER,
+	MIXED_PRECISION_SOLVER	// use only where available
 };
 
 ///////////////////////////////////////////////////////////////////////////////
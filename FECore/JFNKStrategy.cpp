@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FENewtonSolver.h"
 #include "JFNKMatrix.h"
 #include "FEException.h"
+#include "FEProfiler.h"
 
 JFNKStrategy::JFNKStrategy(FENewtonSolver* pns) : FENewtonStrategy(pns)
 {
@@ -83,6 +84,7 @@ bool JFNKStrategy::Update(double s, vector<double>& ui, vector<double>& R0, vect
 void JFNKStrategy::SolveEquations(vector<double>& x, vector<double>& b)
 {
 	// perform a backsubstitution
+	PROFILE_SCOPE("backsolve");
 	if (m_plinsolve->BackSolve(x, b) == false)
 	{
 		throw LinearSolverFailed();
@@ -168,15 +168,14 @@ void Logfile::close()
 //
 void Logfile::printf(const char* sz, ...)
 {
-	static char szmsg[1024] = {0};
-
 	// get a pointer to the argument list
 	va_list	args;
 
 	// make the message
-	static char sztxt[1024] = {0};
+	// (the buffer is local since models in different threads can print at the same time)
+	char sztxt[1024] = {0};
 	va_start(args, sz);
-	vsprintf(sztxt, sz, args);
+	vsnprintf(sztxt, sizeof(sztxt), sz, args);
 	va_end(args);
 	
 	// print to file
@@ -196,9 +195,9 @@ void Logfile::printbox(const char* sztitle, const char* sz, ...)
 	va_list	args;
 
 	// make the message
-	static char sztxt[1024] = {0};
+	char sztxt[1024] = {0};
 	va_start(args, sz);
-	vsprintf(sztxt, sz, args);
+	vsnprintf(sztxt, sizeof(sztxt), sz, args);
 	va_end(args);
 
 	// print the box
@@ -231,7 +230,7 @@ void Logfile::printbox(const char* sztitle, const char* sz, ...)
 	sprintf(ch," *************************************************************************\n");
 
 	// print the message
-	printf(szmsg);
+	printf("%s", szmsg);
 }
 
 
@@ -84,8 +84,8 @@ private:
 //! This class can output to different 
 //! files at the same time.
 //! At this time it outputs data to the screen (stdout) and to an external text file.
-//! Note that this class is implemented as a singleton, in other words, only one
-//! instance can be created.
+//! The log file of the kernel is obtained with GetInstance. Models that are solved
+//! on separate threads can be given their own log file (see FEModel::SetLogfile).
 
 class FECORE_API Logfile
 {
@@ -97,6 +97,9 @@ public:
 	//! obtain a pointer to the logfile
 	static Logfile* GetInstance();
 
+	//! constructor
+	Logfile();
+
 	//! destructor
 	virtual ~Logfile();
 
@@ -137,8 +140,6 @@ public:
 	operator FILE* () { return (m_fp ? m_fp->GetFileHandle() : 0); }
 
 private:
-	//! constructor is private so that you cannot create it directly
-	Logfile();
 	Logfile(const Logfile& log){}
 
 protected:
@@ -151,6 +151,46 @@ void SparseMatrixProfile::ColumnProfile::insertRow(int row)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// Since the row entries are sorted and adjacent entries are always merged, each
+// row entry of a must be contained in a single row entry of this column.
+bool SparseMatrixProfile::ColumnProfile::contains(const SparseMatrixProfile::ColumnProfile& a) const
+{
+	int N = size();
+	int n = 0;
+	for (int i=0; i<a.size(); ++i)
+	{
+		const RowEntry& ra = a.m_data[i];
+		while ((n < N) && (m_data[n].end < ra.start)) ++n;
+		if ((n == N) || (m_data[n].start > ra.start) || (m_data[n].end < ra.end)) return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SparseMatrixProfile::ColumnProfile::merge(const SparseMatrixProfile::ColumnProfile& a)
+{
+	if (a.m_data.empty()) return;
+	if (m_data.empty()) { m_data = a.m_data; return; }
+
+	vector<RowEntry> data;
+	data.reserve(m_data.size() + a.m_data.size());
+
+	int n0 = 0, n1 = 0;
+	int N0 = size(), N1 = a.size();
+	while ((n0 < N0) || (n1 < N1))
+	{
+		// take the entry that starts first
+		const RowEntry& re = ((n1 == N1) || ((n0 < N0) && (m_data[n0].start <= a.m_data[n1].start)) ? m_data[n0++] : a.m_data[n1++]);
+
+		// merge it with the last entry if they overlap or are adjacent
+		if (data.empty() || (re.start > data.back().end + 1)) data.push_back(re);
+		else if (re.end > data.back().end) data.back().end = re.end;
+	}
+
+	m_data = data;
+}
+
 //-----------------------------------------------------------------------------
 //! MatrixProfile constructor. Takes the nr of equations as input argument.
 //! If n is larger than zero a default profile is constructor for a diagonal
@@ -211,6 +251,36 @@ void SparseMatrixProfile::Clear()
 	m_prof.clear(); 
 }
 
+//-----------------------------------------------------------------------------
+int SparseMatrixProfile::NonZeroes() const
+{
+	int nnz = 0;
+	for (int i=0; i<(int)m_prof.size(); ++i)
+	{
+		const ColumnProfile& a = m_prof[i];
+		for (int j=0; j<a.size(); ++j) nnz += a[j].end - a[j].start + 1;
+	}
+	return nnz;
+}
+
+//-----------------------------------------------------------------------------
+bool SparseMatrixProfile::Contains(const SparseMatrixProfile& mp) const
+{
+	if ((mp.m_nrow != m_nrow) || (mp.m_ncol != m_ncol)) return false;
+	for (int i=0; i<m_ncol; ++i)
+	{
+		if (m_prof[i].contains(mp.m_prof[i]) == false) return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SparseMatrixProfile::Merge(const SparseMatrixProfile& mp)
+{
+	assert((mp.m_nrow == m_nrow) && (mp.m_ncol == m_ncol));
+	for (int i=0; i<m_ncol; ++i) m_prof[i].merge(mp.m_prof[i]);
+}
+
 //-----------------------------------------------------------------------------
 //! Updates the profile. The LM array contains a list of elements that contribute
 //! to the sparse matrix. Each "element" defines a set of degrees of freedom that
@@ -84,6 +84,12 @@ public:
 		// add row index to column profile
 		void insertRow(int row);
 
+		// see if all rows of a are also in this column
+		bool contains(const ColumnProfile& a) const;
+
+		// add the rows of a to this column
+		void merge(const ColumnProfile& a);
+
 	private:
 		vector<RowEntry>	m_data;	// the column profile data
 	};
@@ -116,6 +122,15 @@ public:
 	//! returns the non-zero row indices (in condensed format) for a column
 	ColumnProfile& Column(int i) { return m_prof[i]; }
 
+	//! returns the number of nonzeroes in the profile
+	int NonZeroes() const;
+
+	//! see if all the nonzeroes of mp are also part of this profile
+	bool Contains(const SparseMatrixProfile& mp) const;
+
+	//! add the nonzeroes of mp to this profile
+	void Merge(const SparseMatrixProfile& mp);
+
 	// Extracts a block profile
 	SparseMatrixProfile GetBlockProfile(int nrow0, int ncol0, int nrow1, int ncol1) const;
 
@@ -63,33 +63,65 @@ void NodeDataRecord::Parse(const char* szexpr)
 }
 
 //-----------------------------------------------------------------------------
+// The items are node IDs, which are not the same as the node indices when the
+// mesh was reordered.
 double NodeDataRecord::Evaluate(int item, int ndata)
 {
-	FEMesh& mesh = m_pfem->GetMesh();
-	int nnode = item - 1;
-	assert((nnode>=0)&&(nnode<mesh.Nodes()));
-	if ((nnode < 0) || (nnode >= mesh.Nodes())) return 0;
+	// make sure we have a NLT
+	if (m_NLT.empty()) BuildNLT();
+
+	// find the node
+	int index = item - m_offset;
+	if ((index < 0) || (index >= (int) m_NLT.size())) return 0;
+	int nnode = m_NLT[index];
+	assert(nnode >= 0);
+	if (nnode < 0) return 0;
+	assert(m_pfem->GetMesh().Node(nnode).GetID() == item);
 	return m_Data[ndata]->value(nnode);
 }
 
+//-----------------------------------------------------------------------------
+void NodeDataRecord::BuildNLT()
+{
+	m_NLT.clear();
+	FEMesh& m = m_pfem->GetMesh();
+	int NN = m.Nodes();
+	if (NN == 0) return;
+
+	// find the min, max ID
+	int minID = m.Node(0).GetID(), maxID = minID;
+	for (int i=1; i<NN; ++i)
+	{
+		int id = m.Node(i).GetID();
+		if (id < minID) minID = id;
+		if (id > maxID) maxID = id;
+	}
+
+	// build lookup table
+	m_offset = minID;
+	m_NLT.assign(maxID - minID + 1, -1);
+	for (int i=0; i<NN; ++i) m_NLT[m.Node(i).GetID() - minID] = i;
+}
+
 //-----------------------------------------------------------------------------
 void NodeDataRecord::SelectAllItems()
 {
-	int n = m_pfem->GetMesh().Nodes();
+	FEMesh& m = m_pfem->GetMesh();
+	int n = m.Nodes();
 	m_item.resize(n);
-	for (int i=0; i<n; ++i) m_item[i] = i+1;
+	for (int i=0; i<n; ++i) m_item[i] = m.Node(i).GetID();
 }
 
 //-----------------------------------------------------------------------------
 // This sets the item list based on a node set.
-// Note that node sets store the nodes in a zero-based list. However, we need
-// a one-base list here.
+// Note that node sets store the node indices. However, we need the node IDs here.
 void NodeDataRecord::SetItemList(FENodeSet* pns)
 {
+	FEMesh& m = m_pfem->GetMesh();
 	int n = pns->size();
 	assert(n);
 	m_item.resize(n);
-	for (int i=0; i<n; ++i) m_item[i] = (*pns)[i] + 1;
+	for (int i=0; i<n; ++i) m_item[i] = m.Node((*pns)[i]).GetID();
 }
 
 //-----------------------------------------------------------------------------
@@ -50,7 +50,7 @@ protected:
 class FECORE_API NodeDataRecord : public DataRecord
 {
 public:
-	NodeDataRecord(FEModel* pfem, const char* szfile) : DataRecord(pfem, szfile, FE_DATA_NODE){}
+	NodeDataRecord(FEModel* pfem, const char* szfile) : DataRecord(pfem, szfile, FE_DATA_NODE){ m_offset = 0; }
 	double Evaluate(int item, int ndata);
 	void Parse(const char* sz);
 	void SelectAllItems();
@@ -58,6 +58,11 @@ public:
 	int Size() { return (int) m_Data.size(); }
 
 private:
+	void BuildNLT();
+
+private:
+	vector<int>				m_NLT;		//!< node lookup table (node ID - m_offset -> node index)
+	int						m_offset;	//!< smallest node ID
 	vector<FENodeLogData*>	m_Data;
 };
 
@@ -28,6 +28,7 @@ SOFTWARE.*/
 #pragma once
 #include "fecore_api.h"
 #include "FECoreKernel.h"
+#include "FEProfiler.h"
 #include <vector>
 #include <string>
 
@@ -98,4 +99,9 @@ private:
 	Timer&	m_timer;
 };
 
-#define TRACK_TIME(timerName) static Timer* _timer = FECoreKernel::GetInstance().FindTimer(timerName); TimerTracker _trackTimer(*_timer);
+//-----------------------------------------------------------------------------
+// Tracks the time spent in the enclosing block with the named timer. This also
+// opens a profile scope with the same name (see FEProfiler).
+// The timer belongs to the model of the calling thread (see FEModelScope), so it is
+// looked up each time.
+#define TRACK_TIME(timerName) Timer* _timer = FECoreKernel::GetInstance().FindTimer(timerName); TimerTracker _trackTimer(*_timer); FEProfileScope _trackScope(timerName);
@@ -78,6 +78,7 @@ vector<double> operator * (matrix& m, vector<double>& b)
 //-----------------------------------------------------------------------------
 void matrix::alloc(int nr, int nc)
 {
+	m_bext = false;
 	m_nr = nr;
 	m_nc = nc;
 	m_nsize = nr*nc;
@@ -98,11 +99,28 @@ matrix::matrix(int nr, int nc)
 //! matrix destructor
 void matrix::clear()
 {
-	if (m_pr) delete [] m_pr;
-	if (m_pd) delete [] m_pd;
+	if (m_bext == false)
+	{
+		if (m_pr) delete [] m_pr;
+		if (m_pd) delete [] m_pd;
+	}
 	m_pd = 0;
 	m_pr = 0;
 	m_nr = m_nc = 0;
+	m_bext = false;
+}
+
+//-----------------------------------------------------------------------------
+void matrix::attach(int nr, int nc, double* pd, double** pr)
+{
+	clear();
+	m_nr = nr;
+	m_nc = nc;
+	m_nsize = nr*nc;
+	m_pd = pd;
+	m_pr = pr;
+	for (int i=0; i<nr; i++) m_pr[i] = m_pd + i*nc;
+	m_bext = true;
 }
 
 //-----------------------------------------------------------------------------
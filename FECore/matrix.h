@@ -38,7 +38,7 @@ class FECORE_API matrix
 {
 public:
 	//! constructor
-	matrix() : m_nr(0), m_nc(0), m_nsize(0), m_pd(0), m_pr(0) {}
+	matrix() : m_nr(0), m_nc(0), m_nsize(0), m_pd(0), m_pr(0), m_bext(false) {}
 
 	//! constructor
 	matrix(int nr, int nc);
@@ -162,6 +162,12 @@ private:
 	void alloc(int nr, int nc);
 	void clear();
 
+protected:
+	//! use storage that is owned by someone else (e.g. a derived class).
+	//! The matrix will not delete this storage. If the matrix is resized,
+	//! it switches back to its own heap storage.
+	void attach(int nr, int nc, double* pd, double** pr);
+
 protected:
 	double**	m_pr;	// pointer to rows
 	double*		m_pd;	// matrix elements
@@ -169,6 +175,47 @@ protected:
 	int	m_nr;		// nr of rows
 	int	m_nc;		// nr of columns
 	int	m_nsize;	// size of matrix (ie. total nr of elements = nr*nc)
+
+	bool	m_bext;		// storage is not owned by this matrix
+};
+
+//-----------------------------------------------------------------------------
+//! Matrix with compile-time dimensions whose storage lives inside the object.
+
+//! This can be used for element matrices of elements with a fixed number of
+//! nodes and dofs (e.g. HEX8 x 3). It avoids the heap allocations of matrix
+//! and since the row length is known at compile time, loops over the entries
+//! can be unrolled and vectorized. Since it derives from matrix it can be
+//! passed to all assembly routines.
+template <int R, int C> class fixed_matrix : public matrix
+{
+public:
+	enum { ROWS = R, COLS = C };
+
+public:
+	fixed_matrix() { attach(R, C, &m_buf[0][0], m_row); }
+	fixed_matrix(const fixed_matrix& m) : matrix() { attach(R, C, &m_buf[0][0], m_row); memcpy(m_buf, m.m_buf, sizeof(m_buf)); }
+	fixed_matrix& operator = (const fixed_matrix& m) { memcpy(m_buf, m.m_buf, sizeof(m_buf)); return *this; }
+
+	//! access operators (with compile-time row length)
+	double* operator [] (int i) { assert(m_pd == &m_buf[0][0]); return m_buf[i]; }
+	const double* operator [] (int i) const { return m_buf[i]; }
+	double& operator () (int i, int j) { return m_buf[i][j]; }
+	double operator () (int i, int j) const { return m_buf[i][j]; }
+
+	void zero() { memset(m_buf, 0, sizeof(m_buf)); }
+
+	//! make the (square) matrix symmetric by copying the upper triangular part
+	void copy_ut()
+	{
+		assert(R == C);
+		for (int i=0; i<R; ++i)
+			for (int j=i+1; j<R; ++j) m_buf[j][i] = m_buf[i][j];
+	}
+
+private:
+	double	m_buf[R][C];
+	double*	m_row[R];
 };
 
 vector<double> FECORE_API operator / (vector<double>& b, matrix& m);
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include <assert.h>
 #include "mortar.h"
 #include <math.h>
+#include <algorithm>
 #include <FECore/FEMesh.h>
 
 //-----------------------------------------------------------------------------
@@ -565,6 +566,254 @@ void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& mortar)
 	}
 }
 
+//-----------------------------------------------------------------------------
+FacetBoxTree::FacetBoxTree()
+{
+	m_ps = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FacetBoxTree::FacetBox(FESurface& s, int n, vec3d& r0, vec3d& r1)
+{
+	FESurfaceElement& el = s.Element(n);
+	r0 = r1 = s.Node(el.m_lnode[0]).m_rt;
+	int ne = el.Nodes();
+	for (int i=1; i<ne; ++i)
+	{
+		vec3d& r = s.Node(el.m_lnode[i]).m_rt;
+		if (r.x < r0.x) r0.x = r.x; if (r.x > r1.x) r1.x = r.x;
+		if (r.y < r0.y) r0.y = r.y; if (r.y > r1.y) r1.y = r.y;
+		if (r.z < r0.z) r0.z = r.z; if (r.z > r1.z) r1.z = r.z;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FacetBoxTree::IsValid(FESurface& s) const
+{
+	return ((m_ps == &s) && ((int) m_facet.size() == s.Elements()));
+}
+
+//-----------------------------------------------------------------------------
+void FacetBoxTree::Build(FESurface& s)
+{
+	m_ps = &s;
+	m_node.clear();
+	int NF = s.Elements();
+	m_facet.resize(NF);
+	if (NF == 0) return;
+
+	// facet centers are used for splitting
+	vector<vec3d> c(NF), r0(NF), r1(NF);
+	for (int i=0; i<NF; ++i)
+	{
+		m_facet[i] = i;
+		FacetBox(s, i, r0[i], r1[i]);
+		c[i] = (r0[i] + r1[i])*0.5;
+	}
+
+	NODE root;
+	m_node.push_back(root);
+	BuildNode(0, 0, NF, c);
+
+	// calculate the boxes (children are stored after their parent)
+	for (int i=(int)m_node.size()-1; i>=0; --i) FitNode(i, r0, r1);
+}
+
+//-----------------------------------------------------------------------------
+// helper class for sorting facets along an axis
+class FacetAxisCompare
+{
+public:
+	FacetAxisCompare(vector<vec3d>& c, int axis) : m_c(c), m_axis(axis) {}
+	bool operator () (int a, int b) const
+	{
+		const vec3d& ra = m_c[a];
+		const vec3d& rb = m_c[b];
+		if (m_axis == 0) return (ra.x < rb.x);
+		if (m_axis == 1) return (ra.y < rb.y);
+		return (ra.z < rb.z);
+	}
+private:
+	vector<vec3d>&	m_c;
+	int				m_axis;
+};
+
+//-----------------------------------------------------------------------------
+void FacetBoxTree::BuildNode(int n, int first, int count, vector<vec3d>& c)
+{
+	// max number of facets in a leaf
+	const int MAX_LEAF = 4;
+
+	m_node[n].first = first;
+	m_node[n].count = count;
+	m_node[n].child = -1;
+	if (count <= MAX_LEAF) return;
+
+	// find the longest axis of the box around the facet centers
+	vec3d a = c[m_facet[first]], b = a;
+	for (int i=first+1; i<first+count; ++i)
+	{
+		vec3d& r = c[m_facet[i]];
+		if (r.x < a.x) a.x = r.x; if (r.x > b.x) b.x = r.x;
+		if (r.y < a.y) a.y = r.y; if (r.y > b.y) b.y = r.y;
+		if (r.z < a.z) a.z = r.z; if (r.z > b.z) b.z = r.z;
+	}
+	vec3d d = b - a;
+	int axis = 0;
+	if ((d.y >= d.x) && (d.y >= d.z)) axis = 1;
+	else if ((d.z >= d.x) && (d.z >= d.y)) axis = 2;
+
+	// split at the median
+	int half = count/2;
+	vector<int>::iterator it = m_facet.begin() + first;
+	nth_element(it, it + half, it + count, FacetAxisCompare(c, axis));
+
+	// create the children
+	int nc = (int) m_node.size();
+	m_node[n].child = nc;
+	NODE child;
+	m_node.push_back(child);
+	m_node.push_back(child);
+	BuildNode(nc    , first       , half        , c);
+	BuildNode(nc + 1, first + half, count - half, c);
+}
+
+//-----------------------------------------------------------------------------
+// Calculates the box of a node from its facets (leaf) or its children.
+// The children must be up to date.
+void FacetBoxTree::FitNode(int n, vector<vec3d>& r0, vector<vec3d>& r1)
+{
+	NODE& node = m_node[n];
+	if (node.child >= 0)
+	{
+		NODE& a = m_node[node.child];
+		NODE& b = m_node[node.child + 1];
+		node.r0 = vec3d(min(a.r0.x, b.r0.x), min(a.r0.y, b.r0.y), min(a.r0.z, b.r0.z));
+		node.r1 = vec3d(max(a.r1.x, b.r1.x), max(a.r1.y, b.r1.y), max(a.r1.z, b.r1.z));
+	}
+	else
+	{
+		int m = m_facet[node.first];
+		node.r0 = r0[m];
+		node.r1 = r1[m];
+		for (int i=1; i<node.count; ++i)
+		{
+			m = m_facet[node.first + i];
+			node.r0 = vec3d(min(node.r0.x, r0[m].x), min(node.r0.y, r0[m].y), min(node.r0.z, r0[m].z));
+			node.r1 = vec3d(max(node.r1.x, r1[m].x), max(node.r1.y, r1[m].y), max(node.r1.z, r1[m].z));
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FacetBoxTree::Refit(FESurface& s)
+{
+	assert(IsValid(s));
+	int NF = s.Elements();
+	if (NF == 0) return;
+
+	vector<vec3d> r0(NF), r1(NF);
+	for (int i=0; i<NF; ++i) FacetBox(s, i, r0[i], r1[i]);
+
+	// Children are always stored after their parent, so going backwards
+	// guarantees that the children are updated before their parent.
+	for (int i=(int)m_node.size()-1; i>=0; --i) FitNode(i, r0, r1);
+}
+
+//-----------------------------------------------------------------------------
+void FacetBoxTree::FindFacets(const vec3d& r0, const vec3d& r1, vector<int>& facets) const
+{
+	facets.clear();
+	if (m_node.empty()) return;
+
+	int stack[128];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const NODE& node = m_node[stack[--ns]];
+		if ((node.r0.x > r1.x) || (node.r1.x < r0.x) ||
+			(node.r0.y > r1.y) || (node.r1.y < r0.y) ||
+			(node.r0.z > r1.z) || (node.r1.z < r0.z)) continue;
+
+		if (node.child >= 0)
+		{
+			assert(ns + 2 <= 128);
+			stack[ns++] = node.child;
+			stack[ns++] = node.child + 1;
+		}
+		else
+		{
+			for (int i=0; i<node.count; ++i) facets.push_back(m_facet[node.first + i]);
+		}
+	}
+
+	// sort so that patches are always generated in the same order
+	sort(facets.begin(), facets.end());
+}
+
+//-----------------------------------------------------------------------------
+void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& mortar, FacetBoxTree& tree, double srad)
+{
+	// without a search radius all facet pairs are intersected
+	bool bsearch = (srad > 0.0);
+
+	// build or update the tree for the mortar facets
+	if (bsearch)
+	{
+		if (tree.IsValid(ms) == false) tree.Build(ms);
+		else tree.Refit(ms);
+	}
+	int NMF = ms.Elements();
+
+	// The patches are stored per non-mortar facet, so that the facets can be
+	// processed in parallel and the final order does not depend on the threads.
+	int NSF = ss.Elements();
+	vector< vector<Patch> > patches(NSF);
+
+#pragma omp parallel
+	{
+		vector<int> facets;
+		if (bsearch == false)
+		{
+			facets.resize(NMF);
+			for (int k=0; k<NMF; ++k) facets[k] = k;
+		}
+
+#pragma omp for schedule(dynamic, 16)
+		for (int i=0; i<NSF; ++i)
+		{
+			if (bsearch)
+			{
+				// get the box of the non-mortar facet and inflate it by the search radius
+				vec3d r0, r1;
+				FacetBoxTree::FacetBox(ss, i, r0, r1);
+				double d = srad*0.5*(r1 - r0).norm();
+				r0 -= vec3d(d, d, d);
+				r1 += vec3d(d, d, d);
+
+				// find all the mortar facets that may overlap
+				tree.FindFacets(r0, r1, facets);
+			}
+
+			// calculate the patch of triangles, representing the intersection
+			// of the non-mortar facet with the mortar facet
+			for (int k=0; k<(int)facets.size(); ++k)
+			{
+				Patch patch(i, facets[k]);
+				if (CalculateMortarIntersection(ss, ms, i, facets[k], patch)) patches[i].push_back(patch);
+			}
+		}
+	}
+
+	for (int i=0; i<NSF; ++i)
+	{
+		vector<Patch>& pi = patches[i];
+		for (int k=0; k<(int)pi.size(); ++k) mortar.AddPatch(pi[k]);
+	}
+}
+
+//-----------------------------------------------------------------------------
 bool ExportMortar(MortarSurface& mortar, const char* szfile)
 {
 	FILE* fp = fopen(szfile, "wt");
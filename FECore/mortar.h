@@ -130,10 +130,62 @@ private:
 // Calculates the intersection between two segments and adds it to the patch
 FECORE_API bool CalculateMortarIntersection(FESurface& ss, FESurface& ms, int k, int l, Patch& patch);
 
+//-----------------------------------------------------------------------------
+//! Bounding-box tree over the facets of a surface.
+
+//! This is used as a broad phase for the mortar calculation so that only facets
+//! whose bounding boxes overlap need to be intersected. The tree is built once
+//! and afterwards only the boxes are updated (refitted) when the nodes move.
+class FECORE_API FacetBoxTree
+{
+	struct NODE
+	{
+		vec3d	r0, r1;		//!< bounding box
+		int		child;		//!< index of first child (second child follows it), or -1 for leaf
+		int		first;		//!< first facet (into m_facet)
+		int		count;		//!< number of facets
+	};
+
+public:
+	FacetBoxTree();
+
+	//! build the tree for the facets of a surface
+	void Build(FESurface& s);
+
+	//! update the bounding boxes using the current nodal positions
+	void Refit(FESurface& s);
+
+	//! see if the tree was built for this surface
+	bool IsValid(FESurface& s) const;
+
+	//! find all facets whose boxes overlap the box [r0, r1] (sorted in ascending order)
+	void FindFacets(const vec3d& r0, const vec3d& r1, vector<int>& facets) const;
+
+	//! calculate the bounding box of a facet in its current position
+	static void FacetBox(FESurface& s, int n, vec3d& r0, vec3d& r1);
+
+private:
+	void BuildNode(int n, int first, int count, vector<vec3d>& c);
+	void FitNode(int n, vector<vec3d>& r0, vector<vec3d>& r1);
+
+private:
+	FESurface*		m_ps;		//!< surface the tree was built for
+	vector<NODE>	m_node;		//!< tree nodes (root is first, children follow their parent)
+	vector<int>		m_facet;	//!< facet indices, ordered by leaf
+};
+
 //-----------------------------------------------------------------------------
 // Calculates the mortar intersection between two surfaces
 FECORE_API void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& s);
 
+//-----------------------------------------------------------------------------
+// Calculates the mortar intersection between two surfaces. Only facet pairs
+// whose boxes overlap are intersected, where the boxes of the non-mortar facets
+// are inflated by srad times their size. The tree must be built for the mortar
+// surface ms (it is built if necessary, otherwise it is refitted).
+// If srad <= 0, all facet pairs are intersected and the tree is not used.
+FECORE_API void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& s, FacetBoxTree& tree, double srad);
+
 //-----------------------------------------------------------------------------
 // Stores the mortar surface in STL format
 FECORE_API bool ExportMortar(MortarSurface& mortar, const char* szfile);
@@ -0,0 +1,463 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "BlockGMRESSolver.h"
+#include <math.h>
+#include <stdio.h>
+#include <assert.h>
+
+//-----------------------------------------------------------------------------
+bool BlockGMRESSolver::ILU0::Init()
+{
+	int n = Rows();
+	m_val.assign(m_col.size(), 0.0);
+	m_diag.assign(n, -1);
+	for (int i=0; i<n; ++i)
+	{
+		for (int j=m_ptr[i]; j<m_ptr[i+1]; ++j)
+			if (m_col[j] == i) { m_diag[i] = j; break; }
+
+		// we need all diagonal entries
+		if (m_diag[i] == -1) return false;
+	}
+	m_iw.assign(n, -1);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool BlockGMRESSolver::ILU0::Factor()
+{
+	int n = Rows();
+	for (int i=0; i<n; ++i)
+	{
+		const int p0 = m_ptr[i];
+		const int p1 = m_ptr[i+1];
+		for (int p=p0; p<p1; ++p) m_iw[m_col[p]] = p;
+
+		// eliminate the lower part of row i
+		for (int p=p0; p<m_diag[i]; ++p)
+		{
+			const int k = m_col[p];
+			const double l = (m_val[p] /= m_val[m_diag[k]]);
+			for (int q=m_diag[k]+1; q<m_ptr[k+1]; ++q)
+			{
+				const int m = m_iw[m_col[q]];
+				if (m >= 0) m_val[m] -= l*m_val[q];
+			}
+		}
+
+		// make sure we don't divide by zero later
+		double& d = m_val[m_diag[i]];
+		if (fabs(d) < 1e-20)
+		{
+			double rmax = 0.0;
+			for (int p=p0; p<p1; ++p) if (fabs(m_val[p]) > rmax) rmax = fabs(m_val[p]);
+			d = (rmax > 0.0 ? 1e-8*rmax : 1.0);
+		}
+
+		for (int p=p0; p<p1; ++p) m_iw[m_col[p]] = -1;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void BlockGMRESSolver::ILU0::Solve(double* x) const
+{
+	int n = Rows();
+
+	// forward substitution (L has unit diagonal)
+	for (int i=0; i<n; ++i)
+	{
+		double s = x[i];
+		for (int p=m_ptr[i]; p<m_diag[i]; ++p) s -= m_val[p]*x[m_col[p]];
+		x[i] = s;
+	}
+
+	// backward substitution
+	for (int i=n-1; i>=0; --i)
+	{
+		double s = x[i];
+		for (int p=m_diag[i]+1; p<m_ptr[i+1]; ++p) s -= m_val[p]*x[m_col[p]];
+		x[i] = s / m_val[m_diag[i]];
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! constructor
+BlockGMRESSolver::BlockGMRESSolver()
+{
+	m_pA = 0;
+	m_maxiter = 0;	// use default min(N, 1000)
+	m_nrestart = 30;
+	m_tol = 1e-8;
+	m_printLevel = 0;
+	m_nschur = 1;
+	m_iter = 0;
+}
+
+//-----------------------------------------------------------------------------
+//! destructor
+BlockGMRESSolver::~BlockGMRESSolver()
+{
+}
+
+//-----------------------------------------------------------------------------
+void BlockGMRESSolver::SetMaxIterations(int n) { m_maxiter = n; }
+void BlockGMRESSolver::SetNonRestartedIterations(int n) { m_nrestart = n; }
+void BlockGMRESSolver::SetConvergenceTolerance(double tol) { m_tol = tol; }
+void BlockGMRESSolver::SetPrintLevel(int n) { m_printLevel = n; }
+void BlockGMRESSolver::SetSchurBlock(int n) { m_nschur = n; }
+int BlockGMRESSolver::GetIterations() const { return m_iter; }
+
+//-----------------------------------------------------------------------------
+//! Set the partition
+void BlockGMRESSolver::SetPartitions(const vector<int>& part)
+{
+	m_part = part;
+}
+
+//-----------------------------------------------------------------------------
+//! Create a sparse matrix
+SparseMatrix* BlockGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	// we always use a non-symmetric format
+	if (ntype != REAL_UNSYMMETRIC) return 0;
+	m_pA = new CRSSparseMatrix(0);
+	return m_pA;
+}
+
+//-----------------------------------------------------------------------------
+//! set the sparse matrix
+bool BlockGMRESSolver::SetSparseMatrix(SparseMatrix* A)
+{
+	m_pA = dynamic_cast<CRSSparseMatrix*>(A);
+	return (m_pA != 0);
+}
+
+//-----------------------------------------------------------------------------
+//! Preprocess. This sets up the block structure and the sparsity patterns of
+//! the preconditioner.
+bool BlockGMRESSolver::PreProcess()
+{
+	if (m_pA == 0) return false;
+
+	int N = m_pA->Rows();
+	int off = m_pA->Offset();
+	int* ptr = m_pA->Pointers();
+	int* ind = m_pA->Indices();
+
+	// assign the equations to the blocks
+	m_blk.assign(N, 0);
+	int neq = 0;
+	for (int i=0; i<(int)m_part.size(); ++i) neq += m_part[i];
+	if ((m_part.size() >= 2) && (neq == N) && (m_nschur >= 0) && (m_nschur < (int)m_part.size()))
+	{
+		int n0 = 0;
+		for (int i=0; i<m_nschur; ++i) n0 += m_part[i];
+		for (int i=n0; i<n0 + m_part[m_nschur]; ++i) m_blk[i] = 1;
+	}
+
+	m_loc.resize(N);
+	m_eq0.clear();
+	m_eq1.clear();
+	for (int i=0; i<N; ++i)
+	{
+		if (m_blk[i] == 0) { m_loc[i] = (int)m_eq0.size(); m_eq0.push_back(i); }
+		else { m_loc[i] = (int)m_eq1.size(); m_eq1.push_back(i); }
+	}
+	int n0 = (int)m_eq0.size();
+	int n1 = (int)m_eq1.size();
+
+	// structure of A and B blocks
+	m_A.m_ptr.assign(1, 0); m_A.m_col.clear(); m_Amap.clear();
+	m_Bptr.assign(1, 0); m_Bcol.clear(); m_Bmap.clear();
+	for (int k=0; k<n0; ++k)
+	{
+		int i = m_eq0[k];
+		for (int p=ptr[i] - off; p<ptr[i+1] - off; ++p)
+		{
+			int j = ind[p] - off;
+			if (m_blk[j] == 0) { m_A.m_col.push_back(m_loc[j]); m_Amap.push_back(p); }
+			else { m_Bcol.push_back(m_loc[j]); m_Bmap.push_back(p); }
+		}
+		m_A.m_ptr.push_back((int)m_A.m_col.size());
+		m_Bptr.push_back((int)m_Bcol.size());
+	}
+	if (m_A.Init() == false) return false;
+	m_Bval.assign(m_Bcol.size(), 0.0);
+
+	// structure of the Schur complement (same as D, but we make sure the diagonal is there)
+	m_S.m_ptr.assign(1, 0); m_S.m_col.clear(); m_Smap.clear();
+	for (int k=0; k<n1; ++k)
+	{
+		int i = m_eq1[k];
+		bool bdiag = false;
+		for (int p=ptr[i] - off; p<ptr[i+1] - off; ++p)
+		{
+			int j = ind[p] - off;
+			if (m_blk[j] == 1)
+			{
+				int l = m_loc[j];
+				if ((bdiag == false) && (l > k)) { m_S.m_col.push_back(k); m_Smap.push_back(-1); }
+				if (l >= k) bdiag = true;
+				m_S.m_col.push_back(l);
+				m_Smap.push_back(p);
+			}
+		}
+		if (bdiag == false) { m_S.m_col.push_back(k); m_Smap.push_back(-1); }
+		m_S.m_ptr.push_back((int)m_S.m_col.size());
+	}
+	if (m_S.Init() == false) return false;
+
+	m_Ad.resize(n0);
+	m_r0.resize(n0);
+	m_r1.resize(n1);
+
+	m_iter = 0;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Factor matrix. This builds the preconditioner.
+bool BlockGMRESSolver::Factor()
+{
+	int off = m_pA->Offset();
+	int* ptr = m_pA->Pointers();
+	int* ind = m_pA->Indices();
+	double* val = m_pA->Values();
+	int n0 = (int)m_eq0.size();
+	int n1 = (int)m_eq1.size();
+
+	// copy the A and B blocks
+	for (int i=0; i<(int)m_Amap.size(); ++i) m_A.m_val[i] = val[m_Amap[i]];
+	for (int i=0; i<(int)m_Bmap.size(); ++i) m_Bval[i] = val[m_Bmap[i]];
+	for (int i=0; i<n0; ++i)
+	{
+		double d = m_A.m_val[m_A.m_diag[i]];
+		m_Ad[i] = (d != 0.0 ? d : 1.0);
+	}
+
+	// approximate Schur complement: S = D - C*diag(A)^-1*B (only on the pattern of D)
+	for (int i=0; i<(int)m_Smap.size(); ++i) m_S.m_val[i] = (m_Smap[i] >= 0 ? val[m_Smap[i]] : 0.0);
+
+	#pragma omp parallel
+	{
+		vector<int> mark(n1, -1);
+
+		#pragma omp for
+		for (int k=0; k<n1; ++k)
+		{
+			for (int p=m_S.m_ptr[k]; p<m_S.m_ptr[k+1]; ++p) mark[m_S.m_col[p]] = p;
+
+			int i = m_eq1[k];
+			for (int p=ptr[i] - off; p<ptr[i+1] - off; ++p)
+			{
+				int j = ind[p] - off;
+				if (m_blk[j] == 0)
+				{
+					int l = m_loc[j];
+					double c = val[p] / m_Ad[l];
+					for (int q=m_Bptr[l]; q<m_Bptr[l+1]; ++q)
+					{
+						int m = mark[m_Bcol[q]];
+						if (m >= 0) m_S.m_val[m] -= c*m_Bval[q];
+					}
+				}
+			}
+
+			for (int p=m_S.m_ptr[k]; p<m_S.m_ptr[k+1]; ++p) mark[m_S.m_col[p]] = -1;
+		}
+	}
+
+	// factor the diagonal blocks
+	if (m_A.Factor() == false) return false;
+	if (m_S.Factor() == false) return false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// y = K*x
+void BlockGMRESSolver::mult_vector(const double* x, double* y)
+{
+	int N = m_pA->Rows();
+	int off = m_pA->Offset();
+	int* ptr = m_pA->Pointers();
+	int* ind = m_pA->Indices();
+	double* val = m_pA->Values();
+
+	#pragma omp parallel for
+	for (int i=0; i<N; ++i)
+	{
+		double s = 0.0;
+		for (int p=ptr[i] - off; p<ptr[i+1] - off; ++p) s += val[p]*x[ind[p] - off];
+		y[i] = s;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// y = P^-1*x
+void BlockGMRESSolver::precondition(const double* x, double* y)
+{
+	int n0 = (int)m_eq0.size();
+	int n1 = (int)m_eq1.size();
+
+	// solve S*y1 = x1
+	for (int k=0; k<n1; ++k) m_r1[k] = x[m_eq1[k]];
+	if (n1 > 0) m_S.Solve(&m_r1[0]);
+
+	// solve A*y0 = x0 - B*y1
+	for (int k=0; k<n0; ++k)
+	{
+		double s = x[m_eq0[k]];
+		for (int q=m_Bptr[k]; q<m_Bptr[k+1]; ++q) s -= m_Bval[q]*m_r1[m_Bcol[q]];
+		m_r0[k] = s;
+	}
+	if (n0 > 0) m_A.Solve(&m_r0[0]);
+
+	for (int k=0; k<n0; ++k) y[m_eq0[k]] = m_r0[k];
+	for (int k=0; k<n1; ++k) y[m_eq1[k]] = m_r1[k];
+}
+
+//-----------------------------------------------------------------------------
+static double dot(const vector<double>& a, const vector<double>& b)
+{
+	double s = 0.0;
+	for (size_t i=0; i<a.size(); ++i) s += a[i]*b[i];
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+//! Backsolve the linear system, using right-preconditioned restarted GMRES
+bool BlockGMRESSolver::BackSolve(vector<double>& x, vector<double>& b)
+{
+	int N = m_pA->Rows();
+	assert((int)x.size() == N);
+	m_iter = 0;
+
+	int maxiter = (m_maxiter > 0 ? m_maxiter : (N < 1000 ? N : 1000));
+	int m = (m_nrestart > 0 ? m_nrestart : maxiter);
+	if (m > maxiter) m = maxiter;
+
+	x.assign(N, 0.0);
+	double bnorm = sqrt(dot(b, b));
+	if (bnorm == 0.0) return true;
+	double tol = m_tol*bnorm;
+
+	vector< vector<double> > V(m + 1, vector<double>(N));
+	vector< vector<double> > H(m + 1, vector<double>(m, 0.0));
+	vector<double> cs(m), sn(m), g(m + 1), y(m);
+	vector<double> z(N), w(N);
+
+	// initial residual (x = 0)
+	V[0] = b;
+	double beta = bnorm;
+
+	bool bconv = false;
+	while (true)
+	{
+		for (int i=0; i<N; ++i) V[0][i] /= beta;
+		g.assign(m + 1, 0.0); g[0] = beta;
+
+		int k = 0;
+		for (; k<m; ++k)
+		{
+			// w = K*P^-1*v
+			precondition(&V[k][0], &z[0]);
+			mult_vector(&z[0], &w[0]);
+			++m_iter;
+
+			// modified Gram-Schmidt
+			for (int i=0; i<=k; ++i)
+			{
+				double h = dot(w, V[i]);
+				H[i][k] = h;
+				for (int l=0; l<N; ++l) w[l] -= h*V[i][l];
+			}
+			double h = sqrt(dot(w, w));
+			H[k+1][k] = h;
+			if (h != 0.0) for (int l=0; l<N; ++l) V[k+1][l] = w[l] / h;
+
+			// apply previous Givens rotations
+			for (int i=0; i<k; ++i)
+			{
+				double t = cs[i]*H[i][k] + sn[i]*H[i+1][k];
+				H[i+1][k] = -sn[i]*H[i][k] + cs[i]*H[i+1][k];
+				H[i][k] = t;
+			}
+
+			// new rotation
+			double r = sqrt(H[k][k]*H[k][k] + H[k+1][k]*H[k+1][k]);
+			cs[k] = (r != 0.0 ? H[k][k] / r : 1.0);
+			sn[k] = (r != 0.0 ? H[k+1][k] / r : 0.0);
+			H[k][k] = r;
+			H[k+1][k] = 0.0;
+			g[k+1] = -sn[k]*g[k];
+			g[k] = cs[k]*g[k];
+
+			double res = fabs(g[k+1]);
+			if (m_printLevel == 1) fprintf(stdout, "%d: %lg\n", m_iter, res / bnorm);
+
+			if ((res <= tol) || (m_iter >= maxiter) || (h == 0.0)) { ++k; break; }
+		}
+
+		// solve the upper triangular system
+		for (int i=k-1; i>=0; --i)
+		{
+			double s = g[i];
+			for (int j=i+1; j<k; ++j) s -= H[i][j]*y[j];
+			y[i] = s / H[i][i];
+		}
+
+		// update the solution: x += P^-1*V*y
+		w.assign(N, 0.0);
+		for (int i=0; i<k; ++i)
+			for (int l=0; l<N; ++l) w[l] += y[i]*V[i][l];
+		precondition(&w[0], &z[0]);
+		for (int l=0; l<N; ++l) x[l] += z[l];
+
+		// true residual
+		mult_vector(&x[0], &w[0]);
+		for (int l=0; l<N; ++l) V[0][l] = b[l] - w[l];
+		beta = sqrt(dot(V[0], V[0]));
+
+		if (beta <= tol) { bconv = true; break; }
+		if (m_iter >= maxiter) break;
+	}
+
+	if (m_printLevel > 0) fprintf(stdout, "Block GMRES: %d iterations, relative residual = %lg\n", m_iter, beta / bnorm);
+
+	return bconv;
+}
+
+//-----------------------------------------------------------------------------
+//! Clean up
+void BlockGMRESSolver::Destroy()
+{
+}
@@ -0,0 +1,170 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactUnSymmMatrix.h"
+
+//-----------------------------------------------------------------------------
+// This class implements a restarted GMRES solver with a block preconditioner
+// for linear systems that have a saddle-point like 2x2 block structure, e.g.
+//
+//     | A  B | | u |   | f |
+//     | C  D | | p | = | g |
+//
+// as generated by the fluid solvers (velocity and dilatation).
+// The preconditioner is the block upper triangular matrix
+//
+//     | A  B |
+//     | 0  S |
+//
+// where S = D - C*diag(A)^-1*B is an approximation of the Schur complement
+// on the sparsity pattern of D. ILU0 factorizations of A and S are used to
+// apply the preconditioner.
+// The second block is the partition with index schur_block (default 1) of the
+// equation partitions that are set by the FE solver. All other partitions make
+// up the first block. If no partitions are set, the solver uses an ILU0 of the
+// entire matrix.
+// Unlike the other block solvers, this solver does not need MKL.
+class BlockGMRESSolver : public IterativeLinearSolver
+{
+	// ILU0 factorization of a sparse matrix in (zero-based) CSR format
+	class ILU0
+	{
+	public:
+		// Allocate the values once the structure is defined.
+		// This also finds the diagonal entries.
+		bool Init();
+
+		// calculate the factorization (in place)
+		bool Factor();
+
+		// solve LU*x = x (in place)
+		void Solve(double* x) const;
+
+		int Rows() const { return (int)m_ptr.size() - 1; }
+
+	public:
+		vector<int>		m_ptr;	// row pointers
+		vector<int>		m_col;	// column indices (sorted)
+		vector<double>	m_val;	// values
+		vector<int>		m_diag;	// location of diagonal entries
+
+	private:
+		vector<int>		m_iw;	// work array
+	};
+
+public:
+	//! constructor
+	BlockGMRESSolver();
+
+	//! destructor
+	~BlockGMRESSolver();
+
+public:
+	//! Preprocess
+	bool PreProcess() override;
+
+	//! Factor matrix
+	bool Factor() override;
+
+	//! Backsolve the linear system
+	bool BackSolve(vector<double>& x, vector<double>& b) override;
+
+	//! Clean up
+	void Destroy() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* A) override;
+
+	//! Set the partition
+	void SetPartitions(const vector<int>& part) override;
+
+	//! this solver always uses a preconditioner
+	bool HasPreconditioner() const override { return true; }
+
+public:
+	// set max nr of iterations
+	void SetMaxIterations(int n);
+
+	// set the nr of non-restarted iterations
+	void SetNonRestartedIterations(int n);
+
+	// set the relative convergence tolerance
+	void SetConvergenceTolerance(double tol);
+
+	// set the print level
+	void SetPrintLevel(int n);
+
+	// set the partition that defines the Schur complement block
+	void SetSchurBlock(int n);
+
+	// get the iteration count of the last solve
+	int GetIterations() const;
+
+private:
+	// y = K*x
+	void mult_vector(const double* x, double* y);
+
+	// y = P^-1*x
+	void precondition(const double* x, double* y);
+
+private:
+	CRSSparseMatrix*	m_pA;		//!< the global matrix
+	vector<int>			m_part;		//!< partition sizes
+
+	// block structure
+	vector<int>		m_blk;		//!< block (0 or 1) of each equation
+	vector<int>		m_loc;		//!< index of each equation in its block
+	vector<int>		m_eq0;		//!< global equation of each equation in block 0
+	vector<int>		m_eq1;		//!< global equation of each equation in block 1
+
+	// preconditioner data
+	ILU0			m_A;		//!< factorization of A block
+	ILU0			m_S;		//!< factorization of approximate Schur complement
+	vector<int>		m_Amap;		//!< location of A values in global matrix
+	vector<int>		m_Smap;		//!< location of D values in global matrix (or -1)
+	vector<int>		m_Bptr;		//!< B block, row pointers
+	vector<int>		m_Bcol;		//!< B block, column indices (in block 1)
+	vector<int>		m_Bmap;		//!< location of B values in global matrix
+	vector<double>	m_Bval;		//!< B block, values
+	vector<double>	m_Ad;		//!< diagonal of A
+
+	// work vectors
+	vector<double>	m_r0, m_r1;
+
+private:
+	int		m_maxiter;		//!< max number of iterations
+	int		m_nrestart;		//!< nr of non-restarted iterations
+	double	m_tol;			//!< relative residual convergence tolerance
+	int		m_printLevel;	//!< print level
+	int		m_nschur;		//!< partition that defines the Schur block
+	int		m_iter;			//!< nr of iterations of last solve
+};
@@ -173,6 +173,14 @@ bool FGMRESSolver::PreProcess()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+bool FGMRESSolver::Factor()
+{
+	// The matrix has changed, so the preconditioner must be recreated in the next backsolve.
+	m_doPreCond = (m_P != 0);
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 bool FGMRESSolver::BackSolve(vector<double>& x, vector<double>& b)
 {
@@ -42,8 +42,8 @@ public:
 	//! do any pre-processing (allocates temp storage)
 	bool PreProcess();
 
-	//! Factor the matrix (does nothing for iterative solvers)
-	bool Factor() { return true; }
+	//! Factor the matrix (only flags that the preconditioner needs to be recreated)
+	bool Factor();
 
 	//! Calculate the solution of RHS b and store solution in x
 	bool BackSolve(vector<double>& x, vector<double>& b);
@@ -0,0 +1,312 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "MixedPrecisionSolver.h"
+#include <stdio.h>
+#include <math.h>
+
+#ifdef PARDISO
+// The single precision mode requires float arrays, so we use void pointers
+// for the matrix and vector arguments.
+extern "C"
+{
+	int pardisoinit_(void *, int *, int *);
+
+	int pardiso_(void *, int *, int *, int *, int *, int *,
+		void *, int *, int *, int *, int *, int *,
+		int *, void *, void *, int *);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+MixedPrecisionSolver::MixedPrecisionSolver() : m_pA(0)
+{
+	m_bsymm = true;
+	m_bdouble = false;
+	m_bfactor = false;
+
+	m_method = REFINEMENT;
+	m_maxiter = 10;
+	m_tol = 1e-12;
+	m_stall = 0.5;
+	m_printLevel = 0;
+
+	m_mtype = 0;
+	m_n = 0;
+	m_nrhs = 1;
+	m_maxfct = 1;
+	m_mnum = 1;
+	m_msglvl = 0;
+	for (int i=0; i<64; ++i) { m_iparm[i] = 0; m_pt[i] = 0; }
+
+	m_gmres.SetPreconditioner(new SinglePrecisionPreconditioner(this));
+}
+
+//-----------------------------------------------------------------------------
+MixedPrecisionSolver::~MixedPrecisionSolver()
+{
+}
+
+//-----------------------------------------------------------------------------
+void MixedPrecisionSolver::SetMethod(int n) { m_method = n; }
+void MixedPrecisionSolver::SetMaxIterations(int n) { m_maxiter = n; }
+void MixedPrecisionSolver::SetConvergenceTolerance(double tol) { m_tol = tol; }
+void MixedPrecisionSolver::SetStallRatio(double r) { m_stall = r; }
+void MixedPrecisionSolver::SetPrintLevel(int n) { m_printLevel = n; }
+
+//-----------------------------------------------------------------------------
+SparseMatrix* MixedPrecisionSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	m_bsymm = (ntype == REAL_SYMMETRIC);
+	if (m_bsymm) m_pA = new CompactSymmMatrix(1);
+	else m_pA = new CRSSparseMatrix(1);
+	return m_pA;
+}
+
+//-----------------------------------------------------------------------------
+void MixedPrecisionSolver::InitPardiso(bool bsingle)
+{
+#ifdef PARDISO
+	m_mtype = (m_bsymm ? -2 : 11);
+	m_iparm[0] = 0;
+	pardisoinit_(m_pt, &m_mtype, m_iparm);
+
+	m_iparm[0] = 1;						// we modify the defaults
+	m_iparm[7] = (bsingle ? 0 : 1);		// we do the refinement ourselves in single precision mode
+	m_iparm[27] = (bsingle ? 1 : 0);	// single or double precision
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool MixedPrecisionSolver::CallPardiso(int phase, void* a, void* b, void* x)
+{
+#ifdef PARDISO
+	int error = 0;
+	pardiso_(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, a, m_pA->Pointers(), m_pA->Indices(),
+		NULL, &m_nrhs, m_iparm, &m_msglvl, b, x, &error);
+	if (error)
+	{
+		fprintf(stderr, "\nERROR in mixed precision solver (pardiso phase %d): error %d\n", phase, error);
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void MixedPrecisionSolver::ReleasePardiso()
+{
+	if (m_bfactor && m_pA && m_pA->Pointers())
+	{
+		CallPardiso(-1, NULL, NULL, NULL);
+	}
+	m_bfactor = false;
+}
+
+//-----------------------------------------------------------------------------
+bool MixedPrecisionSolver::PreProcess()
+{
+	// Make sure the solver is available
+#ifndef PARDISO
+	fprintf(stderr, "FATAL ERROR: The mixed precision solver is not available on this platform\n\n");
+	return false;
+#else
+	// release a previous factorization before pardiso is reinitialized
+	ReleasePardiso();
+
+	m_n = m_pA->Rows();
+	InitPardiso(m_bdouble == false);
+
+	m_r.resize(m_n);
+	m_d.resize(m_n);
+	if (m_bdouble == false)
+	{
+		m_bf.resize(m_n);
+		m_xf.resize(m_n);
+	}
+
+	if (m_method == FGMRES)
+	{
+		m_gmres.SetSparseMatrix(m_pA);
+		m_gmres.SetMaxIterations(m_maxiter);
+		m_gmres.SetNonRestartedIterations(m_maxiter);
+		m_gmres.DoResidualStoppingTest(true);
+		m_gmres.SetResidualTolerance(m_tol);
+		m_gmres.SetPrintLevel(m_printLevel > 1 ? 1 : 0);
+		if (m_gmres.PreProcess() == false) return false;
+	}
+
+	return LinearSolver::PreProcess();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool MixedPrecisionSolver::Factor()
+{
+	// make sure we have work to do
+	if (m_pA->Rows() == 0) return true;
+
+	// release the previous factorization
+	ReleasePardiso();
+
+	if (m_bdouble) return FactorDouble();
+
+	// copy the matrix values to single precision
+	int nnz = m_pA->NonZeroes();
+	m_af.resize(nnz);
+	const double* a = m_pA->Values();
+	for (int i=0; i<nnz; ++i) m_af[i] = (float) a[i];
+
+	// reordering, symbolic and numerical factorization
+	m_bfactor = true;
+	if (CallPardiso(12, &m_af[0], NULL, NULL) == false)
+	{
+		// The single precision factorization can fail for matrices that are too
+		// ill-conditioned for single precision, so we try again in double.
+		fprintf(stderr, "Mixed precision solver: single precision factorization failed. Switching to double precision.\n");
+		ReleasePardiso();
+		return FactorDouble();
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool MixedPrecisionSolver::FactorDouble()
+{
+	if (m_bfactor) ReleasePardiso();
+
+	// we don't need the single precision data anymore
+	if (m_bdouble == false)
+	{
+		m_bdouble = true;
+		m_af.clear(); m_af.shrink_to_fit();
+		m_bf.clear(); m_bf.shrink_to_fit();
+		m_xf.clear(); m_xf.shrink_to_fit();
+		InitPardiso(false);
+	}
+
+	m_bfactor = true;
+	return CallPardiso(12, m_pA->Values(), NULL, NULL);
+}
+
+//-----------------------------------------------------------------------------
+void MixedPrecisionSolver::SingleSolve(const double* b, double* x)
+{
+	// scale the right hand side to avoid under- or overflow in single precision
+	double s = 0.0;
+	for (int i=0; i<m_n; ++i) s = (fabs(b[i]) > s ? fabs(b[i]) : s);
+	if (s == 0.0)
+	{
+		for (int i=0; i<m_n; ++i) x[i] = 0.0;
+		return;
+	}
+
+	for (int i=0; i<m_n; ++i) m_bf[i] = (float)(b[i] / s);
+	CallPardiso(33, &m_af[0], &m_bf[0], &m_xf[0]);
+	for (int i=0; i<m_n; ++i) x[i] = s*(double)m_xf[i];
+}
+
+//-----------------------------------------------------------------------------
+bool MixedPrecisionSolver::Refine(vector<double>& x, vector<double>& b)
+{
+	double bnorm = 0.0;
+	for (int i=0; i<m_n; ++i) bnorm += b[i]*b[i];
+	bnorm = sqrt(bnorm);
+
+	for (int i=0; i<m_n; ++i) { x[i] = 0.0; m_r[i] = b[i]; }
+	if (bnorm == 0.0) return true;
+
+	double rprev = bnorm;
+	for (int k=0; k<m_maxiter; ++k)
+	{
+		// solve for the correction with the single precision factor
+		SingleSolve(&m_r[0], &m_d[0]);
+		for (int i=0; i<m_n; ++i) x[i] += m_d[i];
+
+		// calculate the residual in double precision
+		m_pA->mult_vector(&x[0], &m_r[0]);
+		double rnorm = 0.0;
+		for (int i=0; i<m_n; ++i)
+		{
+			m_r[i] = b[i] - m_r[i];
+			rnorm += m_r[i]*m_r[i];
+		}
+		rnorm = sqrt(rnorm);
+
+		if (m_printLevel > 1) fprintf(stdout, "%d: %lg\n", k + 1, rnorm / bnorm);
+
+		if (rnorm <= m_tol*bnorm)
+		{
+			if (m_printLevel > 0) fprintf(stdout, "Mixed precision solver: %d refinement steps, relative residual = %lg\n", k + 1, rnorm / bnorm);
+			return true;
+		}
+
+		// see if the refinement stalls
+		if (rnorm > m_stall*rprev) break;
+		rprev = rnorm;
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool MixedPrecisionSolver::BackSolve(vector<double>& x, vector<double>& b)
+{
+	// make sure we have work to do
+	if (m_pA->Rows() == 0) return true;
+
+	if (m_bdouble == false)
+	{
+		bool bconv = false;
+		if (m_method == FGMRES)
+		{
+			for (int i=0; i<m_n; ++i) x[i] = 0.0;
+			bconv = m_gmres.BackSolve(x, b);
+		}
+		else bconv = Refine(x, b);
+		if (bconv) return true;
+
+		// fall back to double precision
+		fprintf(stderr, "Mixed precision solver: refinement stalled. Switching to double precision.\n");
+		if (FactorDouble() == false) return false;
+	}
+
+	return CallPardiso(33, m_pA->Values(), &b[0], &x[0]);
+}
+
+//-----------------------------------------------------------------------------
+void MixedPrecisionSolver::Destroy()
+{
+	ReleasePardiso();
+	m_af.clear(); m_af.shrink_to_fit();
+	m_gmres.Destroy();
+	LinearSolver::Destroy();
+}
@@ -0,0 +1,146 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2019 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactUnSymmMatrix.h"
+#include "CompactSymmMatrix.h"
+#include "FGMRESSolver.h"
+
+//-----------------------------------------------------------------------------
+// This class implements a mixed-precision direct solver. The matrix is factored
+// in single precision with the MKL version of Pardiso, which halves the memory
+// and bandwidth of the factor. Double precision accuracy is then recovered either
+// by iterative refinement (residuals are evaluated with the double precision
+// matrix), or by using the single precision factor as a preconditioner for FGMRES.
+// If the refinement stalls (or FGMRES fails), the matrix is factored in double
+// precision and the solver stays in double precision for the rest of the run.
+class MixedPrecisionSolver : public LinearSolver
+{
+	// preconditioner that applies the single precision factor
+	class SinglePrecisionPreconditioner : public Preconditioner
+	{
+	public:
+		SinglePrecisionPreconditioner(MixedPrecisionSolver* ls) : m_ls(ls) {}
+
+		// the factor is created by the solver
+		bool Create(SparseMatrix* A) override { return true; }
+
+		// apply to vector P x = y
+		void mult_vector(double* x, double* y) override { m_ls->SingleSolve(x, y); }
+
+	private:
+		MixedPrecisionSolver*	m_ls;
+	};
+
+public:
+	enum { REFINEMENT, FGMRES };
+
+public:
+	//! constructor
+	MixedPrecisionSolver();
+
+	//! destructor
+	~MixedPrecisionSolver();
+
+public:
+	//! Preprocess
+	bool PreProcess() override;
+
+	//! Factor matrix
+	bool Factor() override;
+
+	//! Backsolve the linear system
+	bool BackSolve(vector<double>& x, vector<double>& b) override;
+
+	//! Clean up
+	void Destroy() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+public:
+	// set the method used to recover double precision (REFINEMENT or FGMRES)
+	void SetMethod(int n);
+
+	// set max nr of refinement (or FGMRES) iterations
+	void SetMaxIterations(int n);
+
+	// set the relative convergence tolerance
+	void SetConvergenceTolerance(double tol);
+
+	// set the minimum reduction of the residual per refinement step
+	void SetStallRatio(double r);
+
+	// set the print level
+	void SetPrintLevel(int n);
+
+private:
+	// solve with the single precision factor, x = A^-1 b
+	void SingleSolve(const double* b, double* x);
+
+	// do the iterative refinement
+	bool Refine(vector<double>& x, vector<double>& b);
+
+	// switch to double precision
+	bool FactorDouble();
+
+	// initialize pardiso
+	void InitPardiso(bool bsingle);
+
+	// call pardiso
+	bool CallPardiso(int phase, void* a, void* b, void* x);
+
+	// release the pardiso memory
+	void ReleasePardiso();
+
+private:
+	CompactMatrix*	m_pA;		//!< the global matrix (double precision)
+	bool			m_bsymm;	//!< symmetric matrix or not
+	bool			m_bdouble;	//!< fell back to double precision
+	bool			m_bfactor;	//!< pardiso holds a factorization
+
+	vector<float>	m_af;		//!< single precision copy of matrix values
+	vector<float>	m_bf, m_xf;	//!< single precision work vectors
+	vector<double>	m_r, m_d;	//!< double precision work vectors
+
+	FGMRESSolver	m_gmres;	//!< FGMRES solver for the FGMRES method
+
+	// Pardiso control parameters
+	int		m_iparm[64];
+	int		m_maxfct, m_mnum, m_msglvl;
+	int		m_mtype;
+	int		m_n, m_nrhs;
+	void*	m_pt[64];
+
+private:
+	int		m_method;		//!< REFINEMENT or FGMRES
+	int		m_maxiter;		//!< max number of iterations
+	double	m_tol;			//!< relative residual convergence tolerance
+	double	m_stall;		//!< minimum residual reduction factor per refinement step
+	int		m_printLevel;	//!< print level
+};
@@ -44,6 +44,8 @@ SOFTWARE.*/
 #include "StokesSolver.h"
 #include "CG_Stokes_Solver.h"
 #include "SchurSolver.h"
+#include "BlockGMRESSolver.h"
+#include "MixedPrecisionSolver.h"
 #include "FECore/FE_enum.h"
 #include "FECore/FECoreFactory.h"
 #include "FECore/FECoreKernel.h"
@@ -285,10 +287,12 @@ public:
 		m_print_level = 0;
 		m_doResidualTest = true;
 		m_tol = 0;
+		m_precond = 0;
 	}
 	LinearSolver* Create() override
 	{
 		FGMRESSolver* ls = new FGMRESSolver();
+		if (m_precond == 1) ls->SetPreconditioner(new DiagonalPreconditioner);
 		ls->SetMaxIterations(m_maxiter);
 		ls->SetNonRestartedIterations(m_nrestart);
 		ls->SetPrintLevel(m_print_level);
@@ -303,6 +307,7 @@ private:
 	int		m_print_level;		// print level
 	bool	m_doResidualTest;	// residual stopping tets flag
 	double	m_tol;				// residual convergence tolerance
+	int		m_precond;			// preconditioner (0 = none, 1 = Jacobi)
 
 	DECLARE_PARAMETER_LIST();
 };
@@ -315,6 +320,7 @@ BEGIN_PARAMETER_LIST(FGMRESSolverFactory, FELinearSolverFactory)
 	ADD_PARAMETER(m_doResidualTest, FE_PARAM_BOOL  , "check_residual");
 	ADD_PARAMETER(m_nrestart      , FE_PARAM_INT   , "maxrestart");
 	ADD_PARAMETER(m_tol           , FE_PARAM_DOUBLE, "tol");
+	ADD_PARAMETER(m_precond       , FE_PARAM_INT   , "precondition");
 END_PARAMETER_LIST();
 
 #define REGISTER_LINEAR_SOLVER(theSolver, theID) static LinearSolverFactory_T<theSolver, theID> _##theSolver;
@@ -516,6 +522,101 @@ BEGIN_PARAMETER_LIST(Schur_SolverFactory, FELinearSolverFactory)
 	ADD_PARAMETER(m_tol, FE_PARAM_DOUBLE, "tol");
 END_PARAMETER_LIST();
 
+//=============================================================================
+
+template <> class LinearSolverFactory_T<BlockGMRESSolver, BLOCK_GMRES_SOLVER> : public FELinearSolverFactory
+{
+public:
+	LinearSolverFactory_T() : FELinearSolverFactory(BLOCK_GMRES_SOLVER)
+	{
+		FECoreKernel& fecore = FECoreKernel::GetInstance();
+		fecore.RegisterLinearSolver(this);
+
+		m_maxiter = 0;	// use default min(N, 1000)
+		m_nrestart = 30;
+		m_tol = 1e-8;
+		m_print_level = 0;
+		m_nschur = 1;
+	}
+
+	LinearSolver* Create() override
+	{
+		BlockGMRESSolver* ls = new BlockGMRESSolver();
+		ls->SetPrintLevel(m_print_level);
+		ls->SetMaxIterations(m_maxiter);
+		ls->SetNonRestartedIterations(m_nrestart);
+		ls->SetConvergenceTolerance(m_tol);
+		ls->SetSchurBlock(m_nschur);
+		return ls;
+	}
+
+private:
+	int		m_maxiter;		// max nr of iterations
+	int		m_nrestart;		// nr of non-restarted iterations
+	double	m_tol;			// residual relative tolerance
+	int		m_print_level;	// output level
+	int		m_nschur;		// partition of the Schur complement block
+
+	DECLARE_PARAMETER_LIST();
+};
+
+typedef LinearSolverFactory_T<BlockGMRESSolver, BLOCK_GMRES_SOLVER> BlockGMRES_SolverFactory;
+
+BEGIN_PARAMETER_LIST(BlockGMRES_SolverFactory, FELinearSolverFactory)
+	ADD_PARAMETER(m_print_level, FE_PARAM_INT, "print_level");
+	ADD_PARAMETER(m_maxiter, FE_PARAM_INT, "maxiter");
+	ADD_PARAMETER(m_nrestart, FE_PARAM_INT, "maxrestart");
+	ADD_PARAMETER(m_tol, FE_PARAM_DOUBLE, "tol");
+	ADD_PARAMETER(m_nschur, FE_PARAM_INT, "schur_block");
+END_PARAMETER_LIST();
+
+//=============================================================================
+
+template <> class LinearSolverFactory_T<MixedPrecisionSolver, MIXED_PRECISION_SOLVER> : public FELinearSolverFactory
+{
+public:
+	LinearSolverFactory_T() : FELinearSolverFactory(MIXED_PRECISION_SOLVER)
+	{
+		FECoreKernel& fecore = FECoreKernel::GetInstance();
+		fecore.RegisterLinearSolver(this);
+
+		m_method = MixedPrecisionSolver::REFINEMENT;
+		m_maxiter = 10;
+		m_tol = 1e-12;
+		m_stall = 0.5;
+		m_print_level = 0;
+	}
+
+	LinearSolver* Create() override
+	{
+		MixedPrecisionSolver* ls = new MixedPrecisionSolver();
+		ls->SetMethod(m_method);
+		ls->SetMaxIterations(m_maxiter);
+		ls->SetConvergenceTolerance(m_tol);
+		ls->SetStallRatio(m_stall);
+		ls->SetPrintLevel(m_print_level);
+		return ls;
+	}
+
+private:
+	int		m_method;		// 0 = iterative refinement, 1 = FGMRES
+	int		m_maxiter;		// max nr of iterations
+	double	m_tol;			// residual relative tolerance
+	double	m_stall;		// min residual reduction per refinement step
+	int		m_print_level;	// output level
+
+	DECLARE_PARAMETER_LIST();
+};
+
+typedef LinearSolverFactory_T<MixedPrecisionSolver, MIXED_PRECISION_SOLVER> MixedPrecision_SolverFactory;
+
+BEGIN_PARAMETER_LIST(MixedPrecision_SolverFactory, FELinearSolverFactory)
+	ADD_PARAMETER(m_method, FE_PARAM_INT, "method");
+	ADD_PARAMETER(m_maxiter, FE_PARAM_INT, "maxiter");
+	ADD_PARAMETER(m_tol, FE_PARAM_DOUBLE, "tol");
+	ADD_PARAMETER(m_stall, FE_PARAM_DOUBLE, "stall_ratio");
+	ADD_PARAMETER(m_print_level, FE_PARAM_INT, "print_level");
+END_PARAMETER_LIST();
 
 } // namespace NumCore
 
@@ -540,5 +641,7 @@ REGISTER_LINEAR_SOLVER(HypreGMRESsolver  , HYPRE_GMRES        );
 REGISTER_LINEAR_SOLVER(StokesSolver      , STOKES_SOLVER      );
 REGISTER_LINEAR_SOLVER(CG_Stokes_Solver  , CG_STOKES_SOLVER   );
 REGISTER_LINEAR_SOLVER(SchurSolver       , SCHUR_SOLVER       );
+REGISTER_LINEAR_SOLVER(BlockGMRESSolver  , BLOCK_GMRES_SOLVER );
+REGISTER_LINEAR_SOLVER(MixedPrecisionSolver, MIXED_PRECISION_SOLVER);
 }
 
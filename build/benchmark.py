@@ -0,0 +1,381 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# FEBio benchmark suite
+#
+# This script generates a set of canonical models that can be scaled by the
+# number of elements, runs them with febio2 for different numbers of threads and
+# collects the timing information that febio2 writes with the -timings option.
+# The results are written to a JSON file so that they can be compared between
+# versions. Run "make benchmark" from the build directory, or run this script
+# directly (see "python benchmark.py -h" for the options).
+#
+# The following models are defined:
+#   hex8        neo-Hookean block (HEX8 elements) in uniaxial compression
+#   tet10       neo-Hookean block (TET10 elements) in uniaxial compression
+#   biphasic    confined compression of a biphasic block
+#   contact     two neo-Hookean blocks in sliding contact (non-matching meshes)
+#   multiphasic confined compression of a multiphasic block with one solute
+#   fluid       flow through a rectangular channel
+#
+# The size parameter is the number of elements along an edge of the block.
+from __future__ import print_function
+import argparse, json, os, subprocess, sys, time
+
+# =============================================================================
+# Mesh generation
+# =============================================================================
+
+# outward faces of the element types, in local node numbers
+HEX8_FACES  = [(0,1,5,4), (1,2,6,5), (2,3,7,6), (3,0,4,7), (3,2,1,0), (4,5,6,7)]
+TET10_FACES = [(0,1,3,4,8,7), (1,2,3,5,9,8), (2,0,3,6,7,9), (2,1,0,5,4,6)]
+
+# Kuhn triangulation of a cube in six tetrahedra. This gives conforming meshes
+# when all cubes are split the same way. The indices refer to the cube corners
+# numbered as i + 2*j + 4*k.
+KUHN_TETS = [(0,1,3,7), (0,1,5,7), (0,2,3,7), (0,2,6,7), (0,4,5,7), (0,4,6,7)]
+
+class Mesh:
+	def __init__(self):
+		self.nodes = []		# nodal coordinates
+		self.parts = []		# list of (name, element type, material, element list)
+
+	def add_node(self, x):
+		self.nodes.append(x)
+		return len(self.nodes) - 1
+
+	def elements(self):
+		return sum(len(p[3]) for p in self.parts)
+
+	def node_set(self, f):
+		# all nodes whose position satisfies f
+		return [i for i, x in enumerate(self.nodes) if f(x)]
+
+	def surface(self, part, f):
+		# all element faces of a part whose nodes satisfy f
+		name, etype, mat, elems = self.parts[part]
+		faces = HEX8_FACES if etype == "hex8" else TET10_FACES
+		surf = []
+		for e in elems:
+			for face in faces:
+				fn = [e[i] for i in face]
+				if all(f(self.nodes[n]) for n in fn): surf.append(fn)
+		return surf
+
+def tet_volume(x, e):
+	a = [x[e[1]][i] - x[e[0]][i] for i in range(3)]
+	b = [x[e[2]][i] - x[e[0]][i] for i in range(3)]
+	c = [x[e[3]][i] - x[e[0]][i] for i in range(3)]
+	return (a[0]*(b[1]*c[2] - b[2]*c[1]) - a[1]*(b[0]*c[2] - b[2]*c[0]) + a[2]*(b[0]*c[1] - b[1]*c[0]))/6.0
+
+def add_block(mesh, name, mat, etype, x0, x1, n):
+	# add a block [x0,x1] with n = (nx,ny,nz) divisions to the mesh
+	nx, ny, nz = n
+	def grid(i, j, k):
+		return [x0[0] + (x1[0] - x0[0])*i/float(nx), x0[1] + (x1[1] - x0[1])*j/float(ny), x0[2] + (x1[2] - x0[2])*k/float(nz)]
+
+	base = len(mesh.nodes)
+	for k in range(nz + 1):
+		for j in range(ny + 1):
+			for i in range(nx + 1): mesh.add_node(grid(i, j, k))
+	def nid(i, j, k): return base + i + j*(nx + 1) + k*(nx + 1)*(ny + 1)
+
+	elems = []
+	edges = {}
+	for k in range(nz):
+		for j in range(ny):
+			for i in range(nx):
+				if etype == "hex8":
+					elems.append([nid(i,j,k), nid(i+1,j,k), nid(i+1,j+1,k), nid(i,j+1,k),
+								  nid(i,j,k+1), nid(i+1,j,k+1), nid(i+1,j+1,k+1), nid(i,j+1,k+1)])
+				else:
+					c = [nid(i + (m & 1), j + ((m >> 1) & 1), k + ((m >> 2) & 1)) for m in range(8)]
+					for t in KUHN_TETS:
+						e = [c[m] for m in t]
+						if tet_volume(mesh.nodes, e) < 0: e[1], e[2] = e[2], e[1]
+
+						# add the mid-side nodes (shared between elements)
+						for a, b in [(0,1), (1,2), (2,0), (0,3), (1,3), (2,3)]:
+							key = (min(e[a], e[b]), max(e[a], e[b]))
+							if key not in edges:
+								xa, xb = mesh.nodes[e[a]], mesh.nodes[e[b]]
+								edges[key] = mesh.add_node([0.5*(xa[m] + xb[m]) for m in range(3)])
+							e.append(edges[key])
+						elems.append(e)
+
+	mesh.parts.append((name, etype, mat, elems))
+	return len(mesh.parts) - 1
+
+# =============================================================================
+# Model definition
+# =============================================================================
+
+class Model:
+	def __init__(self, module, analysis, steps, dt):
+		self.module = module
+		self.analysis = analysis
+		self.steps = steps
+		self.dt = dt
+		self.mesh = Mesh()
+		self.globals = ""
+		self.materials = []		# xml strings
+		self.node_sets = {}
+		self.surfaces = {}
+		self.surface_pairs = {}
+		self.bcs = []			# xml strings
+		self.contact = []		# xml strings
+		self.plot_vars = []
+
+	def fix(self, dofs, nset):
+		self.bcs.append('\t\t<fix bc="%s" node_set="%s"/>\n' % (dofs, nset))
+
+	def prescribe(self, dof, nset, value):
+		self.bcs.append('\t\t<prescribe bc="%s" node_set="%s">\n\t\t\t<scale lc="1">%g</scale>\n\t\t\t<relative>0</relative>\n\t\t</prescribe>\n' % (dof, nset, value))
+
+	def write(self, fname):
+		m = self.mesh
+		f = open(fname, "w")
+		f.write('<?xml version="1.0" encoding="ISO-8859-1"?>\n')
+		f.write('<febio_spec version="2.5">\n')
+		f.write('\t<Module type="%s"/>\n' % self.module)
+		f.write('\t<Control>\n')
+		f.write('\t\t<time_steps>%d</time_steps>\n' % self.steps)
+		f.write('\t\t<step_size>%g</step_size>\n' % self.dt)
+		f.write('\t\t<analysis type="%s"/>\n' % self.analysis)
+		f.write('\t\t<plot_level>PLOT_MAJOR_ITRS</plot_level>\n')
+		f.write('\t</Control>\n')
+		if self.globals: f.write(self.globals)
+		f.write('\t<Material>\n')
+		for s in self.materials: f.write(s)
+		f.write('\t</Material>\n')
+		f.write('\t<Geometry>\n')
+		f.write('\t\t<Nodes name="nodes">\n')
+		for i, x in enumerate(m.nodes): f.write('\t\t\t<node id="%d">%.9g,%.9g,%.9g</node>\n' % (i + 1, x[0], x[1], x[2]))
+		f.write('\t\t</Nodes>\n')
+		eid = 1
+		for name, etype, mat, elems in m.parts:
+			f.write('\t\t<Elements type="%s" mat="%d" name="%s">\n' % (etype, mat, name))
+			for e in elems:
+				f.write('\t\t\t<elem id="%d">%s</elem>\n' % (eid, ",".join(str(n + 1) for n in e)))
+				eid += 1
+			f.write('\t\t</Elements>\n')
+		for name in sorted(self.node_sets):
+			f.write('\t\t<NodeSet name="%s">\n' % name)
+			for n in self.node_sets[name]: f.write('\t\t\t<node id="%d"/>\n' % (n + 1))
+			f.write('\t\t</NodeSet>\n')
+		for name in sorted(self.surfaces):
+			f.write('\t\t<Surface name="%s">\n' % name)
+			for i, fn in enumerate(self.surfaces[name]):
+				ftype = "quad4" if len(fn) == 4 else "tri6"
+				f.write('\t\t\t<%s id="%d">%s</%s>\n' % (ftype, i + 1, ",".join(str(n + 1) for n in fn), ftype))
+			f.write('\t\t</Surface>\n')
+		for name in sorted(self.surface_pairs):
+			master, slave = self.surface_pairs[name]
+			f.write('\t\t<SurfacePair name="%s">\n\t\t\t<master surface="%s"/>\n\t\t\t<slave surface="%s"/>\n\t\t</SurfacePair>\n' % (name, master, slave))
+		f.write('\t</Geometry>\n')
+		f.write('\t<Boundary>\n')
+		for s in self.bcs: f.write(s)
+		f.write('\t</Boundary>\n')
+		if self.contact:
+			f.write('\t<Contact>\n')
+			for s in self.contact: f.write(s)
+			f.write('\t</Contact>\n')
+		f.write('\t<LoadData>\n')
+		f.write('\t\t<loadcurve id="1" type="smooth">\n\t\t\t<point>0,0</point>\n\t\t\t<point>%g,1</point>\n\t\t</loadcurve>\n' % (self.steps*self.dt))
+		f.write('\t</LoadData>\n')
+		f.write('\t<Output>\n')
+		f.write('\t\t<plotfile type="febio">\n')
+		for v in self.plot_vars: f.write('\t\t\t<var type="%s"/>\n' % v)
+		f.write('\t\t</plotfile>\n')
+		f.write('\t</Output>\n')
+		f.write('</febio_spec>\n')
+		f.close()
+
+NEO_HOOKEAN = '\t\t\t<E>1</E>\n\t\t\t<v>0.3</v>\n'
+
+def eps(a, b): return abs(a - b) < 1e-9
+
+def solid_block(etype, n):
+	fem = Model("solid", "static", 10, 0.1)
+	fem.materials.append('\t\t<material id="1" name="solid" type="neo-Hookean">\n' + NEO_HOOKEAN + '\t\t</material>\n')
+	add_block(fem.mesh, "block", 1, etype, [0,0,0], [1,1,1], [n,n,n])
+	fem.node_sets["bottom"] = fem.mesh.node_set(lambda x: eps(x[2], 0))
+	fem.node_sets["top"]    = fem.mesh.node_set(lambda x: eps(x[2], 1))
+	fem.fix("x,y,z", "bottom")
+	fem.prescribe("z", "top", -0.2)
+	fem.plot_vars = ["displacement", "stress"]
+	return fem
+
+def confined_compression(fem, n):
+	mesh = fem.mesh
+	add_block(mesh, "block", 1, "hex8", [0,0,0], [1,1,1], [n,n,n])
+	fem.node_sets["xfaces"] = mesh.node_set(lambda x: eps(x[0], 0) or eps(x[0], 1))
+	fem.node_sets["yfaces"] = mesh.node_set(lambda x: eps(x[1], 0) or eps(x[1], 1))
+	fem.node_sets["bottom"] = mesh.node_set(lambda x: eps(x[2], 0))
+	fem.node_sets["top"]    = mesh.node_set(lambda x: eps(x[2], 1))
+	fem.fix("x", "xfaces")
+	fem.fix("y", "yfaces")
+	fem.fix("z", "bottom")
+	fem.fix("p", "top")
+	fem.prescribe("z", "top", -0.1)
+
+def biphasic(n):
+	fem = Model("biphasic", "transient", 10, 0.1)
+	fem.materials.append(
+		'\t\t<material id="1" name="biphasic" type="biphasic">\n'
+		'\t\t\t<phi0>0.2</phi0>\n'
+		'\t\t\t<solid type="neo-Hookean">\n' + NEO_HOOKEAN.replace('\t\t\t', '\t\t\t\t') + '\t\t\t</solid>\n'
+		'\t\t\t<permeability type="perm-const-iso">\n\t\t\t\t<perm>0.001</perm>\n\t\t\t</permeability>\n'
+		'\t\t</material>\n')
+	confined_compression(fem, n)
+	fem.plot_vars = ["displacement", "effective fluid pressure", "fluid flux"]
+	return fem
+
+def multiphasic(n):
+	fem = Model("multiphasic", "transient", 10, 0.1)
+	fem.globals = ('\t<Globals>\n'
+		'\t\t<Constants>\n\t\t\t<T>298</T>\n\t\t\t<R>8.314e-06</R>\n\t\t\t<Fc>9.6485e-05</Fc>\n\t\t</Constants>\n'
+		'\t\t<Solutes>\n\t\t\t<solute id="1" name="solute">\n\t\t\t\t<charge_number>0</charge_number>\n'
+		'\t\t\t\t<molar_mass>1</molar_mass>\n\t\t\t\t<density>1</density>\n\t\t\t</solute>\n\t\t</Solutes>\n'
+		'\t</Globals>\n')
+	fem.materials.append(
+		'\t\t<material id="1" name="multiphasic" type="multiphasic">\n'
+		'\t\t\t<phi0>0.2</phi0>\n'
+		'\t\t\t<fixed_charge_density>0</fixed_charge_density>\n'
+		'\t\t\t<solid type="neo-Hookean">\n' + NEO_HOOKEAN.replace('\t\t\t', '\t\t\t\t') + '\t\t\t</solid>\n'
+		'\t\t\t<permeability type="perm-const-iso">\n\t\t\t\t<perm>0.001</perm>\n\t\t\t</permeability>\n'
+		'\t\t\t<osmotic_coefficient type="osm-coef-const">\n\t\t\t\t<osmcoef>1</osmcoef>\n\t\t\t</osmotic_coefficient>\n'
+		'\t\t\t<solute sol="1">\n'
+		'\t\t\t\t<diffusivity type="diff-const-iso">\n\t\t\t\t\t<free_diff>0.001</free_diff>\n\t\t\t\t\t<diff>0.0005</diff>\n\t\t\t\t</diffusivity>\n'
+		'\t\t\t\t<solubility type="solub-const">\n\t\t\t\t\t<solub>1</solub>\n\t\t\t\t</solubility>\n'
+		'\t\t\t</solute>\n'
+		'\t\t</material>\n')
+	confined_compression(fem, n)
+	fem.prescribe("c1", "top", 1.0)
+	fem.plot_vars = ["displacement", "effective fluid pressure", "effective solute concentration"]
+	return fem
+
+def contact(n):
+	fem = Model("solid", "static", 10, 0.1)
+	fem.materials.append('\t\t<material id="1" name="solid" type="neo-Hookean">\n' + NEO_HOOKEAN + '\t\t</material>\n')
+	mesh = fem.mesh
+	# the upper block uses a different mesh density so that the meshes don't match
+	lower = add_block(mesh, "lower", 1, "hex8", [0,0,0.0], [1,1,0.5], [n, n, max(n//2, 1)])
+	upper = add_block(mesh, "upper", 1, "hex8", [0,0,0.5], [1,1,1.0], [n + 1, n + 1, max((n + 1)//2, 1)])
+	nlower = (n + 1)*(n + 1)*(max(n//2, 1) + 1)
+	fem.node_sets["bottom"] = [i for i in mesh.node_set(lambda x: eps(x[2], 0))]
+	fem.node_sets["top"]    = [i for i in mesh.node_set(lambda x: eps(x[2], 1)) if i >= nlower]
+	fem.surfaces["contact_master"] = mesh.surface(lower, lambda x: eps(x[2], 0.5))
+	fem.surfaces["contact_slave"]  = mesh.surface(upper, lambda x: eps(x[2], 0.5))
+	fem.surface_pairs["contact"] = ("contact_master", "contact_slave")
+	fem.fix("x,y,z", "bottom")
+	fem.fix("x,y", "top")
+	fem.prescribe("z", "top", -0.1)
+	fem.contact.append('\t\t<contact type="sliding-elastic" surface_pair="contact">\n'
+		'\t\t\t<penalty>1</penalty>\n\t\t\t<auto_penalty>1</auto_penalty>\n\t\t\t<two_pass>0</two_pass>\n'
+		'\t\t\t<laugon>0</laugon>\n\t\t\t<search_tol>0.01</search_tol>\n\t\t</contact>\n')
+	fem.plot_vars = ["displacement", "stress", "contact pressure"]
+	return fem
+
+def fluid(n):
+	fem = Model("fluid", "dynamic", 10, 0.1)
+	fem.materials.append(
+		'\t\t<material id="1" name="fluid" type="fluid">\n'
+		'\t\t\t<density>1</density>\n\t\t\t<k>10</k>\n'
+		'\t\t\t<viscous type="Newtonian fluid">\n\t\t\t\t<mu>0.01</mu>\n\t\t\t\t<kappa>0</kappa>\n\t\t\t</viscous>\n'
+		'\t\t</material>\n')
+	mesh = fem.mesh
+	add_block(mesh, "channel", 1, "hex8", [0,0,0], [4,1,1], [4*n, n, n])
+	wall = lambda x: eps(x[1], 0) or eps(x[1], 1) or eps(x[2], 0) or eps(x[2], 1)
+	fem.node_sets["walls"]  = mesh.node_set(wall)
+	fem.node_sets["inlet"]  = mesh.node_set(lambda x: eps(x[0], 0) and not wall(x))
+	fem.node_sets["outlet"] = mesh.node_set(lambda x: eps(x[0], 4))
+	fem.fix("wx,wy,wz", "walls")
+	fem.fix("wy,wz", "inlet")
+	fem.fix("ef", "outlet")
+	fem.prescribe("wx", "inlet", 1.0)
+	fem.plot_vars = ["fluid velocity", "fluid pressure"]
+	return fem
+
+MODELS = {
+	"hex8"       : lambda n: solid_block("hex8", n),
+	"tet10"      : lambda n: solid_block("tet10", n),
+	"biphasic"   : biphasic,
+	"contact"    : contact,
+	"multiphasic": multiphasic,
+	"fluid"      : fluid,
+}
+
+# =============================================================================
+# Runner
+# =============================================================================
+
+def run(febio, feb, threads, args):
+	base = os.path.splitext(feb)[0] + "_t%d" % threads
+	timings = base + ".json"
+	if os.path.exists(timings): os.remove(timings)
+	cmd = [febio, "-i", feb, "-o", base + ".log", "-p", base + ".xplt", "-silent", "-timings", timings]
+	if args.config: cmd += ["-config", args.config]
+	env = dict(os.environ)
+	env["OMP_NUM_THREADS"] = str(threads)
+
+	t0 = time.time()
+	ret = subprocess.call(cmd, env=env)
+	wall = time.time() - t0
+
+	res = {}
+	if os.path.exists(timings):
+		with open(timings) as f: res = json.load(f)
+	res["wall_time"] = wall
+	res["exit_code"] = ret
+	return res
+
+def main():
+	parser = argparse.ArgumentParser(description="Generate and run the FEBio benchmark models.")
+	parser.add_argument("-febio", default="bin/febio2.sky", help="the febio2 executable")
+	parser.add_argument("-config", default=None, help="FEBio configuration file (e.g. to select the linear solver)")
+	parser.add_argument("-models", default=",".join(sorted(MODELS)), help="comma separated list of models")
+	parser.add_argument("-sizes", default="4,8,16", help="comma separated list of elements per edge")
+	parser.add_argument("-threads", default="1,2,4", help="comma separated list of thread counts")
+	parser.add_argument("-dir", default="benchmark", help="directory for the models and results")
+	parser.add_argument("-o", default="benchmark.json", help="results file (written to the benchmark directory)")
+	parser.add_argument("-norun", action="store_true", help="only generate the models")
+	args = parser.parse_args()
+
+	models = args.models.split(",")
+	for m in models:
+		if m not in MODELS: sys.exit("Unknown model: %s" % m)
+	sizes = [int(s) for s in args.sizes.split(",")]
+	threads = [int(s) for s in args.threads.split(",")]
+	if not os.path.isdir(args.dir): os.makedirs(args.dir)
+
+	results = []
+	for m in models:
+		for n in sizes:
+			feb = os.path.join(args.dir, "%s_%d.feb" % (m, n))
+			fem = MODELS[m](n)
+			fem.write(feb)
+			print("%-12s size %3d : %8d nodes, %8d elements" % (m, n, len(fem.mesh.nodes), fem.mesh.elements()))
+			if args.norun: continue
+
+			t1 = None
+			for nt in threads:
+				res = run(args.febio, feb, nt, args)
+				res["model"] = m
+				res["size"] = n
+				# speedup relative to the first thread count
+				solve = res.get("phases", {}).get("solve")
+				if t1 is None: t1 = solve
+				res["speedup"] = (t1/solve if (t1 and solve) else None)
+				results.append(res)
+				print("    %2d threads : solve %10.3f s, speedup %s%s" % (nt, solve if solve else 0.0,
+					("%.2f" % res["speedup"]) if res["speedup"] else "-", "" if res.get("converged") else "  (FAILED)"))
+
+	if args.norun: return
+	fout = os.path.join(args.dir, args.o)
+	with open(fout, "w") as f:
+		json.dump({"date": time.strftime("%Y-%m-%d %H:%M:%S"), "febio": args.febio, "runs": results}, f, indent=1)
+	print("Results written to %s" % fout)
+
+if __name__ == "__main__":
+	main()